@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+// Incluir aquí las declaraciones de los benchmarks.
+// Cada benchmark recibe el tamaño del problema; 0 significa "usar el
+// tamaño por defecto" del propio benchmark.
+
+void benchBounds(size_t count);
+
+void benchIntersection(size_t count);
+
+void benchRayPacket(size_t count);
+
+void benchTriangle(size_t count);
+
+void benchFrustum(size_t count);
+
+void benchTransform(size_t count);
+
+void benchAffine(size_t count);
+
+void benchSpaceFilling(size_t count);
+
+void benchSubdivision(size_t count);
+
+void benchImplicitMesher(size_t count);
+
+void benchMeshBoolean(size_t count);
+
+void benchChunkedMesh(size_t count);
+
+void benchKdTree(size_t count);
+
+void benchInstancing(size_t count);
+
+void benchUniforms(size_t count);
+
+void benchRenderQueue(size_t count);
+
+namespace bench {
+
+// Ejecuta fn 'repeats' veces y devuelve el mejor tiempo en milisegundos
+template <typename Fn>
+double bestOf(int repeats, Fn&& fn) {
+    double best = 0.0;
+
+    for (int r = 0; r < repeats; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if (r == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    return best;
+}
+
+inline void report(const char* name, double ms, double items, const char* unit) {
+    std::cout
+        << "  " << name << ": " << ms << " ms"
+        << " (" << items / (ms * 1e3) << " M" << unit << "/s)\n";
+}
+
+// Evita que el compilador elimine un resultado que no se usa
+template <typename T>
+void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
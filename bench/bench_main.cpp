@@ -0,0 +1,60 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "bench.hpp"
+
+// Uso: ./bench_runner [nombre] [tamaño]
+// Sin nombre se ejecutan todos los benchmarks con su tamaño por defecto.
+
+namespace {
+
+struct Benchmark {
+    const char* name;
+    void (*run)(size_t count);
+};
+
+const Benchmark benchmarks[] = {
+    { "bounds", benchBounds },
+    { "raybox", benchIntersection },
+    { "packets", benchRayPacket },
+    { "triangles", benchTriangle },
+    { "frustum", benchFrustum },
+    { "transforms", benchTransform },
+    { "affine", benchAffine },
+    { "spatial", benchSpaceFilling },
+    { "subdivision", benchSubdivision },
+    { "implicit", benchImplicitMesher },
+    { "boolean", benchMeshBoolean },
+    { "chunked", benchChunkedMesh },
+    { "kdtree", benchKdTree },
+    { "instancing", benchInstancing },
+    { "uniforms", benchUniforms },
+    { "render_queue", benchRenderQueue },
+};
+
+} // namespace
+
+int main(int argc, char* argv []) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    const size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 0;
+
+    bool found = false;
+
+    for (const Benchmark& benchmark : benchmarks) {
+        if (filter != nullptr && std::strcmp(filter, benchmark.name) != 0) {
+            continue;
+        }
+
+        std::cout << "[BENCH] " << benchmark.name << '\n';
+        benchmark.run(count);
+        found = true;
+    }
+
+    if (!found) {
+        std::cerr << "Benchmark no encontrado: " << filter << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
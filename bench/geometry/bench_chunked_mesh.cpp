@@ -0,0 +1,65 @@
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+#include "bench.hpp"
+#include "geometry/chunked_mesh.hpp"
+#include "geometry/mesh_factory.hpp"
+
+void benchChunkedMesh(size_t count) {
+    if (count == 0) {
+        count = 4'000'000;
+    }
+
+    // La entrada llega por bloques de esferas pequeñas repartidas en una
+    // rejilla, como lo haría una malla de fotogrametría leída por partes
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh(64, 32);
+    const size_t sphereTriangles = sphere.indices.size() / 3;
+    const int side = std::max(1, static_cast<int>(std::cbrt(double(count) / sphereTriangles)));
+
+    const std::string path = (std::filesystem::temp_directory_path() / "bench_chunked_mesh.cmsh").string();
+    const math::AABB bounds{ glm::vec3(-0.5f), glm::vec3(side - 0.5f) };
+
+    const double buildMs = bench::bestOf(1, [&]() {
+        app::geometry::ChunkedMeshBuilder builder(path, bounds, 16, size_t(64) << 20);
+        app::geometry::Mesh part = sphere;
+
+        for (int z = 0; z < side; z++) {
+            for (int y = 0; y < side; y++) {
+                for (int x = 0; x < side; x++) {
+                    for (size_t i = 0; i < part.vertices.size(); i++) {
+                        part.vertices[i].position = sphere.vertices[i].position + glm::vec3(x, y, z);
+                    }
+                    builder.addTriangles(part);
+                }
+            }
+        }
+        builder.finish();
+    });
+
+    const double triangles = double(side) * side * side * sphereTriangles;
+    bench::report("Construcción (con volcado a disco)", buildMs, triangles, "tri");
+
+    app::geometry::ChunkedMeshFile file;
+    if (!file.open(path)) {
+        return;
+    }
+
+    std::cout
+        << "  Trozos: " << file.getChunks().size()
+        << ", " << file.getTotalBytes() / (1 << 20) << " MB\n";
+
+    std::vector<app::geometry::Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    const double readMs = bench::bestOf(3, [&]() {
+        for (size_t i = 0; i < file.getChunks().size(); i++) {
+            file.readChunk(i, vertices, indices);
+            bench::doNotOptimize(vertices);
+        }
+    });
+
+    bench::report("Lectura de todos los trozos", readMs, double(file.getTotalBytes()), "B");
+
+    std::remove(path.c_str());
+}
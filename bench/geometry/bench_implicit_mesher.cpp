@@ -0,0 +1,51 @@
+#include <cmath>
+
+#include "bench.hpp"
+#include "geometry/implicit_mesher.hpp"
+
+namespace {
+
+// Toro con ruido suave: superficie con detalle y muchos bloques vacíos
+float noisyTorus(const glm::vec3& p) {
+    const glm::vec2 q(glm::length(glm::vec2(p.x, p.z)) - 0.6f, p.y);
+    const float ripple = 0.02f * std::sin(20.0f * p.x) * std::sin(20.0f * p.y) * std::sin(20.0f * p.z);
+    return glm::length(q) - 0.25f + ripple;
+}
+
+} // namespace
+
+void benchImplicitMesher(size_t count) {
+    if (count == 0) {
+        count = 512;
+    }
+
+    const int side = static_cast<int>(count);
+    const float spacing = 2.0f / (side - 1);
+
+    app::geometry::ScalarField field;
+    const double sampleMs = bench::bestOf(1, [&]() {
+        field = app::geometry::sampleField(noisyTorus, glm::ivec3(side), glm::vec3(-1.0f), spacing);
+    });
+
+    std::cout << "  Rejilla: " << side << "^3, muestreo: " << sampleMs << " ms\n";
+
+    const double samples = static_cast<double>(field.values.size());
+
+    app::geometry::MesherSettings settings;
+
+    size_t triangles = 0;
+    bench::report("Marching cubes", bench::bestOf(3, [&]() {
+        const app::geometry::Mesh mesh = app::geometry::meshImplicitSurface(field, settings);
+        triangles = mesh.indices.size() / 3;
+        bench::doNotOptimize(mesh);
+    }), samples, "muestras");
+    std::cout << "    Triángulos: " << triangles << '\n';
+
+    settings.mode = app::geometry::MesherMode::DualContouring;
+    bench::report("Dual contouring", bench::bestOf(3, [&]() {
+        const app::geometry::Mesh mesh = app::geometry::meshImplicitSurface(field, settings);
+        triangles = mesh.indices.size() / 3;
+        bench::doNotOptimize(mesh);
+    }), samples, "muestras");
+    std::cout << "    Triángulos: " << triangles << '\n';
+}
@@ -0,0 +1,80 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "geometry/kd_tree.hpp"
+
+void benchKdTree(size_t count) {
+    if (count == 0) {
+        count = 2'000'000;
+    }
+
+    // Puntos sobre una esfera con ruido: como los vértices de una malla
+    // densa, concentrados en una superficie
+    std::mt19937 rng(39);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    std::vector<glm::vec3> points(count);
+    for (glm::vec3& point : points) {
+        point = glm::normalize(glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng)))
+            * (10.0f + 0.01f * gaussian(rng));
+    }
+
+    const size_t queryCount = 1'000'000;
+    std::vector<glm::vec3> queries(queryCount);
+    for (glm::vec3& query : queries) {
+        query = glm::normalize(glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng))) * 10.02f;
+    }
+
+    std::cout << "  " << count << " puntos, " << queryCount << " consultas\n";
+
+    app::geometry::KdTree tree;
+    bench::report("Construcción", bench::bestOf(3, [&]() {
+        tree = app::geometry::KdTree(points.data(), points.size());
+    }), double(count), "puntos");
+
+    // Fuerza bruta sobre pocas consultas: es lineal en el número de puntos
+    const size_t bruteCount = 100;
+    std::vector<uint32_t> found(queryCount);
+    bench::report("Más cercano (fuerza bruta)", bench::bestOf(3, [&]() {
+        for (size_t q = 0; q < bruteCount; q++) {
+            float best = std::numeric_limits<float>::infinity();
+            for (size_t i = 0; i < count; i++) {
+                const glm::vec3 d = points[i] - queries[q];
+                const float distance = glm::dot(d, d);
+                if (distance < best) {
+                    best = distance;
+                    found[q] = static_cast<uint32_t>(i);
+                }
+            }
+        }
+        bench::doNotOptimize(found);
+    }), double(bruteCount), "consultas");
+
+    bench::report("Más cercano (kd)", bench::bestOf(3, [&]() {
+        for (size_t q = 0; q < queryCount; q++) {
+            found[q] = tree.nearest(queries[q]);
+        }
+        bench::doNotOptimize(found);
+    }), double(queryCount), "consultas");
+
+    std::vector<app::geometry::KdNeighbor> neighbors;
+    size_t total = 0;
+    bench::report("8 más cercanos (kd)", bench::bestOf(3, [&]() {
+        for (size_t q = 0; q < queryCount; q++) {
+            tree.kNearest(queries[q], 8, neighbors);
+            total += neighbors.size();
+        }
+        bench::doNotOptimize(total);
+    }), double(queryCount), "consultas");
+
+    bench::report("Radio 0.05 (kd)", bench::bestOf(3, [&]() {
+        for (size_t q = 0; q < queryCount; q++) {
+            tree.queryRadius(queries[q], 0.05f, [&](uint32_t, float) {
+                total++;
+            });
+        }
+        bench::doNotOptimize(total);
+    }), double(queryCount), "consultas");
+}
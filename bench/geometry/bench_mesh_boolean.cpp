@@ -0,0 +1,57 @@
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "bench.hpp"
+#include "geometry/bvh.hpp"
+#include "geometry/mesh_boolean.hpp"
+#include "geometry/mesh_factory.hpp"
+
+void benchMeshBoolean(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    // Esfera UV con aproximadamente 'count' triángulos (2 * segmentos * anillos)
+    const uint32_t rings = static_cast<uint32_t>(std::sqrt(count / 4.0));
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh(2 * rings, rings);
+
+    const glm::mat4 modelA(1.0f);
+    const glm::mat4 modelB = glm::rotate(
+        glm::translate(glm::mat4(1.0f), glm::vec3(0.3f, 0.1f, 0.05f)),
+        0.5f, glm::vec3(0.3f, 1.0f, 0.2f));
+
+    std::cout << "  Entradas: 2 x " << sphere.indices.size() / 3 << " triángulos\n";
+
+    std::vector<glm::vec3> positions;
+    positions.reserve(sphere.vertices.size());
+    for (const app::geometry::Vertex& vertex : sphere.vertices) {
+        positions.push_back(vertex.position);
+    }
+
+    std::cout << "  BVH: " << bench::bestOf(3, [&]() {
+        app::geometry::Bvh bvh = app::geometry::Bvh::fromTriangles(positions, sphere.indices);
+        bench::doNotOptimize(bvh);
+    }) << " ms\n";
+
+    const struct {
+        const char* name;
+        app::geometry::BooleanOperation operation;
+    } operations[] = {
+        { "Unión", app::geometry::BooleanOperation::Union },
+        { "Diferencia", app::geometry::BooleanOperation::Difference },
+        { "Intersección", app::geometry::BooleanOperation::Intersection },
+    };
+
+    for (const auto& entry : operations) {
+        size_t triangles = 0;
+
+        bench::report(entry.name, bench::bestOf(1, [&]() {
+            const app::geometry::Mesh result =
+                app::geometry::meshBoolean(sphere, modelA, sphere, modelB, entry.operation);
+            triangles = result.indices.size() / 3;
+        }), 2.0 * sphere.indices.size() / 3, "tri");
+
+        std::cout << "    Triángulos resultantes: " << triangles << '\n';
+    }
+}
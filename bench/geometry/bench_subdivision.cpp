@@ -0,0 +1,81 @@
+#include <cmath>
+#include <vector>
+
+#include "bench.hpp"
+#include "geometry/subdivision.hpp"
+
+namespace {
+
+// Toro triangulado de segments x rings quads (2 triángulos por quad)
+app::geometry::Mesh makeTorusCage(uint32_t segments, uint32_t rings) {
+    std::vector<app::geometry::Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    const float pi = 3.14159265358979f;
+
+    for (uint32_t s = 0; s < segments; s++) {
+        const float u = 2.0f * pi * s / segments;
+
+        for (uint32_t r = 0; r < rings; r++) {
+            const float v = 2.0f * pi * r / rings;
+            const float radius = 2.0f + 0.5f * std::cos(v);
+
+            vertices.emplace_back(glm::vec3(
+                radius * std::cos(u), 0.5f * std::sin(v), radius * std::sin(u)));
+        }
+    }
+
+    for (uint32_t s = 0; s < segments; s++) {
+        for (uint32_t r = 0; r < rings; r++) {
+            const uint32_t a = s * rings + r;
+            const uint32_t b = ((s + 1) % segments) * rings + r;
+            const uint32_t c = ((s + 1) % segments) * rings + (r + 1) % rings;
+            const uint32_t d = s * rings + (r + 1) % rings;
+
+            indices.insert(indices.end(), { a, b, c, a, c, d });
+        }
+    }
+
+    return app::geometry::Mesh(vertices, indices);
+}
+
+} // namespace
+
+void benchSubdivision(size_t count) {
+    if (count == 0) {
+        count = 100'000;
+    }
+
+    // Toro con aproximadamente 'count' triángulos
+    const uint32_t side = static_cast<uint32_t>(std::sqrt(count / 2.0));
+    app::geometry::Mesh cage = makeTorusCage(side, side);
+
+    std::cout << "  Jaula: " << cage.indices.size() / 3 << " triángulos, nivel 3\n";
+
+    const int levels = 3;
+    double buildMs = bench::bestOf(1, [&]() {
+        app::geometry::SubdivisionSurface surface(cage, levels);
+        bench::doNotOptimize(surface);
+    });
+
+    const app::geometry::SubdivisionSurface surface(cage, levels);
+
+    size_t entries = 0;
+    for (const app::geometry::StencilTable& table : surface.getTables()) {
+        entries += table.indices.size();
+    }
+
+    std::cout
+        << "  Construcción de topología y stencils: " << buildMs << " ms\n"
+        << "  Vértices refinados: " << surface.getRefinedVertexCount()
+        << ", entradas de stencil: " << entries << '\n';
+
+    std::vector<app::geometry::Vertex> refined;
+    app::geometry::SubdivisionScratch scratch;
+
+    bench::report("Reevaluación tras mover vértices", bench::bestOf(5, [&]() {
+        cage.vertices[0].position.y += 0.01f;
+        surface.evaluate(cage.vertices, refined, scratch);
+        bench::doNotOptimize(refined);
+    }), static_cast<double>(refined.empty() ? surface.getRefinedVertexCount() : refined.size()), "vert");
+}
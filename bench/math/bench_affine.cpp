@@ -0,0 +1,57 @@
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "math/affine.hpp"
+
+void benchAffine(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    std::vector<Transform> transforms(count);
+    std::vector<glm::mat4> matrices(count);
+    std::vector<math::Affine3x4> affines(count);
+
+    for (size_t i = 0; i < count; i++) {
+        Transform& transform = transforms[i];
+        transform.position = glm::vec3(position(rng), position(rng), position(rng));
+        transform.rotation = glm::normalize(glm::quat(gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng)));
+        transform.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+
+        matrices[i] = transform.getModelMatrix();
+        affines[i] = math::Affine3x4::fromTransform(transform);
+    }
+
+    std::cout
+        << "  " << count << " matrices ("
+        << sizeof(glm::mat4) << " bytes la 4x4, " << sizeof(math::Affine3x4) << " la afín)\n";
+
+    std::vector<glm::mat4> inverseMatrices(count);
+    bench::report("glm::inverse (4x4)", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            inverseMatrices[i] = glm::inverse(matrices[i]);
+        }
+        bench::doNotOptimize(inverseMatrices);
+    }), double(count), "inv");
+
+    std::vector<math::Affine3x4> inverseAffines(count);
+    bench::report("Inversa afín general", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            inverseAffines[i] = math::inverse(affines[i]);
+        }
+        bench::doNotOptimize(inverseAffines);
+    }), double(count), "inv");
+
+    bench::report("Inversa desde la TRS", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            inverseAffines[i] = math::inverseTransform(transforms[i]);
+        }
+        bench::doNotOptimize(inverseAffines);
+    }), double(count), "inv");
+}
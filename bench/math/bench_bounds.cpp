@@ -0,0 +1,74 @@
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "geometry/mesh.hpp"
+#include "math/bounds.hpp"
+
+namespace {
+
+// Copia del recorrido escalar original de math::calculateBoundingBox
+math::AABB scalarBoundingBox(const app::geometry::Mesh& mesh) {
+    glm::vec3 min = mesh.vertices[0].position;
+    glm::vec3 max = mesh.vertices[0].position;
+
+    for (const app::geometry::Vertex& vertex : mesh.vertices) {
+        min = glm::min(min, vertex.position);
+        max = glm::max(max, vertex.position);
+    }
+    return math::AABB{ min, max };
+}
+
+} // namespace
+
+void benchBounds(size_t count) {
+    if (count == 0) {
+        count = 50'000'000;
+    }
+
+    std::vector<app::geometry::Vertex> vertices(count);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    for (app::geometry::Vertex& vertex : vertices) {
+        vertex.position = glm::vec3(dist(rng), dist(rng), dist(rng));
+    }
+
+    const app::geometry::Mesh mesh(vertices, {});
+    vertices.clear();
+    vertices.shrink_to_fit();
+
+    const glm::vec3* positions = &mesh.vertices[0].position;
+    const size_t stride = sizeof(app::geometry::Vertex);
+    const double items = static_cast<double>(count);
+
+    std::cout << "  " << count << " vertices (stride " << stride << " bytes)\n";
+
+    math::AABB box;
+    bench::report("AABB escalar (original)", bench::bestOf(3, [&]() {
+        box = scalarBoundingBox(mesh);
+        bench::doNotOptimize(box);
+    }), items, "vert");
+
+    bench::report("AABB SIMD + hilos", bench::bestOf(3, [&]() {
+        box = math::calculateBoundingBox(positions, count, stride);
+        bench::doNotOptimize(box);
+    }), items, "vert");
+
+    math::BoundingSphere sphere;
+    bench::report("Esfera Ritter", bench::bestOf(3, [&]() {
+        sphere = math::calculateBoundingSphereRitter(positions, count, stride);
+        bench::doNotOptimize(sphere);
+    }), items, "vert");
+
+    bench::report("Esfera EPOS-14", bench::bestOf(3, [&]() {
+        sphere = math::calculateBoundingSphereEPOS(positions, count, stride);
+        bench::doNotOptimize(sphere);
+    }), items, "vert");
+
+    math::OBB obb;
+    bench::report("OBB por PCA", bench::bestOf(3, [&]() {
+        obb = math::calculateOrientedBoundingBox(positions, count, stride);
+        bench::doNotOptimize(obb);
+    }), items, "vert");
+}
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "bench.hpp"
+#include "math/frustum.hpp"
+
+void benchFrustum(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 5.0f);
+
+    std::vector<math::AABB> boxes(count);
+    math::AABBSoA boxSoA;
+    math::BoundingSphereSoA sphereSoA;
+    math::OBBSoA obbSoA;
+    boxSoA.reserve(count);
+    sphereSoA.reserve(count);
+    obbSoA.reserve(count);
+
+    for (math::AABB& box : boxes) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        const glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        box = math::AABB{ center - half, center + half };
+
+        boxSoA.add(box);
+        sphereSoA.add(math::BoundingSphere{ center, glm::length(half) });
+
+        math::OBB obb;
+        obb.center = center;
+        obb.halfExtents = half;
+        obbSoA.add(obb);
+    }
+
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const math::Frustum frustum(projection * glm::lookAt(
+        glm::vec3(0.0f, 50.0f, -400.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    const double items = static_cast<double>(count);
+    std::cout << "  " << count << " volúmenes por llamada\n";
+
+    size_t visible = 0;
+    bench::report("AABB escalar", bench::bestOf(5, [&]() {
+        visible = 0;
+        for (const math::AABB& box : boxes) {
+            visible += frustum.classify(box) != math::Containment::Outside;
+        }
+        bench::doNotOptimize(visible);
+    }), items, "caja");
+    std::cout << "  visibles: " << visible << '\n';
+
+    math::ContainmentMasks masks;
+    bench::report("AABB por lotes", bench::bestOf(5, [&]() {
+        frustum.classify(boxSoA, masks);
+        bench::doNotOptimize(masks);
+    }), items, "caja");
+
+    // Con la caché ya caliente (frame siguiente con la misma cámara). Solo
+    // compensa si los vecinos en el array lo son también en el espacio, así
+    // que se mide también con las cajas ordenadas por celdas de una rejilla.
+    std::vector<uint8_t> planeCache(math::Frustum::planeCacheSize(count), 0);
+    frustum.classify(boxSoA, masks, planeCache.data());
+    bench::report("AABB por lotes + coherencia (orden aleatorio)", bench::bestOf(5, [&]() {
+        frustum.classify(boxSoA, masks, planeCache.data());
+        bench::doNotOptimize(masks);
+    }), items, "caja");
+
+    auto cellOf = [](const math::AABB& box) {
+        const glm::ivec3 cell = glm::ivec3((box.min + 500.0f) / 25.0f);
+        return (cell.x * 64 + cell.y) * 64 + cell.z;
+    };
+    std::sort(boxes.begin(), boxes.end(), [&](const math::AABB& a, const math::AABB& b) {
+        return cellOf(a) < cellOf(b);
+    });
+    math::AABBSoA sortedSoA(boxes);
+
+    bench::report("AABB por lotes (ordenadas)", bench::bestOf(5, [&]() {
+        frustum.classify(sortedSoA, masks);
+        bench::doNotOptimize(masks);
+    }), items, "caja");
+
+    std::fill(planeCache.begin(), planeCache.end(), 0);
+    frustum.classify(sortedSoA, masks, planeCache.data());
+    bench::report("AABB por lotes + coherencia (ordenadas)", bench::bestOf(5, [&]() {
+        frustum.classify(sortedSoA, masks, planeCache.data());
+        bench::doNotOptimize(masks);
+    }), items, "caja");
+
+    bench::report("Esferas por lotes", bench::bestOf(5, [&]() {
+        frustum.classify(sphereSoA, masks);
+        bench::doNotOptimize(masks);
+    }), items, "esfera");
+
+    bench::report("OBB por lotes", bench::bestOf(5, [&]() {
+        frustum.classify(obbSoA, masks);
+        bench::doNotOptimize(masks);
+    }), items, "obb");
+}
@@ -0,0 +1,89 @@
+#include <limits>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "bench.hpp"
+#include "math/intersection.hpp"
+
+namespace {
+
+// Ciclos del contador de tiempo del procesador (0 si no hay)
+inline unsigned long long cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+void benchIntersection(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+
+    std::vector<math::AABB> boxes(count);
+    for (math::AABB& box : boxes) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        const glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        box = math::AABB{ center - half, center + half };
+    }
+
+    const math::AABBSoA soa(boxes);
+
+    constexpr int rayCount = 32;
+    std::vector<math::Ray> rays(rayCount);
+    for (math::Ray& ray : rays) {
+        ray.origin = glm::vec3(position(rng), position(rng), position(rng));
+        ray.direction = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)));
+    }
+
+    const double items = static_cast<double>(count) * rayCount;
+
+    std::cout << "  " << count << " cajas x " << rayCount << " rayos\n";
+
+    // Bucle original: un intersect() escalar por caja
+    bench::report("Escalar (una caja por llamada)", bench::bestOf(3, [&]() {
+        for (const math::Ray& ray : rays) {
+            float nearest = std::numeric_limits<float>::infinity();
+            for (const math::AABB& box : boxes) {
+                float distance;
+                if (math::intersect(ray, box, distance) && distance < nearest) {
+                    nearest = distance;
+                }
+            }
+            bench::doNotOptimize(nearest);
+        }
+    }), items, "caja");
+
+    std::vector<uint64_t> mask(soa.maskWords());
+    unsigned long long bestCycles = 0;
+
+    const double ms = bench::bestOf(3, [&]() {
+        const unsigned long long start = cycles();
+        for (const math::Ray& ray : rays) {
+            float distance = 0.0f;
+            const size_t nearest = math::intersect(math::makeRayInverse(ray), soa, distance, mask.data());
+            bench::doNotOptimize(nearest);
+        }
+        const unsigned long long elapsed = cycles() - start;
+        if (bestCycles == 0 || elapsed < bestCycles) {
+            bestCycles = elapsed;
+        }
+    });
+
+    bench::report("SoA SIMD (máscara + más cercana)", ms, items, "caja");
+
+    if (bestCycles > 0) {
+        std::cout << "  SoA SIMD: " << items / static_cast<double>(bestCycles) << " cajas/ciclo (TSC)\n";
+    }
+}
@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "bench.hpp"
+#include "geometry/bvh.hpp"
+#include "math/ray_packet.hpp"
+
+namespace {
+
+constexpr int viewportWidth = 1280;
+constexpr int viewportHeight = 720;
+
+struct Scene {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+};
+
+// Terreno ondulado de ~'triangles' triángulos en [-50, 50]²
+Scene makeTerrain(size_t triangles) {
+    const int side = std::max(2, static_cast<int>(std::sqrt(triangles / 2.0)) + 1);
+
+    Scene scene;
+    scene.positions.reserve(size_t(side) * side);
+    for (int z = 0; z < side; z++) {
+        for (int x = 0; x < side; x++) {
+            const float px = -50.0f + 100.0f * x / (side - 1);
+            const float pz = -50.0f + 100.0f * z / (side - 1);
+            scene.positions.emplace_back(px, 2.0f * std::sin(px * 0.3f) * std::cos(pz * 0.2f), pz);
+        }
+    }
+
+    scene.indices.reserve(size_t(side - 1) * (side - 1) * 6);
+    for (int z = 0; z + 1 < side; z++) {
+        for (int x = 0; x + 1 < side; x++) {
+            const uint32_t a = z * side + x;
+            const uint32_t b = a + 1;
+            const uint32_t c = a + side;
+            const uint32_t d = c + 1;
+            scene.indices.insert(scene.indices.end(), { a, c, b, b, c, d });
+        }
+    }
+    return scene;
+}
+
+math::Ray primaryRay(int x, int y) {
+    const glm::vec3 eye(0.0f, 30.0f, -70.0f);
+    const glm::vec3 forward = glm::normalize(glm::vec3(0.0f, -25.0f, 60.0f));
+    const glm::vec3 right = glm::normalize(glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), forward));
+    const glm::vec3 up = glm::cross(forward, right);
+
+    const float aspect = float(viewportWidth) / viewportHeight;
+    const float u = ((x + 0.5f) / viewportWidth * 2.0f - 1.0f) * aspect * 0.6f;
+    const float v = (1.0f - (y + 0.5f) / viewportHeight * 2.0f) * 0.6f;
+
+    return math::Ray{ eye, glm::normalize(forward + u * right + v * up) };
+}
+
+// Recorrido de un solo rayo con el impacto más cercano (referencia)
+bool castSingle(const Scene& scene, const app::geometry::Bvh& bvh, const math::Ray& ray, float& tHit) {
+    const math::RayInverse inverse = math::makeRayInverse(ray);
+    const std::vector<app::geometry::BvhNode>& nodes = bvh.getNodes();
+    const std::vector<uint32_t>& primitives = bvh.getPrimitives();
+
+    tHit = std::numeric_limits<float>::max();
+    bool found = false;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const app::geometry::BvhNode& node = nodes[index];
+
+        const glm::vec3 t1 = (node.bounds.min - inverse.origin) * inverse.invDirection;
+        const glm::vec3 t2 = (node.bounds.max - inverse.origin) * inverse.invDirection;
+        const glm::vec3 tLow = glm::min(t1, t2);
+        const glm::vec3 tHigh = glm::max(t1, t2);
+        const float enter = std::max(std::max(tLow.x, tLow.y), std::max(tLow.z, 0.0f));
+        const float exit = std::min(std::min(tHigh.x, tHigh.y), std::min(tHigh.z, tHit));
+        if (enter > exit) {
+            continue;
+        }
+
+        if (!node.isLeaf()) {
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            const uint32_t triangle = primitives[i];
+            const glm::vec3& v0 = scene.positions[scene.indices[3 * triangle]];
+            const glm::vec3 e1 = scene.positions[scene.indices[3 * triangle + 1]] - v0;
+            const glm::vec3 e2 = scene.positions[scene.indices[3 * triangle + 2]] - v0;
+
+            const glm::vec3 p = glm::cross(ray.direction, e2);
+            const float det = glm::dot(e1, p);
+            if (det == 0.0f) {
+                continue;
+            }
+            const float invDet = 1.0f / det;
+            const glm::vec3 s = ray.origin - v0;
+            const float u = glm::dot(s, p) * invDet;
+            const glm::vec3 q = glm::cross(s, e1);
+            const float v = glm::dot(ray.direction, q) * invDet;
+            const float t = glm::dot(e2, q) * invDet;
+
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < tHit) {
+                tHit = t;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+// Paquetes de 4 (2x2 píxeles) u 8 (4x2 píxeles)
+template <int N>
+size_t castPackets(const Scene& scene, const app::geometry::Bvh& bvh) {
+    constexpr int tileWidth = N == 8 ? 4 : 2;
+    constexpr int tileHeight = 2;
+
+    size_t hits = 0;
+
+    for (int y = 0; y < viewportHeight; y += tileHeight) {
+        for (int x = 0; x < viewportWidth; x += tileWidth) {
+            math::RayPacket<N> packet;
+            math::RayPacketHit<N> hit;
+
+            for (int lane = 0; lane < N; lane++) {
+                const int px = x + lane % tileWidth;
+                const int py = y + lane / tileWidth;
+                if (px < viewportWidth && py < viewportHeight) {
+                    packet.setRay(lane, primaryRay(px, py));
+                }
+            }
+
+            bvh.queryPacket(packet, [&](uint32_t triangle, int lanes) {
+                math::intersect(packet,
+                    scene.positions[scene.indices[3 * triangle]],
+                    scene.positions[scene.indices[3 * triangle + 1]],
+                    scene.positions[scene.indices[3 * triangle + 2]],
+                    triangle, hit, lanes);
+            });
+
+            for (int lane = 0; lane < N; lane++) {
+                hits += hit.primitive[lane] != math::RayPacketHit<N>::kNoHit;
+            }
+        }
+    }
+    return hits;
+}
+
+} // namespace
+
+void benchRayPacket(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    const Scene scene = makeTerrain(count);
+    const app::geometry::Bvh bvh = app::geometry::Bvh::fromTriangles(scene.positions, scene.indices);
+
+    const double rays = double(viewportWidth) * viewportHeight;
+
+    std::cout
+        << "  " << scene.indices.size() / 3 << " triángulos, "
+        << viewportWidth << "x" << viewportHeight << " rayos\n";
+
+    size_t hits = 0;
+    bench::report("Rayo a rayo", bench::bestOf(3, [&]() {
+        hits = 0;
+        for (int y = 0; y < viewportHeight; y++) {
+            for (int x = 0; x < viewportWidth; x++) {
+                float t;
+                hits += castSingle(scene, bvh, primaryRay(x, y), t);
+            }
+        }
+        bench::doNotOptimize(hits);
+    }), rays, "rayo");
+    std::cout << "  impactos: " << hits << '\n';
+
+    bench::report("Paquetes de 4", bench::bestOf(3, [&]() {
+        hits = castPackets<4>(scene, bvh);
+        bench::doNotOptimize(hits);
+    }), rays, "rayo");
+    std::cout << "  impactos: " << hits << '\n';
+
+    bench::report("Paquetes de 8", bench::bestOf(3, [&]() {
+        hits = castPackets<8>(scene, bvh);
+        bench::doNotOptimize(hits);
+    }), rays, "rayo");
+    std::cout << "  impactos: " << hits << '\n';
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "bench.hpp"
+#include "core/radix_sort.hpp"
+#include "geometry/bvh.hpp"
+#include "math/frustum.hpp"
+#include "math/intersection.hpp"
+#include "math/space_filling.hpp"
+
+namespace {
+
+// Lo que se lee de cada objeto al recorrer la escena, con relleno hasta un
+// tamaño parecido al de Object (malla, transformación, volúmenes...)
+struct ObjectRecord {
+    math::AABB box;
+    glm::vec3 center;
+    uint32_t id;
+    uint8_t lastPlane;
+    char payload[215];
+};
+
+// Recorridos típicos de la escena sobre los mismos objetos en el orden dado
+void measureScene(const char* label, std::vector<ObjectRecord>& objects, const math::Frustum& frustum, const std::vector<math::Ray>& rays) {
+    const double count = double(objects.size());
+    std::cout << "  -- " << label << '\n';
+
+    std::vector<math::AABB> boxes(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        boxes[i] = objects[i].box;
+    }
+
+    app::geometry::Bvh bvh;
+    bench::report("Construcción del BVH", bench::bestOf(3, [&]() {
+        bvh = app::geometry::Bvh(boxes);
+    }), count, "objetos");
+
+    // Culling como en el renderer: se recorre la escena y de los visibles
+    // se lee el resto del objeto
+    size_t visible = 0;
+    bench::report("Culling", bench::bestOf(5, [&]() {
+        visible = 0;
+        for (ObjectRecord& object : objects) {
+            if (frustum.classify(object.box, &object.lastPlane) != math::Containment::Outside) {
+                visible += object.payload[object.id & 127];
+            }
+        }
+        bench::doNotOptimize(visible);
+    }), count, "objetos");
+
+    math::AABBSoA soa(boxes);
+    math::ContainmentMasks masks;
+    std::vector<uint8_t> planeCache(math::Frustum::planeCacheSize(boxes.size()), 0);
+    frustum.classify(soa, masks, planeCache.data());
+    bench::report("Culling por lotes + coherencia", bench::bestOf(5, [&]() {
+        frustum.classify(soa, masks, planeCache.data());
+        bench::doNotOptimize(masks);
+    }), count, "objetos");
+
+    // Picking con el BVH: los candidatos de cada hoja se leen del array de
+    // objetos
+    uint32_t picked = 0;
+    bench::report("Picking (BVH)", bench::bestOf(5, [&]() {
+        for (const math::Ray& ray : rays) {
+            float closest = std::numeric_limits<float>::max();
+            bvh.querySegment(ray.origin, ray.origin + 2000.0f * ray.direction, [&](uint32_t primitive) {
+                const ObjectRecord& object = objects[primitive];
+                float distance;
+                if (math::intersect(ray, object.box, distance) && distance < closest) {
+                    closest = distance;
+                    picked = object.id;
+                }
+            });
+        }
+        bench::doNotOptimize(picked);
+    }), double(rays.size()), "rayos");
+}
+
+} // namespace
+
+void benchSpaceFilling(size_t count) {
+    if (count == 0) {
+        count = 200'000;
+    }
+
+    std::mt19937 rng(40);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 3.0f);
+
+    std::vector<ObjectRecord> objects(count);
+    std::vector<glm::vec3> centers(count);
+    for (size_t i = 0; i < count; i++) {
+        ObjectRecord& object = objects[i];
+        object.center = glm::vec3(position(rng), 0.1f * position(rng), position(rng));
+        const glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        object.box = math::AABB{ object.center - half, object.center + half };
+        object.id = static_cast<uint32_t>(i + 1);
+        object.lastPlane = 0;
+        std::fill(std::begin(object.payload), std::end(object.payload), char(1));
+        centers[i] = object.center;
+    }
+
+    const math::AABB bounds = math::calculateBoundingBox(centers.data(), count);
+
+    std::cout << "  " << count << " objetos de " << sizeof(ObjectRecord) << " bytes\n";
+
+    // Códigos y ordenación
+    std::vector<uint64_t> codes(count);
+    bench::report("Morton 63 bits", bench::bestOf(5, [&]() {
+        math::computeCurveCodes(centers.data(), count, bounds, math::SpaceFillingCurve::Morton, codes.data());
+        bench::doNotOptimize(codes);
+    }), double(count), "códigos");
+
+    bench::report("Hilbert 63 bits", bench::bestOf(5, [&]() {
+        math::computeCurveCodes(centers.data(), count, bounds, math::SpaceFillingCurve::Hilbert, codes.data());
+        bench::doNotOptimize(codes);
+    }), double(count), "códigos");
+
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> order(count);
+    bench::report("std::sort (pares)", bench::bestOf(3, [&]() {
+        std::vector<std::pair<uint64_t, uint32_t>> pairs(count);
+        for (size_t i = 0; i < count; i++) {
+            pairs[i] = { codes[i], uint32_t(i) };
+        }
+        std::sort(pairs.begin(), pairs.end());
+        bench::doNotOptimize(pairs);
+    }), double(count), "claves");
+
+    bench::report("radixSort", bench::bestOf(3, [&]() {
+        keys = codes;
+        std::iota(order.begin(), order.end(), 0u);
+        core::radixSort(keys, order);
+        bench::doNotOptimize(order);
+    }), double(count), "claves");
+
+    // Efecto del orden en memoria sobre los recorridos de la escena
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    const math::Frustum frustum(projection * glm::lookAt(
+        glm::vec3(0.0f, 30.0f, -400.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    std::vector<math::Ray> rays(10'000);
+    std::uniform_real_distribution<float> jitter(-0.3f, 0.3f);
+    for (math::Ray& ray : rays) {
+        ray.origin = glm::vec3(0.0f, 30.0f, -400.0f);
+        ray.direction = glm::normalize(glm::vec3(jitter(rng), -0.05f, 1.0f));
+    }
+
+    std::shuffle(objects.begin(), objects.end(), rng);
+    measureScene("Orden aleatorio (creación)", objects, frustum, rays);
+
+    for (size_t i = 0; i < count; i++) {
+        centers[i] = objects[i].center;
+    }
+    math::computeCurveCodes(centers.data(), count, bounds, math::SpaceFillingCurve::Morton, codes.data());
+    keys = codes;
+    std::iota(order.begin(), order.end(), 0u);
+    core::radixSort(keys, order);
+
+    std::vector<ObjectRecord> sorted(count);
+    for (size_t i = 0; i < count; i++) {
+        sorted[i] = objects[order[i]];
+    }
+    measureScene("Orden de Morton", sorted, frustum, rays);
+
+    math::computeCurveCodes(centers.data(), count, bounds, math::SpaceFillingCurve::Hilbert, codes.data());
+    keys = codes;
+    std::iota(order.begin(), order.end(), 0u);
+    core::radixSort(keys, order);
+    for (size_t i = 0; i < count; i++) {
+        sorted[i] = objects[order[i]];
+    }
+    measureScene("Orden de Hilbert", sorted, frustum, rays);
+}
@@ -0,0 +1,81 @@
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "math/transform_batch.hpp"
+
+namespace {
+
+// La composición original: tres productos de matrices 4x4
+glm::mat4 composeWithProducts(const Transform& transform) {
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(transform.position));
+    model *= glm::mat4_cast(transform.rotation);
+    return glm::scale(model, transform.scale);
+}
+
+} // namespace
+
+void benchTransform(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    std::vector<Transform> transforms(count);
+    math::TransformSoA soa;
+    soa.reserve(count);
+
+    for (Transform& transform : transforms) {
+        transform.position = glm::vec3(position(rng), position(rng), position(rng));
+        transform.rotation = glm::normalize(glm::quat(gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng)));
+        transform.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+        soa.add(transform);
+    }
+
+    std::vector<glm::mat4> matrices(count);
+    std::vector<math::Affine3x4> affines(count);
+
+    std::cout << "  " << count << " transformaciones\n";
+
+    bench::report("Componer con productos de matrices", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            matrices[i] = composeWithProducts(transforms[i]);
+        }
+        bench::doNotOptimize(matrices);
+    }), double(count), "transf");
+
+    bench::report("Componer (getModelMatrix)", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            matrices[i] = transforms[i].getModelMatrix();
+        }
+        bench::doNotOptimize(matrices);
+    }), double(count), "transf");
+
+    bench::report("Componer por lotes (4x4)", bench::bestOf(5, [&]() {
+        math::composeModelMatrices(soa, matrices.data());
+        bench::doNotOptimize(matrices);
+    }), double(count), "transf");
+
+    bench::report("Componer por lotes (3x4)", bench::bestOf(5, [&]() {
+        math::composeModelMatrices(soa, affines.data());
+        bench::doNotOptimize(affines);
+    }), double(count), "transf");
+
+    std::vector<Transform> decomposed(count);
+    bench::report("Descomponer (setFromModelMatrix)", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            decomposed[i].setFromModelMatrix(matrices[i]);
+        }
+        bench::doNotOptimize(decomposed);
+    }), double(count), "transf");
+
+    math::TransformSoA decomposedSoA;
+    bench::report("Descomponer por lotes", bench::bestOf(5, [&]() {
+        math::decomposeModelMatrices(matrices.data(), count, decomposedSoA);
+        bench::doNotOptimize(decomposedSoA);
+    }), double(count), "transf");
+}
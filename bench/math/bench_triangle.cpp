@@ -0,0 +1,89 @@
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "math/intersection.hpp"
+
+namespace {
+
+template <math::TriangleTest Test>
+size_t scalarClosest(const math::Ray& ray, const math::TriangleSoA& triangles) {
+    math::TriangleHit hit;
+    float tMax = std::numeric_limits<float>::max();
+    size_t found = math::TriangleSoA::npos;
+
+    for (size_t i = 0; i < triangles.size(); i++) {
+        if (math::intersectTriangle<Test>(ray,
+            triangles.getVertex(i, 0), triangles.getVertex(i, 1), triangles.getVertex(i, 2), hit, tMax)) {
+            tMax = hit.t;
+            found = i;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+void benchTriangle(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+    math::TriangleSoA triangles;
+    triangles.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        triangles.add(
+            center + glm::vec3(offset(rng), offset(rng), offset(rng)),
+            center + glm::vec3(offset(rng), offset(rng), offset(rng)),
+            center + glm::vec3(offset(rng), offset(rng), offset(rng)));
+    }
+
+    constexpr int rayCount = 16;
+    std::vector<math::Ray> rays(rayCount);
+    for (math::Ray& ray : rays) {
+        ray.origin = glm::vec3(position(rng), position(rng), position(rng));
+        ray.direction = glm::normalize(glm::vec3(position(rng), position(rng), position(rng)));
+    }
+
+    const double items = static_cast<double>(count) * rayCount;
+
+    std::cout << "  " << count << " triángulos x " << rayCount << " rayos (impacto más cercano)\n";
+
+    using math::HitMode;
+    using math::TriangleTest;
+
+    auto run = [&](const char* name, auto&& cast) {
+        bench::report(name, bench::bestOf(3, [&]() {
+            for (const math::Ray& ray : rays) {
+                const size_t found = cast(ray);
+                bench::doNotOptimize(found);
+            }
+        }), items, "tri");
+    };
+
+    math::TriangleHit hit;
+
+    run("Möller–Trumbore escalar", [&](const math::Ray& ray) {
+        return scalarClosest<TriangleTest::MollerTrumbore>(ray, triangles);
+    });
+    run("Möller–Trumbore x4", [&](const math::Ray& ray) {
+        return math::intersect<TriangleTest::MollerTrumbore, HitMode::Closest, 4>(ray, triangles, hit);
+    });
+    run("Möller–Trumbore x8", [&](const math::Ray& ray) {
+        return math::intersect<TriangleTest::MollerTrumbore, HitMode::Closest, 8>(ray, triangles, hit);
+    });
+    run("Estanco escalar", [&](const math::Ray& ray) {
+        return scalarClosest<TriangleTest::Watertight>(ray, triangles);
+    });
+    run("Estanco x4", [&](const math::Ray& ray) {
+        return math::intersect<TriangleTest::Watertight, HitMode::Closest, 4>(ray, triangles, hit);
+    });
+    run("Estanco x8", [&](const math::Ray& ray) {
+        return math::intersect<TriangleTest::Watertight, HitMode::Closest, 8>(ray, triangles, hit);
+    });
+}
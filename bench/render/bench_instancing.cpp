@@ -0,0 +1,109 @@
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "bench.hpp"
+#include "math/affine.hpp"
+#include "math/frustum.hpp"
+#include "render/instance_data.hpp"
+#include "render/render_queue.hpp"
+
+namespace {
+
+// La parte de CPU de Renderer::render para los objetos: cajas de mundo,
+// culling, cola de dibujo (encolar los visibles con su profundidad y
+// ordenar) y las instancias en el orden de la cola. Sin contexto de OpenGL
+// no se puede medir la GPU; las instancias van a un vector en vez de al
+// buffer de streaming, y lo que cambia allí es el número de llamadas
+void measureQueue(const char* label, const std::vector<math::Affine3x4>& models, const std::vector<uint32_t>& meshes, const math::Frustum& frustum) {
+    const size_t count = models.size();
+    const math::AABB unitBox{ glm::vec3(-0.5f), glm::vec3(0.5f) };
+
+    // La cámara está en el origen mirando a -z
+    const glm::vec3 forward(0.0f, 0.0f, -1.0f);
+
+    math::AABBSoA boxes;
+    math::ContainmentMasks visibility;
+    std::vector<uint8_t> planeCache(math::Frustum::planeCacheSize(count), 0);
+    render::RenderQueue queue;
+    std::vector<render::InstanceData> instances;
+
+    std::cout << "  -- " << label << '\n';
+
+    bench::report("Culling + cola + instancias", bench::bestOf(5, [&]() {
+        boxes.clear();
+        boxes.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            boxes.add(math::transformBoundingBox(unitBox, models[i]));
+        }
+        frustum.classify(boxes, visibility, planeCache.data());
+
+        const float* minX = boxes.minX();
+        const float* minY = boxes.minY();
+        const float* minZ = boxes.minZ();
+        const float* maxX = boxes.maxX();
+        const float* maxY = boxes.maxY();
+        const float* maxZ = boxes.maxZ();
+
+        queue.clear();
+        queue.fill(count, [&](size_t i, render::RenderQueue::Writer& writer) {
+            if ((visibility.outside[i >> 6] >> (i & 63)) & 1) {
+                return;
+            }
+
+            const glm::vec3 center(minX[i] + maxX[i], minY[i] + maxY[i], minZ[i] + maxZ[i]);
+            const float depth = 0.5f * glm::dot(forward, center);
+            const uint64_t key = render::draw_key::encode(render::RenderPass::Opaque, false, 0, 0, meshes[i], depth);
+            writer.push(key, static_cast<uint32_t>(i), meshes[i]);
+        });
+        queue.sort();
+
+        const std::vector<render::QueuedDraw>& queued = queue.getDraws();
+        instances.resize(queued.size());
+        for (size_t i = 0; i < queued.size(); i++) {
+            instances[i] = { models[queued[i].object], queued[i].flags };
+        }
+        bench::doNotOptimize(instances);
+    }), double(count), "objetos");
+
+    std::cout
+        << "  Llamadas de dibujo: " << queue.size() << " -> " << queue.getBatches().size()
+        << " (" << instances.size() * sizeof(render::InstanceData) / 1024 << " KB de instancias)\n";
+}
+
+} // namespace
+
+void benchInstancing(size_t count) {
+    if (count == 0) {
+        count = 100'000;
+    }
+
+    std::mt19937 rng(41);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.28f);
+
+    // Relativas a la cámara, que está en el origen mirando a -z
+    std::vector<math::Affine3x4> models(count);
+    for (math::Affine3x4& model : models) {
+        Transform transform;
+        transform.position = glm::dvec3(position(rng), 0.1f * position(rng), position(rng));
+        transform.rotation = glm::angleAxis(angle(rng), glm::vec3(0.0f, 1.0f, 0.0f));
+        model = math::Affine3x4::fromTransform(transform);
+    }
+
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 2000.0f);
+    const math::Frustum frustum(projection);
+
+    std::cout << "  " << count << " instancias\n";
+
+    // Todo cubos: el caso de la escena de ejemplo
+    std::vector<uint32_t> meshes(count, 0);
+    measureQueue("Una malla", models, meshes, frustum);
+
+    // Varias mallas mezcladas (identificadores de GLMesh::getId)
+    for (uint32_t& mesh : meshes) {
+        mesh = rng() % 16;
+    }
+    measureQueue("16 mallas", models, meshes, frustum);
+}
@@ -0,0 +1,48 @@
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "render/render_queue.hpp"
+
+void benchRenderQueue(size_t count) {
+    if (count == 0) {
+        count = 200'000;
+    }
+
+    // Lo que Renderer::render tiene a mano por objeto: malla, profundidad
+    // y si está seleccionado
+    std::mt19937 rng(46);
+    std::uniform_real_distribution<float> depth(0.1f, 2000.0f);
+
+    std::vector<uint32_t> meshes(count);
+    std::vector<float> depths(count);
+    for (size_t i = 0; i < count; i++) {
+        meshes[i] = rng() % 16;
+        depths[i] = depth(rng);
+    }
+
+    render::RenderQueue queue;
+
+    std::cout << "  " << count << " dibujos, 16 mallas\n";
+
+    bench::report("Encolar", bench::bestOf(5, [&]() {
+        queue.clear();
+        queue.fill(count, [&](size_t i, render::RenderQueue::Writer& writer) {
+            const uint64_t key = render::draw_key::encode(render::RenderPass::Opaque, false, 0, 0, meshes[i], depths[i]);
+            writer.push(key, static_cast<uint32_t>(i), meshes[i]);
+        });
+        bench::doNotOptimize(queue.getKeys());
+    }), double(count), "dibujos");
+
+    bench::report("Encolar + ordenar", bench::bestOf(5, [&]() {
+        queue.clear();
+        queue.fill(count, [&](size_t i, render::RenderQueue::Writer& writer) {
+            const uint64_t key = render::draw_key::encode(render::RenderPass::Opaque, false, 0, 0, meshes[i], depths[i]);
+            writer.push(key, static_cast<uint32_t>(i), meshes[i]);
+        });
+        queue.sort();
+        bench::doNotOptimize(queue.getBatches());
+    }), double(count), "dibujos");
+
+    std::cout << "  Lotes: " << queue.getBatches().size() << '\n';
+}
@@ -0,0 +1,79 @@
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+#include "render/uniform_table.hpp"
+
+namespace {
+
+// En lugar de glUniform*: copiar el valor a su location, que es lo que
+// hace el driver en el caso más barato. Lo que se mide es lo de delante
+struct FakeProgram {
+    std::vector<glm::mat4> storage = std::vector<glm::mat4>(16);
+
+    void upload(GLint location, const glm::mat4& value) {
+        if (location >= 0) {
+            storage[location] = value;
+        }
+    }
+};
+
+const char* const names[] = { "view", "projection", "model", "normalMatrix" };
+
+} // namespace
+
+void benchUniforms(size_t count) {
+    if (count == 0) {
+        count = 1'000'000;
+    }
+
+    std::cout << "  " << count << " uniformes mat4\n";
+
+    FakeProgram program;
+    glm::mat4 value(1.0f);
+
+    // Antes: unordered_map<std::string, GLint> y un std::string por llamada
+    std::unordered_map<std::string, GLint> locations;
+    render::UniformTable table;
+    for (GLint i = 0; i < 4; i++) {
+        locations[names[i]] = i;
+        table.add({ names[i], GL_FLOAT_MAT4, i, 1 });
+    }
+
+    bench::report("Por nombre (unordered_map)", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            value[3][0] = float(i);
+            auto it = locations.find(names[i & 3]);
+            program.upload(it != locations.end() ? it->second : -1, value);
+        }
+        bench::doNotOptimize(program.storage);
+    }), double(count), "sets");
+
+    bench::report("Por nombre (UniformTable)", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            value[3][0] = float(i);
+            const render::UniformInfo* uniform = table.find(names[i & 3]);
+            program.upload(uniform != nullptr ? uniform->location : -1, value);
+        }
+        bench::doNotOptimize(program.storage);
+    }), double(count), "sets");
+
+    // Ahora: los handles se resuelven una vez fuera del bucle
+    render::UniformHandle<glm::mat4> handles[4];
+    for (int i = 0; i < 4; i++) {
+        handles[i] = table.getHandle<glm::mat4>(names[i]);
+    }
+
+    bench::report("UniformHandle", bench::bestOf(5, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            value[3][0] = float(i);
+            const render::UniformHandle<glm::mat4>& handle = handles[i & 3];
+            if (handle.valid()) {
+                program.upload(handle.getLocation(), value);
+            }
+        }
+        bench::doNotOptimize(program.storage);
+    }), double(count), "sets");
+}
@@ -1,15 +1,10 @@
 #version 410 core
-in vec3 ourColor;
+#include "uniform_blocks.glsl"
 
-uniform bool useOverrideColor;
-uniform vec3 overrideColor;
+in vec3 ourColor;
 
 out vec4 FragColor;
 void main()
 {
-    vec3 color = useOverrideColor
-        ? overrideColor
-        : ourColor;
-
-    FragColor = vec4(color, 1.0);
-}
\ No newline at end of file
+    FragColor = vec4(ourColor, 1.0);
+}
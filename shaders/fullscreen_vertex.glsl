@@ -0,0 +1,9 @@
+#version 410 core
+
+// Un triángulo que cubre toda la pantalla, sin atributos: los vértices
+// (-1,-1), (3,-1) y (-1,3) salen de gl_VertexID
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
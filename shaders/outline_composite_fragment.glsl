@@ -0,0 +1,30 @@
+#version 410 core
+#include "uniform_blocks.glsl"
+
+// Contorno de selectionWidth píxeles alrededor de la máscara, mezclado
+// sobre la escena (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)
+uniform usampler2D seeds;
+
+out vec4 FragColor;
+
+const uint kNoSeed = 0xffffu;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    uvec2 seed = texelFetch(seeds, pixel, 0).xy;
+
+    // Lejos de todo o dentro de la máscara (su propia semilla)
+    if (seed.x == kNoSeed || all(equal(ivec2(seed), pixel))) {
+        discard;
+    }
+
+    // Un píxel de transición para el antialiasing
+    float seedDistance = length(vec2(seed) - vec2(pixel));
+    float coverage = 1.0 - smoothstep(selectionWidth - 0.5, selectionWidth + 0.5, seedDistance);
+    if (coverage <= 0.0) {
+        discard;
+    }
+
+    FragColor = vec4(selectionColor.rgb, selectionColor.a * coverage);
+}
@@ -0,0 +1,42 @@
+#version 410 core
+
+// Una pasada del jump flooding: la semilla más cercana de las que ven este
+// píxel y sus 8 vecinos a 'jumpStep' píxeles
+uniform usampler2D seeds;
+uniform int jumpStep;
+
+out uvec2 nearestSeed;
+
+const uint kNoSeed = 0xffffu;
+
+void main()
+{
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(seeds, 0);
+
+    uvec2 best = uvec2(kNoSeed);
+    float bestDistance = 1e30;
+
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 neighbour = pixel + ivec2(x, y) * jumpStep;
+            if (any(lessThan(neighbour, ivec2(0))) || any(greaterThanEqual(neighbour, size))) {
+                continue;
+            }
+
+            uvec2 seed = texelFetch(seeds, neighbour, 0).xy;
+            if (seed.x == kNoSeed) {
+                continue;
+            }
+
+            vec2 offset = vec2(seed) - vec2(pixel);
+            float squaredDistance = dot(offset, offset);
+            if (squaredDistance < bestDistance) {
+                bestDistance = squaredDistance;
+                best = seed;
+            }
+        }
+    }
+
+    nearestSeed = best;
+}
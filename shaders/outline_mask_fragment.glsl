@@ -0,0 +1,9 @@
+#version 410 core
+
+// Cada píxel de un seleccionado es su propia semilla
+out uvec2 seed;
+
+void main()
+{
+    seed = uvec2(gl_FragCoord.xy);
+}
@@ -0,0 +1,22 @@
+// Bloques uniformes compartidos por todos los programas (std140). Deben
+// coincidir con FrameUniforms y DrawUniforms de src/render/uniform_blocks.hpp:
+// Shader compara los offsets al enlazar.
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 viewportSize;      // ancho, alto, 1/ancho, 1/alto
+    vec4 wireframeColor;
+    vec4 selectionColor;
+    float time;
+    float wireframeWidth;   // en píxeles
+    float selectionWidth;
+    bool wireframe;         // wireframe sobre toda la escena
+};
+
+// row_major: el mat4x3 son las tres filas de Affine3x4
+layout (std140, row_major) uniform DrawData {
+    mat4x3 model;           // matriz afín: la cuarta fila es 0 0 0 1
+    bool useInstancing;
+};
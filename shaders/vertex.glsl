@@ -1,16 +1,31 @@
 #version 410 core
+#include "uniform_blocks.glsl"
+
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aColor;
 
-uniform float g_uOffset;
-uniform mat4 model;
-uniform mat4 perspective;
-uniform mat4 view;
+// Por instancia (glVertexAttribDivisor 1): las filas de la matriz afín y
+// los flags de InstanceData. Las filas solo se leen con useInstancing; los
+// flags viajan con la instancia pero ahora mismo ningún programa los usa
+layout (location = 2) in vec4 aModelRow0;
+layout (location = 3) in vec4 aModelRow1;
+layout (location = 4) in vec4 aModelRow2;
+layout (location = 5) in uint aInstanceFlags;
 
 out vec3 ourColor;
-    
+
 void main()
 {
+    vec3 worldPos;
+
+    if (useInstancing) {
+        vec4 position = vec4(aPos, 1.0);
+        worldPos = vec3(dot(aModelRow0, position), dot(aModelRow1, position), dot(aModelRow2, position));
+    } else {
+        worldPos = model * vec4(aPos, 1.0);
+    }
+
     ourColor = aColor;
-    gl_Position =  perspective * view *  model * vec4(aPos, 1.0);
-}
\ No newline at end of file
+
+    gl_Position = viewProjection * vec4(worldPos, 1.0);
+}
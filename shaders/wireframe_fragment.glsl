@@ -0,0 +1,26 @@
+#version 410 core
+#include "uniform_blocks.glsl"
+
+in vec3 shadedColor;
+noperspective in vec3 edgeDistance;
+flat in uint triangleWireMode;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 color = shadedColor;
+
+    if (triangleWireMode != 0u) {
+        // Cada triángulo pinta media línea a su lado de la arista compartida
+        float halfWidth = 0.5 * wireframeWidth;
+
+        // Un píxel de transición para el antialiasing
+        float distance = min(edgeDistance.x, min(edgeDistance.y, edgeDistance.z));
+        float coverage = 1.0 - smoothstep(halfWidth - 0.5, halfWidth + 0.5, distance);
+
+        color = mix(color, wireframeColor.rgb, coverage * wireframeColor.a);
+    }
+
+    FragColor = vec4(color, 1.0);
+}
@@ -0,0 +1,58 @@
+#version 410 core
+#include "uniform_blocks.glsl"
+
+// Wireframe sobre el sombreado en la misma pasada (Bærentzen et al.,
+// "Single-pass wireframe rendering"): cada vértice del triángulo recibe su
+// distancia en píxeles al lado opuesto y los otros dos, 0. Interpolada sin
+// perspectiva, en cada fragmento la menor de las tres es la distancia a la
+// arista más cercana, y el fragment shader pinta la línea con ella: mismo
+// grosor en toda la pantalla y bordes suavizados, sin glPolygonMode(GL_LINE)
+// ni glLineWidth.
+
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+in vec3 ourColor[];
+
+out vec3 shadedColor;
+noperspective out vec3 edgeDistance;
+flat out uint triangleWireMode;
+
+void main()
+{
+    // Posiciones en píxeles
+    vec2 screen[3];
+    bool behind = false;
+    for (int i = 0; i < 3; i++) {
+        vec4 position = gl_in[i].gl_Position;
+        behind = behind || position.w <= 0.0;
+        screen[i] = 0.5 * viewportSize.xy * position.xy / position.w;
+    }
+
+    // Alturas del triángulo: doble del área entre cada lado
+    vec2 e0 = screen[2] - screen[1];
+    vec2 e1 = screen[2] - screen[0];
+    vec2 e2 = screen[1] - screen[0];
+    float area = abs(e1.x * e2.y - e1.y * e2.x);
+
+    vec3 heights = vec3(
+        area / max(length(e0), 1e-6),
+        area / max(length(e1), 1e-6),
+        area / max(length(e2), 1e-6));
+
+    // Con un vértice detrás de la cámara la proyección no vale: sin líneas
+    // (el triángulo lo recorta el clipping igualmente)
+    uint mode = wireframe && !behind ? 1u : 0u;
+
+    for (int i = 0; i < 3; i++) {
+        vec3 distance = vec3(0.0);
+        distance[i] = heights[i];
+
+        gl_Position = gl_in[i].gl_Position;
+        shadedColor = ourColor[i];
+        edgeDistance = distance;
+        triangleWireMode = mode;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
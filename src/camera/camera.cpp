@@ -5,7 +5,7 @@
 
 
 glm::vec3 Camera::getForward() const {
-    return glm::normalize(mPivot - mPosition);
+    return glm::normalize(glm::vec3(mPivot - mPosition));
 }
 
 glm::vec3 Camera::getForwardNormaliced() const {
@@ -15,14 +15,14 @@ glm::vec3 Camera::getForwardNormaliced() const {
 }
 
 void Camera::rotateAround(
-    glm::vec3& movinPoint,
-    const glm::vec3& fixedPoint,
+    glm::dvec3& movinPoint,
+    const glm::dvec3& fixedPoint,
     float xrel,
     float yrel) {
 
-    float distance = glm::length(movinPoint - fixedPoint);
+    double distance = glm::length(movinPoint - fixedPoint);
 
-    glm::vec3 direction = glm::normalize(movinPoint - fixedPoint);
+    glm::vec3 direction = glm::normalize(glm::vec3(movinPoint - fixedPoint));
 
     float yaw = glm::degrees(atan2(direction.z, direction.x));
     float pitch = glm::degrees(glm::asin(direction.y));
@@ -41,15 +41,15 @@ void Camera::rotateAround(
     direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
     direction = glm::normalize(direction);
 
-    movinPoint = fixedPoint + distance * direction;
+    movinPoint = fixedPoint + distance * glm::dvec3(direction);
 }
 
 
 
 Camera::Camera(/* args */) {
-    mPosition = glm::vec3(0.1f, 3.0f, 3.0f);
+    mPosition = glm::dvec3(0.1, 3.0, 3.0);
     //mViewDirection = glm::vec3(0.0f, 0.0f, -1.0f);
-    mPivot = glm::vec3(0.0f, 0.0f, -2.0f);
+    mPivot = glm::dvec3(0.0, 0.0, -2.0);
     mUpVector = glm::vec3(0.0f, 1.0f, 0.0f);
     mSpeed = 0.5f;
     mYaw = -90.0f;
@@ -61,11 +61,15 @@ Camera::~Camera() {
 }
 
 
+const glm::dvec3& Camera::getPosition() const {
+    return mPosition;
+}
+
 glm::mat4 Camera::getViewMatrix() const {
     return glm::lookAt(
-        mPosition,
+        glm::vec3(0.0f),
         //mPosition + mViewDirection,
-        mPivot,
+        glm::vec3(mPivot - mPosition),
         mUpVector
     );
 }
@@ -80,7 +84,7 @@ glm::mat4 Camera::getPerspectiveMatrix(float aspect) const {
     );
 }
 
-void Camera::setPivot(const glm::vec3& position) {
+void Camera::setPivot(const glm::dvec3& position) {
     mPivot = position;
 }
 
@@ -116,8 +120,8 @@ void Camera::moveRight(float deltaTime) {
 }
 
 void Camera::translate(const glm::vec3& delta) {
-    mPosition += delta;
-    mPivot += delta;
+    mPosition += glm::dvec3(delta);
+    mPivot += glm::dvec3(delta);
 }
 
 void Camera::mouseLook(float xrel, float yrel) {
@@ -7,13 +7,13 @@
 #include "math/transform.hpp"
 class Camera {
 private:
-    // Transform
-    glm::vec3 mPosition;
+    // Transform (posiciones de mundo en double, como Transform::position)
+    glm::dvec3 mPosition;
     glm::vec3 mViewDirection;
     glm::vec3 mUpVector;
 
     // Orbit
-    glm::vec3 mPivot{ 0.0f };
+    glm::dvec3 mPivot{ 0.0 };
 
     // Orientation
     float mYaw = -90.0f;
@@ -23,7 +23,7 @@ private:
     // Projection
     float mFov = 45.0f;
     float mNearPlane = 0.1f;
-    float mFarPlane = 100.0f;
+    float mFarPlane = 10000.0f;
 
     // Movement
     float mSpeed = 0.0f;
@@ -32,8 +32,8 @@ private:
     glm::vec3 getForwardNormaliced() const;
 
     void rotateAround(
-        glm::vec3& movinPoint,
-        const glm::vec3& fixedPoint,
+        glm::dvec3& movinPoint,
+        const glm::dvec3& fixedPoint,
         float xrel,
         float yrel
     );
@@ -43,10 +43,14 @@ public:
     Camera(/* args */);
     ~Camera();
 
+    const glm::dvec3& getPosition() const;
+
+    // Vista relativa a la cámara: el ojo está en el origen y las posiciones
+    // de mundo se llevan a este espacio restando getPosition() en double
     glm::mat4 getViewMatrix() const;
     glm::mat4 getPerspectiveMatrix(float aspect) const;
 
-    void setPivot(const glm::vec3& position);
+    void setPivot(const glm::dvec3& position);
 
     void moveForward(float deltaTime);
     void moveBackward(float deltaTime);
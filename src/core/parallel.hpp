@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Utilidades mínimas de paralelismo para los kernels de cálculo.
+// No hay pool de hilos: cada llamada lanza sus hilos y los espera,
+// así que solo compensa para trabajos grandes (ver minChunk).
+
+namespace core {
+
+// Número de hilos disponibles en la máquina (al menos 1).
+inline size_t workerCount() {
+    const unsigned int n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<size_t>(n);
+}
+
+// Número de bloques en que se dividirá un rango de 'count' elementos
+// para que ningún bloque tenga menos de 'minChunk' elementos.
+inline size_t chunkCount(size_t count, size_t minChunk) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const size_t byWork = (count + minChunk - 1) / std::max<size_t>(minChunk, 1);
+
+    return std::max<size_t>(1, std::min(workerCount(), byWork));
+}
+
+// Ejecuta fn(begin, end, chunkIndex) sobre bloques contiguos de [0, count).
+// El reparto es determinista: el bloque i cubre [count*i/n, count*(i+1)/n).
+// Devuelve el número de bloques usados, útil para reducir resultados parciales.
+template <typename Fn>
+size_t parallelFor(size_t count, size_t minChunk, Fn&& fn) {
+    const size_t chunks = chunkCount(count, minChunk);
+
+    if (chunks <= 1) {
+        if (count > 0) {
+            fn(size_t(0), count, size_t(0));
+        }
+        return chunks;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+
+    for (size_t i = 0; i + 1 < chunks; i++) {
+        const size_t begin = count * i / chunks;
+        const size_t end = count * (i + 1) / chunks;
+
+        threads.emplace_back([&fn, begin, end, i]() {
+            fn(begin, end, i);
+        });
+    }
+
+    // El último bloque lo procesa el hilo que llama
+    fn(count * (chunks - 1) / chunks, count, chunks - 1);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return chunks;
+}
+
+} // namespace core
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "parallel.hpp"
+
+// Ordenación radix (LSD) de claves enteras sin signo con un valor asociado,
+// p. ej. códigos de Morton con el índice del objeto.
+//
+// Dígitos de 8 bits, de menos a más significativo; cada pasada es estable.
+// Las pasadas en las que todas las claves tienen el mismo dígito (los bytes
+// altos de un código de 30 bits guardado en 64, por ejemplo) se saltan.
+//
+// En paralelo: cada bloque de parallelFor cuenta sus dígitos y después
+// escribe en su propio tramo de cada cubeta, así que no hay atómicas. El
+// reparto en bloques de parallelFor es determinista, de modo que el
+// recuento y el reparto ven los mismos bloques.
+
+namespace core {
+
+// 'keysTemp' y 'valuesTemp' son memoria de trabajo: quien ordena cada frame
+// puede guardarlos y ahorrarse reservarla (y tocarla) cada vez
+template <typename Key, typename Value>
+void radixSort(std::vector<Key>& keys, std::vector<Value>& values, std::vector<Key>& keysTemp, std::vector<Value>& valuesTemp) {
+    static_assert(std::is_unsigned<Key>::value, "radixSort solo ordena enteros sin signo");
+
+    constexpr size_t radix = 256;
+    constexpr size_t minChunk = 1 << 16;
+    const size_t count = keys.size();
+
+    if (count <= 1) {
+        return;
+    }
+
+    keysTemp.resize(count);
+    valuesTemp.resize(count);
+
+    std::vector<std::array<size_t, radix>> histograms(chunkCount(count, minChunk));
+
+    for (int shift = 0; shift < static_cast<int>(8 * sizeof(Key)); shift += 8) {
+        const size_t chunks = parallelFor(count, minChunk, [&](size_t begin, size_t end, size_t chunk) {
+            std::array<size_t, radix>& histogram = histograms[chunk];
+            histogram.fill(0);
+
+            for (size_t i = begin; i < end; i++) {
+                histogram[(keys[i] >> shift) & (radix - 1)]++;
+            }
+        });
+
+        // Si un dígito lo tienen todas las claves, la pasada no mueve nada
+        bool trivial = false;
+        for (size_t digit = 0; digit < radix && !trivial; digit++) {
+            size_t total = 0;
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                total += histograms[chunk][digit];
+            }
+            trivial = total == count;
+        }
+        if (trivial) {
+            continue;
+        }
+
+        // Posición de salida de cada (bloque, dígito): primero por dígito y
+        // dentro de cada dígito por bloque, para que sea estable
+        size_t offset = 0;
+        for (size_t digit = 0; digit < radix; digit++) {
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                const size_t size = histograms[chunk][digit];
+                histograms[chunk][digit] = offset;
+                offset += size;
+            }
+        }
+
+        parallelFor(count, minChunk, [&](size_t begin, size_t end, size_t chunk) {
+            std::array<size_t, radix>& position = histograms[chunk];
+
+            for (size_t i = begin; i < end; i++) {
+                const size_t target = position[(keys[i] >> shift) & (radix - 1)]++;
+                keysTemp[target] = keys[i];
+                valuesTemp[target] = values[i];
+            }
+        });
+
+        keys.swap(keysTemp);
+        values.swap(valuesTemp);
+    }
+}
+
+template <typename Key, typename Value>
+void radixSort(std::vector<Key>& keys, std::vector<Value>& values) {
+    std::vector<Key> keysTemp;
+    std::vector<Value> valuesTemp;
+    radixSort(keys, values, keysTemp, valuesTemp);
+}
+
+} // namespace core
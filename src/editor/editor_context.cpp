@@ -24,6 +24,14 @@ void EditorContext::setTransformMode(TransformMode mode) {
     mTransformode = mode;
 }
 
+SnapMode EditorContext::getSnapMode() const {
+    return mSnapMode;
+}
+
+void EditorContext::setSnapMode(SnapMode mode) {
+    mSnapMode = mode;
+}
+
 void EditorContext::setSelectedObjectId(uint32_t id) {
     mSelectedObjectId = id;
 }
@@ -40,5 +48,13 @@ void EditorContext::clearSelection() {
     mSelectedObjectId = mNoObjectIdSelected;
 }
 
+bool EditorContext::isWireframe() const {
+    return mWireframe;
+}
+
+void EditorContext::setWireframe(bool enabled) {
+    mWireframe = enabled;
+}
+
 } // namespace editor
 
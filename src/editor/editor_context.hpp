@@ -8,8 +8,12 @@ class EditorContext {
 private:
     Tool mTool = Tool::Select;
     TransformMode mTransformode = TransformMode::Local;
+    SnapMode mSnapMode = SnapMode::None;
 
     uint32_t mSelectedObjectId = mNoObjectIdSelected;
+
+    // Wireframe sobre el sombreado en toda la escena
+    bool mWireframe = false;
 public:
     static constexpr uint32_t mNoObjectIdSelected = 0;
 
@@ -22,12 +26,18 @@ public:
     TransformMode getTransformMode() const;
     void setTransformMode(TransformMode mode);
 
+    SnapMode getSnapMode() const;
+    void setSnapMode(SnapMode mode);
+
     void setSelectedObjectId(uint32_t id);
     uint32_t getSelectedObjectId() const;
 
     bool hasSelection() const;
     void clearSelection();
 
+    bool isWireframe() const;
+    void setWireframe(bool enabled);
+
 };
 
 
@@ -17,4 +17,12 @@ enum class TransformMode {
     Local,
     World
 };
+
+// A qué se ajusta el gizmo de mover al arrastrarlo cerca de otro objeto
+enum class SnapMode {
+    None,
+    Vertex,
+    Edge,
+    Face
+};
 }
\ No newline at end of file
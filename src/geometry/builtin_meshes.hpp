@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "mesh.hpp"
+#include "vertex.hpp"
+#include "math/constexpr_math.hpp"
+
+// Geometría fija del editor generada en tiempo de compilación: los datos
+// acaban en la sección de solo lectura del ejecutable y no hay que
+// calcularlos ni reservarlos al arrancar.
+
+namespace app::geometry {
+
+template <size_t VertexCount, size_t IndexCount>
+struct StaticMesh {
+    std::array<Vertex, VertexCount> vertices{};
+    std::array<uint32_t, IndexCount> indices{};
+
+    // Copia a una Mesh normal (para los Object, que pueden modificarla)
+    Mesh toMesh() const {
+        return Mesh(
+            std::vector<Vertex>(vertices.begin(), vertices.end()),
+            std::vector<uint32_t>(indices.begin(), indices.end()));
+    }
+};
+
+constexpr size_t sphereVertexCount(uint32_t segments, uint32_t rings) {
+    return static_cast<size_t>(segments) * (rings - 1) + 2;
+}
+
+constexpr size_t sphereIndexCount(uint32_t segments, uint32_t rings) {
+    return 6 * static_cast<size_t>(segments) * (rings - 1);
+}
+
+// Esfera UV de radio 0.5 centrada en el origen, cerrada y con los polos
+// compartidos. Escribe sphereVertexCount y sphereIndexCount elementos; la
+// usan tanto makeSphere como MeshFactory::createSphereMesh
+constexpr void writeSphere(uint32_t segments, uint32_t rings, Vertex* vertices, uint32_t* indices) {
+    constexpr float radius = 0.5f;
+
+    // El color sigue a la normal para que se aprecie el volumen
+    size_t vertex = 0;
+    auto addVertex = [&](const glm::vec3& normal) {
+        vertices[vertex++] = Vertex(normal * radius, normal * 0.5f + 0.5f);
+    };
+
+    addVertex(glm::vec3(0.0f, 1.0f, 0.0f));   // polo norte
+
+    for (uint32_t r = 1; r < rings; r++) {
+        const double phi = math::cx::kPi * r / rings;
+
+        for (uint32_t s = 0; s < segments; s++) {
+            const double theta = 2.0 * math::cx::kPi * s / segments;
+            addVertex(glm::vec3(
+                static_cast<float>(math::cx::sin(phi) * math::cx::cos(theta)),
+                static_cast<float>(math::cx::cos(phi)),
+                static_cast<float>(math::cx::sin(phi) * math::cx::sin(theta))));
+        }
+    }
+
+    addVertex(glm::vec3(0.0f, -1.0f, 0.0f));  // polo sur
+
+    const uint32_t south = static_cast<uint32_t>(vertex - 1);
+    auto ringVertex = [segments](uint32_t r, uint32_t s) {
+        return 1 + (r - 1) * segments + s % segments;
+    };
+
+    size_t index = 0;
+    auto addTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+        indices[index++] = a;
+        indices[index++] = b;
+        indices[index++] = c;
+    };
+
+    for (uint32_t s = 0; s < segments; s++) {
+        addTriangle(0, ringVertex(1, s + 1), ringVertex(1, s));
+    }
+
+    for (uint32_t r = 1; r + 1 < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            const uint32_t a = ringVertex(r, s);
+            const uint32_t b = ringVertex(r, s + 1);
+            const uint32_t c = ringVertex(r + 1, s + 1);
+            const uint32_t d = ringVertex(r + 1, s);
+
+            addTriangle(a, b, d);
+            addTriangle(b, c, d);
+        }
+    }
+
+    for (uint32_t s = 0; s < segments; s++) {
+        addTriangle(ringVertex(rings - 1, s), ringVertex(rings - 1, s + 1), south);
+    }
+}
+
+template <uint32_t Segments, uint32_t Rings>
+constexpr auto makeSphere() {
+    static_assert(Segments >= 3 && Rings >= 2, "Esfera demasiado pequeña");
+
+    StaticMesh<sphereVertexCount(Segments, Rings), sphereIndexCount(Segments, Rings)> mesh{};
+    writeSphere(Segments, Rings, mesh.vertices.data(), mesh.indices.data());
+    return mesh;
+}
+
+constexpr StaticMesh<4, 6> makeRectangle() {
+    return {
+        { {
+            Vertex({ 0.0f,  0.8f, 0.0f }, { 1.0f, 0.0f, 0.0f }),  // arriba, rojo
+            Vertex({-0.5f, -0.5f, 0.0f }, { 0.0f, 1.0f, 0.0f }),  // izquierda, verde
+            Vertex({ 0.5f, -0.5f, 0.0f }, { 0.0f, 0.0f, 1.0f }),  // derecha, azul
+            Vertex({ 1.0f,  0.5f, 0.0f }, { 1.0f, 1.0f, 1.0f })   // arriba, blanco
+        } },
+        { {
+            0, 1, 2, // primer triángulo
+            3, 0, 2  // segundo triángulo
+        } }
+    };
+}
+
+constexpr StaticMesh<8, 36> makeCube() {
+    return {
+        { {
+            // Cara frontal (roja)
+            Vertex({-0.5f, -0.5f,  0.5f }, { 1.0f, 0.0f, 0.0f }),
+            Vertex({ 0.5f, -0.5f,  0.5f }, { 1.0f, 0.0f, 0.0f }),
+            Vertex({ 0.5f,  0.5f,  0.5f }, { 1.0f, 0.0f, 0.0f }),
+            Vertex({-0.5f,  0.5f,  0.5f }, { 1.0f, 0.0f, 0.0f }),
+
+            // Cara trasera (verde)
+            Vertex({-0.5f, -0.5f, -0.5f }, { 0.0f, 1.0f, 0.0f }),
+            Vertex({ 0.5f, -0.5f, -0.5f }, { 0.0f, 1.0f, 0.0f }),
+            Vertex({ 0.5f,  0.5f, -0.5f }, { 0.0f, 1.0f, 0.0f }),
+            Vertex({-0.5f,  0.5f, -0.5f }, { 0.0f, 1.0f, 0.0f })
+        } },
+        { {
+            0, 1, 2, 2, 3, 0,   // Frontal
+            1, 5, 6, 6, 2, 1,   // Derecha
+            5, 4, 7, 7, 6, 5,   // Trasera
+            4, 0, 3, 3, 7, 4,   // Izquierda
+            3, 2, 6, 6, 7, 3,   // Superior
+            4, 5, 1, 1, 0, 4    // Inferior
+        } }
+    };
+}
+
+// Líneas del grid en el plano XZ, de -Size a Size: 4 paralelas a cada eje
+// por cada i en [0, Size). Las de i = 0 llevan el color del eje
+template <int Size>
+constexpr std::array<Vertex, 8 * Size> makeGridLines() {
+    std::array<Vertex, 8 * Size> lines{};
+    const float size = static_cast<float>(Size);
+
+    for (int i = 0; i < Size; i++) {
+        const float offset = static_cast<float>(i);
+        const glm::vec3 colorX = i == 0 ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f);
+        const glm::vec3 colorZ = i == 0 ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f);
+        Vertex* v = &lines[8 * i];
+
+        // Paralelas al eje Z
+        v[0] = Vertex({ offset, 0.0f, size }, colorZ);
+        v[1] = Vertex({ offset, 0.0f, -size }, colorZ);
+        v[2] = Vertex({ -offset, 0.0f, size }, colorZ);
+        v[3] = Vertex({ -offset, 0.0f, -size }, colorZ);
+
+        // Paralelas al eje X
+        v[4] = Vertex({ size, 0.0f, offset }, colorX);
+        v[5] = Vertex({ -size, 0.0f, offset }, colorX);
+        v[6] = Vertex({ size, 0.0f, -offset }, colorX);
+        v[7] = Vertex({ -size, 0.0f, -offset }, colorX);
+    }
+    return lines;
+}
+
+inline constexpr StaticMesh<4, 6> kRectangleMesh = makeRectangle();
+inline constexpr StaticMesh<8, 36> kCubeMesh = makeCube();
+inline constexpr auto kSphereMesh = makeSphere<32, 16>();
+
+} // namespace app::geometry
@@ -0,0 +1,226 @@
+#include "bvh.hpp"
+#include "core/parallel.hpp"
+
+#include <limits>
+
+namespace app::geometry {
+
+namespace {
+
+constexpr int binCount = 12;
+
+// A partir de esta profundidad se parte por la mediana para acotar la pila
+// de los recorridos (ver los 64 niveles de queryOverlap/querySegment)
+constexpr int maxSahDepth = 32;
+
+math::AABB emptyBox() {
+    const float inf = std::numeric_limits<float>::infinity();
+    return math::AABB{ glm::vec3(inf), glm::vec3(-inf) };
+}
+
+void grow(math::AABB& box, const math::AABB& other) {
+    box.min = glm::min(box.min, other.min);
+    box.max = glm::max(box.max, other.max);
+}
+
+void grow(math::AABB& box, const glm::vec3& point) {
+    box.min = glm::min(box.min, point);
+    box.max = glm::max(box.max, point);
+}
+
+float area(const math::AABB& box) {
+    const glm::vec3 d = box.max - box.min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+struct BuildTask {
+    uint32_t parent;      // nodo padre si es un hijo derecho
+    bool rightChild;
+    uint32_t begin;
+    uint32_t end;
+    int depth;
+};
+
+} // namespace
+
+Bvh::Bvh(const std::vector<math::AABB>& primitiveBounds, uint32_t leafSize) {
+    const uint32_t count = static_cast<uint32_t>(primitiveBounds.size());
+    if (count == 0) {
+        return;
+    }
+
+    leafSize = std::max<uint32_t>(leafSize, 1);
+
+    std::vector<glm::vec3> centroids(count);
+    core::parallelFor(count, 1 << 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            centroids[i] = 0.5f * (primitiveBounds[i].min + primitiveBounds[i].max);
+        }
+    });
+
+    mPrimitives.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+        mPrimitives[i] = i;
+    }
+
+    mNodes.reserve(2 * static_cast<size_t>(count / leafSize) + 1);
+
+    // Recorrido en profundidad: cada nodo se crea al sacarlo de la pila, así
+    // que el hijo izquierdo queda justo detrás de su padre y el derecho se
+    // crea cuando ya está completo todo el subárbol izquierdo.
+    std::vector<BuildTask> tasks;
+    tasks.push_back({ 0, false, 0, count, 0 });
+
+    while (!tasks.empty()) {
+        const BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        const uint32_t node = static_cast<uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+
+        if (task.rightChild) {
+            mNodes[task.parent].first = node;
+        }
+
+        math::AABB bounds = emptyBox();
+        math::AABB centroidBounds = emptyBox();
+
+        for (uint32_t i = task.begin; i < task.end; i++) {
+            grow(bounds, primitiveBounds[mPrimitives[i]]);
+            grow(centroidBounds, centroids[mPrimitives[i]]);
+        }
+
+        mNodes[node].bounds = bounds;
+
+        const uint32_t size = task.end - task.begin;
+        const glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+        const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+        auto makeLeaf = [&]() {
+            mNodes[node].first = task.begin;
+            mNodes[node].count = size;
+        };
+
+        if (size <= leafSize || extent[axis] <= 0.0f) {
+            makeLeaf();
+            continue;
+        }
+
+        uint32_t* first = mPrimitives.data() + task.begin;
+        uint32_t* last = mPrimitives.data() + task.end;
+        uint32_t* middle = nullptr;
+
+        if (task.depth < maxSahDepth) {
+            // SAH por cubetas en el eje de mayor extensión de los centroides
+            math::AABB binBounds[binCount];
+            uint32_t binSizes[binCount] = {};
+            std::fill(binBounds, binBounds + binCount, emptyBox());
+
+            const float scale = binCount / extent[axis];
+            auto binOf = [&](uint32_t primitive) {
+                const int bin = static_cast<int>((centroids[primitive][axis] - centroidBounds.min[axis]) * scale);
+                return std::min(bin, binCount - 1);
+            };
+
+            for (uint32_t* p = first; p != last; p++) {
+                const int bin = binOf(*p);
+                binSizes[bin]++;
+                grow(binBounds[bin], primitiveBounds[*p]);
+            }
+
+            // Coste de cada plano entre cubetas: barrido por la derecha y por la izquierda
+            float rightCost[binCount];
+            math::AABB accumulated = emptyBox();
+            uint32_t accumulatedSize = 0;
+
+            for (int b = binCount - 1; b > 0; b--) {
+                grow(accumulated, binBounds[b]);
+                accumulatedSize += binSizes[b];
+                rightCost[b] = accumulatedSize > 0 ? area(accumulated) * accumulatedSize : 0.0f;
+            }
+
+            float bestCost = std::numeric_limits<float>::infinity();
+            int bestSplit = -1;
+
+            accumulated = emptyBox();
+            accumulatedSize = 0;
+
+            for (int b = 0; b + 1 < binCount; b++) {
+                grow(accumulated, binBounds[b]);
+                accumulatedSize += binSizes[b];
+
+                if (accumulatedSize == 0 || accumulatedSize == size) {
+                    continue;
+                }
+
+                const float cost = area(accumulated) * accumulatedSize + rightCost[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = b;
+                }
+            }
+
+            // Si partir no mejora a una hoja pequeña, se deja como hoja
+            const float leafCost = area(bounds) * size;
+            if (bestSplit >= 0 && size <= 4 * leafSize && bestCost >= leafCost) {
+                makeLeaf();
+                continue;
+            }
+
+            if (bestSplit >= 0) {
+                middle = std::partition(first, last, [&](uint32_t primitive) {
+                    return binOf(primitive) <= bestSplit;
+                });
+            }
+        }
+
+        if (middle == nullptr || middle == first || middle == last) {
+            // Mediana de objetos
+            middle = first + size / 2;
+            std::nth_element(first, middle, last, [&](uint32_t a, uint32_t b) {
+                return centroids[a][axis] < centroids[b][axis];
+            });
+        }
+
+        const uint32_t split = static_cast<uint32_t>(middle - mPrimitives.data());
+
+        // Se apila primero el derecho para construir antes el izquierdo
+        tasks.push_back({ node, true, split, task.end, task.depth + 1 });
+        tasks.push_back({ node, false, task.begin, split, task.depth + 1 });
+    }
+}
+
+Bvh Bvh::fromTriangles(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    std::vector<math::AABB> bounds(indices.size() / 3);
+
+    core::parallelFor(bounds.size(), 1 << 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t t = begin; t < end; t++) {
+            const glm::vec3& a = positions[indices[3 * t]];
+            const glm::vec3& b = positions[indices[3 * t + 1]];
+            const glm::vec3& c = positions[indices[3 * t + 2]];
+
+            bounds[t].min = glm::min(a, glm::min(b, c));
+            bounds[t].max = glm::max(a, glm::max(b, c));
+        }
+    });
+
+    return Bvh(bounds);
+}
+
+bool Bvh::empty() const {
+    return mNodes.empty();
+}
+
+const math::AABB& Bvh::getBounds() const {
+    return mNodes.front().bounds;
+}
+
+const std::vector<BvhNode>& Bvh::getNodes() const {
+    return mNodes;
+}
+
+const std::vector<uint32_t>& Bvh::getPrimitives() const {
+    return mPrimitives;
+}
+
+} // namespace app::geometry
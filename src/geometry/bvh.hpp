@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "math/aabb.hpp"
+#include "math/ray_packet.hpp"
+
+// Jerarquía de volúmenes envolventes (BVH) sobre primitivas con AABB.
+//
+// Se construye con SAH por cubetas (binned SAH) y los nodos se guardan en un
+// único vector en orden de recorrido en profundidad: el hijo izquierdo de un
+// nodo interior está justo detrás de él y el derecho en 'first'.
+
+namespace app::geometry {
+
+struct BvhNode {
+    math::AABB bounds;
+    uint32_t first = 0;   // hoja: primera primitiva; interior: hijo derecho
+    uint32_t count = 0;   // número de primitivas (0 en los nodos interiores)
+
+    bool isLeaf() const { return count > 0; }
+};
+
+class Bvh {
+private:
+    std::vector<BvhNode> mNodes;
+    std::vector<uint32_t> mPrimitives;   // índices de primitiva en orden de hojas
+
+public:
+    Bvh() = default;
+    explicit Bvh(const std::vector<math::AABB>& primitiveBounds, uint32_t leafSize = 4);
+
+    // Un triángulo por primitiva (3 índices consecutivos en 'indices')
+    static Bvh fromTriangles(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+    bool empty() const;
+    const math::AABB& getBounds() const;
+    const std::vector<BvhNode>& getNodes() const;
+    const std::vector<uint32_t>& getPrimitives() const;
+
+    // Llama a fn(primitiva) para cada primitiva cuyo AABB solapa 'box'
+    template <typename Fn>
+    void queryOverlap(const math::AABB& box, Fn&& fn) const;
+
+    // Llama a fn(primitiva) para cada primitiva cuyo AABB corta el segmento
+    template <typename Fn>
+    void querySegment(const glm::vec3& from, const glm::vec3& to, Fn&& fn) const;
+
+    // Recorre el árbol con un paquete de rayos: cada nodo se descarta
+    // primero con el frustum del paquete y después rayo a rayo. Llama a
+    // fn(primitiva, rayos) con la máscara de rayos que llegan a la hoja.
+    // fn puede acortar packet.tMax (p. ej. con math::intersect) y el
+    // recorrido lo tiene en cuenta en los nodos siguientes.
+    template <int N, typename Fn>
+    void queryPacket(const math::RayPacket<N>& packet, Fn&& fn) const;
+};
+
+namespace detail {
+
+inline bool overlaps(const math::AABB& a, const math::AABB& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+        a.min.y <= b.max.y && a.max.y >= b.min.y &&
+        a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+// Test de slabs entre el segmento origin + t * delta (t en [0, 1]) y la caja
+inline bool segmentOverlaps(const glm::vec3& origin, const glm::vec3& inverseDelta, const math::AABB& box) {
+    const glm::vec3 t0 = (box.min - origin) * inverseDelta;
+    const glm::vec3 t1 = (box.max - origin) * inverseDelta;
+
+    const glm::vec3 tNear = glm::min(t0, t1);
+    const glm::vec3 tFar = glm::max(t0, t1);
+
+    const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, 1.0f));
+
+    return enter <= exit;
+}
+
+} // namespace detail
+
+template <typename Fn>
+void Bvh::queryOverlap(const math::AABB& box, Fn&& fn) const {
+    if (mNodes.empty()) {
+        return;
+    }
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BvhNode& node = mNodes[index];
+
+        if (!detail::overlaps(node.bounds, box)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                fn(mPrimitives[i]);
+            }
+        } else {
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+template <typename Fn>
+void Bvh::querySegment(const glm::vec3& from, const glm::vec3& to, Fn&& fn) const {
+    if (mNodes.empty()) {
+        return;
+    }
+
+    // Las componentes nulas dan ±inf, que el test de slabs maneja bien
+    const glm::vec3 inverseDelta = 1.0f / (to - from);
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BvhNode& node = mNodes[index];
+
+        if (!detail::segmentOverlaps(from, inverseDelta, node.bounds)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                fn(mPrimitives[i]);
+            }
+        } else {
+            stack[top++] = node.first;
+            stack[top++] = index + 1;
+        }
+    }
+}
+
+template <int N, typename Fn>
+void Bvh::queryPacket(const math::RayPacket<N>& packet, Fn&& fn) const {
+    if (mNodes.empty() || packet.active == 0) {
+        return;
+    }
+
+    // Se construye una vez con los tMax iniciales: al acortarse los rayos
+    // sigue siendo conservador
+    const math::RayPacketFrustum frustum = math::makePacketFrustum(packet);
+
+    // Dirección de un rayo activo para visitar antes el hijo más cercano
+    int lead = 0;
+    while ((packet.active >> lead & 1) == 0) {
+        lead++;
+    }
+    const glm::vec3 leadOrigin(packet.originX[lead], packet.originY[lead], packet.originZ[lead]);
+    const glm::vec3 leadDirection(packet.directionX[lead], packet.directionY[lead], packet.directionZ[lead]);
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BvhNode& node = mNodes[index];
+
+        if (!math::overlaps(frustum, node.bounds)) {
+            continue;
+        }
+
+        const int lanes = math::intersect(packet, node.bounds);
+        if (lanes == 0) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                fn(mPrimitives[i], lanes);
+            }
+            continue;
+        }
+
+        const uint32_t left = index + 1;
+        const uint32_t right = node.first;
+
+        const glm::vec3 leftCenter = 0.5f * (mNodes[left].bounds.min + mNodes[left].bounds.max);
+        const glm::vec3 rightCenter = 0.5f * (mNodes[right].bounds.min + mNodes[right].bounds.max);
+
+        // El más lejano se apila primero
+        if (glm::dot(leftCenter - leadOrigin, leadDirection) <= glm::dot(rightCenter - leadOrigin, leadDirection)) {
+            stack[top++] = right;
+            stack[top++] = left;
+        } else {
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+    }
+}
+
+} // namespace app::geometry
@@ -0,0 +1,352 @@
+#include "chunked_mesh.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+
+namespace app::geometry {
+
+namespace {
+
+constexpr char fileMagic[4] = { 'C', 'M', 'S', 'H' };
+constexpr uint32_t fileVersion = 1;
+
+// Trozos más grandes se parten aunque vengan de la misma celda
+constexpr uint32_t maxChunkTriangles = 1u << 20;
+
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t chunkCount;
+    uint32_t reserved;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t directoryOffset;
+};
+
+struct ChunkRecord {
+    float boundsMin[3];
+    float boundsMax[3];
+    uint64_t offset;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+};
+
+static_assert(sizeof(Vertex) == 6 * sizeof(float), "El formato guarda Vertex tal cual");
+
+// Para soldar vértices idénticos dentro de un trozo
+struct VertexKey {
+    Vertex vertex;
+
+    bool operator==(const VertexKey& other) const {
+        return std::memcmp(&vertex, &other.vertex, sizeof(Vertex)) == 0;
+    }
+};
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        uint32_t words[6];
+        std::memcpy(words, &key.vertex, sizeof(words));
+
+        uint64_t hash = 1469598103934665603ull;
+        for (uint32_t word : words) {
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+};
+
+} // namespace
+
+uint64_t ChunkInfo::byteSize() const {
+    return uint64_t(vertexCount) * sizeof(Vertex) + uint64_t(indexCount) * sizeof(uint32_t);
+}
+
+// ---------------------------------------------------------------------------
+// ChunkedMeshFile
+// ---------------------------------------------------------------------------
+
+bool ChunkedMeshFile::open(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error: no se puede abrir la malla troceada " << path << std::endl;
+        return false;
+    }
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 ||
+        header.version != fileVersion) {
+        std::cerr << "Error: " << path << " no es una malla troceada válida" << std::endl;
+        return false;
+    }
+
+    std::vector<ChunkRecord> records(header.chunkCount);
+    file.seekg(static_cast<std::streamoff>(header.directoryOffset));
+
+    if (!file.read(reinterpret_cast<char*>(records.data()), records.size() * sizeof(ChunkRecord))) {
+        std::cerr << "Error: directorio de trozos incompleto en " << path << std::endl;
+        return false;
+    }
+
+    mPath = path;
+    mBounds.min = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    mBounds.max = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+
+    mChunks.resize(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        const ChunkRecord& record = records[i];
+        ChunkInfo& chunk = mChunks[i];
+
+        chunk.bounds.min = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+        chunk.bounds.max = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+        chunk.offset = record.offset;
+        chunk.vertexCount = record.vertexCount;
+        chunk.indexCount = record.indexCount;
+    }
+
+    return true;
+}
+
+const std::string& ChunkedMeshFile::getPath() const {
+    return mPath;
+}
+
+const math::AABB& ChunkedMeshFile::getBounds() const {
+    return mBounds;
+}
+
+const std::vector<ChunkInfo>& ChunkedMeshFile::getChunks() const {
+    return mChunks;
+}
+
+uint64_t ChunkedMeshFile::getTotalBytes() const {
+    uint64_t total = 0;
+    for (const ChunkInfo& chunk : mChunks) {
+        total += chunk.byteSize();
+    }
+    return total;
+}
+
+bool ChunkedMeshFile::readChunk(size_t index, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const {
+    if (index >= mChunks.size()) {
+        return false;
+    }
+
+    const ChunkInfo& chunk = mChunks[index];
+
+    std::ifstream file(mPath, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(chunk.offset));
+
+    vertices.resize(chunk.vertexCount);
+    indices.resize(chunk.indexCount);
+
+    return file &&
+        file.read(reinterpret_cast<char*>(vertices.data()), vertices.size() * sizeof(Vertex)) &&
+        file.read(reinterpret_cast<char*>(indices.data()), indices.size() * sizeof(uint32_t));
+}
+
+// ---------------------------------------------------------------------------
+// ChunkedMeshBuilder
+// ---------------------------------------------------------------------------
+
+ChunkedMeshBuilder::ChunkedMeshBuilder(
+    const std::string& path,
+    const math::AABB& bounds,
+    int cellsPerAxis,
+    size_t memoryLimit)
+    : mPath(path),
+    mSpillPath(path + ".spill"),
+    mBounds(bounds),
+    mCellsPerAxis(std::max(cellsPerAxis, 1)),
+    mMemoryLimit(memoryLimit) {
+
+    const size_t cellCount = size_t(mCellsPerAxis) * mCellsPerAxis * mCellsPerAxis;
+    mPending.resize(cellCount);
+    mSpilled.resize(cellCount);
+}
+
+ChunkedMeshBuilder::~ChunkedMeshBuilder() {
+    if (mSpill.is_open()) {
+        mSpill.close();
+        std::remove(mSpillPath.c_str());
+    }
+}
+
+size_t ChunkedMeshBuilder::cellOf(const glm::vec3& point) const {
+    const glm::vec3 extent = glm::max(mBounds.max - mBounds.min, glm::vec3(std::numeric_limits<float>::min()));
+    const glm::vec3 relative = (point - mBounds.min) / extent;
+
+    const glm::ivec3 cell = glm::clamp(
+        glm::ivec3(relative * static_cast<float>(mCellsPerAxis)),
+        glm::ivec3(0),
+        glm::ivec3(mCellsPerAxis - 1));
+
+    return size_t(cell.x) + size_t(mCellsPerAxis) * (size_t(cell.y) + size_t(mCellsPerAxis) * cell.z);
+}
+
+void ChunkedMeshBuilder::addTriangle(const Vertex& a, const Vertex& b, const Vertex& c) {
+    std::vector<Vertex>& cell = mPending[cellOf((a.position + b.position + c.position) / 3.0f)];
+    cell.push_back(a);
+    cell.push_back(b);
+    cell.push_back(c);
+
+    mPendingBytes += 3 * sizeof(Vertex);
+
+    if (mPendingBytes >= mMemoryLimit) {
+        spill();
+    }
+}
+
+void ChunkedMeshBuilder::addTriangles(const Mesh& part) {
+    for (size_t t = 0; t + 2 < part.indices.size(); t += 3) {
+        addTriangle(
+            part.vertices[part.indices[t]],
+            part.vertices[part.indices[t + 1]],
+            part.vertices[part.indices[t + 2]]);
+    }
+}
+
+bool ChunkedMeshBuilder::spill() {
+    if (!mSpill.is_open()) {
+        mSpill.open(mSpillPath, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!mSpill) {
+            std::cerr << "Error: no se puede crear el fichero temporal " << mSpillPath << std::endl;
+            return false;
+        }
+    }
+
+    mSpill.seekp(0, std::ios::end);
+
+    for (size_t cell = 0; cell < mPending.size(); cell++) {
+        std::vector<Vertex>& pending = mPending[cell];
+        if (pending.empty()) {
+            continue;
+        }
+
+        const uint64_t offset = static_cast<uint64_t>(mSpill.tellp());
+        mSpill.write(reinterpret_cast<const char*>(pending.data()), pending.size() * sizeof(Vertex));
+        mSpilled[cell].emplace_back(offset, static_cast<uint32_t>(pending.size() / 3));
+
+        // Libera la memoria, no solo el contenido
+        std::vector<Vertex>().swap(pending);
+    }
+
+    mPendingBytes = 0;
+    return static_cast<bool>(mSpill);
+}
+
+bool ChunkedMeshBuilder::finish() {
+    std::ofstream file(mPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: no se puede escribir la malla troceada " << mPath << std::endl;
+        return false;
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+
+    // La cabecera se reescribe al final con el directorio ya conocido
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<ChunkRecord> records;
+    math::AABB total{ glm::vec3(std::numeric_limits<float>::max()), glm::vec3(-std::numeric_limits<float>::max()) };
+
+    std::vector<Vertex> triangles;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> welded;
+
+    for (size_t cell = 0; cell < mPending.size(); cell++) {
+        // Triángulos de la celda: los volcados a disco y los que siguen en memoria
+        triangles.clear();
+
+        for (const auto& [offset, count] : mSpilled[cell]) {
+            const size_t first = triangles.size();
+            triangles.resize(first + size_t(count) * 3);
+
+            mSpill.seekg(static_cast<std::streamoff>(offset));
+            mSpill.read(reinterpret_cast<char*>(triangles.data() + first), size_t(count) * 3 * sizeof(Vertex));
+        }
+
+        triangles.insert(triangles.end(), mPending[cell].begin(), mPending[cell].end());
+        std::vector<Vertex>().swap(mPending[cell]);
+
+        for (size_t begin = 0; begin < triangles.size(); begin += size_t(maxChunkTriangles) * 3) {
+            const size_t end = std::min(triangles.size(), begin + size_t(maxChunkTriangles) * 3);
+
+            vertices.clear();
+            indices.clear();
+            welded.clear();
+
+            glm::vec3 chunkMin(std::numeric_limits<float>::max());
+            glm::vec3 chunkMax(-std::numeric_limits<float>::max());
+
+            for (size_t i = begin; i < end; i++) {
+                const auto [it, inserted] = welded.emplace(VertexKey{ triangles[i] }, static_cast<uint32_t>(vertices.size()));
+                if (inserted) {
+                    vertices.push_back(triangles[i]);
+                    chunkMin = glm::min(chunkMin, triangles[i].position);
+                    chunkMax = glm::max(chunkMax, triangles[i].position);
+                }
+                indices.push_back(it->second);
+            }
+
+            ChunkRecord record{};
+            record.offset = static_cast<uint64_t>(file.tellp());
+            record.vertexCount = static_cast<uint32_t>(vertices.size());
+            record.indexCount = static_cast<uint32_t>(indices.size());
+            for (int k = 0; k < 3; k++) {
+                record.boundsMin[k] = chunkMin[k];
+                record.boundsMax[k] = chunkMax[k];
+            }
+            records.push_back(record);
+
+            total.min = glm::min(total.min, chunkMin);
+            total.max = glm::max(total.max, chunkMax);
+
+            file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+            file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t));
+        }
+    }
+
+    header.chunkCount = static_cast<uint32_t>(records.size());
+    header.directoryOffset = static_cast<uint64_t>(file.tellp());
+
+    if (records.empty()) {
+        total = math::AABB{ glm::vec3(0.0f), glm::vec3(0.0f) };
+    }
+    for (int k = 0; k < 3; k++) {
+        header.boundsMin[k] = total.min[k];
+        header.boundsMax[k] = total.max[k];
+    }
+
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(ChunkRecord));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (mSpill.is_open()) {
+        mSpill.close();
+        std::remove(mSpillPath.c_str());
+    }
+
+    if (!file) {
+        std::cerr << "Error escribiendo la malla troceada " << mPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool writeChunkedMesh(const std::string& path, const Mesh& mesh, int cellsPerAxis) {
+    math::AABB bounds = math::calculateBoundingBox(mesh);
+
+    ChunkedMeshBuilder builder(path, bounds, cellsPerAxis);
+    builder.addTriangles(mesh);
+    return builder.finish();
+}
+
+} // namespace app::geometry
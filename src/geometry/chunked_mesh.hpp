@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mesh.hpp"
+#include "math/aabb.hpp"
+
+// Mallas troceadas en disco (.cmsh) para mallas que no caben en memoria.
+//
+// La malla se reparte en una rejilla regular según el centroide de cada
+// triángulo y cada celda se guarda como un trozo independiente con sus
+// propios vértices e índices locales. Al abrir el fichero solo se lee la
+// cabecera y el directorio de trozos; los datos se leen bajo demanda.
+//
+// Formato (little-endian):
+//   cabecera | trozo 0 | trozo 1 | ... | directorio (un registro por trozo)
+
+namespace app::geometry {
+
+struct ChunkInfo {
+    math::AABB bounds;
+    uint64_t offset = 0;        // posición de los datos del trozo en el fichero
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+
+    // Bytes en disco (y en GPU): vértices seguidos de índices
+    uint64_t byteSize() const;
+};
+
+class ChunkedMeshFile {
+private:
+    std::string mPath;
+    math::AABB mBounds{ glm::vec3(0.0f), glm::vec3(0.0f) };
+    std::vector<ChunkInfo> mChunks;
+
+public:
+    bool open(const std::string& path);
+
+    const std::string& getPath() const;
+    const math::AABB& getBounds() const;
+    const std::vector<ChunkInfo>& getChunks() const;
+    uint64_t getTotalBytes() const;
+
+    // Cada llamada abre su propio flujo, así que se puede usar desde
+    // cualquier hilo sin sincronización
+    bool readChunk(size_t index, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) const;
+};
+
+// Construye un .cmsh a partir de triángulos que se van añadiendo por partes,
+// sin tener nunca la malla completa en memoria: los triángulos pendientes
+// se vuelcan a un fichero temporal cuando superan 'memoryLimit' bytes.
+class ChunkedMeshBuilder {
+private:
+    std::string mPath;
+    std::string mSpillPath;
+    std::fstream mSpill;
+
+    math::AABB mBounds;
+    int mCellsPerAxis;
+    size_t mMemoryLimit;
+    size_t mPendingBytes = 0;
+
+    // Triángulos sin índices (3 vértices seguidos) por celda
+    std::vector<std::vector<Vertex>> mPending;
+
+    // Bloques volcados al fichero temporal: (posición, número de triángulos)
+    std::vector<std::vector<std::pair<uint64_t, uint32_t>>> mSpilled;
+
+    size_t cellOf(const glm::vec3& point) const;
+    bool spill();
+
+public:
+    // 'bounds' debe contener toda la malla
+    ChunkedMeshBuilder(
+        const std::string& path,
+        const math::AABB& bounds,
+        int cellsPerAxis,
+        size_t memoryLimit = size_t(256) << 20
+    );
+    ~ChunkedMeshBuilder();
+
+    void addTriangle(const Vertex& a, const Vertex& b, const Vertex& c);
+    void addTriangles(const Mesh& part);
+
+    // Escribe el fichero final y borra el temporal
+    bool finish();
+};
+
+bool writeChunkedMesh(const std::string& path, const Mesh& mesh, int cellsPerAxis = 8);
+
+} // namespace app::geometry
@@ -0,0 +1,694 @@
+#include "implicit_mesher.hpp"
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace app::geometry {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Tabla de marching cubes
+//
+// En lugar de copiar la tabla clásica de 256 casos, se genera al arrancar:
+// en cada cara del cubo se unen los cruces que rodean cada región interior,
+// y los segmentos de las 6 caras se encadenan en polígonos cerrados que se
+// triangulan en abanico. Las caras ambiguas se resuelven separando las
+// esquinas interiores; como la decisión depende solo de la cara, dos cubos
+// vecinos siempre coinciden y la malla resultante es cerrada.
+//
+// Esquina i: x = bit 0, y = bit 1, z = bit 2.
+// Arista (eje a, k): une las esquinas con los bits de los otros dos ejes
+// u = (a + 1) % 3 (bit 0 de k) y v = (a + 2) % 3 (bit 1 de k).
+// ---------------------------------------------------------------------------
+
+struct CubeCase {
+    uint8_t count = 0;           // número de índices (3 por triángulo)
+    uint8_t edges[36] = {};
+};
+
+inline int cornerBit(int corner, int axis) {
+    return (corner >> axis) & 1;
+}
+
+inline int edgeAxis(int edge) {
+    return edge / 4;
+}
+
+int edgeCorner(int edge, int end) {
+    const int a = edgeAxis(edge);
+    const int k = edge % 4;
+    const int u = (a + 1) % 3;
+    const int v = (a + 2) % 3;
+
+    return (end << a) | ((k & 1) << u) | (((k >> 1) & 1) << v);
+}
+
+int edgeBetween(int c0, int c1) {
+    const int diff = c0 ^ c1;
+    const int a = (diff == 1) ? 0 : (diff == 2) ? 1 : 2;
+    const int u = (a + 1) % 3;
+    const int v = (a + 2) % 3;
+
+    return a * 4 + cornerBit(c0, u) + 2 * cornerBit(c0, v);
+}
+
+std::array<CubeCase, 256> buildCubeCases() {
+    std::array<CubeCase, 256> cases;
+
+    for (int config = 0; config < 256; config++) {
+        // next[e] = arista a la que lleva el segmento que empieza en e
+        int next[12];
+        std::fill(next, next + 12, -1);
+
+        for (int a = 0; a < 3; a++) {
+            for (int side = 0; side < 2; side++) {
+                const int u = (a + 1) % 3;
+                const int v = (a + 2) % 3;
+
+                // Esquinas de la cara en sentido antihorario vistas desde fuera
+                int corners[4] = {
+                    (side << a),
+                    (side << a) | (1 << u),
+                    (side << a) | (1 << u) | (1 << v),
+                    (side << a) | (1 << v)
+                };
+                if (side == 0) {
+                    std::swap(corners[1], corners[3]);
+                }
+
+                // Cruces en orden a lo largo del borde de la cara; alternan
+                // entre "entrar" (fuera -> dentro) y "salir" (dentro -> fuera)
+                int crossings[4];
+                bool exits[4];
+                int crossingCount = 0;
+
+                for (int i = 0; i < 4; i++) {
+                    const int c0 = corners[i];
+                    const int c1 = corners[(i + 1) % 4];
+                    const bool inside0 = (config >> c0) & 1;
+                    const bool inside1 = (config >> c1) & 1;
+
+                    if (inside0 != inside1) {
+                        crossings[crossingCount] = edgeBetween(c0, c1);
+                        exits[crossingCount] = inside0;
+                        crossingCount++;
+                    }
+                }
+
+                // Cada región interior va de una entrada a la salida siguiente;
+                // el segmento la cierra yendo de la salida a esa entrada.
+                for (int i = 0; i < crossingCount; i++) {
+                    if (exits[i]) {
+                        next[crossings[i]] = crossings[(i + crossingCount - 1) % crossingCount];
+                    }
+                }
+            }
+        }
+
+        CubeCase& cubeCase = cases[config];
+        bool visited[12] = {};
+
+        for (int start = 0; start < 12; start++) {
+            if (next[start] < 0 || visited[start]) {
+                continue;
+            }
+
+            int loop[12];
+            int loopSize = 0;
+
+            for (int e = start; !visited[e]; e = next[e]) {
+                visited[e] = true;
+                loop[loopSize++] = e;
+            }
+
+            for (int i = 1; i + 1 < loopSize; i++) {
+                cubeCase.edges[cubeCase.count++] = static_cast<uint8_t>(loop[0]);
+                cubeCase.edges[cubeCase.count++] = static_cast<uint8_t>(loop[i + 1]);
+                cubeCase.edges[cubeCase.count++] = static_cast<uint8_t>(loop[i]);
+            }
+        }
+    }
+
+    return cases;
+}
+
+const std::array<CubeCase, 256>& cubeCases() {
+    static const std::array<CubeCase, 256> cases = buildCubeCases();
+    return cases;
+}
+
+// ---------------------------------------------------------------------------
+// Bloques y jerarquía de mínimos/máximos
+// ---------------------------------------------------------------------------
+
+struct Range {
+    float min;
+    float max;
+};
+
+struct BlockGrid {
+    glm::ivec3 cells;     // celdas por eje (muestras - 1)
+    glm::ivec3 count;     // bloques por eje
+    int size;             // celdas por lado de bloque
+
+    size_t blockIndex(const glm::ivec3& b) const {
+        return static_cast<size_t>(b.x) +
+            static_cast<size_t>(count.x) * (b.y + static_cast<size_t>(count.y) * b.z);
+    }
+
+    // Bloque propietario de una muestra (las del borde superior van al último)
+    glm::ivec3 blockOfSample(const glm::ivec3& sample) const {
+        return glm::min(sample / size, count - 1);
+    }
+
+    glm::ivec3 cellBegin(const glm::ivec3& b) const {
+        return b * size;
+    }
+
+    glm::ivec3 cellEnd(const glm::ivec3& b) const {
+        return glm::min((b + 1) * size, cells);
+    }
+
+    // Muestras cuyas aristas "salientes" pertenecen al bloque
+    glm::ivec3 ownedSampleEnd(const glm::ivec3& b) const {
+        glm::ivec3 end = (b + 1) * size;
+        for (int k = 0; k < 3; k++) {
+            if (b[k] == count[k] - 1) {
+                end[k] = cells[k] + 1;
+            }
+        }
+        return end;
+    }
+};
+
+// Niveles de la jerarquía: el nivel 0 es un Range por bloque y cada nivel
+// superior agrupa 2x2x2 nodos del anterior.
+struct RangePyramid {
+    std::vector<glm::ivec3> sizes;
+    std::vector<std::vector<Range>> levels;
+};
+
+RangePyramid buildPyramid(const ScalarField& field, const BlockGrid& grid) {
+    RangePyramid pyramid;
+
+    const size_t blockTotal = static_cast<size_t>(grid.count.x) * grid.count.y * grid.count.z;
+
+    pyramid.sizes.push_back(grid.count);
+    pyramid.levels.emplace_back(blockTotal);
+
+    std::vector<Range>& base = pyramid.levels[0];
+
+    core::parallelFor(blockTotal, 8, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            const glm::ivec3 b(
+                static_cast<int>(i % grid.count.x),
+                static_cast<int>((i / grid.count.x) % grid.count.y),
+                static_cast<int>(i / (static_cast<size_t>(grid.count.x) * grid.count.y)));
+
+            // Muestras de todas las celdas del bloque, incluida la última capa
+            const glm::ivec3 from = grid.cellBegin(b);
+            const glm::ivec3 to = grid.cellEnd(b);
+
+            Range range{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+            for (int z = from.z; z <= to.z; z++) {
+                for (int y = from.y; y <= to.y; y++) {
+                    const float* row = &field.values[field.index(from.x, y, z)];
+                    for (int x = 0; x <= to.x - from.x; x++) {
+                        range.min = std::min(range.min, row[x]);
+                        range.max = std::max(range.max, row[x]);
+                    }
+                }
+            }
+
+            base[i] = range;
+        }
+    });
+
+    while (pyramid.sizes.back() != glm::ivec3(1)) {
+        const glm::ivec3 childSize = pyramid.sizes.back();
+        const glm::ivec3 parentSize = (childSize + 1) / 2;
+        const std::vector<Range>& children = pyramid.levels.back();
+
+        std::vector<Range> parents(static_cast<size_t>(parentSize.x) * parentSize.y * parentSize.z);
+
+        for (int z = 0; z < parentSize.z; z++) {
+            for (int y = 0; y < parentSize.y; y++) {
+                for (int x = 0; x < parentSize.x; x++) {
+                    Range range{ std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+                    for (int c = 0; c < 8; c++) {
+                        const glm::ivec3 child(2 * x + (c & 1), 2 * y + ((c >> 1) & 1), 2 * z + ((c >> 2) & 1));
+                        if (glm::any(glm::greaterThanEqual(child, childSize))) {
+                            continue;
+                        }
+
+                        const Range& r = children[child.x + static_cast<size_t>(childSize.x) * (child.y + static_cast<size_t>(childSize.y) * child.z)];
+                        range.min = std::min(range.min, r.min);
+                        range.max = std::max(range.max, r.max);
+                    }
+
+                    parents[x + static_cast<size_t>(parentSize.x) * (y + static_cast<size_t>(parentSize.y) * z)] = range;
+                }
+            }
+        }
+
+        pyramid.sizes.push_back(parentSize);
+        pyramid.levels.push_back(std::move(parents));
+    }
+
+    return pyramid;
+}
+
+// Recorre la jerarquía desde la raíz descartando nodos que no cruzan la isosuperficie
+void collectActiveBlocks(const RangePyramid& pyramid, int level, const glm::ivec3& node,
+    float iso, std::vector<glm::ivec3>& active) {
+
+    const glm::ivec3& size = pyramid.sizes[level];
+    if (glm::any(glm::greaterThanEqual(node, size))) {
+        return;
+    }
+
+    const Range& range = pyramid.levels[level][
+        node.x + static_cast<size_t>(size.x) * (node.y + static_cast<size_t>(size.y) * node.z)];
+
+    if (range.min >= iso || range.max < iso) {
+        return;
+    }
+
+    if (level == 0) {
+        active.push_back(node);
+        return;
+    }
+
+    for (int c = 0; c < 8; c++) {
+        const glm::ivec3 child(2 * node.x + (c & 1), 2 * node.y + ((c >> 1) & 1), 2 * node.z + ((c >> 2) & 1));
+        collectActiveBlocks(pyramid, level - 1, child, iso, active);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Mallado por bloques
+// ---------------------------------------------------------------------------
+
+// Vértices propios de un bloque, ordenados por clave global
+struct BlockVertices {
+    std::vector<uint64_t> keys;
+    std::vector<glm::vec3> positions;
+    uint32_t base = 0;
+};
+
+inline uint64_t sampleKey(const ScalarField& field, const glm::ivec3& s) {
+    return static_cast<uint64_t>(field.index(s.x, s.y, s.z));
+}
+
+inline uint64_t edgeKey(const ScalarField& field, const glm::ivec3& lowerSample, int axis) {
+    return sampleKey(field, lowerSample) * 3 + static_cast<uint64_t>(axis);
+}
+
+inline glm::ivec3 axisOffset(int axis) {
+    glm::ivec3 offset(0);
+    offset[axis] = 1;
+    return offset;
+}
+
+inline bool isInside(float value, float iso) {
+    return value < iso;
+}
+
+glm::vec3 edgeCrossing(const ScalarField& field, const glm::ivec3& s0, int axis, float iso) {
+    const glm::ivec3 s1 = s0 + axisOffset(axis);
+    const float v0 = field.at(s0.x, s0.y, s0.z);
+    const float v1 = field.at(s1.x, s1.y, s1.z);
+
+    const float t = (v1 != v0) ? glm::clamp((iso - v0) / (v1 - v0), 0.0f, 1.0f) : 0.5f;
+
+    return glm::mix(field.position(s0.x, s0.y, s0.z), field.position(s1.x, s1.y, s1.z), t);
+}
+
+// Gradiente por diferencias centrales (laterales en los bordes)
+glm::vec3 gradient(const ScalarField& field, const glm::ivec3& s) {
+    glm::vec3 g;
+    for (int a = 0; a < 3; a++) {
+        glm::ivec3 lo = s, hi = s;
+        lo[a] = std::max(s[a] - 1, 0);
+        hi[a] = std::min(s[a] + 1, field.size[a] - 1);
+
+        g[a] = (field.at(hi.x, hi.y, hi.z) - field.at(lo.x, lo.y, lo.z)) /
+            (static_cast<float>(hi[a] - lo[a]) * field.spacing);
+    }
+    return g;
+}
+
+// Marching cubes: vértices en las aristas con cambio de signo cuya
+// muestra inferior pertenece al bloque
+BlockVertices edgeVertices(const ScalarField& field, const BlockGrid& grid,
+    const glm::ivec3& block, float iso) {
+
+    BlockVertices result;
+
+    const glm::ivec3 from = grid.cellBegin(block);
+    const glm::ivec3 to = grid.ownedSampleEnd(block);
+
+    for (int z = from.z; z < to.z; z++) {
+        for (int y = from.y; y < to.y; y++) {
+            for (int x = from.x; x < to.x; x++) {
+                const glm::ivec3 s(x, y, z);
+                const bool inside = isInside(field.at(x, y, z), iso);
+
+                for (int a = 0; a < 3; a++) {
+                    const glm::ivec3 other = s + axisOffset(a);
+                    if (other[a] >= field.size[a]) {
+                        continue;
+                    }
+
+                    if (isInside(field.at(other.x, other.y, other.z), iso) != inside) {
+                        result.keys.push_back(edgeKey(field, s, a));
+                        result.positions.push_back(edgeCrossing(field, s, a, iso));
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// Resuelve el QEF de dual contouring con regularización hacia el centro de masas
+glm::vec3 solveQEF(const glm::vec3* points, const glm::vec3* normals, int count,
+    const glm::vec3& cellMin, const glm::vec3& cellMax) {
+
+    glm::vec3 massPoint(0.0f);
+    for (int i = 0; i < count; i++) {
+        massPoint += points[i];
+    }
+    massPoint /= static_cast<float>(count);
+
+    // Minimiza suma (n_i . (x - p_i))^2 + lambda |x - c|^2
+    const float lambda = 0.05f;
+    glm::mat3 ata(lambda);
+    glm::vec3 atb(0.0f);
+
+    for (int i = 0; i < count; i++) {
+        const glm::vec3& n = normals[i];
+        ata += glm::outerProduct(n, n);
+        atb += n * glm::dot(n, points[i] - massPoint);
+    }
+
+    const glm::vec3 solution = massPoint + glm::inverse(ata) * atb;
+
+    return glm::clamp(solution, cellMin, cellMax);
+}
+
+// Dual contouring: un vértice por celda con cambio de signo
+BlockVertices cellVertices(const ScalarField& field, const BlockGrid& grid,
+    const glm::ivec3& block, float iso) {
+
+    BlockVertices result;
+
+    const glm::ivec3 from = grid.cellBegin(block);
+    const glm::ivec3 to = grid.cellEnd(block);
+
+    for (int z = from.z; z < to.z; z++) {
+        for (int y = from.y; y < to.y; y++) {
+            for (int x = from.x; x < to.x; x++) {
+                const glm::ivec3 cell(x, y, z);
+
+                int config = 0;
+                for (int c = 0; c < 8; c++) {
+                    const glm::ivec3 s = cell + glm::ivec3(c & 1, (c >> 1) & 1, (c >> 2) & 1);
+                    if (isInside(field.at(s.x, s.y, s.z), iso)) {
+                        config |= 1 << c;
+                    }
+                }
+
+                if (config == 0 || config == 255) {
+                    continue;
+                }
+
+                glm::vec3 points[12];
+                glm::vec3 normals[12];
+                int count = 0;
+
+                for (int e = 0; e < 12; e++) {
+                    const int c0 = edgeCorner(e, 0);
+                    const int c1 = edgeCorner(e, 1);
+
+                    if (((config >> c0) & 1) == ((config >> c1) & 1)) {
+                        continue;
+                    }
+
+                    const glm::ivec3 s0 = cell + glm::ivec3(c0 & 1, (c0 >> 1) & 1, (c0 >> 2) & 1);
+                    const glm::ivec3 s1 = cell + glm::ivec3(c1 & 1, (c1 >> 1) & 1, (c1 >> 2) & 1);
+                    const float v0 = field.at(s0.x, s0.y, s0.z);
+                    const float v1 = field.at(s1.x, s1.y, s1.z);
+                    const float t = (v1 != v0) ? glm::clamp((iso - v0) / (v1 - v0), 0.0f, 1.0f) : 0.5f;
+
+                    points[count] = edgeCrossing(field, s0, edgeAxis(e), iso);
+
+                    const glm::vec3 n = glm::mix(gradient(field, s0), gradient(field, s1), t);
+                    const float length = glm::length(n);
+                    normals[count] = (length > 0.0f) ? n / length : glm::vec3(0.0f);
+                    count++;
+                }
+
+                result.keys.push_back(sampleKey(field, cell));
+                result.positions.push_back(solveQEF(
+                    points, normals, count,
+                    field.position(x, y, z),
+                    field.position(x + 1, y + 1, z + 1)));
+            }
+        }
+    }
+
+    return result;
+}
+
+// Traduce una clave global al índice final del vértice buscando en el
+// bloque propietario (solo lectura, sin bloqueos)
+struct VertexLookup {
+    const BlockGrid& grid;
+    const std::vector<int>& slotOfBlock;
+    const std::vector<BlockVertices>& blocks;
+
+    uint32_t find(const glm::ivec3& ownerBlock, uint64_t key) const {
+        const int slot = slotOfBlock[grid.blockIndex(ownerBlock)];
+        const BlockVertices& owner = blocks[slot];
+
+        const auto it = std::lower_bound(owner.keys.begin(), owner.keys.end(), key);
+        return owner.base + static_cast<uint32_t>(it - owner.keys.begin());
+    }
+};
+
+void marchingCubesTriangles(const ScalarField& field, const BlockGrid& grid,
+    const glm::ivec3& block, float iso, const VertexLookup& lookup, std::vector<uint32_t>& indices) {
+
+    const std::array<CubeCase, 256>& cases = cubeCases();
+
+    const glm::ivec3 from = grid.cellBegin(block);
+    const glm::ivec3 to = grid.cellEnd(block);
+
+    for (int z = from.z; z < to.z; z++) {
+        for (int y = from.y; y < to.y; y++) {
+            for (int x = from.x; x < to.x; x++) {
+                const glm::ivec3 cell(x, y, z);
+
+                int config = 0;
+                for (int c = 0; c < 8; c++) {
+                    const glm::ivec3 s = cell + glm::ivec3(c & 1, (c >> 1) & 1, (c >> 2) & 1);
+                    if (isInside(field.at(s.x, s.y, s.z), iso)) {
+                        config |= 1 << c;
+                    }
+                }
+
+                const CubeCase& cubeCase = cases[config];
+
+                for (int i = 0; i < cubeCase.count; i++) {
+                    const int e = cubeCase.edges[i];
+                    const int c0 = edgeCorner(e, 0);
+                    const glm::ivec3 lower = cell + glm::ivec3(c0 & 1, (c0 >> 1) & 1, (c0 >> 2) & 1);
+
+                    indices.push_back(lookup.find(
+                        grid.blockOfSample(lower),
+                        edgeKey(field, lower, edgeAxis(e))));
+                }
+            }
+        }
+    }
+}
+
+void dualContouringQuads(const ScalarField& field, const BlockGrid& grid,
+    const glm::ivec3& block, float iso, const VertexLookup& lookup, std::vector<uint32_t>& indices) {
+
+    const glm::ivec3 from = grid.cellBegin(block);
+    const glm::ivec3 to = grid.ownedSampleEnd(block);
+
+    for (int z = from.z; z < to.z; z++) {
+        for (int y = from.y; y < to.y; y++) {
+            for (int x = from.x; x < to.x; x++) {
+                const glm::ivec3 s(x, y, z);
+                const bool inside = isInside(field.at(x, y, z), iso);
+
+                for (int a = 0; a < 3; a++) {
+                    const int u = (a + 1) % 3;
+                    const int v = (a + 2) % 3;
+                    const glm::ivec3 other = s + axisOffset(a);
+
+                    // Las aristas del borde de la rejilla no tienen las 4 celdas
+                    if (other[a] >= field.size[a] || s[u] == 0 || s[v] == 0 ||
+                        s[u] >= field.size[u] - 1 || s[v] >= field.size[v] - 1) {
+                        continue;
+                    }
+
+                    if (isInside(field.at(other.x, other.y, other.z), iso) == inside) {
+                        continue;
+                    }
+
+                    // Las 4 celdas alrededor de la arista, en sentido antihorario respecto al eje
+                    const glm::ivec3 du = axisOffset(u);
+                    const glm::ivec3 dv = axisOffset(v);
+                    const glm::ivec3 cells[4] = { s - du - dv, s - dv, s, s - du };
+
+                    uint32_t quad[4];
+                    for (int k = 0; k < 4; k++) {
+                        quad[k] = lookup.find(grid.blockOfSample(cells[k]), sampleKey(field, cells[k]));
+                    }
+
+                    // La normal apunta de dentro a fuera
+                    if (inside) {
+                        indices.insert(indices.end(), { quad[0], quad[1], quad[2], quad[0], quad[2], quad[3] });
+                    } else {
+                        indices.insert(indices.end(), { quad[0], quad[2], quad[1], quad[0], quad[3], quad[2] });
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+size_t ScalarField::index(int x, int y, int z) const {
+    return static_cast<size_t>(x) +
+        static_cast<size_t>(size.x) * (static_cast<size_t>(y) + static_cast<size_t>(size.y) * z);
+}
+
+float ScalarField::at(int x, int y, int z) const {
+    return values[index(x, y, z)];
+}
+
+glm::vec3 ScalarField::position(int x, int y, int z) const {
+    return origin + glm::vec3(x, y, z) * spacing;
+}
+
+ScalarField sampleField(
+    const std::function<float(const glm::vec3&)>& function,
+    const glm::ivec3& size,
+    const glm::vec3& origin,
+    float spacing) {
+
+    ScalarField field;
+    field.size = size;
+    field.origin = origin;
+    field.spacing = spacing;
+    field.values.resize(static_cast<size_t>(size.x) * size.y * size.z);
+
+    // Un plano z por iteración
+    core::parallelFor(static_cast<size_t>(size.z), 1, [&](size_t begin, size_t end, size_t) {
+        for (int z = static_cast<int>(begin); z < static_cast<int>(end); z++) {
+            for (int y = 0; y < size.y; y++) {
+                for (int x = 0; x < size.x; x++) {
+                    field.values[field.index(x, y, z)] = function(field.position(x, y, z));
+                }
+            }
+        }
+    });
+
+    return field;
+}
+
+Mesh meshImplicitSurface(const ScalarField& field, const MesherSettings& settings) {
+    if (glm::any(glm::lessThan(field.size, glm::ivec3(2)))) {
+        return Mesh({}, {});
+    }
+
+    BlockGrid grid;
+    grid.size = std::max(settings.blockSize, 1);
+    grid.cells = field.size - 1;
+    grid.count = (grid.cells + grid.size - 1) / grid.size;
+
+    const float iso = settings.isoValue;
+
+    // 1. Jerarquía de mínimos/máximos y bloques que cruzan la isosuperficie
+    const RangePyramid pyramid = buildPyramid(field, grid);
+
+    std::vector<glm::ivec3> activeBlocks;
+    collectActiveBlocks(pyramid, static_cast<int>(pyramid.levels.size()) - 1, glm::ivec3(0), iso, activeBlocks);
+
+    std::vector<int> slotOfBlock(static_cast<size_t>(grid.count.x) * grid.count.y * grid.count.z, -1);
+    for (size_t i = 0; i < activeBlocks.size(); i++) {
+        slotOfBlock[grid.blockIndex(activeBlocks[i])] = static_cast<int>(i);
+    }
+
+    // 2. Cada bloque calcula los vértices de los que es propietario
+    std::vector<BlockVertices> blocks(activeBlocks.size());
+    const bool dual = settings.mode == MesherMode::DualContouring;
+
+    core::parallelFor(activeBlocks.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            blocks[i] = dual
+                ? cellVertices(field, grid, activeBlocks[i], iso)
+                : edgeVertices(field, grid, activeBlocks[i], iso);
+        }
+    });
+
+    // 3. Suma prefija: índice global del primer vértice de cada bloque
+    uint32_t vertexCount = 0;
+    for (BlockVertices& block : blocks) {
+        block.base = vertexCount;
+        vertexCount += static_cast<uint32_t>(block.keys.size());
+    }
+
+    // 4. Triángulos por bloque; los vértices de bloques vecinos se buscan
+    // en su bloque propietario, que ya no cambia
+    const VertexLookup lookup{ grid, slotOfBlock, blocks };
+    std::vector<std::vector<uint32_t>> blockIndices(activeBlocks.size());
+
+    core::parallelFor(activeBlocks.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            if (dual) {
+                dualContouringQuads(field, grid, activeBlocks[i], iso, lookup, blockIndices[i]);
+            } else {
+                marchingCubesTriangles(field, grid, activeBlocks[i], iso, lookup, blockIndices[i]);
+            }
+        }
+    });
+
+    // 5. Concatenación
+    std::vector<Vertex> vertices(vertexCount);
+    for (const BlockVertices& block : blocks) {
+        for (size_t i = 0; i < block.positions.size(); i++) {
+            vertices[block.base + i] = Vertex(block.positions[i], settings.color);
+        }
+    }
+
+    size_t indexCount = 0;
+    for (const std::vector<uint32_t>& part : blockIndices) {
+        indexCount += part.size();
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(indexCount);
+    for (const std::vector<uint32_t>& part : blockIndices) {
+        indices.insert(indices.end(), part.begin(), part.end());
+    }
+
+    return Mesh(vertices, indices);
+}
+
+} // namespace app::geometry
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.hpp"
+
+// Mallado de superficies implícitas (campos de distancia con signo o de densidad).
+//
+// El campo se recorre por bloques de celdas en paralelo. Una jerarquía de
+// mínimos/máximos por bloque permite saltarse regiones enteras que no cruzan
+// la isosuperficie. Los vértices compartidos entre bloques tienen un único
+// bloque propietario, así que las costuras se cosen sin bloqueos globales.
+
+namespace app::geometry {
+
+// Campo escalar muestreado en una rejilla regular.
+// Convención: valores menores que la isosuperficie están "dentro".
+struct ScalarField {
+    glm::ivec3 size{ 0 };          // número de muestras por eje
+    glm::vec3 origin{ 0.0f };      // posición de la muestra (0, 0, 0)
+    float spacing = 1.0f;          // distancia entre muestras
+    std::vector<float> values;     // x es el índice que varía más rápido
+
+    size_t index(int x, int y, int z) const;
+    float at(int x, int y, int z) const;
+    glm::vec3 position(int x, int y, int z) const;
+};
+
+// Muestrea una función en paralelo sobre la rejilla
+ScalarField sampleField(
+    const std::function<float(const glm::vec3&)>& function,
+    const glm::ivec3& size,
+    const glm::vec3& origin,
+    float spacing
+);
+
+enum class MesherMode {
+    MarchingCubes,
+    DualContouring
+};
+
+struct MesherSettings {
+    MesherMode mode = MesherMode::MarchingCubes;
+    float isoValue = 0.0f;
+    int blockSize = 16;                 // celdas por lado de cada bloque
+    glm::vec3 color{ 1.0f, 1.0f, 1.0f };
+};
+
+Mesh meshImplicitSurface(const ScalarField& field, const MesherSettings& settings = {});
+
+} // namespace app::geometry
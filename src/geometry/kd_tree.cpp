@@ -0,0 +1,249 @@
+#include "kd_tree.hpp"
+#include "core/parallel.hpp"
+
+#include <algorithm>
+
+namespace app::geometry {
+
+namespace {
+
+// Rango pendiente en las búsquedas de vecinos. 'offsets' es la distancia
+// por eje de la consulta a la celda del rango (0 si está dentro en ese eje)
+// y 'minDistanceSquared' la suma de sus cuadrados: una cota inferior de la
+// distancia a cualquiera de sus puntos (Arya y Mount)
+struct PendingRange {
+    size_t begin;
+    size_t end;
+    glm::vec3 offsets;
+    float minDistanceSquared;
+};
+
+// Al bajar un nivel, el hijo del lado de la consulta hereda la cota del
+// padre y el del otro lado la aumenta con la distancia al plano de corte
+void splitRange(const PendingRange& range, size_t middle, int axis, float offset, PendingRange& nearSide, PendingRange& farSide) {
+    const bool left = offset <= 0.0f;
+
+    nearSide = range;
+    farSide = range;
+    if (left) {
+        nearSide.end = middle;
+        farSide.begin = middle + 1;
+    } else {
+        nearSide.begin = middle + 1;
+        farSide.end = middle;
+    }
+
+    farSide.offsets[axis] = offset;
+    farSide.minDistanceSquared += offset * offset - range.offsets[axis] * range.offsets[axis];
+}
+
+// Por debajo no compensa lanzar hilos para construir
+constexpr size_t minParallelBuild = 1 << 16;
+
+} // namespace
+
+KdTree::KdTree(const glm::vec3* positions, size_t count, size_t stride) {
+    mPoints.resize(count);
+    mSplitAxis.resize(count);
+
+    const char* bytes = reinterpret_cast<const char*>(positions);
+    for (size_t i = 0; i < count; i++) {
+        mPoints[i].position = *reinterpret_cast<const glm::vec3*>(bytes + i * stride);
+        mPoints[i].index = static_cast<uint32_t>(i);
+    }
+
+    if (count < minParallelBuild) {
+        build(0, count, 0, nullptr);
+        return;
+    }
+
+    // Los primeros niveles en serie hasta tener un subárbol por hilo (o
+    // algunos más, para repartir mejor) y el resto en paralelo: cada
+    // subárbol es un rango independiente del array
+    std::vector<std::pair<size_t, size_t>> subtrees;
+    build(0, count, 0, &subtrees);
+
+    core::parallelFor(subtrees.size(), 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            build(subtrees[i].first, subtrees[i].second, 0, nullptr);
+        }
+    });
+}
+
+KdTree::KdTree(const Mesh& mesh)
+    : KdTree(
+        mesh.vertices.empty() ? nullptr : &mesh.vertices[0].position,
+        mesh.vertices.size(),
+        sizeof(Vertex)) {
+}
+
+void KdTree::build(size_t begin, size_t end, int depth, std::vector<std::pair<size_t, size_t>>* subtrees) {
+    while (end - begin > kLeafSize) {
+        if (subtrees != nullptr && (size_t(1) << depth) >= 4 * core::workerCount()) {
+            subtrees->emplace_back(begin, end);
+            return;
+        }
+
+        // Eje de mayor extensión del rango
+        glm::vec3 min = mPoints[begin].position;
+        glm::vec3 max = mPoints[begin].position;
+        for (size_t i = begin + 1; i < end; i++) {
+            min = glm::min(min, mPoints[i].position);
+            max = glm::max(max, mPoints[i].position);
+        }
+        const glm::vec3 extent = max - min;
+        const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+        const size_t middle = begin + (end - begin) / 2;
+        std::nth_element(
+            mPoints.begin() + begin,
+            mPoints.begin() + middle,
+            mPoints.begin() + end,
+            [axis](const KdPoint& a, const KdPoint& b) {
+                return a.position[axis] < b.position[axis];
+            });
+
+        mSplitAxis[middle] = static_cast<uint8_t>(axis);
+
+        // Recursión en el izquierdo y bucle en el derecho
+        build(begin, middle, depth + 1, subtrees);
+        begin = middle + 1;
+        depth++;
+    }
+}
+
+bool KdTree::empty() const {
+    return mPoints.empty();
+}
+
+size_t KdTree::size() const {
+    return mPoints.size();
+}
+
+uint32_t KdTree::nearest(const glm::vec3& point, float maxDistance, float* distanceSquared) const {
+    float best = maxDistance * maxDistance;
+    uint32_t bestIndex = npos;
+
+    auto visit = [&](size_t i) {
+        const glm::vec3 d = mPoints[i].position - point;
+        const float distance = glm::dot(d, d);
+        if (distance < best) {
+            best = distance;
+            bestIndex = mPoints[i].index;
+        }
+    };
+
+    PendingRange stack[64];
+    int top = 0;
+    if (!mPoints.empty()) {
+        stack[top++] = { 0, mPoints.size(), glm::vec3(0.0f), 0.0f };
+    }
+
+    while (top > 0) {
+        const PendingRange range = stack[--top];
+        if (range.minDistanceSquared >= best) {
+            continue;
+        }
+
+        if (range.end - range.begin <= kLeafSize) {
+            for (size_t i = range.begin; i < range.end; i++) {
+                visit(i);
+            }
+            continue;
+        }
+
+        const size_t middle = range.begin + (range.end - range.begin) / 2;
+        const int axis = mSplitAxis[middle];
+        const float offset = point[axis] - mPoints[middle].position[axis];
+
+        visit(middle);
+
+        // El lado de la consulta se apila el último para visitarlo antes
+        PendingRange nearSide;
+        PendingRange farSide;
+        splitRange(range, middle, axis, offset, nearSide, farSide);
+
+        stack[top++] = farSide;
+        stack[top++] = nearSide;
+    }
+
+    if (distanceSquared != nullptr && bestIndex != npos) {
+        *distanceSquared = best;
+    }
+    return bestIndex;
+}
+
+void KdTree::kNearest(const glm::vec3& point, size_t k, std::vector<KdNeighbor>& result, float maxDistance) const {
+    result.clear();
+    if (k == 0) {
+        return;
+    }
+
+    // Montículo de máximos: en la cima el más lejano de los k actuales
+    auto farther = [](const KdNeighbor& a, const KdNeighbor& b) {
+        return a.distanceSquared < b.distanceSquared;
+    };
+    const float limit = maxDistance * maxDistance;
+    auto bound = [&]() {
+        return result.size() < k ? limit : result.front().distanceSquared;
+    };
+
+    auto visit = [&](size_t i) {
+        const glm::vec3 d = mPoints[i].position - point;
+        const float distance = glm::dot(d, d);
+        if (distance >= bound()) {
+            return;
+        }
+
+        if (result.size() == k) {
+            std::pop_heap(result.begin(), result.end(), farther);
+            result.pop_back();
+        }
+        result.push_back({ mPoints[i].index, distance });
+        std::push_heap(result.begin(), result.end(), farther);
+    };
+
+    PendingRange stack[64];
+    int top = 0;
+    if (!mPoints.empty()) {
+        stack[top++] = { 0, mPoints.size(), glm::vec3(0.0f), 0.0f };
+    }
+
+    while (top > 0) {
+        const PendingRange range = stack[--top];
+        if (range.minDistanceSquared >= bound()) {
+            continue;
+        }
+
+        if (range.end - range.begin <= kLeafSize) {
+            for (size_t i = range.begin; i < range.end; i++) {
+                visit(i);
+            }
+            continue;
+        }
+
+        const size_t middle = range.begin + (range.end - range.begin) / 2;
+        const int axis = mSplitAxis[middle];
+        const float offset = point[axis] - mPoints[middle].position[axis];
+
+        visit(middle);
+
+        PendingRange nearSide;
+        PendingRange farSide;
+        splitRange(range, middle, axis, offset, nearSide, farSide);
+
+        stack[top++] = farSide;
+        stack[top++] = nearSide;
+    }
+
+    std::sort_heap(result.begin(), result.end(), farther);
+}
+
+void KdTree::queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const {
+    result.clear();
+    queryRadius(center, radius, [&](uint32_t index, float) {
+        result.push_back(index);
+    });
+}
+
+} // namespace app::geometry
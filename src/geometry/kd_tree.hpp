@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.hpp"
+
+// Árbol kd estático sobre una nube de puntos (los vértices de una malla),
+// para buscar el vecino más cercano, los k más cercanos o todos los puntos
+// dentro de un radio.
+//
+// No hay nodos: los puntos se reordenan de forma que cada rango [begin, end)
+// tiene su mediana en el centro, con los menores a la izquierda y los
+// mayores a la derecha en el eje de corte. El árbol es implícito en esa
+// ordenación y solo se guarda el eje de corte de cada mediana (1 byte).
+
+namespace app::geometry {
+
+struct KdPoint {
+    glm::vec3 position;
+    uint32_t index;                // índice del punto en el array original
+};
+
+struct KdNeighbor {
+    uint32_t index = 0;            // índice del punto en el array original
+    float distanceSquared = 0.0f;
+};
+
+class KdTree {
+private:
+    std::vector<KdPoint> mPoints;       // en orden del árbol
+    std::vector<uint8_t> mSplitAxis;    // eje de corte de cada mediana
+
+    void build(size_t begin, size_t end, int depth, std::vector<std::pair<size_t, size_t>>* subtrees);
+
+public:
+    // Los rangos con menos puntos se recorren enteros
+    static constexpr size_t kLeafSize = 8;
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    KdTree() = default;
+
+    // 'stride' en bytes, como en math::calculateBoundingBox
+    KdTree(const glm::vec3* positions, size_t count, size_t stride = sizeof(glm::vec3));
+    explicit KdTree(const Mesh& mesh);
+
+    bool empty() const;
+    size_t size() const;
+
+    // Índice del punto más cercano a una distancia menor que 'maxDistance',
+    // o npos si no hay ninguno
+    uint32_t nearest(
+        const glm::vec3& point,
+        float maxDistance = std::numeric_limits<float>::infinity(),
+        float* distanceSquared = nullptr
+    ) const;
+
+    // Los k puntos más cercanos (como mucho), ordenados de cerca a lejos
+    void kNearest(
+        const glm::vec3& point,
+        size_t k,
+        std::vector<KdNeighbor>& result,
+        float maxDistance = std::numeric_limits<float>::infinity()
+    ) const;
+
+    // Llama a fn(índice, distancia²) para cada punto a distancia <= radius,
+    // sin orden
+    template <typename Fn>
+    void queryRadius(const glm::vec3& center, float radius, Fn&& fn) const;
+
+    void queryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& result) const;
+};
+
+template <typename Fn>
+void KdTree::queryRadius(const glm::vec3& center, float radius, Fn&& fn) const {
+    struct Range {
+        size_t begin;
+        size_t end;
+    };
+
+    const float radiusSquared = radius * radius;
+
+    // El árbol está equilibrado: la profundidad es log2(n / kLeafSize)
+    Range stack[64];
+    int top = 0;
+    if (!mPoints.empty()) {
+        stack[top++] = { 0, mPoints.size() };
+    }
+
+    while (top > 0) {
+        const Range range = stack[--top];
+
+        if (range.end - range.begin <= kLeafSize) {
+            for (size_t i = range.begin; i < range.end; i++) {
+                const glm::vec3 d = mPoints[i].position - center;
+                const float distance = glm::dot(d, d);
+                if (distance <= radiusSquared) {
+                    fn(mPoints[i].index, distance);
+                }
+            }
+            continue;
+        }
+
+        const size_t middle = range.begin + (range.end - range.begin) / 2;
+        const int axis = mSplitAxis[middle];
+        const float offset = center[axis] - mPoints[middle].position[axis];
+
+        const glm::vec3 d = mPoints[middle].position - center;
+        const float distance = glm::dot(d, d);
+        if (distance <= radiusSquared) {
+            fn(mPoints[middle].index, distance);
+        }
+
+        if (offset <= radius) {
+            stack[top++] = { range.begin, middle };
+        }
+        if (offset >= -radius) {
+            stack[top++] = { middle + 1, range.end };
+        }
+    }
+}
+
+} // namespace app::geometry
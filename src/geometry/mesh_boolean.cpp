@@ -0,0 +1,1280 @@
+#include "mesh_boolean.hpp"
+#include "bvh.hpp"
+#include "core/parallel.hpp"
+#include "math/predicates.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+
+namespace app::geometry {
+
+namespace {
+
+// Malla en espacio de mundo con su BVH
+struct Solid {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> colors;
+    std::vector<uint32_t> indices;
+    Bvh bvh;
+
+    size_t triangleCount() const {
+        return indices.size() / 3;
+    }
+
+    const glm::vec3& corner(size_t triangle, int k) const {
+        return positions[indices[3 * triangle + k]];
+    }
+};
+
+Solid makeSolid(const Mesh& mesh, const glm::mat4& model) {
+    Solid solid;
+    solid.positions.resize(mesh.vertices.size());
+    solid.colors.resize(mesh.vertices.size());
+    solid.indices.assign(mesh.indices.begin(), mesh.indices.begin() + mesh.indices.size() / 3 * 3);
+
+    core::parallelFor(mesh.vertices.size(), 1 << 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            solid.positions[i] = glm::vec3(model * glm::vec4(mesh.vertices[i].position, 1.0f));
+            solid.colors[i] = mesh.vertices[i].color;
+        }
+    });
+
+    solid.bvh = Bvh::fromTriangles(solid.positions, solid.indices);
+    return solid;
+}
+
+// Orden lexicográfico de posiciones: para que los cálculos que dependen de
+// qué extremo de una arista va primero den lo mismo en los dos triángulos
+// que la comparten
+bool lessPosition(const glm::vec3& a, const glm::vec3& b) {
+    if (a.x != b.x) {
+        return a.x < b.x;
+    }
+    if (a.y != b.y) {
+        return a.y < b.y;
+    }
+    return a.z < b.z;
+}
+
+// ---------------------------------------------------------------------------
+// Intersección triángulo-triángulo
+// ---------------------------------------------------------------------------
+
+// Dónde cae un punto de corte dentro de un triángulo: en su interior o sobre
+// la arista k (de la esquina k a la k + 1)
+constexpr int8_t kInterior = -1;
+constexpr int8_t kOnEdge = 0;
+
+struct CutPoint {
+    glm::vec3 position;
+    int8_t location[2];     // en el triángulo de A y en el de B
+};
+
+// Corte entre el triángulo triangle[0] de A y el triangle[1] de B
+struct CutSegment {
+    uint32_t triangle[2];
+    CutPoint ends[2];
+};
+
+// Los extremos del segmento de corte son los puntos en los que una arista
+// de un triángulo atraviesa el otro. Cada uno depende solo de la arista y
+// del triángulo atravesado, así que todos los triángulos que comparten la
+// arista deciden lo mismo y lo calculan con los mismos bits.
+//
+// Las decisiones son signos exactos de orient3d. Un cero (un vértice sobre
+// el plano del otro triángulo, dos aristas que se cortan) se desempata como
+// si la geometría estuviera ligeramente desplazada, siempre en el mismo
+// sentido para los mismos puntos, para que las aristas vecinas no reclamen
+// las dos (o ninguna) el mismo cruce.
+
+// Lado del plano de 'triangle' en el que está 'point'; nunca 0
+int sideOfPlane(const glm::vec3 triangle[3], const glm::vec3& point) {
+    return math::orient3d(triangle[0], triangle[1], triangle[2], point) >= 0 ? 1 : -1;
+}
+
+// Signo de orient3d(a, b, c, d) para las aristas ab y cd; nunca 0. El
+// desempate cambia de signo al dar la vuelta a una arista, igual que el
+// determinante, y no depende de cuál de las dos se pase primero
+int edgeOrientation(glm::vec3 a, glm::vec3 b, glm::vec3 c, glm::vec3 d) {
+    const int sign = math::orient3d(a, b, c, d);
+    if (sign != 0) {
+        return sign;
+    }
+
+    int parity = 1;
+    if (lessPosition(b, a)) {
+        std::swap(a, b);
+        parity = -parity;
+    }
+    if (lessPosition(d, c)) {
+        std::swap(c, d);
+        parity = -parity;
+    }
+    return lessPosition(a, c) ? parity : -parity;
+}
+
+// Si la arista (from, to) atraviesa 'triangle' y dónde. El punto se calcula
+// siempre desde el extremo menor de la arista
+bool edgeCrossesTriangle(const glm::vec3& from, const glm::vec3& to, const glm::vec3 triangle[3], glm::vec3& point) {
+    if (sideOfPlane(triangle, from) == sideOfPlane(triangle, to)) {
+        return false;
+    }
+
+    const glm::vec3& e0 = lessPosition(from, to) ? from : to;
+    const glm::vec3& e1 = lessPosition(from, to) ? to : from;
+
+    const int s0 = edgeOrientation(e0, e1, triangle[0], triangle[1]);
+    const int s1 = edgeOrientation(e0, e1, triangle[1], triangle[2]);
+    const int s2 = edgeOrientation(e0, e1, triangle[2], triangle[0]);
+    if (s0 != s1 || s1 != s2) {
+        return false;
+    }
+
+    const glm::dvec3 origin(triangle[0]);
+    const glm::dvec3 normal = glm::cross(glm::dvec3(triangle[1]) - origin, glm::dvec3(triangle[2]) - origin);
+
+    const double d0 = glm::dot(normal, glm::dvec3(e0) - origin);
+    const double d1 = glm::dot(normal, glm::dvec3(e1) - origin);
+    const double t = (d0 != d1) ? glm::clamp(d0 / (d0 - d1), 0.0, 1.0) : 0.5;
+
+    point = glm::vec3(glm::mix(glm::dvec3(e0), glm::dvec3(e1), t));
+    return true;
+}
+
+// Segmento común a los dos triángulos: las aristas de cada uno que
+// atraviesan el otro. Los contactos sin cruce (coplanares, en un solo
+// punto) no generan segmento
+bool intersectTriangles(const glm::vec3 p[3], const glm::vec3 q[3], CutPoint& from, CutPoint& to) {
+    int sidesP[3], sidesQ[3];
+    for (int i = 0; i < 3; i++) {
+        sidesP[i] = sideOfPlane(q, p[i]);
+        sidesQ[i] = sideOfPlane(p, q[i]);
+    }
+    if ((sidesP[0] == sidesP[1] && sidesP[1] == sidesP[2]) ||
+        (sidesQ[0] == sidesQ[1] && sidesQ[1] == sidesQ[2])) {
+        return false;
+    }
+
+    CutPoint ends[4];
+    int count = 0;
+
+    for (int k = 0; k < 3; k++) {
+        glm::vec3 point;
+        if (count < 4 && edgeCrossesTriangle(p[k], p[(k + 1) % 3], q, point)) {
+            ends[count++] = { point, { static_cast<int8_t>(kOnEdge + k), kInterior } };
+        }
+        if (count < 4 && edgeCrossesTriangle(q[k], q[(k + 1) % 3], p, point)) {
+            ends[count++] = { point, { kInterior, static_cast<int8_t>(kOnEdge + k) } };
+        }
+    }
+
+    if (count != 2) {
+        return false;
+    }
+
+    from = ends[0];
+    to = ends[1];
+    return true;
+}
+
+// Junta los puntos de corte que están a unos pocos ulp unos de otros. Salen
+// de aristas casi iguales (triángulos muy estrechos, a menudo de una
+// booleana anterior) o de cortes que pasan rozando un vértice, y con el
+// redondeo dos segmentos seguidos de la costura pueden llegar a cruzarse.
+// Todos pasan a la misma posición, así que los triángulos que los comparten
+// siguen viendo el mismo punto. Las esquinas de los triángulos cortados
+// también entran, pero no se mueven: un grupo con una esquina va a parar
+// exactamente a ella, y no a un punto que se sale de sus aristas
+void snapCutPoints(std::vector<CutSegment>& segments, const Solid& a, const Solid& b, float tolerance) {
+    std::vector<glm::vec3> positions;
+    positions.reserve(8 * segments.size());
+
+    for (const CutSegment& segment : segments) {
+        for (int k = 0; k < 3; k++) {
+            positions.push_back(a.corner(segment.triangle[0], k));
+            positions.push_back(b.corner(segment.triangle[1], k));
+        }
+    }
+    const size_t cornerCount = positions.size();
+
+    for (const CutSegment& segment : segments) {
+        positions.push_back(segment.ends[0].position);
+        positions.push_back(segment.ends[1].position);
+    }
+
+    // Rejilla de celdas del tamaño de la tolerancia: cada punto solo se
+    // compara con los de su celda y las 26 vecinas. Las coordenadas no
+    // pasan de 2^19 celdas, así que caben 21 bits por eje
+    auto cellOf = [&](const glm::vec3& position) {
+        return glm::ivec3(glm::floor(position / tolerance));
+    };
+    auto keyOf = [](const glm::ivec3& cell) {
+        const glm::ivec3 biased = cell + glm::ivec3(1 << 20);
+        return (uint64_t(biased.x) << 42) | (uint64_t(biased.y) << 21) | uint64_t(biased.z);
+    };
+
+    std::vector<std::pair<uint64_t, uint32_t>> cells(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        cells[i] = { keyOf(cellOf(positions[i])), static_cast<uint32_t>(i) };
+    }
+    std::sort(cells.begin(), cells.end());
+
+    std::vector<uint32_t> parent(positions.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    auto find = [&](uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (size_t i = cornerCount; i < positions.size(); i++) {
+        const glm::ivec3 cell = cellOf(positions[i]);
+
+        for (int dx = -1; dx <= 1; dx++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dz = -1; dz <= 1; dz++) {
+                    const uint64_t key = keyOf(cell + glm::ivec3(dx, dy, dz));
+                    auto it = std::lower_bound(cells.begin(), cells.end(), std::make_pair(key, uint32_t(0)));
+
+                    for (; it != cells.end() && it->first == key; ++it) {
+                        const glm::vec3 difference = glm::abs(positions[i] - positions[it->second]);
+                        if (difference.x > tolerance || difference.y > tolerance || difference.z > tolerance) {
+                            continue;
+                        }
+
+                        const uint32_t ra = find(static_cast<uint32_t>(i));
+                        const uint32_t rb = find(it->second);
+                        if (ra != rb) {
+                            parent[std::max(ra, rb)] = std::min(ra, rb);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // El representante de cada grupo es el de menor índice: una esquina si
+    // la hay
+    for (size_t i = 0; i < segments.size(); i++) {
+        for (int end = 0; end < 2; end++) {
+            const uint32_t index = static_cast<uint32_t>(cornerCount + 2 * i + end);
+            segments[i].ends[end].position = positions[find(index)];
+        }
+    }
+}
+
+std::vector<CutSegment> findCutSegments(const Solid& a, const Solid& b) {
+    const size_t count = a.triangleCount();
+
+    std::vector<std::vector<CutSegment>> partial(core::chunkCount(count, 1024));
+
+    core::parallelFor(count, 1024, [&](size_t begin, size_t end, size_t chunk) {
+        std::vector<CutSegment>& segments = partial[chunk];
+
+        for (size_t t = begin; t < end; t++) {
+            const glm::vec3 p[3] = { a.corner(t, 0), a.corner(t, 1), a.corner(t, 2) };
+
+            math::AABB box;
+            box.min = glm::min(p[0], glm::min(p[1], p[2]));
+            box.max = glm::max(p[0], glm::max(p[1], p[2]));
+
+            b.bvh.queryOverlap(box, [&](uint32_t other) {
+                const glm::vec3 q[3] = { b.corner(other, 0), b.corner(other, 1), b.corner(other, 2) };
+
+                CutSegment segment;
+                if (intersectTriangles(p, q, segment.ends[0], segment.ends[1])) {
+                    segment.triangle[0] = static_cast<uint32_t>(t);
+                    segment.triangle[1] = other;
+                    segments.push_back(segment);
+                }
+            });
+        }
+    });
+
+    std::vector<CutSegment> segments;
+    for (const std::vector<CutSegment>& part : partial) {
+        segments.insert(segments.end(), part.begin(), part.end());
+    }
+
+    if (!segments.empty()) {
+        const math::AABB& boundsA = a.bvh.getBounds();
+        const math::AABB& boundsB = b.bvh.getBounds();
+        const glm::vec3 extent = glm::max(
+            glm::max(glm::abs(boundsA.min), glm::abs(boundsA.max)),
+            glm::max(glm::abs(boundsB.min), glm::abs(boundsB.max)));
+        const float scale = std::max(extent.x, std::max(extent.y, extent.z));
+
+        snapCutPoints(segments, a, b, 32.0f * std::numeric_limits<float>::epsilon() * std::max(scale, 1e-30f));
+    }
+    return segments;
+}
+
+// Segmentos agrupados por triángulo (CSR): los del triángulo t son
+// list[offsets[t]] .. list[offsets[t + 1]]
+struct SegmentsByTriangle {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> list;
+
+    bool isCut(size_t triangle) const {
+        return offsets[triangle + 1] > offsets[triangle];
+    }
+};
+
+// 'side' es 0 para los triángulos de A y 1 para los de B
+SegmentsByTriangle groupSegments(const std::vector<CutSegment>& segments, size_t triangleCount, int side) {
+    SegmentsByTriangle grouped;
+    grouped.offsets.assign(triangleCount + 1, 0);
+
+    for (const CutSegment& segment : segments) {
+        grouped.offsets[segment.triangle[side] + 1]++;
+    }
+    std::partial_sum(grouped.offsets.begin(), grouped.offsets.end(), grouped.offsets.begin());
+
+    std::vector<uint32_t> cursor(grouped.offsets.begin(), grouped.offsets.end() - 1);
+    grouped.list.resize(segments.size());
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        const uint32_t triangle = segments[i].triangle[side];
+        grouped.list[cursor[triangle]++] = static_cast<uint32_t>(i);
+    }
+
+    return grouped;
+}
+
+// ---------------------------------------------------------------------------
+// Clasificación dentro/fuera por paridad de cruces
+// ---------------------------------------------------------------------------
+
+// 1 si el segmento pq atraviesa el interior del triángulo abc, 0 si no lo toca
+// y -1 en los casos degenerados (toca una arista o un vértice, o un extremo
+// está sobre el triángulo)
+int segmentCrossesTriangle(const glm::vec3& p, const glm::vec3& q,
+    const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+
+    const int sideP = math::orient3d(a, b, c, p);
+    const int sideQ = math::orient3d(a, b, c, q);
+
+    if (sideP == sideQ) {
+        return sideP == 0 ? -1 : 0;
+    }
+
+    const int e0 = math::orient3d(p, q, a, b);
+    const int e1 = math::orient3d(p, q, b, c);
+    const int e2 = math::orient3d(p, q, c, a);
+
+    if ((e0 > 0 || e1 > 0 || e2 > 0) && (e0 < 0 || e1 < 0 || e2 < 0)) {
+        return 0;
+    }
+
+    if (e0 == 0 || e1 == 0 || e2 == 0 || sideP == 0 || sideQ == 0) {
+        return -1;
+    }
+
+    return 1;
+}
+
+// Direcciones sin relación con los ejes para evitar aristas alineadas
+const glm::vec3 rayDirections[] = {
+    {  0.267f,  0.535f,  0.802f },
+    { -0.613f,  0.358f,  0.705f },
+    {  0.129f, -0.914f,  0.385f },
+    {  0.890f,  0.221f, -0.398f },
+    { -0.301f, -0.447f, -0.842f },
+};
+
+bool isInside(const glm::vec3& point, const Solid& solid) {
+    if (solid.bvh.empty()) {
+        return false;
+    }
+
+    const math::AABB& box = solid.bvh.getBounds();
+    if (glm::any(glm::lessThan(point, box.min)) || glm::any(glm::greaterThan(point, box.max))) {
+        return false;
+    }
+
+    const float reach = 2.0f * glm::length(box.max - box.min) + 1.0f;
+
+    for (const glm::vec3& direction : rayDirections) {
+        const glm::vec3 far = point + direction * reach;
+
+        int crossings = 0;
+        bool degenerate = false;
+
+        solid.bvh.querySegment(point, far, [&](uint32_t triangle) {
+            if (degenerate) {
+                return;
+            }
+
+            const int result = segmentCrossesTriangle(point, far,
+                solid.corner(triangle, 0), solid.corner(triangle, 1), solid.corner(triangle, 2));
+
+            if (result < 0) {
+                degenerate = true;
+            } else {
+                crossings += result;
+            }
+        });
+
+        if (!degenerate) {
+            return (crossings & 1) != 0;
+        }
+    }
+
+    // Punto sobre la superficie (caras coplanares): se considera fuera
+    return false;
+}
+
+// Vértices con la misma posición exacta se identifican (las mallas con
+// colores por cara duplican vértices): el representante de cada uno
+std::vector<uint32_t> canonicalVertices(const std::vector<glm::vec3>& positions) {
+    // Se ordenan copias de las posiciones y no índices: el orden por índice
+    // salta por toda la memoria en cada comparación
+    std::vector<std::pair<glm::vec3, uint32_t>> sorted(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        sorted[i] = { positions[i], static_cast<uint32_t>(i) };
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return lessPosition(a.first, b.first);
+    });
+
+    std::vector<uint32_t> canonical(positions.size());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        const bool same = i > 0 && !lessPosition(sorted[i - 1].first, sorted[i].first);
+        canonical[sorted[i].second] = same ? canonical[sorted[i - 1].second] : sorted[i].second;
+    }
+    return canonical;
+}
+
+// Arista k del triángulo (de la esquina k a la k + 1), sin orientación
+uint64_t edgeKey(const Solid& solid, const std::vector<uint32_t>& canonical, size_t triangle, int k) {
+    const uint64_t u = canonical[solid.indices[3 * triangle + k]];
+    const uint64_t v = canonical[solid.indices[3 * triangle + (k + 1) % 3]];
+    return (std::min(u, v) << 32) | std::max(u, v);
+}
+
+// Clasifica los triángulos sin cortar. Los que comparten arista están todos
+// del mismo lado, así que basta con un rayo por componente conexa.
+std::vector<uint8_t> classifyUncut(const Solid& solid, const std::vector<uint32_t>& canonical,
+    const SegmentsByTriangle& cuts, const Solid& other) {
+
+    const size_t triangleCount = solid.triangleCount();
+
+    // Aristas de los triángulos sin cortar, ordenadas para emparejarlas
+    std::vector<std::pair<uint64_t, uint32_t>> edges;
+    edges.reserve(3 * triangleCount);
+
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (cuts.isCut(t)) {
+            continue;
+        }
+
+        for (int k = 0; k < 3; k++) {
+            edges.emplace_back(edgeKey(solid, canonical, t, k), static_cast<uint32_t>(t));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<uint32_t> parent(triangleCount);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    auto find = [&](uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (size_t i = 1; i < edges.size(); i++) {
+        if (edges[i].first == edges[i - 1].first) {
+            const uint32_t ra = find(edges[i].second);
+            const uint32_t rb = find(edges[i - 1].second);
+            if (ra != rb) {
+                parent[std::max(ra, rb)] = std::min(ra, rb);
+            }
+        }
+    }
+
+    // Un rayo por componente, desde el centroide de su primer triángulo
+    std::vector<uint32_t> roots;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!cuts.isCut(t) && find(static_cast<uint32_t>(t)) == t) {
+            roots.push_back(static_cast<uint32_t>(t));
+        }
+    }
+
+    std::vector<uint8_t> inside(triangleCount, 0);
+
+    core::parallelFor(roots.size(), 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t t = roots[i];
+            const glm::vec3 centroid = (solid.corner(t, 0) + solid.corner(t, 1) + solid.corner(t, 2)) / 3.0f;
+            inside[t] = isInside(centroid, other) ? 1 : 0;
+        }
+    });
+
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (!cuts.isCut(t)) {
+            inside[t] = inside[find(static_cast<uint32_t>(t))];
+        }
+    }
+
+    return inside;
+}
+
+// Si un trozo se conserva en el resultado y si hay que invertir su orientación
+bool keepPiece(BooleanOperation operation, bool fromA, bool inside, bool& flip) {
+    flip = false;
+
+    switch (operation) {
+    case BooleanOperation::Union:
+        return !inside;
+    case BooleanOperation::Intersection:
+        return inside;
+    case BooleanOperation::Difference:
+        if (fromA) {
+            return !inside;
+        }
+        flip = true;
+        return inside;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Retriangulación de los triángulos cortados
+// ---------------------------------------------------------------------------
+
+// Puntos de corte sobre cada arista de una malla, compartidos por los dos
+// triángulos de la arista: los dos la parten por los mismos puntos y no
+// quedan uniones en T
+struct EdgePoint {
+    uint64_t edge;
+    glm::vec3 position;
+};
+
+std::vector<EdgePoint> collectEdgePoints(const Solid& solid, const std::vector<uint32_t>& canonical,
+    const std::vector<CutSegment>& segments, int side) {
+
+    std::vector<EdgePoint> points;
+
+    for (const CutSegment& segment : segments) {
+        for (const CutPoint& end : segment.ends) {
+            const int8_t location = end.location[side];
+            if (location >= kOnEdge) {
+                points.push_back({ edgeKey(solid, canonical, segment.triangle[side], location - kOnEdge), end.position });
+            }
+        }
+    }
+
+    auto less = [](const EdgePoint& a, const EdgePoint& b) {
+        return a.edge != b.edge ? a.edge < b.edge : lessPosition(a.position, b.position);
+    };
+    auto same = [](const EdgePoint& a, const EdgePoint& b) {
+        return a.edge == b.edge && a.position == b.position;
+    };
+
+    std::sort(points.begin(), points.end(), less);
+    points.erase(std::unique(points.begin(), points.end(), same), points.end());
+    return points;
+}
+
+double orient(const glm::dvec2& a, const glm::dvec2& b, const glm::dvec2& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Triangulación de un triángulo con sus puntos de corte como vértices y sus
+// segmentos de corte como aristas obligatorias.
+//
+// Trabaja en las coordenadas (u, v) del triángulo (esquinas (0, 0), (1, 0) y
+// (0, 1)): los puntos de una arista se colocan exactamente sobre ella por su
+// parámetro, aunque su posición en float no caiga sobre la recta. Los puntos
+// se insertan partiendo el triángulo (o la arista) que los contiene y cada
+// segmento se recupera girando las aristas que lo cruzan (Sloan, "A fast
+// algorithm for generating constrained Delaunay triangulations", 1993), así
+// que solo se corta por el segmento y no por la recta que lo contiene.
+class TriangleSplitter {
+public:
+    using Triangle = std::array<uint32_t, 3>;
+
+    struct Point {
+        glm::dvec2 uv;
+        glm::vec3 position;
+        glm::vec3 color;
+        uint8_t boundary;       // bit k: sobre la arista k
+    };
+
+private:
+    glm::vec3 mCorners[3];
+    glm::vec3 mColors[3];
+
+    std::vector<Point> mPoints;
+    std::vector<Triangle> mTriangles;
+
+    // Aristas obligatorias (menor, mayor) con el segmento del que salen
+    std::vector<std::pair<uint64_t, uint32_t>> mConstraints;
+
+    static uint64_t key(uint32_t a, uint32_t b) {
+        return (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+    }
+
+    // Parámetro a lo largo de la arista k, de 0 en la esquina k a 1 en la k + 1
+    static double edgeParameter(const glm::dvec2& uv, int k) {
+        return k == 0 ? uv.x : k == 1 ? uv.y : 1.0 - uv.y;
+    }
+
+    glm::vec3 colorAt(const glm::dvec2& uv) const {
+        const float u = static_cast<float>(uv.x);
+        const float v = static_cast<float>(uv.y);
+        return mColors[0] * (1.0f - u - v) + mColors[1] * u + mColors[2] * v;
+    }
+
+    // Punto ya insertado en la misma posición. Con 'boundary', solo los de
+    // esas aristas: en un triángulo muy estrecho dos aristas pueden dar el
+    // mismo punto en float, y cada una tiene que partirse por el suyo para
+    // coincidir con su vecino
+    int findPoint(const glm::vec3& position, uint8_t boundary = 0) const {
+        for (size_t i = 0; i < mPoints.size(); i++) {
+            if (mPoints[i].position == position && (boundary == 0 || (mPoints[i].boundary & boundary) != 0)) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    uint32_t addPoint(const glm::dvec2& uv, const glm::vec3& position, uint8_t boundary) {
+        mPoints.push_back({ uv, position, colorAt(uv), boundary });
+        return static_cast<uint32_t>(mPoints.size() - 1);
+    }
+
+    // Triángulo con la arista orientada (a, b) y su posición en él
+    bool findEdge(uint32_t a, uint32_t b, size_t& triangle, int& edge) const {
+        for (size_t t = 0; t < mTriangles.size(); t++) {
+            for (int e = 0; e < 3; e++) {
+                if (mTriangles[t][e] == a && mTriangles[t][(e + 1) % 3] == b) {
+                    triangle = t;
+                    edge = e;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool hasEdge(uint32_t a, uint32_t b) const {
+        size_t triangle;
+        int edge;
+        return findEdge(a, b, triangle, edge) || findEdge(b, a, triangle, edge);
+    }
+
+    bool isConstrained(uint32_t a, uint32_t b) const {
+        const uint64_t edge = key(a, b);
+        for (const auto& constraint : mConstraints) {
+            if (constraint.first == edge) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Parte en dos el triángulo por 'point', que está sobre su arista 'edge'
+    void splitTriangleEdge(size_t triangle, int edge, uint32_t point) {
+        const uint32_t a = mTriangles[triangle][edge];
+        const uint32_t b = mTriangles[triangle][(edge + 1) % 3];
+        const uint32_t c = mTriangles[triangle][(edge + 2) % 3];
+
+        mTriangles[triangle] = { a, point, c };
+        mTriangles.push_back({ point, b, c });
+    }
+
+    // Si los segmentos pq y ab se cruzan fuera de sus extremos
+    bool crosses(uint32_t p, uint32_t q, uint32_t a, uint32_t b) const {
+        if (a == p || a == q || b == p || b == q) {
+            return false;
+        }
+
+        const glm::dvec2& P = mPoints[p].uv;
+        const glm::dvec2& Q = mPoints[q].uv;
+        const glm::dvec2& A = mPoints[a].uv;
+        const glm::dvec2& B = mPoints[b].uv;
+
+        const double sideA = orient(P, Q, A);
+        const double sideB = orient(P, Q, B);
+        const double sideP = orient(A, B, P);
+        const double sideQ = orient(A, B, Q);
+
+        return ((sideA > 0.0 && sideB < 0.0) || (sideA < 0.0 && sideB > 0.0))
+            && ((sideP > 0.0 && sideQ < 0.0) || (sideP < 0.0 && sideQ > 0.0));
+    }
+
+    // Gira aristas hasta que (p, q) sea una arista de la triangulación
+    bool recoverEdge(uint32_t p, uint32_t q) {
+        std::deque<std::pair<uint32_t, uint32_t>> crossing;
+
+        for (const Triangle& triangle : mTriangles) {
+            for (int e = 0; e < 3; e++) {
+                const uint32_t a = triangle[e];
+                const uint32_t b = triangle[(e + 1) % 3];
+                if (a < b && crosses(p, q, a, b)) {
+                    // Dos segmentos de corte que se cruzan: la otra malla se
+                    // corta a sí misma
+                    if (isConstrained(a, b)) {
+                        return false;
+                    }
+                    crossing.emplace_back(a, b);
+                }
+            }
+        }
+
+        // Sloan: una arista que no se puede girar todavía vuelve a la cola;
+        // el límite solo protege de entradas degeneradas
+        size_t budget = 64 * (crossing.size() + 1);
+
+        while (!crossing.empty() && budget-- > 0) {
+            const auto [a, b] = crossing.front();
+            crossing.pop_front();
+
+            size_t first, second;
+            int edgeFirst, edgeSecond;
+            if (!findEdge(a, b, first, edgeFirst) || !findEdge(b, a, second, edgeSecond)) {
+                continue;
+            }
+
+            const uint32_t c = mTriangles[first][(edgeFirst + 2) % 3];
+            const uint32_t d = mTriangles[second][(edgeSecond + 2) % 3];
+
+            // Solo si el cuadrilátero es convexo
+            if (orient(mPoints[a].uv, mPoints[d].uv, mPoints[c].uv) <= 0.0 ||
+                orient(mPoints[d].uv, mPoints[b].uv, mPoints[c].uv) <= 0.0) {
+                crossing.emplace_back(a, b);
+                continue;
+            }
+
+            mTriangles[first] = { a, d, c };
+            mTriangles[second] = { d, b, c };
+
+            if (crosses(p, q, c, d)) {
+                crossing.emplace_back(c, d);
+            }
+        }
+
+        return hasEdge(p, q);
+    }
+
+public:
+    TriangleSplitter(const glm::vec3 corners[3], const glm::vec3 colors[3]) {
+        for (int k = 0; k < 3; k++) {
+            mCorners[k] = corners[k];
+            mColors[k] = colors[k];
+        }
+
+        // La esquina k está en las aristas k y k - 1
+        addPoint({ 0.0, 0.0 }, corners[0], 0b101);
+        addPoint({ 1.0, 0.0 }, corners[1], 0b011);
+        addPoint({ 0.0, 1.0 }, corners[2], 0b110);
+        mTriangles.push_back({ 0, 1, 2 });
+    }
+
+    // Punto de la arista k, colocado por su proyección sobre ella
+    uint32_t insertOnEdge(int k, const glm::vec3& position) {
+        const int existing = findPoint(position, static_cast<uint8_t>(1 << k));
+        if (existing >= 0) {
+            return static_cast<uint32_t>(existing);
+        }
+
+        const glm::dvec3 from(mCorners[k]);
+        const glm::dvec3 direction = glm::dvec3(mCorners[(k + 1) % 3]) - from;
+        const double s = glm::clamp(glm::dot(glm::dvec3(position) - from, direction) / glm::dot(direction, direction), 0.0, 1.0);
+
+        const glm::dvec2 uv = k == 0 ? glm::dvec2(s, 0.0) : k == 1 ? glm::dvec2(1.0 - s, s) : glm::dvec2(0.0, 1.0 - s);
+
+        // El tramo de la arista k que lo contiene; solo hay un triángulo a
+        // ese lado
+        for (size_t t = 0; t < mTriangles.size(); t++) {
+            for (int e = 0; e < 3; e++) {
+                const Point& a = mPoints[mTriangles[t][e]];
+                const Point& b = mPoints[mTriangles[t][(e + 1) % 3]];
+
+                if ((a.boundary >> k & 1) && (b.boundary >> k & 1) &&
+                    edgeParameter(a.uv, k) < s && s < edgeParameter(b.uv, k)) {
+                    const uint32_t point = addPoint(uv, position, static_cast<uint8_t>(1 << k));
+                    splitTriangleEdge(t, e, point);
+                    return point;
+                }
+            }
+        }
+
+        // Con el mismo parámetro que otro punto (o que una esquina): el más
+        // cercano hace de él
+        uint32_t nearest = 0;
+        for (uint32_t i = 1; i < mPoints.size(); i++) {
+            if ((mPoints[i].boundary >> k & 1) &&
+                std::abs(edgeParameter(mPoints[i].uv, k) - s) < std::abs(edgeParameter(mPoints[nearest].uv, k) - s)) {
+                nearest = i;
+            }
+        }
+        return nearest;
+    }
+
+    // Punto del interior, colocado por su proyección sobre el plano
+    uint32_t insertInterior(const glm::vec3& position) {
+        const int existing = findPoint(position);
+        if (existing >= 0) {
+            return static_cast<uint32_t>(existing);
+        }
+
+        const glm::dvec3 origin(mCorners[0]);
+        const glm::dvec3 e1 = glm::dvec3(mCorners[1]) - origin;
+        const glm::dvec3 e2 = glm::dvec3(mCorners[2]) - origin;
+        const glm::dvec3 r = glm::dvec3(position) - origin;
+
+        const double a = glm::dot(e1, e1);
+        const double b = glm::dot(e1, e2);
+        const double c = glm::dot(e2, e2);
+        const double d = glm::dot(e1, r);
+        const double e = glm::dot(e2, r);
+        const double determinant = a * c - b * b;
+
+        glm::dvec2 uv(1.0 / 3.0);
+        if (determinant > 0.0) {
+            uv = glm::dvec2((c * d - b * e) / determinant, (a * e - b * d) / determinant);
+        }
+
+        // Lejos de las aristas: lo que cae encima es de la arista, no de aquí
+        constexpr double margin = 1e-9;
+        uv = glm::max(uv, glm::dvec2(margin));
+        const double excess = uv.x + uv.y - (1.0 - margin);
+        if (excess > 0.0) {
+            uv -= glm::dvec2(0.5 * excess);
+        }
+
+        // El triángulo en el que queda más adentro
+        size_t best = 0;
+        int bestVertex = 0;
+        double bestInside = -1e300;
+
+        for (size_t t = 0; t < mTriangles.size(); t++) {
+            const glm::dvec2& A = mPoints[mTriangles[t][0]].uv;
+            const glm::dvec2& B = mPoints[mTriangles[t][1]].uv;
+            const glm::dvec2& C = mPoints[mTriangles[t][2]].uv;
+
+            const double area = orient(A, B, C);
+            if (area <= 0.0) {
+                continue;
+            }
+
+            const double barycentric[3] = { orient(B, C, uv) / area, orient(C, A, uv) / area, orient(A, B, uv) / area };
+            const int vertex = static_cast<int>(std::min_element(barycentric, barycentric + 3) - barycentric);
+
+            if (barycentric[vertex] > bestInside) {
+                bestInside = barycentric[vertex];
+                best = t;
+                bestVertex = vertex;
+            }
+        }
+
+        const uint32_t point = addPoint(uv, position, 0);
+
+        // Sobre la arista opuesta a 'bestVertex': se parten los dos
+        // triángulos que la comparten
+        if (bestInside <= 1e-12) {
+            const int edge = (bestVertex + 1) % 3;
+            const uint32_t a = mTriangles[best][edge];
+            const uint32_t b = mTriangles[best][(edge + 1) % 3];
+
+            size_t other;
+            int otherEdge;
+            if (findEdge(b, a, other, otherEdge)) {
+                splitTriangleEdge(best, edge, point);
+                splitTriangleEdge(other, otherEdge, point);
+                return point;
+            }
+        }
+
+        const Triangle triangle = mTriangles[best];
+        mTriangles[best] = { triangle[0], triangle[1], point };
+        mTriangles.push_back({ triangle[1], triangle[2], point });
+        mTriangles.push_back({ triangle[2], triangle[0], point });
+        return point;
+    }
+
+    // Hace de (p, q) aristas obligatorias, partidas por los puntos que
+    // caigan sobre el segmento. Falso si no se ha podido recuperar
+    bool constrain(uint32_t p, uint32_t q, uint32_t segment) {
+        const glm::dvec2 from = mPoints[p].uv;
+        const glm::dvec2 direction = mPoints[q].uv - from;
+        const double length2 = glm::dot(direction, direction);
+
+        if (p == q || length2 <= 0.0) {
+            return true;
+        }
+
+        std::vector<std::pair<double, uint32_t>> chain = { { 0.0, p }, { 1.0, q } };
+        for (uint32_t w = 0; w < mPoints.size(); w++) {
+            if (w == p || w == q) {
+                continue;
+            }
+
+            const double t = glm::dot(mPoints[w].uv - from, direction) / length2;
+            const double distance = orient(from, mPoints[q].uv, mPoints[w].uv) / std::sqrt(length2);
+            if (t > 1e-12 && t < 1.0 - 1e-12 && std::abs(distance) <= 1e-12) {
+                chain.emplace_back(t, w);
+            }
+        }
+        std::sort(chain.begin(), chain.end());
+
+        bool ok = true;
+        for (size_t i = 0; i + 1 < chain.size(); i++) {
+            const uint32_t a = chain[i].second;
+            const uint32_t b = chain[i + 1].second;
+
+            if (hasEdge(a, b) || recoverEdge(a, b)) {
+                mConstraints.emplace_back(key(a, b), segment);
+            } else {
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    // Segmento de la arista obligatoria (a, b), o -1 si no lo es
+    int64_t getConstraint(uint32_t a, uint32_t b) const {
+        const uint64_t edge = key(a, b);
+        for (const auto& constraint : mConstraints) {
+            if (constraint.first == edge) {
+                return constraint.second;
+            }
+        }
+        return -1;
+    }
+
+    // Región de cada triángulo: las que no separa ninguna arista obligatoria
+    // están del mismo lado de la otra malla
+    std::vector<uint32_t> getRegions() const {
+        std::vector<uint32_t> parent(mTriangles.size());
+        std::iota(parent.begin(), parent.end(), 0);
+
+        auto find = [&](uint32_t x) {
+            while (parent[x] != x) {
+                parent[x] = parent[parent[x]];
+                x = parent[x];
+            }
+            return x;
+        };
+
+        std::vector<std::pair<uint64_t, uint32_t>> edges;
+        edges.reserve(3 * mTriangles.size());
+        for (size_t t = 0; t < mTriangles.size(); t++) {
+            for (int e = 0; e < 3; e++) {
+                edges.emplace_back(key(mTriangles[t][e], mTriangles[t][(e + 1) % 3]), static_cast<uint32_t>(t));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t i = 1; i < edges.size(); i++) {
+            if (edges[i].first != edges[i - 1].first || isConstrained(
+                static_cast<uint32_t>(edges[i].first >> 32), static_cast<uint32_t>(edges[i].first))) {
+                continue;
+            }
+
+            const uint32_t ra = find(edges[i].second);
+            const uint32_t rb = find(edges[i - 1].second);
+            if (ra != rb) {
+                parent[std::max(ra, rb)] = std::min(ra, rb);
+            }
+        }
+
+        std::vector<uint32_t> regions(mTriangles.size());
+        for (size_t t = 0; t < mTriangles.size(); t++) {
+            regions[t] = find(static_cast<uint32_t>(t));
+        }
+        return regions;
+    }
+
+    const std::vector<Point>& getPoints() const {
+        return mPoints;
+    }
+
+    const std::vector<Triangle>& getTriangles() const {
+        return mTriangles;
+    }
+};
+
+// Lado del plano del triángulo 'otherTriangle' en el que está 'point', con
+// su distancia a él. orient3d > 0: debajo del triángulo, que mira hacia
+// fuera, así que dentro de la otra malla. 0 si está sobre el plano
+int sideOfCut(const glm::vec3& point, const Solid& other, uint32_t otherTriangle, double& distance) {
+    const glm::vec3& q0 = other.corner(otherTriangle, 0);
+    const glm::vec3& q1 = other.corner(otherTriangle, 1);
+    const glm::vec3& q2 = other.corner(otherTriangle, 2);
+
+    const glm::dvec3 normal = glm::cross(glm::dvec3(q1) - glm::dvec3(q0), glm::dvec3(q2) - glm::dvec3(q0));
+    const double length = glm::length(normal);
+    distance = length > 0.0 ? std::abs(glm::dot(normal, glm::dvec3(point) - glm::dvec3(q0))) / length : 0.0;
+
+    return math::orient3d(q0, q1, q2, point);
+}
+
+// Trocea un triángulo por sus puntos y segmentos de corte, clasifica cada
+// región y añade al resultado los triángulos de las que se conservan.
+// 'inside' es la clasificación del triángulo entero si no lo corta ningún
+// segmento (solo tiene puntos de corte en sus aristas)
+void retriangulate(const Solid& solid, size_t triangle, int side, const std::vector<CutSegment>& segments,
+    const SegmentsByTriangle& cuts, const std::vector<uint32_t>& canonical, const std::vector<EdgePoint>& edgePoints,
+    const Solid& other, BooleanOperation operation, bool inside, std::vector<Vertex>& output) {
+
+    glm::vec3 corners[3], colors[3];
+    for (int k = 0; k < 3; k++) {
+        const uint32_t index = solid.indices[3 * triangle + k];
+        corners[k] = solid.positions[index];
+        colors[k] = solid.colors[index];
+    }
+
+    TriangleSplitter splitter(corners, colors);
+
+    // Primero los puntos de las aristas, los mismos que usa el vecino
+    for (int k = 0; k < 3; k++) {
+        const uint64_t edge = edgeKey(solid, canonical, triangle, k);
+        auto it = std::lower_bound(edgePoints.begin(), edgePoints.end(), edge,
+            [](const EdgePoint& point, uint64_t value) { return point.edge < value; });
+
+        for (; it != edgePoints.end() && it->edge == edge; ++it) {
+            splitter.insertOnEdge(k, it->position);
+        }
+    }
+
+    // Después los extremos de los segmentos y los segmentos
+    auto insertEnd = [&](const CutPoint& end) {
+        const int8_t location = end.location[side];
+        if (location >= kOnEdge) {
+            return splitter.insertOnEdge(location - kOnEdge, end.position);
+        }
+        return splitter.insertInterior(end.position);
+    };
+
+    for (uint32_t i = cuts.offsets[triangle]; i < cuts.offsets[triangle + 1]; i++) {
+        const CutSegment& segment = segments[cuts.list[i]];
+        insertEnd(segment.ends[0]);
+        insertEnd(segment.ends[1]);
+    }
+    for (uint32_t i = cuts.offsets[triangle]; i < cuts.offsets[triangle + 1]; i++) {
+        const CutSegment& segment = segments[cuts.list[i]];
+        splitter.constrain(insertEnd(segment.ends[0]), insertEnd(segment.ends[1]), cuts.list[i]);
+    }
+
+    const std::vector<TriangleSplitter::Point>& points = splitter.getPoints();
+    const std::vector<TriangleSplitter::Triangle>& triangles = splitter.getTriangles();
+    const std::vector<uint32_t> regions = splitter.getRegions();
+
+    // Clasificación de cada región por los segmentos de su borde. El plano
+    // del otro triángulo corta al nuestro justo por la recta del segmento,
+    // así que todo lo que queda al lado de la región está del mismo lado de
+    // ese plano: se mira la esquina original más alejada de la recta por ese
+    // lado (los vértices de los trozos pueden estar casi sobre ella), y de
+    // todos los segmentos, el que la deja más lejos del plano
+    std::vector<int> regionSide(triangles.size(), 0);
+    std::vector<double> regionDistance(triangles.size(), -1.0);
+
+    if (cuts.isCut(triangle)) {
+        for (size_t t = 0; t < triangles.size(); t++) {
+            for (int e = 0; e < 3; e++) {
+                const uint32_t a = triangles[t][e];
+                const uint32_t b = triangles[t][(e + 1) % 3];
+
+                const int64_t segment = splitter.getConstraint(a, b);
+                if (segment < 0) {
+                    continue;
+                }
+
+                // La región está a la izquierda de (a, b), como su triángulo;
+                // los tres primeros puntos son las esquinas
+                int corner = -1;
+                double farthest = 0.0;
+                for (int k = 0; k < 3; k++) {
+                    const double left = orient(points[a].uv, points[b].uv, points[k].uv);
+                    if (left > farthest) {
+                        farthest = left;
+                        corner = k;
+                    }
+                }
+                if (corner < 0) {
+                    continue;
+                }
+
+                double distance;
+                const int orientation = sideOfCut(corners[corner], other, segments[segment].triangle[1 - side], distance);
+
+                const uint32_t region = regions[t];
+                if (orientation != 0 && distance > regionDistance[region]) {
+                    regionDistance[region] = distance;
+                    regionSide[region] = orientation;
+                }
+            }
+        }
+    }
+
+    for (size_t t = 0; t < triangles.size(); t++) {
+        const uint32_t region = regions[t];
+
+        // Sin segmento útil en el borde: rayo desde el centroide
+        if (regionSide[region] == 0) {
+            bool regionInside = inside;
+            if (cuts.isCut(triangle)) {
+                const glm::vec3 centroid = (points[triangles[region][0]].position
+                    + points[triangles[region][1]].position
+                    + points[triangles[region][2]].position) / 3.0f;
+                regionInside = isInside(centroid, other);
+            }
+            regionSide[region] = regionInside ? 1 : -1;
+        }
+
+        bool flip;
+        if (!keepPiece(operation, side == 0, regionSide[region] > 0, flip)) {
+            continue;
+        }
+
+        const TriangleSplitter::Point& v0 = points[triangles[t][0]];
+        const TriangleSplitter::Point& v1 = points[triangles[t][flip ? 2 : 1]];
+        const TriangleSplitter::Point& v2 = points[triangles[t][flip ? 1 : 2]];
+
+        output.emplace_back(v0.position, v0.color);
+        output.emplace_back(v1.position, v1.color);
+        output.emplace_back(v2.position, v2.color);
+    }
+}
+
+// Añade al resultado la parte de 'solid' que se conserva: los triángulos
+// enteros comparten sus vértices y los trozos van sueltos, hasta soldarlos
+// al final. 'side' es 0 para A y 1 para B
+void emitSolid(const Solid& solid, const Solid& other, const std::vector<CutSegment>& segments,
+    BooleanOperation operation, int side, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+
+    const std::vector<uint32_t> canonical = canonicalVertices(solid.positions);
+    const SegmentsByTriangle cuts = groupSegments(segments, solid.triangleCount(), side);
+    const std::vector<uint8_t> inside = classifyUncut(solid, canonical, cuts, other);
+    const std::vector<EdgePoint> edgePoints = collectEdgePoints(solid, canonical, segments, side);
+
+    auto hasEdgePoints = [&](size_t triangle) {
+        for (int k = 0; k < 3; k++) {
+            const uint64_t edge = edgeKey(solid, canonical, triangle, k);
+            auto it = std::lower_bound(edgePoints.begin(), edgePoints.end(), edge,
+                [](const EdgePoint& point, uint64_t value) { return point.edge < value; });
+            if (it != edgePoints.end() && it->edge == edge) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Triángulos enteros: tal cual, con un vértice por posición
+    std::vector<uint32_t> splitTriangles;
+    std::vector<uint32_t> outputIndex(solid.positions.size(), UINT32_MAX);
+
+    for (size_t t = 0; t < solid.triangleCount(); t++) {
+        if (cuts.isCut(t) || hasEdgePoints(t)) {
+            splitTriangles.push_back(static_cast<uint32_t>(t));
+            continue;
+        }
+
+        bool flip;
+        if (!keepPiece(operation, side == 0, inside[t] != 0, flip)) {
+            continue;
+        }
+
+        for (int k : { 0, flip ? 2 : 1, flip ? 1 : 2 }) {
+            const uint32_t index = canonical[solid.indices[3 * t + k]];
+            if (outputIndex[index] == UINT32_MAX) {
+                outputIndex[index] = static_cast<uint32_t>(vertices.size());
+                vertices.emplace_back(solid.positions[index], solid.colors[index]);
+            }
+            indices.push_back(outputIndex[index]);
+        }
+    }
+
+    // Triángulos cortados: en paralelo, cada bloque en su propio buffer
+    std::vector<std::vector<Vertex>> partial(core::chunkCount(splitTriangles.size(), 64));
+
+    core::parallelFor(splitTriangles.size(), 64, [&](size_t begin, size_t end, size_t chunk) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t t = splitTriangles[i];
+            retriangulate(solid, t, side, segments, cuts, canonical, edgePoints, other, operation, inside[t] != 0, partial[chunk]);
+        }
+    });
+
+    for (const std::vector<Vertex>& part : partial) {
+        for (const Vertex& vertex : part) {
+            indices.push_back(static_cast<uint32_t>(vertices.size()));
+            vertices.push_back(vertex);
+        }
+    }
+}
+
+// Suelda los vértices con la misma posición (los de la costura entre las
+// dos mallas salen de los mismos puntos de corte) y quita los triángulos que
+// se quedan con dos vértices iguales
+Mesh weldVertices(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    std::vector<glm::vec3> positions(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        positions[i] = vertices[i].position;
+    }
+    const std::vector<uint32_t> canonical = canonicalVertices(positions);
+
+    std::vector<Vertex> welded;
+    std::vector<uint32_t> remap(vertices.size());
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        if (canonical[i] == i) {
+            remap[i] = static_cast<uint32_t>(welded.size());
+            welded.push_back(vertices[i]);
+        }
+    }
+
+    std::vector<uint32_t> weldedIndices;
+    weldedIndices.reserve(indices.size());
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t a = remap[canonical[indices[i]]];
+        const uint32_t b = remap[canonical[indices[i + 1]]];
+        const uint32_t c = remap[canonical[indices[i + 2]]];
+        if (a != b && b != c && c != a) {
+            weldedIndices.insert(weldedIndices.end(), { a, b, c });
+        }
+    }
+
+    return Mesh(welded, weldedIndices);
+}
+
+} // namespace
+
+Mesh meshBoolean(
+    const Mesh& a,
+    const glm::mat4& modelA,
+    const Mesh& b,
+    const glm::mat4& modelB,
+    BooleanOperation operation) {
+
+    const Solid solidA = makeSolid(a, modelA);
+    const Solid solidB = makeSolid(b, modelB);
+
+    const std::vector<CutSegment> segments = findCutSegments(solidA, solidB);
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    emitSolid(solidA, solidB, segments, operation, 0, vertices, indices);
+    emitSolid(solidB, solidA, segments, operation, 1, vertices, indices);
+
+    return weldVertices(vertices, indices);
+}
+
+Mesh meshBoolean(const Mesh& a, const Mesh& b, BooleanOperation operation) {
+    return meshBoolean(a, glm::mat4(1.0f), b, glm::mat4(1.0f), operation);
+}
+
+} // namespace app::geometry
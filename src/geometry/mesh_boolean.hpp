@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "mesh.hpp"
+
+// Operaciones booleanas (CSG) entre mallas cerradas.
+//
+// 1. Se construye un BVH de triángulos por malla y se buscan los pares de
+//    triángulos que se cortan. Cada extremo de un segmento de corte es una
+//    arista de un triángulo atravesando el otro, decidido con orient3d
+//    exacto y calculado siempre igual: los triángulos que comparten la
+//    arista obtienen el mismo punto, bit a bit.
+// 2. Cada triángulo cortado se triangula con sus puntos de corte como
+//    vértices y sus segmentos como aristas obligatorias (solo el segmento,
+//    no la recta que lo contiene). Los puntos que caen en una arista parten
+//    también al vecino, aunque a él no lo corte nada, así que no quedan
+//    uniones en T. En paralelo, un triángulo por tarea.
+// 3. Cada región entre segmentos se clasifica dentro/fuera con el signo
+//    exacto respecto al plano del triángulo que la cortó. Los triángulos sin
+//    cortar se agrupan en componentes conexas y se clasifica una por grupo
+//    por paridad de cruces de un rayo.
+// 4. Los vértices con la misma posición se sueldan: el resultado es una
+//    malla cerrada que puede ser a su vez operando de otra booleana.
+//
+// Las mallas deben ser cerradas y con las normales hacia fuera (triángulos
+// en sentido antihorario vistos desde fuera). Los contactos sin cruce (caras
+// coplanares que se solapan, mallas que se tocan en un punto o una arista)
+// no generan costura y el resultado puede no ser una variedad ahí.
+
+namespace app::geometry {
+
+enum class BooleanOperation {
+    Union,
+    Difference,      // a - b
+    Intersection
+};
+
+// Las posiciones de cada malla se llevan a espacio de mundo con su matriz de modelo
+Mesh meshBoolean(
+    const Mesh& a,
+    const glm::mat4& modelA,
+    const Mesh& b,
+    const glm::mat4& modelB,
+    BooleanOperation operation
+);
+
+Mesh meshBoolean(const Mesh& a, const Mesh& b, BooleanOperation operation);
+
+} // namespace app::geometry
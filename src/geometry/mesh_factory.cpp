@@ -1,4 +1,7 @@
 #include "mesh_factory.hpp"
+#include "builtin_meshes.hpp"
+
+#include <algorithm>
 
 namespace app::geometry {
 MeshFactory::MeshFactory(/* args */) {
@@ -7,65 +10,31 @@ MeshFactory::MeshFactory(/* args */) {
 MeshFactory::~MeshFactory() {
 }
 Mesh app::geometry::MeshFactory::createRectangleMesh() {
-
-    const std::vector<Vertex> vertexPosition{
-        {{ 0.0f,  0.8f, 0.0f}, {1.0f, 0.0f, 0.0f}},  // arriba, rojo
-        {{-0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}},  // izquierda, verde
-        {{ 0.5f, -0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}},  // derecha, azul
-        {{ 1.0f,  0.5f, 0.0f}, {1.0f, 1.0f, 1.0f}}  // arriba, blanco
-    };
-    const std::vector<uint32_t> indices{
-        0, 1, 2, // primer triángulo
-        3, 0, 2  // segundo triángulo
-    };
-
-
-    return Mesh(vertexPosition, indices);
+    return kRectangleMesh.toMesh();
 }
 
 Mesh app::geometry::MeshFactory::createCubeMesh() {
+    return kCubeMesh.toMesh();
+}
 
-    const std::vector<Vertex> vertices{
-        // Cara frontal (roja)
-        {{-0.5f, -0.5f,  0.5f},{ 1.0f, 0.0f, 0.0f}},
-        {{ 0.5f, -0.5f,  0.5f},{ 1.0f, 0.0f, 0.0f}},
-        {{ 0.5f,  0.5f,  0.5f},{ 1.0f, 0.0f, 0.0f}},
-        {{-0.5f,  0.5f,  0.5f},{ 1.0f, 0.0f, 0.0f}},
-
-        // Cara trasera (verde)
-        {{-0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}},
-        {{ 0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}},
-        {{ 0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}},
-        {{-0.5f,  0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}}
-    };
-
-    const std::vector<uint32_t> indices{
-        // Frontal
-        0,1,2,
-        2,3,0,
-
-        // Derecha
-        1,5,6,
-        6,2,1,
-
-        // Trasera
-        5,4,7,
-        7,6,5,
-
-        // Izquierda
-        4,0,3,
-        3,7,4,
+Mesh app::geometry::MeshFactory::createSphereMesh(uint32_t segments, uint32_t rings) {
+    segments = std::max<uint32_t>(segments, 3);
+    rings = std::max<uint32_t>(rings, 2);
 
-        // Superior
-        3,2,6,
-        6,7,3,
+    // La de por defecto ya está generada en tiempo de compilación
+    if (segments == 32 && rings == 16) {
+        return kSphereMesh.toMesh();
+    }
 
-        // Inferior
-        4,5,1,
-        1,0,4
-    };
+    std::vector<Vertex> vertices(sphereVertexCount(segments, rings));
+    std::vector<uint32_t> indices(sphereIndexCount(segments, rings));
+    writeSphere(segments, rings, vertices.data(), indices.data());
 
     return Mesh(vertices, indices);
 }
 
+Mesh app::geometry::MeshFactory::createImplicitMesh(const ScalarField& field, const MesherSettings& settings) {
+    return meshImplicitSurface(field, settings);
+}
+
 } // namespace app::geometry
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "mesh.hpp"
+#include "implicit_mesher.hpp"
 
 
 namespace app::geometry {
@@ -13,6 +14,12 @@ public:
 
     static Mesh createRectangleMesh();
     static Mesh createCubeMesh();
+
+    // Esfera UV de radio 0.5 centrada en el origen, cerrada y con los polos compartidos
+    static Mesh createSphereMesh(uint32_t segments = 32, uint32_t rings = 16);
+
+    // Malla de la isosuperficie de un campo escalar muestreado
+    static Mesh createImplicitMesh(const ScalarField& field, const MesherSettings& settings = {});
 };
 
 } // namespace app_geometry
@@ -0,0 +1,521 @@
+#include "subdivision.hpp"
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace app::geometry {
+
+namespace {
+
+constexpr uint32_t kInvalid = std::numeric_limits<uint32_t>::max();
+constexpr size_t kMinChunk = 1 << 14;
+
+// Floats por vértice en los buffers intermedios
+constexpr size_t kPrimvarWidth = 8;
+
+// Polígonos de un nivel en formato CSR
+struct Topology {
+    uint32_t vertexCount = 0;
+    std::vector<uint32_t> faceOffsets{ 0 };
+    std::vector<uint32_t> faceVertices;
+
+    size_t faceCount() const {
+        return faceOffsets.size() - 1;
+    }
+};
+
+// Aristas del nivel y adyacencias vértice -> aristas / caras
+struct Adjacency {
+    std::vector<uint32_t> edgeVertices;   // 2 por arista
+    std::vector<uint32_t> edgeFaces;      // 2 por arista (kInvalid si no hay)
+    std::vector<uint32_t> edgeFaceCount;
+    std::vector<uint32_t> cornerEdges;    // arista que sale de cada esquina de cara
+
+    std::vector<uint32_t> vertexEdgeOffsets;
+    std::vector<uint32_t> vertexEdges;
+    std::vector<uint32_t> vertexFaceOffsets;
+    std::vector<uint32_t> vertexFaces;
+
+    size_t edgeCount() const {
+        return edgeFaceCount.size();
+    }
+};
+
+Adjacency buildAdjacency(const Topology& topology) {
+    Adjacency adjacency;
+
+    const size_t cornerCount = topology.faceVertices.size();
+
+    std::vector<uint32_t> cornerFace(cornerCount);
+    for (size_t f = 0; f < topology.faceCount(); f++) {
+        for (uint32_t c = topology.faceOffsets[f]; c < topology.faceOffsets[f + 1]; c++) {
+            cornerFace[c] = static_cast<uint32_t>(f);
+        }
+    }
+
+    // Cada esquina aporta la arista (v, siguiente). Ordenando por la clave
+    // (min, max) las dos mitades de cada arista quedan contiguas.
+    std::vector<std::pair<uint64_t, uint32_t>> halfEdges(cornerCount);
+
+    for (size_t f = 0; f < topology.faceCount(); f++) {
+        const uint32_t begin = topology.faceOffsets[f];
+        const uint32_t end = topology.faceOffsets[f + 1];
+
+        for (uint32_t c = begin; c < end; c++) {
+            const uint32_t next = (c + 1 < end) ? c + 1 : begin;
+            const uint32_t a = topology.faceVertices[c];
+            const uint32_t b = topology.faceVertices[next];
+
+            const uint64_t key =
+                (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+
+            halfEdges[c] = { key, c };
+        }
+    }
+
+    std::sort(halfEdges.begin(), halfEdges.end());
+
+    adjacency.cornerEdges.resize(cornerCount);
+
+    for (size_t i = 0; i < cornerCount;) {
+        const uint64_t key = halfEdges[i].first;
+        const uint32_t edge = static_cast<uint32_t>(adjacency.edgeFaceCount.size());
+
+        adjacency.edgeVertices.push_back(static_cast<uint32_t>(key >> 32));
+        adjacency.edgeVertices.push_back(static_cast<uint32_t>(key & 0xffffffffu));
+
+        uint32_t faces[2] = { kInvalid, kInvalid };
+        uint32_t count = 0;
+
+        for (; i < cornerCount && halfEdges[i].first == key; i++) {
+            const uint32_t corner = halfEdges[i].second;
+            if (count < 2) {
+                faces[count] = cornerFace[corner];
+            }
+            count++;
+            adjacency.cornerEdges[corner] = edge;
+        }
+
+        adjacency.edgeFaces.push_back(faces[0]);
+        adjacency.edgeFaces.push_back(faces[1]);
+        adjacency.edgeFaceCount.push_back(count);
+    }
+
+    // Vértice -> aristas
+    adjacency.vertexEdgeOffsets.assign(topology.vertexCount + 1, 0);
+    for (uint32_t v : adjacency.edgeVertices) {
+        adjacency.vertexEdgeOffsets[v + 1]++;
+    }
+    for (uint32_t v = 0; v < topology.vertexCount; v++) {
+        adjacency.vertexEdgeOffsets[v + 1] += adjacency.vertexEdgeOffsets[v];
+    }
+
+    adjacency.vertexEdges.resize(adjacency.edgeVertices.size());
+    std::vector<uint32_t> cursor(adjacency.vertexEdgeOffsets.begin(), adjacency.vertexEdgeOffsets.end() - 1);
+    for (size_t e = 0; e < adjacency.edgeCount(); e++) {
+        adjacency.vertexEdges[cursor[adjacency.edgeVertices[2 * e]]++] = static_cast<uint32_t>(e);
+        adjacency.vertexEdges[cursor[adjacency.edgeVertices[2 * e + 1]]++] = static_cast<uint32_t>(e);
+    }
+
+    // Vértice -> caras
+    adjacency.vertexFaceOffsets.assign(topology.vertexCount + 1, 0);
+    for (uint32_t v : topology.faceVertices) {
+        adjacency.vertexFaceOffsets[v + 1]++;
+    }
+    for (uint32_t v = 0; v < topology.vertexCount; v++) {
+        adjacency.vertexFaceOffsets[v + 1] += adjacency.vertexFaceOffsets[v];
+    }
+
+    adjacency.vertexFaces.resize(cornerCount);
+    cursor.assign(adjacency.vertexFaceOffsets.begin(), adjacency.vertexFaceOffsets.end() - 1);
+    for (size_t c = 0; c < cornerCount; c++) {
+        adjacency.vertexFaces[cursor[topology.faceVertices[c]]++] = cornerFace[c];
+    }
+
+    return adjacency;
+}
+
+// Acumula pesos de una fila y fusiona los índices repetidos
+class RowBuilder {
+private:
+    std::vector<std::pair<uint32_t, float>> mEntries;
+
+public:
+    void add(uint32_t index, float weight) {
+        mEntries.emplace_back(index, weight);
+    }
+
+    // Añade el punto de cara de 'face' con el peso dado
+    void addFacePoint(const Topology& topology, uint32_t face, float weight) {
+        const uint32_t begin = topology.faceOffsets[face];
+        const uint32_t end = topology.faceOffsets[face + 1];
+        const float w = weight / static_cast<float>(end - begin);
+
+        for (uint32_t c = begin; c < end; c++) {
+            add(topology.faceVertices[c], w);
+        }
+    }
+
+    void flush(StencilTable& table) {
+        std::sort(mEntries.begin(), mEntries.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (size_t i = 0; i < mEntries.size();) {
+            const uint32_t index = mEntries[i].first;
+            float weight = 0.0f;
+
+            for (; i < mEntries.size() && mEntries[i].first == index; i++) {
+                weight += mEntries[i].second;
+            }
+
+            table.indices.push_back(index);
+            table.weights.push_back(weight);
+        }
+
+        table.offsets.push_back(static_cast<uint32_t>(table.indices.size()));
+        mEntries.clear();
+    }
+};
+
+// Reglas de Catmull-Clark para la fila 'row' del nivel refinado.
+// Orden de los vértices nuevos: [puntos de vértice][puntos de arista][puntos de cara]
+void buildRow(const Topology& topology, const Adjacency& adjacency, size_t row, RowBuilder& builder) {
+    const size_t vertexCount = topology.vertexCount;
+    const size_t edgeCount = adjacency.edgeCount();
+
+    if (row >= vertexCount + edgeCount) {
+        // Punto de cara: media de sus vértices
+        builder.addFacePoint(topology, static_cast<uint32_t>(row - vertexCount - edgeCount), 1.0f);
+        return;
+    }
+
+    if (row >= vertexCount) {
+        const size_t e = row - vertexCount;
+        const uint32_t v0 = adjacency.edgeVertices[2 * e];
+        const uint32_t v1 = adjacency.edgeVertices[2 * e + 1];
+
+        if (adjacency.edgeFaceCount[e] == 2) {
+            // Arista interior: media de sus extremos y de los dos puntos de cara
+            builder.add(v0, 0.25f);
+            builder.add(v1, 0.25f);
+            builder.addFacePoint(topology, adjacency.edgeFaces[2 * e], 0.25f);
+            builder.addFacePoint(topology, adjacency.edgeFaces[2 * e + 1], 0.25f);
+        } else {
+            // Borde (o arista no manifold): punto medio
+            builder.add(v0, 0.5f);
+            builder.add(v1, 0.5f);
+        }
+        return;
+    }
+
+    const uint32_t v = static_cast<uint32_t>(row);
+    const uint32_t edgeBegin = adjacency.vertexEdgeOffsets[v];
+    const uint32_t edgeEnd = adjacency.vertexEdgeOffsets[v + 1];
+    const uint32_t faceBegin = adjacency.vertexFaceOffsets[v];
+    const uint32_t faceEnd = adjacency.vertexFaceOffsets[v + 1];
+
+    const uint32_t valence = edgeEnd - edgeBegin;
+
+    uint32_t boundaryNeighbors[2];
+    uint32_t boundaryCount = 0;
+
+    for (uint32_t i = edgeBegin; i < edgeEnd; i++) {
+        const uint32_t e = adjacency.vertexEdges[i];
+        if (adjacency.edgeFaceCount[e] != 2) {
+            if (boundaryCount < 2) {
+                const uint32_t a = adjacency.edgeVertices[2 * e];
+                boundaryNeighbors[boundaryCount] = (a == v) ? adjacency.edgeVertices[2 * e + 1] : a;
+            }
+            boundaryCount++;
+        }
+    }
+
+    if (boundaryCount == 0 && valence >= 3 && faceEnd - faceBegin == valence) {
+        // Vértice interior: (Q + 2R + (n - 3)S) / n
+        const float n = static_cast<float>(valence);
+        const float faceWeight = 1.0f / (n * n);
+        const float edgeWeight = 1.0f / (n * n);
+
+        builder.add(v, (n - 3.0f) / n);
+
+        for (uint32_t i = faceBegin; i < faceEnd; i++) {
+            builder.addFacePoint(topology, adjacency.vertexFaces[i], faceWeight);
+        }
+
+        // Cada punto medio de arista aporta 2/n * 1/n * (v + otro) / 2
+        for (uint32_t i = edgeBegin; i < edgeEnd; i++) {
+            const uint32_t e = adjacency.vertexEdges[i];
+            builder.add(adjacency.edgeVertices[2 * e], edgeWeight);
+            builder.add(adjacency.edgeVertices[2 * e + 1], edgeWeight);
+        }
+    } else if (boundaryCount == 2) {
+        // Vértice de borde: regla de la B-spline cúbica sobre el borde
+        builder.add(v, 0.75f);
+        builder.add(boundaryNeighbors[0], 0.125f);
+        builder.add(boundaryNeighbors[1], 0.125f);
+    } else {
+        // Esquinas, vértices aislados o no manifold: se mantienen fijos
+        builder.add(v, 1.0f);
+    }
+}
+
+StencilTable buildStencilTable(const Topology& topology, const Adjacency& adjacency) {
+    const size_t rows = topology.vertexCount + adjacency.edgeCount() + topology.faceCount();
+
+    // Cada bloque construye su trozo de tabla y luego se concatenan
+    std::vector<StencilTable> partial(core::chunkCount(rows, kMinChunk));
+
+    core::parallelFor(rows, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        RowBuilder builder;
+        StencilTable& table = partial[chunk];
+
+        for (size_t row = begin; row < end; row++) {
+            buildRow(topology, adjacency, row, builder);
+            builder.flush(table);
+        }
+    });
+
+    StencilTable table;
+    table.offsets.reserve(rows + 1);
+
+    for (const StencilTable& part : partial) {
+        const uint32_t base = static_cast<uint32_t>(table.indices.size());
+
+        for (size_t i = 1; i < part.offsets.size(); i++) {
+            table.offsets.push_back(base + part.offsets[i]);
+        }
+        table.indices.insert(table.indices.end(), part.indices.begin(), part.indices.end());
+        table.weights.insert(table.weights.end(), part.weights.begin(), part.weights.end());
+    }
+
+    return table;
+}
+
+// Cada cara de k lados genera k quads: (vértice, arista, cara, arista anterior)
+Topology refineTopology(const Topology& topology, const Adjacency& adjacency) {
+    const uint32_t vertexCount = topology.vertexCount;
+    const uint32_t edgeBase = vertexCount;
+    const uint32_t faceBase = vertexCount + static_cast<uint32_t>(adjacency.edgeCount());
+
+    Topology refined;
+    refined.vertexCount = faceBase + static_cast<uint32_t>(topology.faceCount());
+    refined.faceOffsets.reserve(topology.faceVertices.size() + 1);
+    refined.faceVertices.reserve(topology.faceVertices.size() * 4);
+
+    for (size_t f = 0; f < topology.faceCount(); f++) {
+        const uint32_t begin = topology.faceOffsets[f];
+        const uint32_t end = topology.faceOffsets[f + 1];
+
+        for (uint32_t c = begin; c < end; c++) {
+            const uint32_t previous = (c > begin) ? c - 1 : end - 1;
+
+            refined.faceVertices.push_back(topology.faceVertices[c]);
+            refined.faceVertices.push_back(edgeBase + adjacency.cornerEdges[c]);
+            refined.faceVertices.push_back(faceBase + static_cast<uint32_t>(f));
+            refined.faceVertices.push_back(edgeBase + adjacency.cornerEdges[previous]);
+
+            refined.faceOffsets.push_back(static_cast<uint32_t>(refined.faceVertices.size()));
+        }
+    }
+
+    return refined;
+}
+
+// dst[fila] = suma de peso * src[índice], con 8 floats por vértice
+void applyStencils(const StencilTable& table, const float* src, float* dst) {
+    core::parallelFor(table.size(), kMinChunk, [&](size_t begin, size_t end, size_t) {
+        for (size_t row = begin; row < end; row++) {
+            const uint32_t entryBegin = table.offsets[row];
+            const uint32_t entryEnd = table.offsets[row + 1];
+            float* out = dst + row * kPrimvarWidth;
+
+#if defined(__AVX__)
+            __m256 acc = _mm256_setzero_ps();
+            for (uint32_t e = entryBegin; e < entryEnd; e++) {
+                const __m256 w = _mm256_set1_ps(table.weights[e]);
+                const __m256 value = _mm256_load_ps(src + table.indices[e] * kPrimvarWidth);
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(w, value));
+            }
+            _mm256_store_ps(out, acc);
+#elif defined(__SSE2__)
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            for (uint32_t e = entryBegin; e < entryEnd; e++) {
+                const __m128 w = _mm_set1_ps(table.weights[e]);
+                const float* value = src + table.indices[e] * kPrimvarWidth;
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_load_ps(value)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_load_ps(value + 4)));
+            }
+            _mm_store_ps(out, acc0);
+            _mm_store_ps(out + 4, acc1);
+#else
+            float acc[kPrimvarWidth] = {};
+            for (uint32_t e = entryBegin; e < entryEnd; e++) {
+                const float w = table.weights[e];
+                const float* value = src + table.indices[e] * kPrimvarWidth;
+                for (size_t k = 0; k < kPrimvarWidth; k++) {
+                    acc[k] += w * value[k];
+                }
+            }
+            std::copy(acc, acc + kPrimvarWidth, out);
+#endif
+        }
+    });
+}
+
+// Vector con datos alineados a 32 bytes para las cargas alineadas
+float* alignedData(std::vector<float>& buffer, size_t vertexCount) {
+    buffer.resize(vertexCount * kPrimvarWidth + kPrimvarWidth);
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(buffer.data());
+    const uintptr_t aligned = (address + 31) & ~uintptr_t(31);
+
+    return reinterpret_cast<float*>(aligned);
+}
+
+} // namespace
+
+size_t StencilTable::size() const {
+    return offsets.size() - 1;
+}
+
+SubdivisionSurface::SubdivisionSurface(const Mesh& cage, int levels)
+    : mLevels(std::max(levels, 0)),
+    mCageVertexCount(cage.vertices.size()) {
+
+    Topology topology;
+    topology.vertexCount = static_cast<uint32_t>(cage.vertices.size());
+    topology.faceVertices = cage.indices;
+    topology.faceOffsets.reserve(cage.indices.size() / 3 + 1);
+
+    for (size_t i = 3; i <= cage.indices.size(); i += 3) {
+        topology.faceOffsets.push_back(static_cast<uint32_t>(i));
+    }
+    topology.faceVertices.resize(topology.faceOffsets.back());
+
+    for (int level = 0; level < mLevels; level++) {
+        const Adjacency adjacency = buildAdjacency(topology);
+
+        mTables.push_back(buildStencilTable(topology, adjacency));
+        topology = refineTopology(topology, adjacency);
+    }
+
+    // Triangulación del último nivel
+    mIndices.reserve(topology.faceVertices.size() * 3 / 2);
+
+    for (size_t f = 0; f < topology.faceCount(); f++) {
+        const uint32_t begin = topology.faceOffsets[f];
+        const uint32_t end = topology.faceOffsets[f + 1];
+
+        for (uint32_t c = begin + 1; c + 1 < end; c++) {
+            mIndices.push_back(topology.faceVertices[begin]);
+            mIndices.push_back(topology.faceVertices[c]);
+            mIndices.push_back(topology.faceVertices[c + 1]);
+        }
+    }
+}
+
+int SubdivisionSurface::getLevels() const {
+    return mLevels;
+}
+
+size_t SubdivisionSurface::getCageVertexCount() const {
+    return mCageVertexCount;
+}
+
+size_t SubdivisionSurface::getRefinedVertexCount() const {
+    return mTables.empty() ? mCageVertexCount : mTables.back().size();
+}
+
+const std::vector<uint32_t>& SubdivisionSurface::getIndices() const {
+    return mIndices;
+}
+
+const std::vector<StencilTable>& SubdivisionSurface::getTables() const {
+    return mTables;
+}
+
+bool SubdivisionSurface::evaluate(
+    const std::vector<Vertex>& cageVertices,
+    std::vector<Vertex>& refinedVertices,
+    SubdivisionScratch& scratch) const {
+
+    if (cageVertices.size() != mCageVertexCount) {
+        std::cerr << "Error: La jaula tiene " << cageVertices.size()
+            << " vértices y la subdivisión se construyó con " << mCageVertexCount << "." << std::endl;
+        return false;
+    }
+
+    refinedVertices.resize(getRefinedVertexCount());
+
+    if (mTables.empty()) {
+        std::copy(cageVertices.begin(), cageVertices.end(), refinedVertices.begin());
+        return true;
+    }
+
+    float* src = alignedData(scratch.levels[0], mCageVertexCount);
+
+    core::parallelFor(mCageVertexCount, kMinChunk, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            const Vertex& vertex = cageVertices[i];
+            float* out = src + i * kPrimvarWidth;
+
+            out[0] = vertex.position.x;
+            out[1] = vertex.position.y;
+            out[2] = vertex.position.z;
+            out[3] = 0.0f;
+            out[4] = vertex.color.r;
+            out[5] = vertex.color.g;
+            out[6] = vertex.color.b;
+            out[7] = 0.0f;
+        }
+    });
+
+    int current = 0;
+
+    for (const StencilTable& table : mTables) {
+        float* dst = alignedData(scratch.levels[1 - current], table.size());
+        applyStencils(table, src, dst);
+
+        src = dst;
+        current = 1 - current;
+    }
+
+    core::parallelFor(refinedVertices.size(), kMinChunk, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            const float* value = src + i * kPrimvarWidth;
+
+            refinedVertices[i].position = glm::vec3(value[0], value[1], value[2]);
+            refinedVertices[i].color = glm::vec3(value[4], value[5], value[6]);
+        }
+    });
+    return true;
+}
+
+bool SubdivisionSurface::evaluate(
+    const std::vector<Vertex>& cageVertices,
+    std::vector<Vertex>& refinedVertices) const {
+
+    SubdivisionScratch scratch;
+    return evaluate(cageVertices, refinedVertices, scratch);
+}
+
+Mesh SubdivisionSurface::refine(const Mesh& cage) const {
+    std::vector<Vertex> vertices;
+    if (!evaluate(cage.vertices, vertices)) {
+        return Mesh({}, {});
+    }
+
+    return Mesh(vertices, mIndices);
+}
+
+} // namespace app::geometry
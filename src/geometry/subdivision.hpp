@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mesh.hpp"
+
+// Subdivisión Catmull-Clark con topología precalculada.
+//
+// Al construir la superficie se analiza la topología de la malla de control
+// (la "jaula") una sola vez y se genera, por cada nivel, una tabla de stencils:
+// cada vértice refinado es una combinación lineal fija de vértices del nivel
+// anterior. Reevaluar tras mover vértices de la jaula se reduce a aplicar esas
+// tablas, es decir, productos matriz dispersa por vector.
+
+namespace app::geometry {
+
+// Matriz dispersa en formato CSR: la fila i usa las entradas
+// [offsets[i], offsets[i + 1]) de 'indices' y 'weights'.
+struct StencilTable {
+    std::vector<uint32_t> offsets{ 0 };
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+
+    size_t size() const;
+};
+
+// Buffers intermedios entre niveles de una evaluación: 8 floats por vértice
+// (posición y color rellenados a 4 para cargarlos con SIMD). Los pone quien
+// evalúa, así una misma superficie se puede evaluar desde varias hebras (o
+// desde las copias de un Object que la comparten) sin pisarse
+struct SubdivisionScratch {
+    std::vector<float> levels[2];
+};
+
+class SubdivisionSurface {
+private:
+    int mLevels = 0;
+    size_t mCageVertexCount = 0;
+
+    std::vector<StencilTable> mTables;
+
+    // Triángulos del último nivel (cada quad refinado da dos)
+    std::vector<uint32_t> mIndices;
+
+public:
+    SubdivisionSurface(const Mesh& cage, int levels);
+
+    int getLevels() const;
+    size_t getCageVertexCount() const;
+    size_t getRefinedVertexCount() const;
+    const std::vector<uint32_t>& getIndices() const;
+    const std::vector<StencilTable>& getTables() const;
+
+    // Aplica las tablas a los vértices de la jaula (posición y color).
+    // 'cageVertices' debe tener la misma topología con la que se construyó;
+    // si no tiene los mismos vértices devuelve falso y no toca
+    // 'refinedVertices'. Reutilizar 'scratch' entre llamadas evita reservar
+    // memoria cada vez
+    bool evaluate(
+        const std::vector<Vertex>& cageVertices,
+        std::vector<Vertex>& refinedVertices,
+        SubdivisionScratch& scratch
+    ) const;
+    bool evaluate(
+        const std::vector<Vertex>& cageVertices,
+        std::vector<Vertex>& refinedVertices
+    ) const;
+
+    // Malla vacía si 'cage' no tiene los vértices de la jaula
+    Mesh refine(const Mesh& cage) const;
+};
+
+} // namespace app::geometry
@@ -4,14 +4,19 @@
 namespace app::geometry {
 
 struct Vertex {
-    glm::vec3 position;
+    glm::vec3 position{ 0.0f };
     glm::vec3 color{ 1.0f, 1.0f, 1.0f };
 
-    Vertex() = default;
+    // constexpr para poder generar mallas fijas en tiempo de compilación
+    constexpr Vertex() = default;
 
-    Vertex(const glm::vec3& pos);
+    constexpr Vertex(const glm::vec3& pos)
+        : position(pos) {
+    }
 
-    Vertex(const glm::vec3& pos, const glm::vec3& col);
+    constexpr Vertex(const glm::vec3& pos, const glm::vec3& col)
+        : position(pos), color(col) {
+    }
 };
 
 } // namespace geometry
@@ -7,6 +7,11 @@ int main(int argc, char* argv []) {
 
     app.init();
 
+    // ./ventana [malla.cmsh]: abre una malla troceada en disco
+    if (argc > 1 && !app.mScene.addStreamedMesh(argv[1])) {
+        return 1;
+    }
+
     app.run();
 
     app.shutdown();
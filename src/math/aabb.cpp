@@ -1,4 +1,5 @@
 #include "aabb.hpp"
+#include "bounds.hpp"
 #include "geometry/mesh.hpp"
 
 namespace math {
@@ -13,14 +14,12 @@ AABB calculateBoundingBox(const app::geometry::Mesh& mesh) {
         };
     }
 
-    glm::vec3 min = mesh.vertices[0].position;
-    glm::vec3 max = mesh.vertices[0].position;
-
-    for (const app::geometry::Vertex& vertex : mesh.vertices) {
-        min = glm::min(min, vertex.position);
-        max = glm::max(max, vertex.position);
-    }
-    return AABB{ min, max };
+    // Recorremos las posiciones directamente dentro de los Vertex
+    return calculateBoundingBox(
+        &mesh.vertices[0].position,
+        mesh.vertices.size(),
+        sizeof(app::geometry::Vertex)
+    );
 }
 
-} // namespace math
\ No newline at end of file
+} // namespace math
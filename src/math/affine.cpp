@@ -0,0 +1,109 @@
+#include "affine.hpp"
+
+#include <algorithm>
+
+namespace math {
+
+Affine3x4::Affine3x4(const glm::mat4& matrix) {
+    for (int row = 0; row < 3; row++) {
+        rows[row] = glm::vec4(matrix[0][row], matrix[1][row], matrix[2][row], matrix[3][row]);
+    }
+}
+
+Affine3x4 Affine3x4::fromTranslation(const glm::vec3& translation) {
+    Affine3x4 result;
+    for (int row = 0; row < 3; row++) {
+        result.rows[row].w = translation[row];
+    }
+    return result;
+}
+
+Affine3x4 Affine3x4::fromTransform(const Transform& transform, const glm::dvec3& origin) {
+    const glm::mat3 basis = glm::mat3_cast(transform.rotation);
+    const glm::vec3& s = transform.scale;
+    const glm::vec3 p(transform.position - origin);
+
+    Affine3x4 result;
+    for (int row = 0; row < 3; row++) {
+        result.rows[row] = glm::vec4(basis[0][row] * s.x, basis[1][row] * s.y, basis[2][row] * s.z, p[row]);
+    }
+    return result;
+}
+
+glm::mat4 Affine3x4::toMatrix() const {
+    return glm::mat4(
+        glm::vec4(getColumn(0), 0.0f),
+        glm::vec4(getColumn(1), 0.0f),
+        glm::vec4(getColumn(2), 0.0f),
+        glm::vec4(getColumn(3), 1.0f));
+}
+
+Affine3x4 operator*(const Affine3x4& a, const Affine3x4& b) {
+    Affine3x4 result;
+    for (int row = 0; row < 3; row++) {
+        const glm::vec4& r = a.rows[row];
+        result.rows[row] = r.x * b.rows[0] + r.y * b.rows[1] + r.z * b.rows[2] + glm::vec4(0.0f, 0.0f, 0.0f, r.w);
+    }
+    return result;
+}
+
+Affine3x4 inverseTransform(const Transform& transform, const glm::dvec3& origin) {
+    const glm::mat3 basis = glm::mat3_cast(transform.rotation);
+    const glm::vec3 position(transform.position - origin);
+
+    // Fila i de S⁻¹ Rᵀ: la columna i de R dividida por la escala i
+    Affine3x4 result;
+    for (int row = 0; row < 3; row++) {
+        const glm::vec3 axis = basis[row] / transform.scale[row];
+        result.rows[row] = glm::vec4(axis, -glm::dot(axis, position));
+    }
+    return result;
+}
+
+Affine3x4 inverse(const Affine3x4& m) {
+    const glm::vec4& a = m.rows[0];
+    const glm::vec4& b = m.rows[1];
+    const glm::vec4& c = m.rows[2];
+
+    // Adjunta de la 3x3 (cofactores traspuestos) y un solo determinante
+    const float c00 = b.y * c.z - b.z * c.y;
+    const float c01 = a.z * c.y - a.y * c.z;
+    const float c02 = a.y * b.z - a.z * b.y;
+    const float c10 = b.z * c.x - b.x * c.z;
+    const float c11 = a.x * c.z - a.z * c.x;
+    const float c12 = a.z * b.x - a.x * b.z;
+    const float c20 = b.x * c.y - b.y * c.x;
+    const float c21 = a.y * c.x - a.x * c.y;
+    const float c22 = a.x * b.y - a.y * b.x;
+
+    const float invDet = 1.0f / (a.x * c00 + a.y * c10 + a.z * c20);
+
+    Affine3x4 result;
+    result.rows[0] = glm::vec4(c00, c01, c02, 0.0f) * invDet;
+    result.rows[1] = glm::vec4(c10, c11, c12, 0.0f) * invDet;
+    result.rows[2] = glm::vec4(c20, c21, c22, 0.0f) * invDet;
+
+    // Traslación: -A⁻¹ t
+    const glm::vec4 t(a.w, b.w, c.w, 0.0f);
+    for (int row = 0; row < 3; row++) {
+        result.rows[row].w = -glm::dot(result.rows[row], t);
+    }
+    return result;
+}
+
+AABB transformBoundingBox(const AABB& box, const Affine3x4& m) {
+    const glm::vec3 translation = m.getTranslation();
+    AABB result{ translation, translation };
+
+    for (int column = 0; column < 3; column++) {
+        for (int row = 0; row < 3; row++) {
+            const float a = m.rows[row][column] * box.min[column];
+            const float b = m.rows[row][column] * box.max[column];
+            result.min[row] += std::min(a, b);
+            result.max[row] += std::max(a, b);
+        }
+    }
+    return result;
+}
+
+} // namespace math
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+#include "transform.hpp"
+
+// Matriz afín guardada como sus tres primeras filas (la cuarta de una
+// matriz de modelo es siempre 0 0 0 1): 12 floats en vez de 16.
+//
+// Fila i = (m[0][i], m[1][i], m[2][i], traslación[i]), el mismo formato
+// que las filas 3x4 de composeModelMatrices y que un 'mat4x3' de GLSL
+// subido con glUniformMatrix4x3fv(..., GL_TRUE, ...).
+
+namespace math {
+
+struct Affine3x4 {
+    glm::vec4 rows[3] = {
+        glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
+        glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
+        glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)
+    };
+
+    Affine3x4() = default;
+
+    // Descarta la cuarta fila: solo vale para matrices afines
+    explicit Affine3x4(const glm::mat4& matrix);
+
+    static Affine3x4 fromTranslation(const glm::vec3& translation);
+
+    // T * R * S sin pasar por una 4x4, relativa a 'origin' como
+    // Transform::getModelMatrix
+    static Affine3x4 fromTransform(const Transform& transform, const glm::dvec3& origin = glm::dvec3(0.0));
+
+    glm::mat4 toMatrix() const;
+
+    glm::vec3 getColumn(int column) const {
+        return glm::vec3(rows[0][column], rows[1][column], rows[2][column]);
+    }
+    glm::vec3 getTranslation() const { return getColumn(3); }
+
+    glm::vec3 transformPoint(const glm::vec3& p) const {
+        const glm::vec4 h(p, 1.0f);
+        return glm::vec3(glm::dot(rows[0], h), glm::dot(rows[1], h), glm::dot(rows[2], h));
+    }
+
+    glm::vec3 transformVector(const glm::vec3& v) const {
+        const glm::vec4 h(v, 0.0f);
+        return glm::vec3(glm::dot(rows[0], h), glm::dot(rows[1], h), glm::dot(rows[2], h));
+    }
+
+    const float* data() const { return &rows[0][0]; }
+};
+
+static_assert(sizeof(Affine3x4) == 12 * sizeof(float), "Affine3x4 debe ocupar 12 floats seguidos");
+
+Affine3x4 operator*(const Affine3x4& a, const Affine3x4& b);
+
+// Inversa de T * R * S (relativa a 'origin') en forma cerrada:
+// S⁻¹ * Rᵀ * T⁻¹. Sin determinante ni adjunta; la escala no puede ser nula
+// en ningún eje
+Affine3x4 inverseTransform(const Transform& transform, const glm::dvec3& origin = glm::dvec3(0.0));
+
+// Inversa de una afín cualquiera: la 3x3 por su adjunta (un solo
+// determinante de 3x3) y la traslación como -A⁻¹ t, sin los cofactores 4x4
+// de glm::inverse
+Affine3x4 inverse(const Affine3x4& m);
+
+// Caja que envuelve la caja 'box' transformada por 'm' (método de Arvo):
+// la caja de mundo de un objeto a partir de la local y su matriz de modelo
+AABB transformBoundingBox(const AABB& box, const Affine3x4& m);
+
+} // namespace math
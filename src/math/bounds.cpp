@@ -0,0 +1,927 @@
+#include "bounds.hpp"
+#include "geometry/mesh.hpp"
+#include "core/parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace math {
+
+namespace {
+
+// Por debajo de este tamaño no compensa lanzar hilos
+constexpr size_t kMinChunk = 1 << 16;
+
+// Direcciones de EPOS-14: los 3 ejes y las 4 diagonales del cubo.
+// Ritter usa solo las 3 primeras.
+constexpr int kEposNormals = 7;
+const glm::vec3 kNormals[kEposNormals] = {
+    { 1.0f,  0.0f,  0.0f },
+    { 0.0f,  1.0f,  0.0f },
+    { 0.0f,  0.0f,  1.0f },
+    { 1.0f,  1.0f,  1.0f },
+    { 1.0f,  1.0f, -1.0f },
+    { 1.0f, -1.0f,  1.0f },
+    { 1.0f, -1.0f, -1.0f }
+};
+
+inline const glm::vec3& positionAt(const glm::vec3* positions, size_t stride, size_t i) {
+    return *reinterpret_cast<const glm::vec3*>(
+        reinterpret_cast<const unsigned char*>(positions) + i * stride);
+}
+
+// Índice (exclusivo) hasta el que se puede leer cada posición con una carga
+// de 16 bytes. Con stride de 12 bytes la última posición no tiene 4 floats.
+inline size_t simdLimit(size_t count, size_t stride) {
+    if (stride >= sizeof(float) * 4) {
+        return count;
+    }
+    return count > 0 ? count - 1 : 0;
+}
+
+// Los índices de los extremos se guardan en enteros de 32 bits en SSE
+inline bool simdIndexable(size_t count) {
+    return count < (size_t(1) << 31);
+}
+
+#if defined(__SSE2__)
+inline __m128 load4(const glm::vec3* positions, size_t stride, size_t i) {
+    return _mm_loadu_ps(&positionAt(positions, stride, i).x);
+}
+
+// Carga 4 posiciones consecutivas y las transpone a x, y, z (SoA)
+inline void loadSoA(const glm::vec3* positions, size_t stride, size_t i,
+    __m128& x, __m128& y, __m128& z) {
+
+    __m128 r0 = load4(positions, stride, i);
+    __m128 r1 = load4(positions, stride, i + 1);
+    __m128 r2 = load4(positions, stride, i + 2);
+    __m128 r3 = load4(positions, stride, i + 3);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    x = r0;
+    y = r1;
+    z = r2;
+}
+
+inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+AABB boundsOfRange(const glm::vec3* positions, size_t stride,
+    size_t begin, size_t end, size_t limit) {
+
+    glm::vec3 min = positionAt(positions, stride, begin);
+    glm::vec3 max = min;
+
+    size_t i = begin;
+
+#if defined(__SSE2__)
+    const size_t simdEnd = std::min(end, limit);
+
+    if (i + 4 <= simdEnd) {
+        // Cuatro acumuladores independientes para no encadenar latencias
+        __m128 min0 = load4(positions, stride, i);
+        __m128 max0 = min0;
+        __m128 min1 = min0, max1 = min0;
+        __m128 min2 = min0, max2 = min0;
+        __m128 min3 = min0, max3 = min0;
+
+        for (; i + 4 <= simdEnd; i += 4) {
+            const __m128 p0 = load4(positions, stride, i);
+            const __m128 p1 = load4(positions, stride, i + 1);
+            const __m128 p2 = load4(positions, stride, i + 2);
+            const __m128 p3 = load4(positions, stride, i + 3);
+
+            min0 = _mm_min_ps(min0, p0); max0 = _mm_max_ps(max0, p0);
+            min1 = _mm_min_ps(min1, p1); max1 = _mm_max_ps(max1, p1);
+            min2 = _mm_min_ps(min2, p2); max2 = _mm_max_ps(max2, p2);
+            min3 = _mm_min_ps(min3, p3); max3 = _mm_max_ps(max3, p3);
+        }
+
+        min0 = _mm_min_ps(_mm_min_ps(min0, min1), _mm_min_ps(min2, min3));
+        max0 = _mm_max_ps(_mm_max_ps(max0, max1), _mm_max_ps(max2, max3));
+
+        alignas(16) float minOut[4];
+        alignas(16) float maxOut[4];
+        _mm_store_ps(minOut, min0);
+        _mm_store_ps(maxOut, max0);
+
+        min = glm::vec3(minOut[0], minOut[1], minOut[2]);
+        max = glm::vec3(maxOut[0], maxOut[1], maxOut[2]);
+    }
+#endif
+
+    for (; i < end; i++) {
+        const glm::vec3& p = positionAt(positions, stride, i);
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+
+    return AABB{ min, max };
+}
+
+// Puntos extremos (mínimo y máximo) en la proyección sobre cada dirección
+struct Extremes {
+    float minProj[kEposNormals];
+    float maxProj[kEposNormals];
+    size_t minIndex[kEposNormals];
+    size_t maxIndex[kEposNormals];
+};
+
+Extremes extremesOfRange(const glm::vec3* positions, size_t stride,
+    size_t begin, size_t end, size_t limit, int normalCount) {
+
+    Extremes result;
+    for (int k = 0; k < normalCount; k++) {
+        result.minProj[k] = std::numeric_limits<float>::infinity();
+        result.maxProj[k] = -std::numeric_limits<float>::infinity();
+        result.minIndex[k] = begin;
+        result.maxIndex[k] = begin;
+    }
+
+    size_t i = begin;
+
+#if defined(__SSE2__)
+    const size_t simdEnd = std::min(end, limit);
+
+    if (simdIndexable(end) && i + 4 <= simdEnd) {
+        __m128 minProj[kEposNormals];
+        __m128 maxProj[kEposNormals];
+        __m128 minIndex[kEposNormals];
+        __m128 maxIndex[kEposNormals];
+
+        for (int k = 0; k < normalCount; k++) {
+            minProj[k] = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            maxProj[k] = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            minIndex[k] = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(begin)));
+            maxIndex[k] = minIndex[k];
+        }
+
+        __m128i index = _mm_setr_epi32(
+            static_cast<int>(i), static_cast<int>(i + 1),
+            static_cast<int>(i + 2), static_cast<int>(i + 3));
+        const __m128i four = _mm_set1_epi32(4);
+
+        for (; i + 4 <= simdEnd; i += 4) {
+            __m128 x, y, z;
+            loadSoA(positions, stride, i, x, y, z);
+
+            const __m128 indexBits = _mm_castsi128_ps(index);
+
+            for (int k = 0; k < normalCount; k++) {
+                const glm::vec3& n = kNormals[k];
+                const __m128 proj = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(x, _mm_set1_ps(n.x)),
+                        _mm_mul_ps(y, _mm_set1_ps(n.y))),
+                    _mm_mul_ps(z, _mm_set1_ps(n.z)));
+
+                const __m128 lower = _mm_cmplt_ps(proj, minProj[k]);
+                const __m128 greater = _mm_cmpgt_ps(proj, maxProj[k]);
+
+                minProj[k] = select(lower, proj, minProj[k]);
+                maxProj[k] = select(greater, proj, maxProj[k]);
+                minIndex[k] = select(lower, indexBits, minIndex[k]);
+                maxIndex[k] = select(greater, indexBits, maxIndex[k]);
+            }
+
+            index = _mm_add_epi32(index, four);
+        }
+
+        // Reducción horizontal de los 4 carriles
+        for (int k = 0; k < normalCount; k++) {
+            alignas(16) float minValues[4], maxValues[4];
+            alignas(16) int32_t minIndices[4], maxIndices[4];
+
+            _mm_store_ps(minValues, minProj[k]);
+            _mm_store_ps(maxValues, maxProj[k]);
+            _mm_store_si128(reinterpret_cast<__m128i*>(minIndices), _mm_castps_si128(minIndex[k]));
+            _mm_store_si128(reinterpret_cast<__m128i*>(maxIndices), _mm_castps_si128(maxIndex[k]));
+
+            for (int lane = 0; lane < 4; lane++) {
+                if (minValues[lane] < result.minProj[k]) {
+                    result.minProj[k] = minValues[lane];
+                    result.minIndex[k] = static_cast<size_t>(minIndices[lane]);
+                }
+                if (maxValues[lane] > result.maxProj[k]) {
+                    result.maxProj[k] = maxValues[lane];
+                    result.maxIndex[k] = static_cast<size_t>(maxIndices[lane]);
+                }
+            }
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        const glm::vec3& p = positionAt(positions, stride, i);
+
+        for (int k = 0; k < normalCount; k++) {
+            const float proj = glm::dot(p, kNormals[k]);
+
+            if (proj < result.minProj[k]) {
+                result.minProj[k] = proj;
+                result.minIndex[k] = i;
+            }
+            if (proj > result.maxProj[k]) {
+                result.maxProj[k] = proj;
+                result.maxIndex[k] = i;
+            }
+        }
+    }
+
+    return result;
+}
+
+Extremes findExtremes(const glm::vec3* positions, size_t count, size_t stride, int normalCount) {
+    const size_t limit = simdLimit(count, stride);
+
+    std::vector<Extremes> partial(core::chunkCount(count, kMinChunk));
+
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        partial[chunk] = extremesOfRange(positions, stride, begin, end, limit, normalCount);
+    });
+
+    Extremes result = partial[0];
+    for (size_t c = 1; c < partial.size(); c++) {
+        for (int k = 0; k < normalCount; k++) {
+            if (partial[c].minProj[k] < result.minProj[k]) {
+                result.minProj[k] = partial[c].minProj[k];
+                result.minIndex[k] = partial[c].minIndex[k];
+            }
+            if (partial[c].maxProj[k] > result.maxProj[k]) {
+                result.maxProj[k] = partial[c].maxProj[k];
+                result.maxIndex[k] = partial[c].maxIndex[k];
+            }
+        }
+    }
+    return result;
+}
+
+// Crecimiento de Ritter: si el punto queda fuera se desplaza el centro
+// y se agranda el radio lo justo para incluirlo.
+inline void growSphere(BoundingSphere& sphere, const glm::vec3& point) {
+    const glm::vec3 d = point - sphere.center;
+    const float distance2 = glm::dot(d, d);
+
+    if (distance2 <= sphere.radius * sphere.radius) {
+        return;
+    }
+
+    const float distance = std::sqrt(distance2);
+    const float newRadius = (sphere.radius + distance) * 0.5f;
+
+    sphere.center += d * ((newRadius - sphere.radius) / distance);
+    sphere.radius = newRadius;
+}
+
+void growSphereRange(BoundingSphere& sphere, const glm::vec3* positions, size_t stride,
+    size_t begin, size_t end, size_t limit) {
+
+    size_t i = begin;
+
+#if defined(__SSE2__)
+    // Descartamos en bloques de 4 los puntos que ya están dentro;
+    // solo los que quedan fuera pasan por el crecimiento escalar.
+    const size_t simdEnd = std::min(end, limit);
+
+    for (; i + 4 <= simdEnd; i += 4) {
+        __m128 x, y, z;
+        loadSoA(positions, stride, i, x, y, z);
+
+        const __m128 dx = _mm_sub_ps(x, _mm_set1_ps(sphere.center.x));
+        const __m128 dy = _mm_sub_ps(y, _mm_set1_ps(sphere.center.y));
+        const __m128 dz = _mm_sub_ps(z, _mm_set1_ps(sphere.center.z));
+
+        const __m128 distance2 = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+            _mm_mul_ps(dz, dz));
+
+        const int outside = _mm_movemask_ps(
+            _mm_cmpgt_ps(distance2, _mm_set1_ps(sphere.radius * sphere.radius)));
+
+        if (outside != 0) {
+            for (int lane = 0; lane < 4; lane++) {
+                growSphere(sphere, positionAt(positions, stride, i + lane));
+            }
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        growSphere(sphere, positionAt(positions, stride, i));
+    }
+}
+
+// Esfera que contiene a las dos esferas dadas
+BoundingSphere mergeSpheres(const BoundingSphere& a, const BoundingSphere& b) {
+    const glm::vec3 d = b.center - a.center;
+    const float distance = glm::length(d);
+
+    if (distance + b.radius <= a.radius) {
+        return a;
+    }
+    if (distance + a.radius <= b.radius) {
+        return b;
+    }
+
+    BoundingSphere result;
+    result.radius = (distance + a.radius + b.radius) * 0.5f;
+    result.center = a.center + d * ((result.radius - a.radius) / distance);
+    return result;
+}
+
+// Crece la esfera en paralelo: cada bloque parte de la misma esfera inicial
+// y el resultado final es la unión de las esferas de cada bloque.
+BoundingSphere growSphereParallel(const BoundingSphere& initial,
+    const glm::vec3* positions, size_t count, size_t stride) {
+
+    const size_t limit = simdLimit(count, stride);
+
+    std::vector<BoundingSphere> partial(core::chunkCount(count, kMinChunk), initial);
+
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        growSphereRange(partial[chunk], positions, stride, begin, end, limit);
+    });
+
+    BoundingSphere result = partial[0];
+    for (size_t c = 1; c < partial.size(); c++) {
+        result = mergeSpheres(result, partial[c]);
+    }
+
+    // Margen para absorber el redondeo en float del centro y del radio
+    const float magnitude = std::max({
+        std::abs(result.center.x),
+        std::abs(result.center.y),
+        std::abs(result.center.z),
+        result.radius
+    });
+    result.radius += magnitude * 4.0f * std::numeric_limits<float>::epsilon();
+
+    return result;
+}
+
+BoundingSphere sphereFromPair(const glm::vec3& a, const glm::vec3& b) {
+    return BoundingSphere{ (a + b) * 0.5f, glm::length(b - a) * 0.5f };
+}
+
+bool sphereContains(const BoundingSphere& sphere, const glm::vec3& point) {
+    const glm::vec3 d = point - sphere.center;
+    const float r = sphere.radius * (1.0f + 1e-5f) + 1e-6f;
+    return glm::dot(d, d) <= r * r;
+}
+
+// Circunferencia circunscrita al triángulo; si es degenerado,
+// la esfera del par más alejado.
+BoundingSphere sphereFromTriangle(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2) {
+    const glm::vec3 a = p1 - p0;
+    const glm::vec3 b = p2 - p0;
+    const glm::vec3 axb = glm::cross(a, b);
+    const float denominator = 2.0f * glm::dot(axb, axb);
+
+    if (denominator <= std::numeric_limits<float>::epsilon() * glm::dot(a, a) * glm::dot(b, b)) {
+        BoundingSphere best = sphereFromPair(p0, p1);
+        const BoundingSphere s02 = sphereFromPair(p0, p2);
+        const BoundingSphere s12 = sphereFromPair(p1, p2);
+        if (s02.radius > best.radius) best = s02;
+        if (s12.radius > best.radius) best = s12;
+        return best;
+    }
+
+    const glm::vec3 offset =
+        (glm::dot(a, a) * glm::cross(b, axb) + glm::dot(b, b) * glm::cross(axb, a)) / denominator;
+
+    return BoundingSphere{ p0 + offset, glm::length(offset) };
+}
+
+// Esfera circunscrita al tetraedro; si es degenerado, la menor esfera de
+// tres puntos que contiene al cuarto.
+BoundingSphere sphereFromTetrahedron(const glm::vec3& p0, const glm::vec3& p1,
+    const glm::vec3& p2, const glm::vec3& p3) {
+
+    const glm::vec3 a = p1 - p0;
+    const glm::vec3 b = p2 - p0;
+    const glm::vec3 c = p3 - p0;
+    const float determinant = 2.0f * glm::dot(a, glm::cross(b, c));
+
+    const float scale = glm::length(a) * glm::length(b) * glm::length(c);
+
+    if (std::abs(determinant) > 1e-6f * scale) {
+        const glm::vec3 offset = (
+            glm::dot(a, a) * glm::cross(b, c) +
+            glm::dot(b, b) * glm::cross(c, a) +
+            glm::dot(c, c) * glm::cross(a, b)) / determinant;
+
+        return BoundingSphere{ p0 + offset, glm::length(offset) };
+    }
+
+    const glm::vec3 points[4] = { p0, p1, p2, p3 };
+    BoundingSphere best{ glm::vec3(0.0f), std::numeric_limits<float>::infinity() };
+
+    for (int skip = 0; skip < 4; skip++) {
+        glm::vec3 tri[3];
+        int n = 0;
+        for (int k = 0; k < 4; k++) {
+            if (k != skip) tri[n++] = points[k];
+        }
+
+        const BoundingSphere candidate = sphereFromTriangle(tri[0], tri[1], tri[2]);
+        if (candidate.radius < best.radius && sphereContains(candidate, points[skip])) {
+            best = candidate;
+        }
+    }
+
+    if (std::isinf(best.radius)) {
+        best = sphereFromTriangle(p0, p1, p2);
+        growSphere(best, p3);
+    }
+    return best;
+}
+
+BoundingSphere sphereFromBoundary(const glm::vec3* boundary, int count) {
+    switch (count) {
+    case 0: return BoundingSphere{ glm::vec3(0.0f), -1.0f };
+    case 1: return BoundingSphere{ boundary[0], 0.0f };
+    case 2: return sphereFromPair(boundary[0], boundary[1]);
+    case 3: return sphereFromTriangle(boundary[0], boundary[1], boundary[2]);
+    default: return sphereFromTetrahedron(boundary[0], boundary[1], boundary[2], boundary[3]);
+    }
+}
+
+// Algoritmo de Welzl para la esfera mínima de un conjunto pequeño de puntos
+BoundingSphere welzl(const glm::vec3* points, int count, glm::vec3* boundary, int boundaryCount) {
+    if (count == 0 || boundaryCount == 4) {
+        return sphereFromBoundary(boundary, boundaryCount);
+    }
+
+    const glm::vec3& point = points[count - 1];
+    BoundingSphere sphere = welzl(points, count - 1, boundary, boundaryCount);
+
+    if (sphere.radius >= 0.0f && sphereContains(sphere, point)) {
+        return sphere;
+    }
+
+    boundary[boundaryCount] = point;
+    return welzl(points, count - 1, boundary, boundaryCount + 1);
+}
+
+// Autovalores y autovectores de una matriz simétrica 3x3 (método de Jacobi).
+// Los autovectores quedan en las columnas de 'vectors'.
+void jacobiEigen(double a[3][3], double vectors[3][3]) {
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            vectors[r][c] = (r == c) ? 1.0 : 0.0;
+        }
+    }
+
+    for (int sweep = 0; sweep < 50; sweep++) {
+        const double offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        const double diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (offDiagonal <= 1e-24 * diagonal || offDiagonal < 1e-300) {
+            break;
+        }
+
+        for (int p = 0; p < 2; p++) {
+            for (int q = p + 1; q < 3; q++) {
+                if (std::abs(a[p][q]) < 1e-300) {
+                    continue;
+                }
+
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t = (theta >= 0.0 ? 1.0 : -1.0) /
+                    (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+
+                for (int k = 0; k < 3; k++) {
+                    const double akp = a[k][p];
+                    const double akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; k++) {
+                    const double apk = a[p][k];
+                    const double aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; k++) {
+                    const double vkp = vectors[k][p];
+                    const double vkq = vectors[k][q];
+                    vectors[k][p] = c * vkp - s * vkq;
+                    vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+struct Moments {
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    double covariance[3][3] = {};
+};
+
+// Mínimo y máximo de las proyecciones sobre los tres ejes de la OBB,
+// relativas a 'origin' para no perder precisión.
+AABB projectRange(const glm::vec3* positions, size_t stride, size_t begin, size_t end,
+    size_t limit, const glm::vec3& origin, const glm::mat3& axes) {
+
+    glm::vec3 min(std::numeric_limits<float>::infinity());
+    glm::vec3 max(-std::numeric_limits<float>::infinity());
+
+    size_t i = begin;
+
+#if defined(__SSE2__)
+    const size_t simdEnd = std::min(end, limit);
+
+    if (i + 4 <= simdEnd) {
+        __m128 minAxis[3], maxAxis[3];
+        for (int k = 0; k < 3; k++) {
+            minAxis[k] = _mm_set1_ps(min[k]);
+            maxAxis[k] = _mm_set1_ps(max[k]);
+        }
+
+        for (; i + 4 <= simdEnd; i += 4) {
+            __m128 x, y, z;
+            loadSoA(positions, stride, i, x, y, z);
+
+            x = _mm_sub_ps(x, _mm_set1_ps(origin.x));
+            y = _mm_sub_ps(y, _mm_set1_ps(origin.y));
+            z = _mm_sub_ps(z, _mm_set1_ps(origin.z));
+
+            for (int k = 0; k < 3; k++) {
+                const glm::vec3& axis = axes[k];
+                const __m128 proj = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(x, _mm_set1_ps(axis.x)),
+                        _mm_mul_ps(y, _mm_set1_ps(axis.y))),
+                    _mm_mul_ps(z, _mm_set1_ps(axis.z)));
+
+                minAxis[k] = _mm_min_ps(minAxis[k], proj);
+                maxAxis[k] = _mm_max_ps(maxAxis[k], proj);
+            }
+        }
+
+        for (int k = 0; k < 3; k++) {
+            alignas(16) float minValues[4], maxValues[4];
+            _mm_store_ps(minValues, minAxis[k]);
+            _mm_store_ps(maxValues, maxAxis[k]);
+
+            for (int lane = 0; lane < 4; lane++) {
+                min[k] = std::min(min[k], minValues[lane]);
+                max[k] = std::max(max[k], maxValues[lane]);
+            }
+        }
+    }
+#endif
+
+    for (; i < end; i++) {
+        const glm::vec3 p = positionAt(positions, stride, i) - origin;
+
+        for (int k = 0; k < 3; k++) {
+            const float proj = glm::dot(p, axes[k]);
+            min[k] = std::min(min[k], proj);
+            max[k] = std::max(max[k], proj);
+        }
+    }
+
+    return AABB{ min, max };
+}
+
+} // namespace
+
+AABB calculateBoundingBox(const glm::vec3* positions, size_t count, size_t stride) {
+    if (count == 0) {
+        return AABB{ glm::vec3(0.0f), glm::vec3(0.0f) };
+    }
+
+    const size_t limit = simdLimit(count, stride);
+
+    std::vector<AABB> partial(core::chunkCount(count, kMinChunk));
+
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        partial[chunk] = boundsOfRange(positions, stride, begin, end, limit);
+    });
+
+    AABB result = partial[0];
+    for (size_t c = 1; c < partial.size(); c++) {
+        result.min = glm::min(result.min, partial[c].min);
+        result.max = glm::max(result.max, partial[c].max);
+    }
+    return result;
+}
+
+BoundingSphere calculateBoundingSphereRitter(const glm::vec3* positions, size_t count, size_t stride) {
+    if (count == 0) {
+        return BoundingSphere{};
+    }
+
+    // Par de extremos más separado entre los ejes X, Y y Z
+    const Extremes extremes = findExtremes(positions, count, stride, 3);
+
+    BoundingSphere initial;
+    float bestDistance2 = -1.0f;
+
+    for (int k = 0; k < 3; k++) {
+        const glm::vec3& a = positionAt(positions, stride, extremes.minIndex[k]);
+        const glm::vec3& b = positionAt(positions, stride, extremes.maxIndex[k]);
+        const float distance2 = glm::dot(b - a, b - a);
+
+        if (distance2 > bestDistance2) {
+            bestDistance2 = distance2;
+            initial = sphereFromPair(a, b);
+        }
+    }
+
+    return growSphereParallel(initial, positions, count, stride);
+}
+
+BoundingSphere calculateBoundingSphereEPOS(const glm::vec3* positions, size_t count, size_t stride) {
+    if (count == 0) {
+        return BoundingSphere{};
+    }
+
+    const Extremes extremes = findExtremes(positions, count, stride, kEposNormals);
+
+    glm::vec3 points[2 * kEposNormals];
+    int pointCount = 0;
+
+    for (int k = 0; k < kEposNormals; k++) {
+        points[pointCount++] = positionAt(positions, stride, extremes.minIndex[k]);
+        points[pointCount++] = positionAt(positions, stride, extremes.maxIndex[k]);
+    }
+
+    glm::vec3 boundary[4];
+    BoundingSphere initial = welzl(points, pointCount, boundary, 0);
+
+    return growSphereParallel(initial, positions, count, stride);
+}
+
+OBB calculateOrientedBoundingBox(const glm::vec3* positions, size_t count, size_t stride) {
+    if (count == 0) {
+        return OBB{};
+    }
+
+    const size_t chunks = core::chunkCount(count, kMinChunk);
+    std::vector<Moments> partial(chunks);
+
+    // Primera pasada: media
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        Moments& moments = partial[chunk];
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& p = positionAt(positions, stride, i);
+            moments.sum[0] += p.x;
+            moments.sum[1] += p.y;
+            moments.sum[2] += p.z;
+        }
+    });
+
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    for (const Moments& moments : partial) {
+        for (int k = 0; k < 3; k++) {
+            mean[k] += moments.sum[k];
+        }
+    }
+    for (int k = 0; k < 3; k++) {
+        mean[k] /= static_cast<double>(count);
+    }
+
+    // Segunda pasada: covarianza centrada
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        Moments& moments = partial[chunk];
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& p = positionAt(positions, stride, i);
+            const double d[3] = { p.x - mean[0], p.y - mean[1], p.z - mean[2] };
+
+            for (int r = 0; r < 3; r++) {
+                for (int c = r; c < 3; c++) {
+                    moments.covariance[r][c] += d[r] * d[c];
+                }
+            }
+        }
+    });
+
+    double covariance[3][3] = {};
+    for (const Moments& moments : partial) {
+        for (int r = 0; r < 3; r++) {
+            for (int c = r; c < 3; c++) {
+                covariance[r][c] += moments.covariance[r][c];
+            }
+        }
+    }
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < r; c++) {
+            covariance[r][c] = covariance[c][r];
+        }
+    }
+
+    double vectors[3][3];
+    jacobiEigen(covariance, vectors);
+
+    // Ordenamos los ejes de mayor a menor varianza
+    int order[3] = { 0, 1, 2 };
+    std::sort(order, order + 3, [&](int a, int b) {
+        return covariance[a][a] > covariance[b][b];
+    });
+
+    glm::mat3 axes;
+    for (int k = 0; k < 2; k++) {
+        axes[k] = glm::normalize(glm::vec3(
+            static_cast<float>(vectors[0][order[k]]),
+            static_cast<float>(vectors[1][order[k]]),
+            static_cast<float>(vectors[2][order[k]])));
+    }
+    // Base ortonormal a derechas
+    axes[1] = glm::normalize(axes[1] - axes[0] * glm::dot(axes[0], axes[1]));
+    axes[2] = glm::cross(axes[0], axes[1]);
+
+    const glm::vec3 origin(
+        static_cast<float>(mean[0]),
+        static_cast<float>(mean[1]),
+        static_cast<float>(mean[2]));
+
+    const size_t limit = simdLimit(count, stride);
+    std::vector<AABB> ranges(chunks);
+
+    core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+        ranges[chunk] = projectRange(positions, stride, begin, end, limit, origin, axes);
+    });
+
+    AABB local = ranges[0];
+    for (size_t c = 1; c < ranges.size(); c++) {
+        local.min = glm::min(local.min, ranges[c].min);
+        local.max = glm::max(local.max, ranges[c].max);
+    }
+
+    OBB result;
+    result.axes = axes;
+    result.center = origin + axes * ((local.min + local.max) * 0.5f);
+    result.halfExtents = (local.max - local.min) * 0.5f;
+    return result;
+}
+
+BoundingSphere calculateBoundingSphere(const app::geometry::Mesh& mesh) {
+    if (mesh.vertices.empty()) {
+        return BoundingSphere{};
+    }
+
+    return calculateBoundingSphereEPOS(
+        &mesh.vertices[0].position,
+        mesh.vertices.size(),
+        sizeof(app::geometry::Vertex));
+}
+
+OBB calculateOrientedBoundingBox(const app::geometry::Mesh& mesh) {
+    if (mesh.vertices.empty()) {
+        return OBB{};
+    }
+
+    return calculateOrientedBoundingBox(
+        &mesh.vertices[0].position,
+        mesh.vertices.size(),
+        sizeof(app::geometry::Vertex));
+}
+
+bool contains(const BoundingSphere& sphere, const glm::vec3& point) {
+    return sphereContains(sphere, point);
+}
+
+bool contains(const OBB& box, const glm::vec3& point) {
+    const glm::vec3 d = point - box.center;
+    const glm::vec3 tolerance = box.halfExtents * 1e-5f + glm::vec3(1e-5f);
+
+    for (int k = 0; k < 3; k++) {
+        if (std::abs(glm::dot(d, box.axes[k])) > box.halfExtents[k] + tolerance[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// SoA
+// ---------------------------------------------------------------------------
+
+namespace {
+
+inline size_t paddedSize(size_t count) {
+    return (count + 7) / 8 * 8;
+}
+
+// Añade un hueco (rellenando con ceros hasta el siguiente múltiplo de 8)
+// si los arrays están llenos
+template <size_t Size>
+void growSoA(std::vector<float>* const (&arrays)[Size], size_t count) {
+    if (count == arrays[0]->size()) {
+        for (std::vector<float>* array : arrays) {
+            array->resize(count + 8, 0.0f);
+        }
+    }
+}
+
+} // namespace
+
+void BoundingSphereSoA::reserve(size_t count) {
+    for (std::vector<float>& array : mCenter) {
+        array.reserve(paddedSize(count));
+    }
+    mRadius.reserve(paddedSize(count));
+}
+
+void BoundingSphereSoA::clear() {
+    for (std::vector<float>& array : mCenter) {
+        array.clear();
+    }
+    mRadius.clear();
+    mCount = 0;
+}
+
+void BoundingSphereSoA::add(const BoundingSphere& sphere) {
+    std::vector<float>* const arrays[] = { &mCenter[0], &mCenter[1], &mCenter[2], &mRadius };
+    growSoA(arrays, mCount);
+
+    for (int axis = 0; axis < 3; axis++) {
+        mCenter[axis][mCount] = sphere.center[axis];
+    }
+    mRadius[mCount] = sphere.radius;
+    mCount++;
+}
+
+size_t BoundingSphereSoA::size() const {
+    return mCount;
+}
+
+BoundingSphere BoundingSphereSoA::get(size_t index) const {
+    return BoundingSphere{
+        glm::vec3(mCenter[0][index], mCenter[1][index], mCenter[2][index]),
+        mRadius[index]
+    };
+}
+
+void OBBSoA::reserve(size_t count) {
+    for (int i = 0; i < 3; i++) {
+        mCenter[i].reserve(paddedSize(count));
+        mHalfExtents[i].reserve(paddedSize(count));
+        for (std::vector<float>& array : mAxes[i]) {
+            array.reserve(paddedSize(count));
+        }
+    }
+}
+
+void OBBSoA::clear() {
+    for (int i = 0; i < 3; i++) {
+        mCenter[i].clear();
+        mHalfExtents[i].clear();
+        for (std::vector<float>& array : mAxes[i]) {
+            array.clear();
+        }
+    }
+    mCount = 0;
+}
+
+void OBBSoA::add(const OBB& box) {
+    std::vector<float>* const arrays[] = {
+        &mCenter[0], &mCenter[1], &mCenter[2],
+        &mHalfExtents[0], &mHalfExtents[1], &mHalfExtents[2],
+        &mAxes[0][0], &mAxes[0][1], &mAxes[0][2],
+        &mAxes[1][0], &mAxes[1][1], &mAxes[1][2],
+        &mAxes[2][0], &mAxes[2][1], &mAxes[2][2]
+    };
+    growSoA(arrays, mCount);
+
+    for (int i = 0; i < 3; i++) {
+        mCenter[i][mCount] = box.center[i];
+        mHalfExtents[i][mCount] = box.halfExtents[i];
+        for (int c = 0; c < 3; c++) {
+            mAxes[i][c][mCount] = box.axes[i][c];
+        }
+    }
+    mCount++;
+}
+
+size_t OBBSoA::size() const {
+    return mCount;
+}
+
+OBB OBBSoA::get(size_t index) const {
+    OBB box;
+    for (int i = 0; i < 3; i++) {
+        box.center[i] = mCenter[i][index];
+        box.halfExtents[i] = mHalfExtents[i][index];
+        for (int c = 0; c < 3; c++) {
+            box.axes[i][c] = mAxes[i][c][index];
+        }
+    }
+    return box;
+}
+
+} // namespace math
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+
+// Volúmenes envolventes calculados sobre nubes de puntos grandes.
+// Todos los kernels reciben posiciones con un 'stride' en bytes, de forma
+// que pueden recorrer directamente un std::vector<Vertex> sin copiarlo.
+// Se paralelizan por bloques y usan SSE cuando está disponible.
+
+namespace math {
+
+// Esfera envolvente
+struct BoundingSphere {
+    glm::vec3 center{ 0.0f };
+    float radius = 0.0f;
+};
+
+// OBB significa Oriented Bounding Box: caja orientada.
+// Las columnas de 'axes' son los ejes locales (ortonormales).
+struct OBB {
+    glm::vec3 center{ 0.0f };
+    glm::mat3 axes{ 1.0f };
+    glm::vec3 halfExtents{ 0.0f };
+};
+
+AABB calculateBoundingBox(
+    const glm::vec3* positions,
+    size_t count,
+    size_t stride = sizeof(glm::vec3)
+);
+
+// Algoritmo de Ritter: esfera inicial desde los extremos en X, Y y Z
+// y una pasada de crecimiento sobre todos los puntos.
+BoundingSphere calculateBoundingSphereRitter(
+    const glm::vec3* positions,
+    size_t count,
+    size_t stride = sizeof(glm::vec3)
+);
+
+// EPOS-14 (Larsson): puntos extremos en 7 direcciones, esfera mínima
+// exacta de esos 14 puntos y crecimiento de Ritter. Más ajustada que Ritter.
+BoundingSphere calculateBoundingSphereEPOS(
+    const glm::vec3* positions,
+    size_t count,
+    size_t stride = sizeof(glm::vec3)
+);
+
+// Caja orientada según los ejes principales (PCA) de los puntos.
+OBB calculateOrientedBoundingBox(
+    const glm::vec3* positions,
+    size_t count,
+    size_t stride = sizeof(glm::vec3)
+);
+
+BoundingSphere calculateBoundingSphere(const app::geometry::Mesh& mesh);
+OBB calculateOrientedBoundingBox(const app::geometry::Mesh& mesh);
+
+bool contains(const BoundingSphere& sphere, const glm::vec3& point);
+bool contains(const OBB& box, const glm::vec3& point);
+
+// Versiones SoA (una componente por array) para los tests por lotes,
+// rellenadas hasta un múltiplo de 8 como AABBSoA
+class BoundingSphereSoA {
+private:
+    std::vector<float> mCenter[3];
+    std::vector<float> mRadius;
+    size_t mCount = 0;
+
+public:
+    static constexpr size_t kLanes = 8;
+
+    void reserve(size_t count);
+    void clear();
+    void add(const BoundingSphere& sphere);
+
+    size_t size() const;
+    BoundingSphere get(size_t index) const;
+
+    const float* center(int axis) const { return mCenter[axis].data(); }
+    const float* radius() const { return mRadius.data(); }
+};
+
+class OBBSoA {
+private:
+    std::vector<float> mCenter[3];
+    std::vector<float> mAxes[3][3];      // [eje local][componente]
+    std::vector<float> mHalfExtents[3];
+    size_t mCount = 0;
+
+public:
+    static constexpr size_t kLanes = 8;
+
+    void reserve(size_t count);
+    void clear();
+    void add(const OBB& box);
+
+    size_t size() const;
+    OBB get(size_t index) const;
+
+    const float* center(int axis) const { return mCenter[axis].data(); }
+    const float* axis(int local, int component) const { return mAxes[local][component].data(); }
+    const float* halfExtent(int axis) const { return mHalfExtents[axis].data(); }
+};
+
+} // namespace math
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+// Matemáticas evaluables en tiempo de compilación.
+//
+// Los tipos de glm ya son constexpr para la aritmética (+, *, dot, cross,
+// producto de matrices y cuaterniones...), pero no para lo que necesita
+// sqrt o trigonometría. Aquí están esas piezas, para poder generar tablas y
+// geometría fija como constantes (ver geometry/builtin_meshes.hpp).
+//
+// Cotas de error (comprobadas en test_constexpr_math.cpp):
+//   sqrt:     como mucho 1 ulp de double respecto a std::sqrt
+//   sin, cos: error absoluto <= 1e-15 * max(1, |x|)
+// En float, el resultado redondeado coincide con std:: salvo 1 ulp.
+
+namespace math::cx {
+
+constexpr double kPi = 3.14159265358979323846;
+
+namespace detail {
+
+// π/2 partido en dos para restar múltiplos sin perder los bits bajos
+constexpr double kHalfPiHigh = 1.57079632679489655800e+00;
+constexpr double kHalfPiLow = 6.12323399573676603587e-17;
+
+constexpr long long nearest(double x) {
+    return x >= 0.0 ? static_cast<long long>(x + 0.5) : -static_cast<long long>(0.5 - x);
+}
+
+// Series de Taylor en |x| <= π/4; el primer término omitido es < 1e-19
+constexpr double sinKernel(double x) {
+    const double x2 = x * x;
+    double sum = 1.0 / 355687428096000.0;     // 1/17!
+    sum = sum * -x2 + 1.0 / 1307674368000.0;  // 1/15!
+    sum = sum * -x2 + 1.0 / 6227020800.0;
+    sum = sum * -x2 + 1.0 / 39916800.0;
+    sum = sum * -x2 + 1.0 / 362880.0;
+    sum = sum * -x2 + 1.0 / 5040.0;
+    sum = sum * -x2 + 1.0 / 120.0;
+    sum = sum * -x2 + 1.0 / 6.0;
+    return x - x * x2 * sum;
+}
+
+constexpr double cosKernel(double x) {
+    const double x2 = x * x;
+    double sum = 1.0 / 6402373705728000.0;    // 1/18!
+    sum = sum * -x2 + 1.0 / 20922789888000.0; // 1/16!
+    sum = sum * -x2 + 1.0 / 87178291200.0;
+    sum = sum * -x2 + 1.0 / 479001600.0;
+    sum = sum * -x2 + 1.0 / 3628800.0;
+    sum = sum * -x2 + 1.0 / 40320.0;
+    sum = sum * -x2 + 1.0 / 720.0;
+    sum = sum * -x2 + 1.0 / 24.0;
+    return 1.0 - 0.5 * x2 + x2 * x2 * sum;
+}
+
+} // namespace detail
+
+// Newton sobre la mantisa llevada a [1, 4) con potencias de 4 exactas
+constexpr double sqrt(double x) {
+    if (x != x || x < 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (x == 0.0 || x == std::numeric_limits<double>::infinity()) {
+        return x;
+    }
+
+    double m = x;
+    double scale = 1.0;
+    while (m >= 4.0) {
+        m *= 0.25;
+        scale *= 2.0;
+    }
+    while (m < 1.0) {
+        m *= 4.0;
+        scale *= 0.5;
+    }
+
+    // Empezando por encima la convergencia es monótona: 6 pasos bastan
+    double y = 0.5 * (1.0 + m);
+    for (int i = 0; i < 6; i++) {
+        y = 0.5 * (y + m / y);
+    }
+    return y * scale;
+}
+
+// Reducción a [-π/4, π/4] por cuadrantes. Pensadas para ángulos
+// moderados (|x| < 1e6): más allá el error crece con |x|
+constexpr double sin(double x) {
+    const long long quadrant = detail::nearest(x / detail::kHalfPiHigh);
+    const double r = (x - quadrant * detail::kHalfPiHigh) - quadrant * detail::kHalfPiLow;
+
+    switch (quadrant & 3) {
+    case 0: return detail::sinKernel(r);
+    case 1: return detail::cosKernel(r);
+    case 2: return -detail::sinKernel(r);
+    default: return -detail::cosKernel(r);
+    }
+}
+
+constexpr double cos(double x) {
+    const long long quadrant = detail::nearest(x / detail::kHalfPiHigh);
+    const double r = (x - quadrant * detail::kHalfPiHigh) - quadrant * detail::kHalfPiLow;
+
+    switch (quadrant & 3) {
+    case 0: return detail::cosKernel(r);
+    case 1: return -detail::sinKernel(r);
+    case 2: return -detail::cosKernel(r);
+    default: return detail::sinKernel(r);
+    }
+}
+
+constexpr float sqrt(float x) { return static_cast<float>(sqrt(static_cast<double>(x))); }
+constexpr float sin(float x) { return static_cast<float>(sin(static_cast<double>(x))); }
+constexpr float cos(float x) { return static_cast<float>(cos(static_cast<double>(x))); }
+
+constexpr float radians(float degrees) {
+    return static_cast<float>(degrees * (kPi / 180.0));
+}
+
+// ---------------------------------------------------------------------------
+// Vectores, cuaterniones y matrices (lo que glm no tiene como constexpr)
+// ---------------------------------------------------------------------------
+
+constexpr float length(const glm::vec3& v) {
+    return sqrt(glm::dot(v, v));
+}
+
+constexpr glm::vec3 normalize(const glm::vec3& v) {
+    return v * (1.0f / length(v));
+}
+
+// 'axis' debe estar normalizado
+constexpr glm::quat angleAxis(float angle, const glm::vec3& axis) {
+    const float s = sin(0.5f * angle);
+    return glm::quat(cos(0.5f * angle), axis.x * s, axis.y * s, axis.z * s);
+}
+
+// Igual que glm::mat3_cast
+constexpr glm::mat3 mat3Cast(const glm::quat& q) {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    return glm::mat3(
+        1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy),
+        2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx),
+        2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy));
+}
+
+constexpr glm::mat3 transpose(const glm::mat3& m) {
+    return glm::mat3(
+        m[0][0], m[1][0], m[2][0],
+        m[0][1], m[1][1], m[2][1],
+        m[0][2], m[1][2], m[2][2]);
+}
+
+// T * R * S, como Transform::getModelMatrix
+constexpr glm::mat4 modelMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    const glm::mat3 basis = mat3Cast(rotation);
+
+    return glm::mat4(
+        glm::vec4(basis[0] * scale.x, 0.0f),
+        glm::vec4(basis[1] * scale.y, 0.0f),
+        glm::vec4(basis[2] * scale.z, 0.0f),
+        glm::vec4(position, 1.0f));
+}
+
+} // namespace math::cx
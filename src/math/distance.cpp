@@ -0,0 +1,188 @@
+#include "distance.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace math {
+
+glm::vec3 closestPointOnSegment(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, float* t) {
+    const glm::vec3 ab = b - a;
+    const float lengthSquared = glm::dot(ab, ab);
+
+    float s = 0.0f;
+    if (lengthSquared > 0.0f) {
+        s = std::clamp(glm::dot(point - a, ab) / lengthSquared, 0.0f, 1.0f);
+    }
+
+    if (t != nullptr) {
+        *t = s;
+    }
+    return a + s * ab;
+}
+
+glm::vec3 closestPointOnTriangle(const glm::vec3& point, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    const glm::vec3 ab = b - a;
+    const glm::vec3 ac = c - a;
+
+    // Región del vértice a
+    const glm::vec3 ap = point - a;
+    const float d1 = glm::dot(ab, ap);
+    const float d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+
+    // Región del vértice b
+    const glm::vec3 bp = point - b;
+    const float d3 = glm::dot(ab, bp);
+    const float d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+
+    // Región de la arista ab
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + d1 / (d1 - d3) * ab;
+    }
+
+    // Región del vértice c
+    const glm::vec3 cp = point - c;
+    const float d5 = glm::dot(ab, cp);
+    const float d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+
+    // Región de la arista ac
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + d2 / (d2 - d6) * ac;
+    }
+
+    // Región de la arista bc
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+    }
+
+    // Interior: coordenadas baricéntricas con una sola división
+    const float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+glm::vec3 closestPointOnAABB(const glm::vec3& point, const AABB& box) {
+    return glm::clamp(point, box.min, box.max);
+}
+
+glm::vec3 closestPointOnOBB(const glm::vec3& point, const OBB& box) {
+    const glm::vec3 d = point - box.center;
+
+    glm::vec3 result = box.center;
+    for (int axis = 0; axis < 3; axis++) {
+        const float extent = box.halfExtents[axis];
+        result += std::clamp(glm::dot(d, box.axes[axis]), -extent, extent) * box.axes[axis];
+    }
+    return result;
+}
+
+float distanceSquared(const glm::vec3& point, const AABB& box) {
+    const glm::vec3 d = point - closestPointOnAABB(point, box);
+    return glm::dot(d, d);
+}
+
+float distanceSquared(const glm::vec3& point, const OBB& box) {
+    const glm::vec3 d = point - closestPointOnOBB(point, box);
+    return glm::dot(d, d);
+}
+
+float closestPointsSegmentAABB(
+    const glm::vec3& a,
+    const glm::vec3& b,
+    const AABB& box,
+    glm::vec3* onSegment,
+    glm::vec3* onBox) {
+
+    const glm::vec3 d = b - a;
+
+    // Cortes del segmento con los 6 planos entre los dos extremos, en orden
+    float breaks[8];
+    int breakCount = 0;
+    breaks[breakCount++] = 0.0f;
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (d[axis] == 0.0f) {
+            continue;
+        }
+        for (float plane : { box.min[axis], box.max[axis] }) {
+            const float t = (plane - a[axis]) / d[axis];
+            if (!(t > 0.0f && t < 1.0f)) {
+                continue;
+            }
+
+            // Inserción ordenada: son como mucho 8
+            int i = breakCount++;
+            while (breaks[i - 1] > t) {
+                breaks[i] = breaks[i - 1];
+                i--;
+            }
+            breaks[i] = t;
+        }
+    }
+    breaks[breakCount++] = 1.0f;
+
+    float bestT = 0.0f;
+    float best = std::numeric_limits<float>::max();
+
+    for (int i = 0; i + 1 < breakCount; i++) {
+        const float t0 = breaks[i];
+        const float t1 = breaks[i + 1];
+        const float middle = 0.5f * (t0 + t1);
+
+        // Dentro del trozo cada eje está siempre por debajo, dentro o por
+        // encima de la caja: la distancia es A t² + B t + C
+        float quadratic = 0.0f;
+        float linear = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            const float x = a[axis] + middle * d[axis];
+
+            float bound;
+            if (x < box.min[axis]) {
+                bound = box.min[axis];
+            } else if (x > box.max[axis]) {
+                bound = box.max[axis];
+            } else {
+                continue;
+            }
+
+            const float offset = a[axis] - bound;
+            quadratic += d[axis] * d[axis];
+            linear += 2.0f * d[axis] * offset;
+        }
+
+        float t = t0;
+        if (quadratic > 0.0f) {
+            t = std::clamp(-linear / (2.0f * quadratic), t0, t1);
+        }
+
+        const glm::vec3 p = a + t * d;
+        const glm::vec3 delta = p - closestPointOnAABB(p, box);
+        const float distance = glm::dot(delta, delta);
+
+        if (distance < best) {
+            best = distance;
+            bestT = t;
+        }
+    }
+
+    const glm::vec3 p = a + bestT * d;
+    if (onSegment != nullptr) {
+        *onSegment = p;
+    }
+    if (onBox != nullptr) {
+        *onBox = closestPointOnAABB(p, box);
+    }
+    return best;
+}
+
+} // namespace math
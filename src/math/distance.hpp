@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+#include "bounds.hpp"
+
+// Puntos más cercanos y distancias entre primitivas (Ericson, "Real-Time
+// Collision Detection", cap. 5). Las distancias se devuelven al cuadrado:
+// para comparar no hace falta la raíz.
+
+namespace math {
+
+// Punto del segmento [a, b] más cercano a 'point'. Si 't' no es nulo
+// recibe su parámetro en [0, 1]. Un segmento degenerado devuelve 'a'
+glm::vec3 closestPointOnSegment(
+    const glm::vec3& point,
+    const glm::vec3& a,
+    const glm::vec3& b,
+    float* t = nullptr
+);
+
+// Punto del triángulo (a, b, c), interior incluido, más cercano a 'point'.
+// Se decide por regiones de Voronoi sin normalizar ni dividir salvo al final
+glm::vec3 closestPointOnTriangle(
+    const glm::vec3& point,
+    const glm::vec3& a,
+    const glm::vec3& b,
+    const glm::vec3& c
+);
+
+glm::vec3 closestPointOnAABB(const glm::vec3& point, const AABB& box);
+
+// Se proyecta sobre cada eje local y se recorta a la semiextensión
+glm::vec3 closestPointOnOBB(const glm::vec3& point, const OBB& box);
+
+float distanceSquared(const glm::vec3& point, const AABB& box);
+float distanceSquared(const glm::vec3& point, const OBB& box);
+
+// Distancia al cuadrado entre el segmento [a, b] y la caja (0 si la corta).
+// Es exacta: la distancia a lo largo del segmento es una cuadrática a trozos
+// con como mucho 6 cortes (uno por plano de la caja) y se minimiza en cada
+// trozo. Si no son nulos, 'onSegment' y 'onBox' reciben los puntos más
+// cercanos.
+float closestPointsSegmentAABB(
+    const glm::vec3& a,
+    const glm::vec3& b,
+    const AABB& box,
+    glm::vec3* onSegment = nullptr,
+    glm::vec3* onBox = nullptr
+);
+
+} // namespace math
@@ -0,0 +1,308 @@
+#include "frustum.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace math {
+
+namespace {
+
+#if defined(__AVX__)
+constexpr int kWidth = 8;
+#else
+constexpr int kWidth = 4;
+#endif
+
+using L = simd::Lanes<kWidth>;
+
+Plane normalizePlane(const glm::vec4& coefficients) {
+    const glm::vec3 normal(coefficients);
+    const float length = glm::length(normal);
+
+    if (length == 0.0f) {
+        return Plane{ normal, coefficients.w };
+    }
+    return Plane{ normal / length, coefficients.w / length };
+}
+
+// Test escalar común: 'evaluate(plano, s, r)' da la distancia con signo del
+// centro al plano y el radio del volumen proyectado sobre su normal
+template <typename Evaluate>
+Containment classifyScalar(const Plane (&planes)[6], Evaluate&& evaluate, uint8_t* lastPlane) {
+    float s, r;
+
+    if (lastPlane != nullptr) {
+        evaluate(planes[*lastPlane], s, r);
+        if (s < -r) {
+            return Containment::Outside;
+        }
+    }
+
+    bool inside = true;
+
+    for (uint8_t p = 0; p < Frustum::PlaneCount; p++) {
+        evaluate(planes[p], s, r);
+
+        if (s < -r) {
+            if (lastPlane != nullptr) {
+                *lastPlane = p;
+            }
+            return Containment::Outside;
+        }
+        if (s < r) {
+            inside = false;
+        }
+    }
+    return inside ? Containment::Inside : Containment::Intersect;
+}
+
+// Normal y distancia de un plano por carril
+struct PlaneLanes {
+    L nx, ny, nz, d;
+
+    static PlaneLanes broadcast(const Plane& plane) {
+        return PlaneLanes{
+            L::broadcast(plane.normal.x), L::broadcast(plane.normal.y),
+            L::broadcast(plane.normal.z), L::broadcast(plane.distance)
+        };
+    }
+};
+
+// Cada forma carga un bloque de kWidth volúmenes y da, para un plano, la
+// distancia con signo del centro (s) y el radio proyectado (r)
+
+struct AabbShape {
+    const AABBSoA& boxes;
+
+    struct Block {
+        L cx, cy, cz;
+        L ex, ey, ez;
+    };
+
+    size_t size() const { return boxes.size(); }
+
+    Block load(size_t i) const {
+        const L half = L::broadcast(0.5f);
+        const L minX = L::load(boxes.minX() + i), maxX = L::load(boxes.maxX() + i);
+        const L minY = L::load(boxes.minY() + i), maxY = L::load(boxes.maxY() + i);
+        const L minZ = L::load(boxes.minZ() + i), maxZ = L::load(boxes.maxZ() + i);
+
+        return Block{
+            (minX + maxX) * half, (minY + maxY) * half, (minZ + maxZ) * half,
+            (maxX - minX) * half, (maxY - minY) * half, (maxZ - minZ) * half
+        };
+    }
+
+    void evaluate(const Block& b, const PlaneLanes& p, L& s, L& r) const {
+        s = p.nx * b.cx + p.ny * b.cy + p.nz * b.cz + p.d;
+        r = abs(p.nx) * b.ex + abs(p.ny) * b.ey + abs(p.nz) * b.ez;
+    }
+};
+
+struct SphereShape {
+    const BoundingSphereSoA& spheres;
+
+    struct Block {
+        L cx, cy, cz, radius;
+    };
+
+    size_t size() const { return spheres.size(); }
+
+    Block load(size_t i) const {
+        return Block{
+            L::load(spheres.center(0) + i), L::load(spheres.center(1) + i),
+            L::load(spheres.center(2) + i), L::load(spheres.radius() + i)
+        };
+    }
+
+    void evaluate(const Block& b, const PlaneLanes& p, L& s, L& r) const {
+        s = p.nx * b.cx + p.ny * b.cy + p.nz * b.cz + p.d;
+        r = b.radius;
+    }
+};
+
+struct ObbShape {
+    const OBBSoA& boxes;
+
+    struct Block {
+        L cx, cy, cz;
+        L axes[3][3];
+        L extent[3];
+    };
+
+    size_t size() const { return boxes.size(); }
+
+    Block load(size_t i) const {
+        Block b;
+        b.cx = L::load(boxes.center(0) + i);
+        b.cy = L::load(boxes.center(1) + i);
+        b.cz = L::load(boxes.center(2) + i);
+
+        for (int a = 0; a < 3; a++) {
+            b.extent[a] = L::load(boxes.halfExtent(a) + i);
+            for (int c = 0; c < 3; c++) {
+                b.axes[a][c] = L::load(boxes.axis(a, c) + i);
+            }
+        }
+        return b;
+    }
+
+    void evaluate(const Block& b, const PlaneLanes& p, L& s, L& r) const {
+        s = p.nx * b.cx + p.ny * b.cy + p.nz * b.cz + p.d;
+        r = L::broadcast(0.0f);
+
+        for (int a = 0; a < 3; a++) {
+            const L projection = p.nx * b.axes[a][0] + p.ny * b.axes[a][1] + p.nz * b.axes[a][2];
+            r = r + abs(projection) * b.extent[a];
+        }
+    }
+};
+
+template <typename Shape>
+void classifyBatch(const Plane (&planes)[6], const Shape& shape, ContainmentMasks& result, uint8_t* planeCache) {
+    const size_t count = shape.size();
+    const size_t words = (count + 63) / 64;
+
+    result.inside.assign(words, 0);
+    result.intersect.assign(words, 0);
+    result.outside.assign(words, 0);
+
+    PlaneLanes allPlanes[Frustum::PlaneCount];
+    for (int p = 0; p < Frustum::PlaneCount; p++) {
+        allPlanes[p] = PlaneLanes::broadcast(planes[p]);
+    }
+
+    const L zero = L::broadcast(0.0f);
+
+    for (size_t i = 0; i < count; i += kWidth) {
+        const int valid = count - i >= size_t(kWidth) ? (1 << kWidth) - 1 : (1 << (count - i)) - 1;
+        const typename Shape::Block block = shape.load(i);
+
+        L s, r;
+        int outside = 0;
+        int inside = valid;
+        int skipPlane = Frustum::PlaneCount;
+
+        // Un byte de caché por grupo de 8 elementos (uno o dos bloques)
+        uint8_t* cached = planeCache != nullptr ? &planeCache[i / 8] : nullptr;
+
+        if (cached != nullptr) {
+            // Ya probado para todo el bloque: el bucle de abajo se lo salta
+            shape.evaluate(block, allPlanes[*cached], s, r);
+            outside = movemask(s < zero - r) & valid;
+            inside &= movemask(s >= r);
+            skipPlane = *cached;
+        }
+
+        for (int p = 0; p < Frustum::PlaneCount && outside != valid; p++) {
+            if (p == skipPlane) {
+                continue;
+            }
+
+            shape.evaluate(block, allPlanes[p], s, r);
+
+            const int rejected = movemask(s < zero - r) & valid & ~outside;
+            inside &= movemask(s >= r);
+
+            if (cached != nullptr && rejected != 0) {
+                *cached = static_cast<uint8_t>(p);
+            }
+            outside |= rejected;
+        }
+
+        inside &= ~outside;
+        const int intersect = valid & ~outside & ~inside;
+
+        const size_t word = i >> 6;
+        const int shift = static_cast<int>(i & 63);
+        result.inside[word] |= uint64_t(inside) << shift;
+        result.intersect[word] |= uint64_t(intersect) << shift;
+        result.outside[word] |= uint64_t(outside) << shift;
+    }
+}
+
+} // namespace
+
+Containment ContainmentMasks::get(size_t index) const {
+    const uint64_t bit = uint64_t(1) << (index & 63);
+
+    if ((inside[index >> 6] & bit) != 0) {
+        return Containment::Inside;
+    }
+    if ((intersect[index >> 6] & bit) != 0) {
+        return Containment::Intersect;
+    }
+    return Containment::Outside;
+}
+
+Frustum::Frustum(const glm::mat4& m) {
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    mPlanes[Left] = normalizePlane(row3 + row0);
+    mPlanes[Right] = normalizePlane(row3 - row0);
+    mPlanes[Bottom] = normalizePlane(row3 + row1);
+    mPlanes[Top] = normalizePlane(row3 - row1);
+    mPlanes[Near] = normalizePlane(row3 + row2);
+    mPlanes[Far] = normalizePlane(row3 - row2);
+}
+
+size_t Frustum::planeCacheSize(size_t count) {
+    return (count + 7) / 8;
+}
+
+const Plane& Frustum::getPlane(int index) const {
+    return mPlanes[index];
+}
+
+bool Frustum::contains(const glm::vec3& point) const {
+    for (const Plane& plane : mPlanes) {
+        if (plane.signedDistance(point) < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Containment Frustum::classify(const AABB& box, uint8_t* lastPlane) const {
+    const glm::vec3 center = 0.5f * (box.min + box.max);
+    const glm::vec3 extent = 0.5f * (box.max - box.min);
+
+    return classifyScalar(mPlanes, [&](const Plane& plane, float& s, float& r) {
+        s = plane.signedDistance(center);
+        r = glm::dot(glm::abs(plane.normal), extent);
+    }, lastPlane);
+}
+
+Containment Frustum::classify(const BoundingSphere& sphere, uint8_t* lastPlane) const {
+    return classifyScalar(mPlanes, [&](const Plane& plane, float& s, float& r) {
+        s = plane.signedDistance(sphere.center);
+        r = sphere.radius;
+    }, lastPlane);
+}
+
+Containment Frustum::classify(const OBB& box, uint8_t* lastPlane) const {
+    return classifyScalar(mPlanes, [&](const Plane& plane, float& s, float& r) {
+        s = plane.signedDistance(box.center);
+        r = box.halfExtents.x * std::abs(glm::dot(plane.normal, box.axes[0])) +
+            box.halfExtents.y * std::abs(glm::dot(plane.normal, box.axes[1])) +
+            box.halfExtents.z * std::abs(glm::dot(plane.normal, box.axes[2]));
+    }, lastPlane);
+}
+
+void Frustum::classify(const AABBSoA& boxes, ContainmentMasks& result, uint8_t* planeCache) const {
+    classifyBatch(mPlanes, AabbShape{ boxes }, result, planeCache);
+}
+
+void Frustum::classify(const BoundingSphereSoA& spheres, ContainmentMasks& result, uint8_t* planeCache) const {
+    classifyBatch(mPlanes, SphereShape{ spheres }, result, planeCache);
+}
+
+void Frustum::classify(const OBBSoA& boxes, ContainmentMasks& result, uint8_t* planeCache) const {
+    classifyBatch(mPlanes, ObbShape{ boxes }, result, planeCache);
+}
+
+} // namespace math
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+#include "bounds.hpp"
+#include "intersection.hpp"
+
+// Frustum de la cámara y tests de visibilidad contra volúmenes envolventes.
+//
+// Los planos se extraen de la matriz vista-proyección (Gribb-Hartmann) con la
+// normal hacia dentro y normalizados. Los tests por lotes reciben los
+// volúmenes en SoA y prueban 4 u 8 a la vez contra cada plano.
+
+namespace math {
+
+// Un punto p está en el lado interior si dot(normal, p) + distance >= 0
+struct Plane {
+    glm::vec3 normal{ 0.0f };
+    float distance = 0.0f;
+
+    float signedDistance(const glm::vec3& point) const {
+        return glm::dot(normal, point) + distance;
+    }
+};
+
+enum class Containment : uint8_t {
+    Outside,
+    Intersect,
+    Inside
+};
+
+// Un bit por elemento (64 por palabra) en exactamente una de las tres máscaras
+struct ContainmentMasks {
+    std::vector<uint64_t> inside;
+    std::vector<uint64_t> intersect;
+    std::vector<uint64_t> outside;
+
+    Containment get(size_t index) const;
+};
+
+class Frustum {
+private:
+    Plane mPlanes[6];
+
+public:
+    enum PlaneIndex {
+        Left, Right, Bottom, Top, Near, Far,
+        PlaneCount
+    };
+
+    Frustum() = default;
+
+    // Profundidad de clip de OpenGL ([-1, 1]), la que usa glm por defecto
+    explicit Frustum(const glm::mat4& viewProjection);
+
+    const Plane& getPlane(int index) const;
+
+    bool contains(const glm::vec3& point) const;
+
+    // Coherencia entre frames: si 'lastPlane' no es nulo, se prueba primero
+    // el plano que rechazó al volumen la última vez (un objeto que estaba
+    // fuera suele seguir fuera por el mismo plano) y se actualiza con el
+    // plano que lo rechace ahora. Debe empezar a 0.
+    Containment classify(const AABB& box, uint8_t* lastPlane = nullptr) const;
+    Containment classify(const BoundingSphere& sphere, uint8_t* lastPlane = nullptr) const;
+    Containment classify(const OBB& box, uint8_t* lastPlane = nullptr) const;
+
+    // Por lotes. 'planeCache', si no es nulo, tiene planeCacheSize(n) bytes
+    // (empezando a 0): uno por cada grupo de 8 elementos consecutivos, con el
+    // último plano que rechazó a alguno de ellos. Un grupo que sigue entero
+    // fuera por ese plano se resuelve con un solo test. Compartir el plano
+    // por grupo evita leer y escribir la caché carril a carril, y solo pierde
+    // si los vecinos en el array no lo son en el espacio.
+    static size_t planeCacheSize(size_t count);
+
+    void classify(const AABBSoA& boxes, ContainmentMasks& result, uint8_t* planeCache = nullptr) const;
+    void classify(const BoundingSphereSoA& spheres, ContainmentMasks& result, uint8_t* planeCache = nullptr) const;
+    void classify(const OBBSoA& boxes, ContainmentMasks& result, uint8_t* planeCache = nullptr) const;
+};
+
+} // namespace math
@@ -1,103 +1,714 @@
 #include "intersection.hpp"
+#include "simd.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <utility>
 
-bool math::intersect(const Ray& ray, const AABB& box, float& distance) {
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-    //p(x) = o + t.d
+namespace math {
 
-    //Para un eje X
-    // o.x = ray.origen.x
-    // d = ray.direction.x
-    // p = box.min o box.max
+namespace {
 
-    // calular intervalo t1 y t2
-    // t = (p - o) / d
+//p(x) = o + t.d  ->  t = (p - o) / d = (p - o) * (1 / d)
+//
+// Test de "slabs" sin ramas: para cada eje el rayo está entre los dos
+// planos de la caja en [t1, t2] (o [t2, t1] si la dirección es negativa).
+// El intervalo final es la intersección de los tres, recortada a t >= 0
+// para no seleccionar nada detrás de la cámara. Si el origen está dentro
+// de la caja tNear queda en 0.
+inline bool slab(const RayInverse& ray, const glm::vec3& min, const glm::vec3& max, float& tNear) {
+    const glm::vec3 t1 = (min - ray.origin) * ray.invDirection;
+    const glm::vec3 t2 = (max - ray.origin) * ray.invDirection;
 
-    float tMin = -std::numeric_limits<float>::infinity(); // -infinito
-    float tMax = std::numeric_limits<float>::infinity();  // +infinito
+    const glm::vec3 tLow = glm::min(t1, t2);
+    const glm::vec3 tHigh = glm::max(t1, t2);
 
-    // Para vista en perspectiva y rayos no paralelos a ejes
-    if (ray.direction.x != 0) {
+    const float tMin = std::max(std::max(tLow.x, tLow.y), std::max(tLow.z, 0.0f));
+    const float tMax = std::min(std::min(tHigh.x, tHigh.y), tHigh.z);
 
-        float tx_min = (box.min.x - ray.origin.x) / ray.direction.x;
-        float tx_max = (box.max.x - ray.origin.x) / ray.direction.x;
+    tNear = tMin;
+    return tMin <= tMax;
+}
 
-        if (tx_min > tx_max) {
-            std::swap(tx_min, tx_max);
+inline size_t roundUp(size_t count) {
+    return (count + AABBSoA::kLanes - 1) / AABBSoA::kLanes * AABBSoA::kLanes;
+}
+
+} // namespace
+
+RayInverse makeRayInverse(const Ray& ray) {
+    RayInverse inverse;
+    inverse.origin = ray.origin;
+
+    for (int axis = 0; axis < 3; axis++) {
+        const float d = ray.direction[axis];
+        const float inv = 1.0f / d;
+
+        inverse.invDirection[axis] = std::isfinite(inv)
+            ? inv
+            : std::copysign(std::numeric_limits<float>::max(), d);
+    }
+    return inverse;
+}
+
+bool intersect(const Ray& ray, const AABB& box, float& distance) {
+    float tNear;
+    if (!slab(makeRayInverse(ray), box.min, box.max, tNear)) {
+        return false;
+    }
+
+    distance = tNear;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// AABBSoA
+// ---------------------------------------------------------------------------
+
+AABBSoA::AABBSoA(const std::vector<AABB>& boxes) {
+    reserve(boxes.size());
+    for (const AABB& box : boxes) {
+        add(box);
+    }
+}
+
+void AABBSoA::reserve(size_t count) {
+    const size_t padded = roundUp(count);
+    for (std::vector<float>* v : { &mMinX, &mMinY, &mMinZ, &mMaxX, &mMaxY, &mMaxZ }) {
+        v->reserve(padded);
+    }
+}
+
+void AABBSoA::clear() {
+    for (std::vector<float>* v : { &mMinX, &mMinY, &mMinZ, &mMaxX, &mMaxY, &mMaxZ }) {
+        v->clear();
+    }
+    mCount = 0;
+}
+
+void AABBSoA::add(const AABB& box) {
+    // Los huecos de relleno se ignoran al probar, pero se dejan a cero
+    // para que nunca contengan valores no finitos
+    if (mCount == mMinX.size()) {
+        const size_t padded = mCount + kLanes;
+        for (std::vector<float>* v : { &mMinX, &mMinY, &mMinZ, &mMaxX, &mMaxY, &mMaxZ }) {
+            v->resize(padded, 0.0f);
         }
+    }
+
+    mMinX[mCount] = box.min.x;
+    mMinY[mCount] = box.min.y;
+    mMinZ[mCount] = box.min.z;
+    mMaxX[mCount] = box.max.x;
+    mMaxY[mCount] = box.max.y;
+    mMaxZ[mCount] = box.max.z;
+    mCount++;
+}
+
+size_t AABBSoA::size() const {
+    return mCount;
+}
 
-        // Recortamos el segmento de coincidencia
-        tMin = std::max(tMin, tx_min);
-        tMax = std::min(tMax, tx_max);
+bool AABBSoA::empty() const {
+    return mCount == 0;
+}
 
-        if (tMin > tMax) {
-            return false;
+AABB AABBSoA::get(size_t index) const {
+    return AABB{
+        glm::vec3(mMinX[index], mMinY[index], mMinZ[index]),
+        glm::vec3(mMaxX[index], mMaxY[index], mMaxZ[index])
+    };
+}
+
+size_t AABBSoA::maskWords() const {
+    return (mMinX.size() + 63) / 64;
+}
+
+// ---------------------------------------------------------------------------
+// Un rayo contra muchas cajas
+// ---------------------------------------------------------------------------
+
+size_t intersect(const RayInverse& ray, const AABBSoA& boxes, float& distance, uint64_t* hitMask) {
+    const size_t count = boxes.size();
+
+    if (hitMask != nullptr) {
+        std::memset(hitMask, 0, boxes.maskWords() * sizeof(uint64_t));
+    }
+
+    float bestT = std::numeric_limits<float>::infinity();
+    size_t bestIndex = AABBSoA::npos;
+
+    if (count == 0) {
+        return bestIndex;
+    }
+
+    const float* minX = boxes.minX();
+    const float* minY = boxes.minY();
+    const float* minZ = boxes.minZ();
+    const float* maxX = boxes.maxX();
+    const float* maxY = boxes.maxY();
+    const float* maxZ = boxes.maxZ();
+
+    // Cada carril guarda su mejor t y el bloque en el que lo encontró; el
+    // índice del bloque va en float (exacto hasta 2^24 bloques) para no
+    // necesitar aritmética entera de 256 bits, que es de AVX2.
+#if defined(__AVX__)
+    constexpr size_t width = 8;
+    const size_t padded = roundUp(count);
+
+    const __m256 ox = _mm256_set1_ps(ray.origin.x);
+    const __m256 oy = _mm256_set1_ps(ray.origin.y);
+    const __m256 oz = _mm256_set1_ps(ray.origin.z);
+    const __m256 ix = _mm256_set1_ps(ray.invDirection.x);
+    const __m256 iy = _mm256_set1_ps(ray.invDirection.y);
+    const __m256 iz = _mm256_set1_ps(ray.invDirection.z);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    // Carriles válidos del último bloque (los de relleno no cuentan)
+    const int tailMask = (1 << (width - (padded - count))) - 1;
+
+    __m256 laneBestT = _mm256_set1_ps(bestT);
+    __m256 laneBestBlock = _mm256_setzero_ps();
+    __m256 block = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < padded; i += width, block = _mm256_add_ps(block, one)) {
+        const __m256 t1x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(minX + i), ox), ix);
+        const __m256 t2x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(maxX + i), ox), ix);
+        const __m256 t1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(minY + i), oy), iy);
+        const __m256 t2y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(maxY + i), oy), iy);
+        const __m256 t1z = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(minZ + i), oz), iz);
+        const __m256 t2z = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(maxZ + i), oz), iz);
+
+        const __m256 tMin = _mm256_max_ps(
+            _mm256_max_ps(_mm256_min_ps(t1x, t2x), _mm256_min_ps(t1y, t2y)),
+            _mm256_max_ps(_mm256_min_ps(t1z, t2z), zero));
+        const __m256 tMax = _mm256_min_ps(
+            _mm256_min_ps(_mm256_max_ps(t1x, t2x), _mm256_max_ps(t1y, t2y)),
+            _mm256_max_ps(t1z, t2z));
+
+        __m256 hit = _mm256_cmp_ps(tMin, tMax, _CMP_LE_OQ);
+        int bits = _mm256_movemask_ps(hit);
+
+        if (i + width > count) {
+            bits &= tailMask;
+            const __m256i lanes = _mm256_set_epi32(
+                -(bits >> 7 & 1), -(bits >> 6 & 1), -(bits >> 5 & 1), -(bits >> 4 & 1),
+                -(bits >> 3 & 1), -(bits >> 2 & 1), -(bits >> 1 & 1), -(bits & 1));
+            hit = _mm256_castsi256_ps(lanes);
         }
 
-    } else {
-        if (ray.origin.x < box.min.x ||
-            ray.origin.x > box.max.x) {
-            return false;
+        const __m256 closer = _mm256_and_ps(hit, _mm256_cmp_ps(tMin, laneBestT, _CMP_LT_OQ));
+        laneBestT = _mm256_blendv_ps(laneBestT, tMin, closer);
+        laneBestBlock = _mm256_blendv_ps(laneBestBlock, block, closer);
+
+        if (hitMask != nullptr) {
+            hitMask[i >> 6] |= uint64_t(bits) << (i & 63);
         }
     }
 
-    if (ray.direction.y != 0) {
+    alignas(32) float lastT[width];
+    alignas(32) float lastBlock[width];
+    _mm256_store_ps(lastT, laneBestT);
+    _mm256_store_ps(lastBlock, laneBestBlock);
 
-        float ty_min = (box.min.y - ray.origin.y) / ray.direction.y;
-        float ty_max = (box.max.y - ray.origin.y) / ray.direction.y;
+#elif defined(__SSE2__)
+    constexpr size_t width = 4;
 
-        if (ty_min > ty_max) {
-            std::swap(ty_min, ty_max);
-        }
+    const __m128 ox = _mm_set1_ps(ray.origin.x);
+    const __m128 oy = _mm_set1_ps(ray.origin.y);
+    const __m128 oz = _mm_set1_ps(ray.origin.z);
+    const __m128 ix = _mm_set1_ps(ray.invDirection.x);
+    const __m128 iy = _mm_set1_ps(ray.invDirection.y);
+    const __m128 iz = _mm_set1_ps(ray.invDirection.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
 
-        // Recortamos el segmento de coincidencia
-        tMin = std::max(tMin, ty_min);
-        tMax = std::min(tMax, ty_max);
+    // Con 4 carriles el relleno (hasta 8) puede ocupar un bloque entero
+    const size_t used = (count + width - 1) / width * width;
+    const int tailMask = (1 << (width - (used - count))) - 1;
 
-        if (tMin > tMax) {
-            return false;
+    __m128 laneBestT = _mm_set1_ps(bestT);
+    __m128 laneBestBlock = _mm_setzero_ps();
+    __m128 block = _mm_setzero_ps();
+
+    for (size_t i = 0; i < used; i += width, block = _mm_add_ps(block, one)) {
+        const __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minX + i), ox), ix);
+        const __m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxX + i), ox), ix);
+        const __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minY + i), oy), iy);
+        const __m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxY + i), oy), iy);
+        const __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minZ + i), oz), iz);
+        const __m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxZ + i), oz), iz);
+
+        const __m128 tMin = _mm_max_ps(
+            _mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)),
+            _mm_max_ps(_mm_min_ps(t1z, t2z), zero));
+        const __m128 tMax = _mm_min_ps(
+            _mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)),
+            _mm_max_ps(t1z, t2z));
+
+        __m128 hit = _mm_cmple_ps(tMin, tMax);
+        int bits = _mm_movemask_ps(hit);
+
+        if (i + width > count) {
+            bits &= tailMask;
+            hit = _mm_castsi128_ps(_mm_set_epi32(
+                -(bits >> 3 & 1), -(bits >> 2 & 1), -(bits >> 1 & 1), -(bits & 1)));
         }
 
-    } else {
+        const __m128 closer = _mm_and_ps(hit, _mm_cmplt_ps(tMin, laneBestT));
+        laneBestT = _mm_or_ps(_mm_and_ps(closer, tMin), _mm_andnot_ps(closer, laneBestT));
+        laneBestBlock = _mm_or_ps(_mm_and_ps(closer, block), _mm_andnot_ps(closer, laneBestBlock));
 
-        if (ray.origin.y < box.min.y ||
-            ray.origin.y > box.max.y) {
-            return false;
+        if (hitMask != nullptr) {
+            hitMask[i >> 6] |= uint64_t(bits) << (i & 63);
         }
     }
 
-    if (ray.direction.z != 0) {
+    alignas(16) float lastT[width];
+    alignas(16) float lastBlock[width];
+    _mm_store_ps(lastT, laneBestT);
+    _mm_store_ps(lastBlock, laneBestBlock);
 
-        float tz_min = (box.min.z - ray.origin.z) / ray.direction.z;
-        float tz_max = (box.max.z - ray.origin.z) / ray.direction.z;
+#else
+    constexpr size_t width = 1;
 
-        if (tz_min > tz_max) {
-            std::swap(tz_min, tz_max);
+    float lastT[width] = { bestT };
+    float lastBlock[width] = { 0.0f };
 
+    for (size_t i = 0; i < count; i++) {
+        float tNear;
+        const bool hit = slab(ray,
+            glm::vec3(minX[i], minY[i], minZ[i]),
+            glm::vec3(maxX[i], maxY[i], maxZ[i]),
+            tNear);
+
+        if (hit && tNear < lastT[0]) {
+            lastT[0] = tNear;
+            lastBlock[0] = static_cast<float>(i);
+        }
+        if (hit && hitMask != nullptr) {
+            hitMask[i >> 6] |= uint64_t(1) << (i & 63);
         }
+    }
+#endif
 
-        tMin = std::max(tMin, tz_min);
-        tMax = std::min(tMax, tz_max);
+    // Reducción entre carriles; a igual distancia gana el índice menor
+    for (size_t lane = 0; lane < width; lane++) {
+        if (lastT[lane] == std::numeric_limits<float>::infinity()) {
+            continue;
+        }
 
-        if (tMin > tMax) {
-            return false;
+        const size_t index = static_cast<size_t>(lastBlock[lane]) * width + lane;
+        if (lastT[lane] < bestT || (lastT[lane] == bestT && index < bestIndex)) {
+            bestT = lastT[lane];
+            bestIndex = index;
         }
+    }
 
-    } else {
+    if (bestIndex != AABBSoA::npos) {
+        distance = bestT;
+    }
+    return bestIndex;
+}
 
-        if (ray.origin.z < box.min.z ||
-            ray.origin.z > box.max.z) {
-            return false;
-        }
+// ---------------------------------------------------------------------------
+// Rayo contra triángulos
+// ---------------------------------------------------------------------------
+
+namespace {
+
+// Datos del rayo para el test estanco: el eje dominante de la dirección
+// pasa a ser Z y la cizalla (sx, sy, sz) lleva la dirección a (0, 0, 1)
+struct WatertightRay {
+    glm::vec3 origin;
+    int kx, ky, kz;
+    float sx, sy, sz;
+};
+
+WatertightRay makeWatertightRay(const Ray& ray) {
+    const glm::vec3 d = glm::abs(ray.direction);
+
+    WatertightRay w;
+    w.origin = ray.origin;
+    w.kz = d.x > d.y ? (d.x > d.z ? 0 : 2) : (d.y > d.z ? 1 : 2);
+    w.kx = (w.kz + 1) % 3;
+    w.ky = (w.kx + 1) % 3;
+
+    // Conserva el sentido de giro para que el signo de las funciones de
+    // arista no dependa del signo de la dirección
+    if (ray.direction[w.kz] < 0.0f) {
+        std::swap(w.kx, w.ky);
+    }
+
+    w.sx = ray.direction[w.kx] / ray.direction[w.kz];
+    w.sy = ray.direction[w.ky] / ray.direction[w.kz];
+    w.sz = 1.0f / ray.direction[w.kz];
+    return w;
+}
+
+bool watertight(const WatertightRay& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+    float tMax, TriangleHit& hit) {
+
+    const glm::vec3 a = v0 - ray.origin;
+    const glm::vec3 b = v1 - ray.origin;
+    const glm::vec3 c = v2 - ray.origin;
+
+    const float ax = a[ray.kx] - ray.sx * a[ray.kz];
+    const float ay = a[ray.ky] - ray.sy * a[ray.kz];
+    const float bx = b[ray.kx] - ray.sx * b[ray.kz];
+    const float by = b[ray.ky] - ray.sy * b[ray.kz];
+    const float cx = c[ray.kx] - ray.sx * c[ray.kz];
+    const float cy = c[ray.ky] - ray.sy * c[ray.kz];
+
+    float u = cx * by - cy * bx;
+    float v = ax * cy - ay * cx;
+    float w = bx * ay - by * ax;
+
+    // En una arista el resultado en float puede ser 0 por redondeo; en double
+    // el producto de dos floats es exacto y el signo ya es fiable
+    if (u == 0.0f || v == 0.0f || w == 0.0f) {
+        u = static_cast<float>(double(cx) * double(by) - double(cy) * double(bx));
+        v = static_cast<float>(double(ax) * double(cy) - double(ay) * double(cx));
+        w = static_cast<float>(double(bx) * double(ay) - double(by) * double(ax));
     }
 
-    // Evitamos la selección detrás de la cámara
-    if (tMax < 0.0f) {
+    if ((u < 0.0f || v < 0.0f || w < 0.0f) && (u > 0.0f || v > 0.0f || w > 0.0f)) {
         return false;
     }
 
-    distance = std::max(tMin, 0.0f);
+    const float det = u + v + w;
+    if (det == 0.0f) {
+        return false;
+    }
+
+    const float az = ray.sz * a[ray.kz];
+    const float bz = ray.sz * b[ray.kz];
+    const float cz = ray.sz * c[ray.kz];
+    const float t = u * az + v * bz + w * cz;
+
+    // Se compara sin dividir: t / det en [0, tMax)
+    const float tSigned = det < 0.0f ? -t : t;
+    const float detAbs = std::abs(det);
+    if (tSigned < 0.0f || tSigned >= tMax * detAbs) {
+        return false;
+    }
 
+    const float invDet = 1.0f / det;
+    hit.t = t * invDet;
+    hit.u = v * invDet;
+    hit.v = w * invDet;
     return true;
-}
\ No newline at end of file
+}
+
+bool mollerTrumbore(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+    float tMax, TriangleHit& hit) {
+
+    const glm::vec3 e1 = v1 - v0;
+    const glm::vec3 e2 = v2 - v0;
+
+    const glm::vec3 p = glm::cross(ray.direction, e2);
+    const float det = glm::dot(e1, p);
+    if (det == 0.0f) {
+        return false;
+    }
+
+    const float invDet = 1.0f / det;
+    const glm::vec3 s = ray.origin - v0;
+    const float u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const glm::vec3 q = glm::cross(s, e1);
+    const float v = glm::dot(ray.direction, q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    const float t = glm::dot(e2, q) * invDet;
+    if (t < 0.0f || t >= tMax) {
+        return false;
+    }
+
+    hit.t = t;
+    hit.u = u;
+    hit.v = v;
+    return true;
+}
+
+// Devuelve la máscara de carriles con impacto y deja t, u y v por carril
+template <int Width>
+int mollerTrumboreLanes(const Ray& ray, const TriangleSoA& triangles, size_t i, float tMax,
+    float* t, float* u, float* v) {
+
+    using L = simd::Lanes<Width>;
+
+    const L v0x = L::load(triangles.data(0, 0) + i);
+    const L v0y = L::load(triangles.data(0, 1) + i);
+    const L v0z = L::load(triangles.data(0, 2) + i);
+
+    const L e1x = L::load(triangles.data(1, 0) + i) - v0x;
+    const L e1y = L::load(triangles.data(1, 1) + i) - v0y;
+    const L e1z = L::load(triangles.data(1, 2) + i) - v0z;
+    const L e2x = L::load(triangles.data(2, 0) + i) - v0x;
+    const L e2y = L::load(triangles.data(2, 1) + i) - v0y;
+    const L e2z = L::load(triangles.data(2, 2) + i) - v0z;
+
+    const L dx = L::broadcast(ray.direction.x);
+    const L dy = L::broadcast(ray.direction.y);
+    const L dz = L::broadcast(ray.direction.z);
+
+    // p = d x e2
+    const L px = dy * e2z - dz * e2y;
+    const L py = dz * e2x - dx * e2z;
+    const L pz = dx * e2y - dy * e2x;
+
+    const L det = e1x * px + e1y * py + e1z * pz;
+    const L invDet = L::broadcast(1.0f) / det;
+
+    const L sx = L::broadcast(ray.origin.x) - v0x;
+    const L sy = L::broadcast(ray.origin.y) - v0y;
+    const L sz = L::broadcast(ray.origin.z) - v0z;
+
+    const L uLanes = (sx * px + sy * py + sz * pz) * invDet;
+
+    // q = s x e1
+    const L qx = sy * e1z - sz * e1y;
+    const L qy = sz * e1x - sx * e1z;
+    const L qz = sx * e1y - sy * e1x;
+
+    const L vLanes = (dx * qx + dy * qy + dz * qz) * invDet;
+    const L tLanes = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+    const L zero = L::broadcast(0.0f);
+    const L inside =
+        (abs(det) > zero) &
+        (uLanes >= zero) & (vLanes >= zero) & (uLanes + vLanes <= L::broadcast(1.0f)) &
+        (tLanes >= zero) & (tLanes < L::broadcast(tMax));
+
+    const int mask = movemask(inside);
+    if (mask != 0) {
+        tLanes.store(t);
+        uLanes.store(u);
+        vLanes.store(v);
+    }
+    return mask;
+}
+
+template <int Width>
+int watertightLanes(const WatertightRay& w, const TriangleSoA& triangles, size_t i, int valid,
+    float tMax, float* t, float* u, float* v) {
+
+    using L = simd::Lanes<Width>;
+
+    const L ox = L::broadcast(w.origin[w.kx]);
+    const L oy = L::broadcast(w.origin[w.ky]);
+    const L oz = L::broadcast(w.origin[w.kz]);
+    const L sx = L::broadcast(w.sx);
+    const L sy = L::broadcast(w.sy);
+    const L sz = L::broadcast(w.sz);
+
+    // Vértices relativos al origen, en el orden de ejes del rayo
+    const L az = L::load(triangles.data(0, w.kz) + i) - oz;
+    const L bz = L::load(triangles.data(1, w.kz) + i) - oz;
+    const L cz = L::load(triangles.data(2, w.kz) + i) - oz;
+
+    const L ax = (L::load(triangles.data(0, w.kx) + i) - ox) - sx * az;
+    const L ay = (L::load(triangles.data(0, w.ky) + i) - oy) - sy * az;
+    const L bx = (L::load(triangles.data(1, w.kx) + i) - ox) - sx * bz;
+    const L by = (L::load(triangles.data(1, w.ky) + i) - oy) - sy * bz;
+    const L cx = (L::load(triangles.data(2, w.kx) + i) - ox) - sx * cz;
+    const L cy = (L::load(triangles.data(2, w.ky) + i) - oy) - sy * cz;
+
+    const L eu = cx * by - cy * bx;
+    const L ev = ax * cy - ay * cx;
+    const L ew = bx * ay - by * ax;
+
+    const L zero = L::broadcast(0.0f);
+
+    // Los carriles con alguna función de arista exactamente 0 se rehacen
+    // uno a uno con el test escalar, que recurre a double
+    const int onEdge = movemask((eu == zero) | (ev == zero) | (ew == zero)) & valid;
+
+    const L negative = (eu < zero) | (ev < zero) | (ew < zero);
+    const L positive = (eu > zero) | (ev > zero) | (ew > zero);
+
+    const L det = eu + ev + ew;
+    const L tScaled = eu * (sz * az) + ev * (sz * bz) + ew * (sz * cz);
+
+    // t / det en [0, tMax) sin dividir: se quita el signo de det a los dos
+    const L detSign = signBit(det);
+    const L tSigned = tScaled ^ detSign;
+    const L detAbs = abs(det);
+
+    const L inside = andNot(negative & positive,
+        (detAbs > zero) & (tSigned >= zero) & (tSigned < L::broadcast(tMax) * detAbs));
+
+    int mask = movemask(inside) & valid & ~onEdge;
+
+    if ((mask | onEdge) != 0) {
+        const L invDet = L::broadcast(1.0f) / det;
+        (tScaled * invDet).store(t);
+        (ev * invDet).store(u);
+        (ew * invDet).store(v);
+    }
+
+    for (int lane = 0; lane < Width; lane++) {
+        if ((onEdge >> lane & 1) == 0) {
+            continue;
+        }
+
+        TriangleHit edgeHit;
+        const size_t index = i + lane;
+        if (watertight(w, triangles.getVertex(index, 0), triangles.getVertex(index, 1),
+            triangles.getVertex(index, 2), tMax, edgeHit)) {
+            t[lane] = edgeHit.t;
+            u[lane] = edgeHit.u;
+            v[lane] = edgeHit.v;
+            mask |= 1 << lane;
+        }
+    }
+
+    return mask;
+}
+
+} // namespace
+
+template <TriangleTest Test>
+bool intersectTriangle(const Ray& ray, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2,
+    TriangleHit& hit, float tMax) {
+
+    if constexpr (Test == TriangleTest::Watertight) {
+        return watertight(makeWatertightRay(ray), v0, v1, v2, tMax, hit);
+    } else {
+        return mollerTrumbore(ray, v0, v1, v2, tMax, hit);
+    }
+}
+
+TriangleSoA::TriangleSoA(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    reserve(indices.size() / 3);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        add(positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]]);
+    }
+}
+
+void TriangleSoA::reserve(size_t count) {
+    for (auto& vertex : mVertices) {
+        for (std::vector<float>& axis : vertex) {
+            axis.reserve(roundUp(count));
+        }
+    }
+}
+
+void TriangleSoA::clear() {
+    for (auto& vertex : mVertices) {
+        for (std::vector<float>& axis : vertex) {
+            axis.clear();
+        }
+    }
+    mCount = 0;
+}
+
+void TriangleSoA::add(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+    // Relleno con triángulos degenerados en el origen (det = 0)
+    if (mCount == mVertices[0][0].size()) {
+        for (auto& vertex : mVertices) {
+            for (std::vector<float>& axis : vertex) {
+                axis.resize(mCount + kLanes, 0.0f);
+            }
+        }
+    }
+
+    const glm::vec3* corners[3] = { &v0, &v1, &v2 };
+    for (int vertex = 0; vertex < 3; vertex++) {
+        for (int axis = 0; axis < 3; axis++) {
+            mVertices[vertex][axis][mCount] = (*corners[vertex])[axis];
+        }
+    }
+    mCount++;
+}
+
+size_t TriangleSoA::size() const {
+    return mCount;
+}
+
+bool TriangleSoA::empty() const {
+    return mCount == 0;
+}
+
+glm::vec3 TriangleSoA::getVertex(size_t index, int vertex) const {
+    return glm::vec3(
+        mVertices[vertex][0][index],
+        mVertices[vertex][1][index],
+        mVertices[vertex][2][index]);
+}
+
+template <TriangleTest Test, HitMode Mode, int Width>
+size_t intersect(const Ray& ray, const TriangleSoA& triangles, TriangleHit& hit, float tMax) {
+    static_assert(Width == 4 || Width == 8, "Solo hay kernels de 4 y 8 carriles");
+
+    const size_t count = triangles.size();
+    const WatertightRay w = makeWatertightRay(ray);
+
+    size_t found = TriangleSoA::npos;
+
+    alignas(32) float t[Width];
+    alignas(32) float u[Width];
+    alignas(32) float v[Width];
+
+    for (size_t i = 0; i < count; i += Width) {
+        // Carriles de relleno fuera
+        const int valid = count - i >= size_t(Width) ? (1 << Width) - 1 : (1 << (count - i)) - 1;
+
+        int mask;
+        if constexpr (Test == TriangleTest::Watertight) {
+            mask = watertightLanes<Width>(w, triangles, i, valid, tMax, t, u, v);
+        } else {
+            mask = mollerTrumboreLanes<Width>(ray, triangles, i, tMax, t, u, v) & valid;
+        }
+
+        if (mask == 0) {
+            continue;
+        }
+
+        // Los impactos son raros: se elige el mejor carril en escalar y se
+        // acorta tMax para descartar antes en los bloques siguientes
+        for (int lane = 0; lane < Width; lane++) {
+            if ((mask >> lane & 1) != 0 && t[lane] < tMax) {
+                tMax = t[lane];
+                hit = TriangleHit{ t[lane], u[lane], v[lane] };
+                found = i + lane;
+
+                if constexpr (Mode == HitMode::Any) {
+                    return found;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+template bool intersectTriangle<TriangleTest::MollerTrumbore>(const Ray&, const glm::vec3&, const glm::vec3&,
+    const glm::vec3&, TriangleHit&, float);
+template bool intersectTriangle<TriangleTest::Watertight>(const Ray&, const glm::vec3&, const glm::vec3&,
+    const glm::vec3&, TriangleHit&, float);
+
+template size_t intersect<TriangleTest::MollerTrumbore, HitMode::Closest, 4>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::MollerTrumbore, HitMode::Closest, 8>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::MollerTrumbore, HitMode::Any, 4>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::MollerTrumbore, HitMode::Any, 8>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::Watertight, HitMode::Closest, 4>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::Watertight, HitMode::Closest, 8>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::Watertight, HitMode::Any, 4>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+template size_t intersect<TriangleTest::Watertight, HitMode::Any, 8>(const Ray&, const TriangleSoA&, TriangleHit&, float);
+
+} // namespace math
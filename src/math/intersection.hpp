@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 #include "aabb.hpp"
 #include "ray.hpp"
 
@@ -10,5 +15,139 @@ namespace math
         const AABB& box,
         float& distance
     );
-} // namespace math
 
+    // Rayo con la inversa de la dirección ya calculada, para no dividir en
+    // cada test. Las componentes nulas se sustituyen por ±FLT_MAX en lugar
+    // de infinito, así (min - origen) * inversa nunca da 0 * inf = NaN y los
+    // tests pueden ser sin ramas.
+    struct RayInverse {
+        glm::vec3 origin;
+        glm::vec3 invDirection;
+    };
+
+    RayInverse makeRayInverse(const Ray& ray);
+
+    // Muchas AABB guardadas como estructura de arrays (SoA): cada coordenada
+    // en su propio array contiguo para cargar 4 u 8 cajas de una vez.
+    // Los arrays se rellenan hasta un múltiplo de kLanes.
+    class AABBSoA {
+    private:
+        std::vector<float> mMinX, mMinY, mMinZ;
+        std::vector<float> mMaxX, mMaxY, mMaxZ;
+        size_t mCount = 0;
+
+    public:
+        static constexpr size_t kLanes = 8;
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        AABBSoA() = default;
+        explicit AABBSoA(const std::vector<AABB>& boxes);
+
+        void reserve(size_t count);
+        void clear();
+        void add(const AABB& box);
+
+        size_t size() const;
+        bool empty() const;
+        AABB get(size_t index) const;
+
+        // Palabras de 64 bits que necesita la máscara de impactos
+        size_t maskWords() const;
+
+        const float* minX() const { return mMinX.data(); }
+        const float* minY() const { return mMinY.data(); }
+        const float* minZ() const { return mMinZ.data(); }
+        const float* maxX() const { return mMaxX.data(); }
+        const float* maxY() const { return mMaxY.data(); }
+        const float* maxZ() const { return mMaxZ.data(); }
+    };
+
+    // Un rayo contra todas las cajas (AVX: 8 cajas por iteración, SSE: 4).
+    // Devuelve el índice de la caja más cercana (o AABBSoA::npos) y su
+    // distancia en 'distance', con la misma semántica que intersect(): si el
+    // origen está dentro la distancia es 0. Si 'hitMask' no es nulo debe
+    // tener maskWords() palabras y recibe un bit por caja alcanzada.
+    size_t intersect(
+        const RayInverse& ray,
+        const AABBSoA& boxes,
+        float& distance,
+        uint64_t* hitMask = nullptr
+    );
+
+    // -----------------------------------------------------------------------
+    // Rayo contra triángulos
+    // -----------------------------------------------------------------------
+
+    enum class TriangleTest {
+        // Möller–Trumbore: el más barato, pero un rayo que pasa justo por
+        // una arista compartida puede no cortar ninguno de los dos triángulos
+        MollerTrumbore,
+
+        // Woop, Benthin y Wald (2013): se pasa a un espacio en el que el rayo
+        // es el eje Z y se evalúan las funciones de arista en 2D, rehaciendo
+        // en double las que salen exactamente 0. Nunca deja huecos en una
+        // malla cerrada.
+        Watertight
+    };
+
+    enum class HitMode {
+        Closest,     // el impacto más cercano
+        Any          // el primero que se encuentre (sombras, oclusión)
+    };
+
+    // Distancia y coordenadas baricéntricas de v1 (u) y v2 (v)
+    struct TriangleHit {
+        float t = 0.0f;
+        float u = 0.0f;
+        float v = 0.0f;
+    };
+
+    // Acepta impactos con 0 <= t < tMax, por las dos caras
+    template <TriangleTest Test>
+    bool intersectTriangle(
+        const Ray& ray,
+        const glm::vec3& v0,
+        const glm::vec3& v1,
+        const glm::vec3& v2,
+        TriangleHit& hit,
+        float tMax = std::numeric_limits<float>::max()
+    );
+
+    // Triángulos como estructura de arrays (una coordenada de un vértice por
+    // array), rellenados hasta un múltiplo de 8
+    class TriangleSoA {
+    private:
+        std::vector<float> mVertices[3][3];   // [vértice][eje]
+        size_t mCount = 0;
+
+    public:
+        static constexpr size_t kLanes = 8;
+        static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+        TriangleSoA() = default;
+
+        // Un triángulo por cada 3 índices
+        TriangleSoA(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+
+        void reserve(size_t count);
+        void clear();
+        void add(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+
+        size_t size() const;
+        bool empty() const;
+        glm::vec3 getVertex(size_t index, int vertex) const;
+
+        const float* data(int vertex, int axis) const { return mVertices[vertex][axis].data(); }
+    };
+
+    // Un rayo contra todos los triángulos, 'Width' (4 u 8) por iteración.
+    // Devuelve el índice del triángulo encontrado (o TriangleSoA::npos).
+    // Con HitMode::Any termina en el primer bloque con algún impacto.
+    template <TriangleTest Test, HitMode Mode, int Width = 8>
+    size_t intersect(
+        const Ray& ray,
+        const TriangleSoA& triangles,
+        TriangleHit& hit,
+        float tMax = std::numeric_limits<float>::max()
+    );
+} // namespace math
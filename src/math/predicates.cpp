@@ -0,0 +1,232 @@
+#include "predicates.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace math {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Aritmética de expansiones
+//
+// Una expansión es una suma de doubles que no se solapan, ordenados de menor
+// a mayor magnitud. Su signo es el del último término distinto de cero.
+// ---------------------------------------------------------------------------
+
+// Suficiente para el determinante 3x3 de diferencias exactas (192 términos)
+constexpr int maxTerms = 192;
+
+struct Expansion {
+    double terms[maxTerms];
+    int size = 0;
+
+    void push(double value) {
+        if (value != 0.0) {
+            terms[size++] = value;
+        }
+    }
+
+    int sign() const {
+        if (size == 0) {
+            return 0;
+        }
+        return terms[size - 1] > 0.0 ? 1 : -1;
+    }
+};
+
+inline void twoSum(double a, double b, double& x, double& y) {
+    x = a + b;
+    const double bVirtual = x - a;
+    const double aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+inline void twoDiff(double a, double b, double& x, double& y) {
+    x = a - b;
+    const double bVirtual = a - x;
+    const double aVirtual = x + bVirtual;
+    y = (a - aVirtual) + (bVirtual - b);
+}
+
+inline void twoProduct(double a, double b, double& x, double& y) {
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// h = e + f
+void expansionSum(const Expansion& e, const Expansion& f, Expansion& h) {
+    Expansion result = e;
+
+    for (int i = 0; i < f.size; i++) {
+        Expansion grown;
+        double q = f.terms[i];
+
+        for (int j = 0; j < result.size; j++) {
+            double sum, error;
+            twoSum(q, result.terms[j], sum, error);
+            grown.push(error);
+            q = sum;
+        }
+        grown.push(q);
+
+        result = grown;
+    }
+
+    h = result;
+}
+
+// h = e * b
+void scaleExpansion(const Expansion& e, double b, Expansion& h) {
+    h.size = 0;
+    if (e.size == 0) {
+        return;
+    }
+
+    double q, error;
+    twoProduct(e.terms[0], b, q, error);
+    h.push(error);
+
+    for (int i = 1; i < e.size; i++) {
+        double product, productError;
+        twoProduct(e.terms[i], b, product, productError);
+
+        double sum;
+        twoSum(q, productError, sum, error);
+        h.push(error);
+
+        twoSum(product, sum, q, error);
+        h.push(error);
+    }
+    h.push(q);
+}
+
+// h = e * f
+void expansionProduct(const Expansion& e, const Expansion& f, Expansion& h) {
+    Expansion result;
+    Expansion scaled;
+
+    for (int i = 0; i < f.size; i++) {
+        scaleExpansion(e, f.terms[i], scaled);
+        expansionSum(result, scaled, result);
+    }
+
+    h = result;
+}
+
+Expansion difference(double a, double b) {
+    Expansion e;
+    double x, y;
+    twoDiff(a, b, x, y);
+    e.push(y);
+    e.push(x);
+    return e;
+}
+
+Expansion negate(const Expansion& e) {
+    Expansion result = e;
+    for (int i = 0; i < result.size; i++) {
+        result.terms[i] = -result.terms[i];
+    }
+    return result;
+}
+
+// ad x (bd, cd) con diferencias exactas
+int orient3dExact(const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c, const glm::dvec3& d) {
+    const Expansion adx = difference(a.x, d.x), ady = difference(a.y, d.y), adz = difference(a.z, d.z);
+    const Expansion bdx = difference(b.x, d.x), bdy = difference(b.y, d.y), bdz = difference(b.z, d.z);
+    const Expansion cdx = difference(c.x, d.x), cdy = difference(c.y, d.y), cdz = difference(c.z, d.z);
+
+    // Menores 2x2
+    auto minor = [](const Expansion& p, const Expansion& q, const Expansion& r, const Expansion& s) {
+        Expansion ps, rq, result;
+        expansionProduct(p, s, ps);
+        expansionProduct(r, q, rq);
+        expansionSum(ps, negate(rq), result);
+        return result;
+    };
+
+    const Expansion m0 = minor(bdy, bdz, cdy, cdz);   // bdy*cdz - cdy*bdz
+    const Expansion m1 = minor(bdz, bdx, cdz, cdx);   // bdz*cdx - cdz*bdx
+    const Expansion m2 = minor(bdx, bdy, cdx, cdy);   // bdx*cdy - cdx*bdy
+
+    Expansion t0, t1, t2, sum, det;
+    expansionProduct(adx, m0, t0);
+    expansionProduct(ady, m1, t1);
+    expansionProduct(adz, m2, t2);
+    expansionSum(t0, t1, sum);
+    expansionSum(sum, t2, det);
+
+    return det.sign();
+}
+
+int orient2dExact(const glm::dvec2& a, const glm::dvec2& b, const glm::dvec2& c) {
+    const Expansion acx = difference(a.x, c.x), acy = difference(a.y, c.y);
+    const Expansion bcx = difference(b.x, c.x), bcy = difference(b.y, c.y);
+
+    Expansion left, right, det;
+    expansionProduct(acx, bcy, left);
+    expansionProduct(acy, bcx, right);
+    expansionSum(left, negate(right), det);
+
+    return det.sign();
+}
+
+constexpr double epsilon = std::numeric_limits<double>::epsilon() * 0.5;
+
+// Cotas de error del filtro (Shewchuk, "Adaptive Precision Floating-Point
+// Arithmetic and Fast Robust Geometric Predicates")
+constexpr double orient3dBound = (7.0 + 56.0 * epsilon) * epsilon;
+constexpr double orient2dBound = (3.0 + 16.0 * epsilon) * epsilon;
+
+} // namespace
+
+int orient3d(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d) {
+    const glm::dvec3 ad = glm::dvec3(a) - glm::dvec3(d);
+    const glm::dvec3 bd = glm::dvec3(b) - glm::dvec3(d);
+    const glm::dvec3 cd = glm::dvec3(c) - glm::dvec3(d);
+
+    const double bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+    const double cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+    const double adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+
+    const double det =
+        ad.z * (bdxcdy - cdxbdy) +
+        bd.z * (cdxady - adxcdy) +
+        cd.z * (adxbdy - bdxady);
+
+    const double permanent =
+        (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(ad.z) +
+        (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bd.z) +
+        (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cd.z);
+
+    const double bound = orient3dBound * permanent;
+
+    if (det > bound) {
+        return 1;
+    }
+    if (-det > bound) {
+        return -1;
+    }
+
+    return orient3dExact(a, b, c, d);
+}
+
+int orient2d(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) {
+    const double left = (double(a.x) - c.x) * (double(b.y) - c.y);
+    const double right = (double(a.y) - c.y) * (double(b.x) - c.x);
+    const double det = left - right;
+
+    const double bound = orient2dBound * (std::abs(left) + std::abs(right));
+
+    if (det > bound) {
+        return 1;
+    }
+    if (-det > bound) {
+        return -1;
+    }
+
+    return orient2dExact(a, b, c);
+}
+
+} // namespace math
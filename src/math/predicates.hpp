@@ -0,0 +1,30 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Predicados geométricos exactos (Shewchuk).
+//
+// Primero se evalúa el determinante en double y se compara con una cota de
+// error; solo si el resultado no es concluyente se recalcula de forma exacta
+// con aritmética de expansiones. Las coordenadas de entrada son float, así
+// que el caso rápido resuelve casi todas las consultas.
+
+namespace math {
+
+// Signo del volumen orientado del tetraedro (a, b, c, d):
+//  > 0 si d queda debajo del plano abc (abc antihorario visto desde arriba),
+//  < 0 si queda encima y 0 si los cuatro puntos son coplanares.
+int orient3d(
+    const glm::vec3& a,
+    const glm::vec3& b,
+    const glm::vec3& c,
+    const glm::vec3& d
+);
+
+// Como orient3d en 2D: > 0 si (a, b, c) giran en sentido antihorario.
+int orient2d(
+    const glm::vec2& a,
+    const glm::vec2& b,
+    const glm::vec2& c
+);
+
+} // namespace math
@@ -0,0 +1,190 @@
+#include "ray_packet.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+
+namespace math {
+
+namespace {
+
+// Intervalo de (p - [oMin, oMax]) * [iMin, iMax]
+inline void slabInterval(float p, float oMin, float oMax, float iMin, float iMax, float& lo, float& hi) {
+    const float nLo = p - oMax;
+    const float nHi = p - oMin;
+
+    const float a = nLo * iMin;
+    const float b = nLo * iMax;
+    const float c = nHi * iMin;
+    const float d = nHi * iMax;
+
+    lo = std::min(std::min(a, b), std::min(c, d));
+    hi = std::max(std::max(a, b), std::max(c, d));
+}
+
+} // namespace
+
+template <int N>
+RayPacketFrustum makePacketFrustum(const RayPacket<N>& packet) {
+    const float inf = std::numeric_limits<float>::infinity();
+
+    RayPacketFrustum frustum{
+        glm::vec3(inf), glm::vec3(-inf),
+        glm::vec3(inf), glm::vec3(-inf),
+        0.0f
+    };
+
+    for (int lane = 0; lane < N; lane++) {
+        if ((packet.active >> lane & 1) == 0) {
+            continue;
+        }
+
+        const glm::vec3 origin(packet.originX[lane], packet.originY[lane], packet.originZ[lane]);
+        const glm::vec3 inverse(packet.invDirectionX[lane], packet.invDirectionY[lane], packet.invDirectionZ[lane]);
+
+        frustum.originMin = glm::min(frustum.originMin, origin);
+        frustum.originMax = glm::max(frustum.originMax, origin);
+        frustum.invDirectionMin = glm::min(frustum.invDirectionMin, inverse);
+        frustum.invDirectionMax = glm::max(frustum.invDirectionMax, inverse);
+        frustum.tMax = std::max(frustum.tMax, packet.tMax[lane]);
+    }
+    return frustum;
+}
+
+bool overlaps(const RayPacketFrustum& frustum, const AABB& box) {
+    // Cada rayo entra en la caja no antes de la mayor de las cotas inferiores
+    // de entrada por eje y sale no después de la menor de las superiores.
+    float enter = 0.0f;
+    float exit = frustum.tMax;
+
+    for (int axis = 0; axis < 3; axis++) {
+        float loMin, hiMin, loMax, hiMax;
+
+        slabInterval(box.min[axis], frustum.originMin[axis], frustum.originMax[axis],
+            frustum.invDirectionMin[axis], frustum.invDirectionMax[axis], loMin, hiMin);
+        slabInterval(box.max[axis], frustum.originMin[axis], frustum.originMax[axis],
+            frustum.invDirectionMin[axis], frustum.invDirectionMax[axis], loMax, hiMax);
+
+        enter = std::max(enter, std::min(loMin, loMax));
+        exit = std::min(exit, std::max(hiMin, hiMax));
+    }
+    return enter <= exit;
+}
+
+template <int N>
+int intersect(const RayPacket<N>& packet, const AABB& box, float* tNear) {
+    using L = simd::Lanes<N>;
+
+    const L t1x = (L::broadcast(box.min.x) - L::load(packet.originX)) * L::load(packet.invDirectionX);
+    const L t2x = (L::broadcast(box.max.x) - L::load(packet.originX)) * L::load(packet.invDirectionX);
+    const L t1y = (L::broadcast(box.min.y) - L::load(packet.originY)) * L::load(packet.invDirectionY);
+    const L t2y = (L::broadcast(box.max.y) - L::load(packet.originY)) * L::load(packet.invDirectionY);
+    const L t1z = (L::broadcast(box.min.z) - L::load(packet.originZ)) * L::load(packet.invDirectionZ);
+    const L t2z = (L::broadcast(box.max.z) - L::load(packet.originZ)) * L::load(packet.invDirectionZ);
+
+    const L enter = max(
+        max(min(t1x, t2x), min(t1y, t2y)),
+        max(min(t1z, t2z), L::broadcast(0.0f)));
+    const L exit = min(
+        min(max(t1x, t2x), max(t1y, t2y)),
+        min(max(t1z, t2z), L::load(packet.tMax)));
+
+    if (tNear != nullptr) {
+        enter.store(tNear);
+    }
+    return movemask(enter <= exit) & packet.active;
+}
+
+template <int N>
+int intersect(
+    RayPacket<N>& packet,
+    const glm::vec3& v0,
+    const glm::vec3& v1,
+    const glm::vec3& v2,
+    uint32_t primitive,
+    RayPacketHit<N>& hit,
+    int lanes) {
+
+    using L = simd::Lanes<N>;
+
+    lanes &= packet.active;
+    if (lanes == 0) {
+        return 0;
+    }
+
+    const glm::vec3 e1 = v1 - v0;
+    const glm::vec3 e2 = v2 - v0;
+
+    const L e1x = L::broadcast(e1.x), e1y = L::broadcast(e1.y), e1z = L::broadcast(e1.z);
+    const L e2x = L::broadcast(e2.x), e2y = L::broadcast(e2.y), e2z = L::broadcast(e2.z);
+
+    const L dx = L::load(packet.directionX);
+    const L dy = L::load(packet.directionY);
+    const L dz = L::load(packet.directionZ);
+
+    // p = d x e2
+    const L px = dy * e2z - dz * e2y;
+    const L py = dz * e2x - dx * e2z;
+    const L pz = dx * e2y - dy * e2x;
+
+    const L det = e1x * px + e1y * py + e1z * pz;
+    const L invDet = L::broadcast(1.0f) / det;
+
+    // s = o - v0
+    const L sx = L::load(packet.originX) - L::broadcast(v0.x);
+    const L sy = L::load(packet.originY) - L::broadcast(v0.y);
+    const L sz = L::load(packet.originZ) - L::broadcast(v0.z);
+
+    const L u = (sx * px + sy * py + sz * pz) * invDet;
+
+    // q = s x e1
+    const L qx = sy * e1z - sz * e1y;
+    const L qy = sz * e1x - sx * e1z;
+    const L qz = sx * e1y - sy * e1x;
+
+    const L v = (dx * qx + dy * qy + dz * qz) * invDet;
+    const L t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+    const L zero = L::broadcast(0.0f);
+    const L tMax = L::load(packet.tMax);
+
+    // Con det == 0 (rayo paralelo) u, v y t salen inf o NaN y las
+    // comparaciones fallan solas
+    const L inside =
+        (abs(det) > zero) &
+        (u >= zero) & (v >= zero) & (u + v <= L::broadcast(1.0f)) &
+        (t >= zero) & (t < tMax);
+
+    const int updated = movemask(inside) & lanes;
+    if (updated == 0) {
+        return 0;
+    }
+
+    select(L::fromBits(updated), t, tMax).store(packet.tMax);
+
+    alignas(32) float uLanes[N];
+    alignas(32) float vLanes[N];
+    u.store(uLanes);
+    v.store(vLanes);
+
+    for (int lane = 0; lane < N; lane++) {
+        if ((updated >> lane & 1) != 0) {
+            hit.primitive[lane] = primitive;
+            hit.u[lane] = uLanes[lane];
+            hit.v[lane] = vLanes[lane];
+        }
+    }
+    return updated;
+}
+
+template RayPacketFrustum makePacketFrustum<4>(const RayPacket<4>&);
+template RayPacketFrustum makePacketFrustum<8>(const RayPacket<8>&);
+
+template int intersect<4>(const RayPacket<4>&, const AABB&, float*);
+template int intersect<8>(const RayPacket<8>&, const AABB&, float*);
+
+template int intersect<4>(RayPacket<4>&, const glm::vec3&, const glm::vec3&, const glm::vec3&,
+    uint32_t, RayPacketHit<4>&, int);
+template int intersect<8>(RayPacket<8>&, const glm::vec3&, const glm::vec3&, const glm::vec3&,
+    uint32_t, RayPacketHit<8>&, int);
+
+} // namespace math
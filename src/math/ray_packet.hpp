@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+#include "intersection.hpp"
+#include "ray.hpp"
+
+// Paquetes de 4 u 8 rayos coherentes (previsualización al pasar el ratón,
+// refinado de la selección por rectángulo, previsualizaciones por CPU...).
+//
+// Los rayos se guardan como estructura de arrays y cada kernel prueba todos
+// los rayos del paquete a la vez contra una caja o un triángulo, con un rayo
+// por carril SIMD (SSE para 4, AVX para 8). Los kernels devuelven una
+// máscara de bits con un bit por rayo.
+
+namespace math {
+
+template <int N>
+struct RayPacket {
+    static_assert(N == 4 || N == 8, "Solo hay paquetes de 4 y 8 rayos");
+
+    static constexpr int kSize = N;
+    static constexpr int kAllLanes = (1 << N) - 1;
+
+    alignas(32) float originX[N];
+    alignas(32) float originY[N];
+    alignas(32) float originZ[N];
+    alignas(32) float directionX[N];
+    alignas(32) float directionY[N];
+    alignas(32) float directionZ[N];
+    alignas(32) float invDirectionX[N];
+    alignas(32) float invDirectionY[N];
+    alignas(32) float invDirectionZ[N];
+
+    // Distancia máxima de cada rayo; los kernels de triángulos la acortan
+    // al encontrar un impacto más cercano
+    alignas(32) float tMax[N];
+
+    // Rayos válidos (un paquete en el borde de la pantalla puede ir a medias)
+    int active = 0;
+
+    RayPacket() {
+        for (int lane = 0; lane < N; lane++) {
+            setRay(lane, Ray{ glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f) }, 0.0f);
+        }
+        active = 0;
+    }
+
+    void setRay(int lane, const Ray& ray, float maxDistance = std::numeric_limits<float>::max()) {
+        const RayInverse inverse = makeRayInverse(ray);
+
+        originX[lane] = ray.origin.x;
+        originY[lane] = ray.origin.y;
+        originZ[lane] = ray.origin.z;
+        directionX[lane] = ray.direction.x;
+        directionY[lane] = ray.direction.y;
+        directionZ[lane] = ray.direction.z;
+        invDirectionX[lane] = inverse.invDirection.x;
+        invDirectionY[lane] = inverse.invDirection.y;
+        invDirectionZ[lane] = inverse.invDirection.z;
+        tMax[lane] = maxDistance;
+
+        active |= 1 << lane;
+    }
+
+    Ray getRay(int lane) const {
+        return Ray{
+            glm::vec3(originX[lane], originY[lane], originZ[lane]),
+            glm::vec3(directionX[lane], directionY[lane], directionZ[lane])
+        };
+    }
+};
+
+using RayPacket4 = RayPacket<4>;
+using RayPacket8 = RayPacket<8>;
+
+// Impacto más cercano por rayo; la distancia queda en RayPacket::tMax
+template <int N>
+struct RayPacketHit {
+    static constexpr uint32_t kNoHit = std::numeric_limits<uint32_t>::max();
+
+    uint32_t primitive[N];
+    float u[N];      // coordenadas baricéntricas del impacto
+    float v[N];
+
+    RayPacketHit() {
+        for (int lane = 0; lane < N; lane++) {
+            primitive[lane] = kNoHit;
+            u[lane] = 0.0f;
+            v[lane] = 0.0f;
+        }
+    }
+};
+
+// Frustum conservador del paquete: los intervalos que cubren los orígenes y
+// las inversas de las direcciones de todos sus rayos. Con aritmética de
+// intervalos basta un test por caja para descartarla para todo el paquete;
+// cuanto más coherentes son los rayos, más ajustado es.
+struct RayPacketFrustum {
+    glm::vec3 originMin;
+    glm::vec3 originMax;
+    glm::vec3 invDirectionMin;
+    glm::vec3 invDirectionMax;
+    float tMax;
+};
+
+template <int N>
+RayPacketFrustum makePacketFrustum(const RayPacket<N>& packet);
+
+// false si ningún rayo del paquete puede cortar la caja
+bool overlaps(const RayPacketFrustum& frustum, const AABB& box);
+
+// Bit i a 1 si el rayo activo i corta la caja antes de su tMax. Si 'tNear'
+// no es nulo recibe la distancia de entrada de cada rayo (0 si empieza dentro).
+template <int N>
+int intersect(const RayPacket<N>& packet, const AABB& box, float* tNear = nullptr);
+
+// Möller–Trumbore con un rayo por carril contra un mismo triángulo. Los
+// rayos de 'lanes' que lo cortan antes de su tMax actualizan tMax y 'hit';
+// devuelve la máscara de los rayos actualizados.
+template <int N>
+int intersect(
+    RayPacket<N>& packet,
+    const glm::vec3& v0,
+    const glm::vec3& v1,
+    const glm::vec3& v2,
+    uint32_t primitive,
+    RayPacketHit<N>& hit,
+    int lanes = RayPacket<N>::kAllLanes
+);
+
+} // namespace math
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Carriles de floats de ancho fijo (4 u 8) para escribir los kernels por
+// paquetes una sola vez como plantilla sobre N.
+//
+//   Lanes<4>: SSE si está disponible.
+//   Lanes<8>: AVX si está disponible; si no, dos Lanes<4>.
+//
+// Sin SSE se usa un array y bucles. Las máscaras son Lanes con todos los
+// bits a 1 en los carriles verdaderos, como en SSE/AVX. Pensado para
+// incluirse solo desde .cpp: no forma parte de ninguna interfaz pública.
+
+namespace math::simd {
+
+template <int N>
+struct Lanes;
+
+// ---------------------------------------------------------------------------
+// 4 carriles
+// ---------------------------------------------------------------------------
+
+#if defined(__SSE2__)
+
+template <>
+struct Lanes<4> {
+    __m128 v;
+
+    static Lanes broadcast(float x) { return { _mm_set1_ps(x) }; }
+    // Máscara con el carril i activo si lo está el bit i de 'bits'
+    static Lanes fromBits(int bits);
+    static Lanes load(const float* p) { return { _mm_loadu_ps(p) }; }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+};
+
+inline Lanes<4> operator+(Lanes<4> a, Lanes<4> b) { return { _mm_add_ps(a.v, b.v) }; }
+inline Lanes<4> operator-(Lanes<4> a, Lanes<4> b) { return { _mm_sub_ps(a.v, b.v) }; }
+inline Lanes<4> operator*(Lanes<4> a, Lanes<4> b) { return { _mm_mul_ps(a.v, b.v) }; }
+inline Lanes<4> operator/(Lanes<4> a, Lanes<4> b) { return { _mm_div_ps(a.v, b.v) }; }
+inline Lanes<4> operator&(Lanes<4> a, Lanes<4> b) { return { _mm_and_ps(a.v, b.v) }; }
+inline Lanes<4> operator|(Lanes<4> a, Lanes<4> b) { return { _mm_or_ps(a.v, b.v) }; }
+inline Lanes<4> operator^(Lanes<4> a, Lanes<4> b) { return { _mm_xor_ps(a.v, b.v) }; }
+inline Lanes<4> andNot(Lanes<4> a, Lanes<4> b) { return { _mm_andnot_ps(a.v, b.v) }; }
+inline Lanes<4> min(Lanes<4> a, Lanes<4> b) { return { _mm_min_ps(a.v, b.v) }; }
+inline Lanes<4> max(Lanes<4> a, Lanes<4> b) { return { _mm_max_ps(a.v, b.v) }; }
+inline Lanes<4> operator<(Lanes<4> a, Lanes<4> b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+inline Lanes<4> operator<=(Lanes<4> a, Lanes<4> b) { return { _mm_cmple_ps(a.v, b.v) }; }
+inline Lanes<4> operator>(Lanes<4> a, Lanes<4> b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+inline Lanes<4> operator>=(Lanes<4> a, Lanes<4> b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+inline Lanes<4> operator==(Lanes<4> a, Lanes<4> b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+inline Lanes<4> sqrt(Lanes<4> a) { return { _mm_sqrt_ps(a.v) }; }
+inline int movemask(Lanes<4> a) { return _mm_movemask_ps(a.v); }
+
+// Traspone la matriz 4x4 cuyas filas son a, b, c y d
+inline void transpose(Lanes<4>& a, Lanes<4>& b, Lanes<4>& c, Lanes<4>& d) {
+    _MM_TRANSPOSE4_PS(a.v, b.v, c.v, d.v);
+}
+
+inline Lanes<4> select(Lanes<4> mask, Lanes<4> a, Lanes<4> b) {
+    return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+}
+
+inline Lanes<4> Lanes<4>::fromBits(int bits) {
+    return { _mm_castsi128_ps(_mm_set_epi32(
+        -(bits >> 3 & 1), -(bits >> 2 & 1), -(bits >> 1 & 1), -(bits & 1))) };
+}
+
+#else
+
+template <>
+struct Lanes<4> {
+    float v[4];
+
+    static Lanes broadcast(float x) { return { { x, x, x, x } }; }
+    // Máscara con el carril i activo si lo está el bit i de 'bits'
+    static Lanes fromBits(int bits);
+    static Lanes load(const float* p) { Lanes r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+};
+
+namespace detail {
+
+inline uint32_t bitsOf(float x) { uint32_t b; std::memcpy(&b, &x, 4); return b; }
+inline float floatOf(uint32_t b) { float x; std::memcpy(&x, &b, 4); return x; }
+inline float maskOf(bool value) { return floatOf(value ? 0xffffffffu : 0u); }
+
+template <typename Op>
+inline Lanes<4> map(Lanes<4> a, Lanes<4> b, Op op) {
+    Lanes<4> r;
+    for (int i = 0; i < 4; i++) {
+        r.v[i] = op(a.v[i], b.v[i]);
+    }
+    return r;
+}
+
+} // namespace detail
+
+inline Lanes<4> operator+(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x + y; }); }
+inline Lanes<4> operator-(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x - y; }); }
+inline Lanes<4> operator*(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x * y; }); }
+inline Lanes<4> operator/(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x / y; }); }
+inline Lanes<4> min(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x < y ? x : y; }); }
+inline Lanes<4> max(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return x > y ? x : y; }); }
+
+inline Lanes<4> operator&(Lanes<4> a, Lanes<4> b) {
+    return detail::map(a, b, [](float x, float y) { return detail::floatOf(detail::bitsOf(x) & detail::bitsOf(y)); });
+}
+inline Lanes<4> operator|(Lanes<4> a, Lanes<4> b) {
+    return detail::map(a, b, [](float x, float y) { return detail::floatOf(detail::bitsOf(x) | detail::bitsOf(y)); });
+}
+inline Lanes<4> operator^(Lanes<4> a, Lanes<4> b) {
+    return detail::map(a, b, [](float x, float y) { return detail::floatOf(detail::bitsOf(x) ^ detail::bitsOf(y)); });
+}
+inline Lanes<4> andNot(Lanes<4> a, Lanes<4> b) {
+    return detail::map(a, b, [](float x, float y) { return detail::floatOf(~detail::bitsOf(x) & detail::bitsOf(y)); });
+}
+
+inline Lanes<4> operator<(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x < y); }); }
+inline Lanes<4> operator<=(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x <= y); }); }
+inline Lanes<4> operator>(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x > y); }); }
+inline Lanes<4> operator>=(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x >= y); }); }
+inline Lanes<4> operator==(Lanes<4> a, Lanes<4> b) { return detail::map(a, b, [](float x, float y) { return detail::maskOf(x == y); }); }
+
+inline Lanes<4> sqrt(Lanes<4> a) {
+    Lanes<4> r;
+    for (int i = 0; i < 4; i++) {
+        r.v[i] = std::sqrt(a.v[i]);
+    }
+    return r;
+}
+
+// Traspone la matriz 4x4 cuyas filas son a, b, c y d
+inline void transpose(Lanes<4>& a, Lanes<4>& b, Lanes<4>& c, Lanes<4>& d) {
+    Lanes<4>* rows[4] = { &a, &b, &c, &d };
+    for (int i = 0; i < 4; i++) {
+        for (int j = i + 1; j < 4; j++) {
+            std::swap(rows[i]->v[j], rows[j]->v[i]);
+        }
+    }
+}
+
+inline int movemask(Lanes<4> a) {
+    int bits = 0;
+    for (int i = 0; i < 4; i++) {
+        bits |= int(detail::bitsOf(a.v[i]) >> 31) << i;
+    }
+    return bits;
+}
+
+inline Lanes<4> select(Lanes<4> mask, Lanes<4> a, Lanes<4> b) {
+    return (mask & a) | andNot(mask, b);
+}
+
+inline Lanes<4> Lanes<4>::fromBits(int bits) {
+    Lanes<4> r;
+    for (int i = 0; i < 4; i++) {
+        r.v[i] = detail::maskOf((bits >> i & 1) != 0);
+    }
+    return r;
+}
+
+#endif
+
+// ---------------------------------------------------------------------------
+// 8 carriles
+// ---------------------------------------------------------------------------
+
+#if defined(__AVX__)
+
+template <>
+struct Lanes<8> {
+    __m256 v;
+
+    static Lanes broadcast(float x) { return { _mm256_set1_ps(x) }; }
+    // Máscara con el carril i activo si lo está el bit i de 'bits'
+    static Lanes fromBits(int bits);
+    static Lanes load(const float* p) { return { _mm256_loadu_ps(p) }; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+};
+
+inline Lanes<8> operator+(Lanes<8> a, Lanes<8> b) { return { _mm256_add_ps(a.v, b.v) }; }
+inline Lanes<8> operator-(Lanes<8> a, Lanes<8> b) { return { _mm256_sub_ps(a.v, b.v) }; }
+inline Lanes<8> operator*(Lanes<8> a, Lanes<8> b) { return { _mm256_mul_ps(a.v, b.v) }; }
+inline Lanes<8> operator/(Lanes<8> a, Lanes<8> b) { return { _mm256_div_ps(a.v, b.v) }; }
+inline Lanes<8> operator&(Lanes<8> a, Lanes<8> b) { return { _mm256_and_ps(a.v, b.v) }; }
+inline Lanes<8> operator|(Lanes<8> a, Lanes<8> b) { return { _mm256_or_ps(a.v, b.v) }; }
+inline Lanes<8> operator^(Lanes<8> a, Lanes<8> b) { return { _mm256_xor_ps(a.v, b.v) }; }
+inline Lanes<8> andNot(Lanes<8> a, Lanes<8> b) { return { _mm256_andnot_ps(a.v, b.v) }; }
+inline Lanes<8> min(Lanes<8> a, Lanes<8> b) { return { _mm256_min_ps(a.v, b.v) }; }
+inline Lanes<8> max(Lanes<8> a, Lanes<8> b) { return { _mm256_max_ps(a.v, b.v) }; }
+inline Lanes<8> operator<(Lanes<8> a, Lanes<8> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+inline Lanes<8> operator<=(Lanes<8> a, Lanes<8> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+inline Lanes<8> operator>(Lanes<8> a, Lanes<8> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+inline Lanes<8> operator>=(Lanes<8> a, Lanes<8> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+inline Lanes<8> operator==(Lanes<8> a, Lanes<8> b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+inline int movemask(Lanes<8> a) { return _mm256_movemask_ps(a.v); }
+
+inline Lanes<8> select(Lanes<8> mask, Lanes<8> a, Lanes<8> b) {
+    return { _mm256_blendv_ps(b.v, a.v, mask.v) };
+}
+
+inline Lanes<8> Lanes<8>::fromBits(int bits) {
+    return { _mm256_castsi256_ps(_mm256_set_epi32(
+        -(bits >> 7 & 1), -(bits >> 6 & 1), -(bits >> 5 & 1), -(bits >> 4 & 1),
+        -(bits >> 3 & 1), -(bits >> 2 & 1), -(bits >> 1 & 1), -(bits & 1))) };
+}
+
+#else
+
+template <>
+struct Lanes<8> {
+    Lanes<4> lo, hi;
+
+    static Lanes broadcast(float x) { return { Lanes<4>::broadcast(x), Lanes<4>::broadcast(x) }; }
+    // Máscara con el carril i activo si lo está el bit i de 'bits'
+    static Lanes fromBits(int bits);
+    static Lanes load(const float* p) { return { Lanes<4>::load(p), Lanes<4>::load(p + 4) }; }
+    void store(float* p) const { lo.store(p); hi.store(p + 4); }
+};
+
+inline Lanes<8> operator+(Lanes<8> a, Lanes<8> b) { return { a.lo + b.lo, a.hi + b.hi }; }
+inline Lanes<8> operator-(Lanes<8> a, Lanes<8> b) { return { a.lo - b.lo, a.hi - b.hi }; }
+inline Lanes<8> operator*(Lanes<8> a, Lanes<8> b) { return { a.lo * b.lo, a.hi * b.hi }; }
+inline Lanes<8> operator/(Lanes<8> a, Lanes<8> b) { return { a.lo / b.lo, a.hi / b.hi }; }
+inline Lanes<8> operator&(Lanes<8> a, Lanes<8> b) { return { a.lo & b.lo, a.hi & b.hi }; }
+inline Lanes<8> operator|(Lanes<8> a, Lanes<8> b) { return { a.lo | b.lo, a.hi | b.hi }; }
+inline Lanes<8> operator^(Lanes<8> a, Lanes<8> b) { return { a.lo ^ b.lo, a.hi ^ b.hi }; }
+inline Lanes<8> andNot(Lanes<8> a, Lanes<8> b) { return { andNot(a.lo, b.lo), andNot(a.hi, b.hi) }; }
+inline Lanes<8> min(Lanes<8> a, Lanes<8> b) { return { min(a.lo, b.lo), min(a.hi, b.hi) }; }
+inline Lanes<8> max(Lanes<8> a, Lanes<8> b) { return { max(a.lo, b.lo), max(a.hi, b.hi) }; }
+inline Lanes<8> operator<(Lanes<8> a, Lanes<8> b) { return { a.lo < b.lo, a.hi < b.hi }; }
+inline Lanes<8> operator<=(Lanes<8> a, Lanes<8> b) { return { a.lo <= b.lo, a.hi <= b.hi }; }
+inline Lanes<8> operator>(Lanes<8> a, Lanes<8> b) { return { a.lo > b.lo, a.hi > b.hi }; }
+inline Lanes<8> operator>=(Lanes<8> a, Lanes<8> b) { return { a.lo >= b.lo, a.hi >= b.hi }; }
+inline Lanes<8> operator==(Lanes<8> a, Lanes<8> b) { return { a.lo == b.lo, a.hi == b.hi }; }
+inline int movemask(Lanes<8> a) { return movemask(a.lo) | movemask(a.hi) << 4; }
+
+inline Lanes<8> select(Lanes<8> mask, Lanes<8> a, Lanes<8> b) {
+    return { select(mask.lo, a.lo, b.lo), select(mask.hi, a.hi, b.hi) };
+}
+
+inline Lanes<8> Lanes<8>::fromBits(int bits) {
+    return { Lanes<4>::fromBits(bits), Lanes<4>::fromBits(bits >> 4) };
+}
+
+#endif
+
+// Valor absoluto: borra el bit de signo
+template <int N>
+inline Lanes<N> abs(Lanes<N> a) {
+    return andNot(Lanes<N>::broadcast(-0.0f), a);
+}
+
+// El bit de signo de 'a' en un valor por lo demás nulo
+template <int N>
+inline Lanes<N> signBit(Lanes<N> a) {
+    return Lanes<N>::broadcast(-0.0f) & a;
+}
+
+} // namespace math::simd
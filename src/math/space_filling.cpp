@@ -0,0 +1,153 @@
+#include "space_filling.hpp"
+#include "core/parallel.hpp"
+
+#include <algorithm>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace math {
+
+namespace {
+
+#if !defined(__BMI2__)
+// Separa los 10 bits bajos dejando dos ceros entre cada uno
+uint32_t expandBits10(uint32_t v) {
+    v &= 0x3ffu;
+    v = (v | (v << 16)) & 0x030000ffu;
+    v = (v | (v << 8)) & 0x0300f00fu;
+    v = (v | (v << 4)) & 0x030c30c3u;
+    v = (v | (v << 2)) & 0x09249249u;
+    return v;
+}
+
+// Lo mismo con 21 bits en 64
+uint64_t expandBits21(uint64_t v) {
+    v &= 0x1fffffull;
+    v = (v | (v << 32)) & 0x001f00000000ffffull;
+    v = (v | (v << 16)) & 0x001f0000ff0000ffull;
+    v = (v | (v << 8)) & 0x100f00f00f00f00full;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+#endif
+
+// Skilling, "Programming the Hilbert curve" (2004): transforma las
+// coordenadas en la forma "traspuesta" del índice de Hilbert, que luego
+// basta con entrelazar (x[0] aporta el bit más alto de cada grupo)
+void axesToTranspose(uint32_t x[3], int bits) {
+    const uint32_t top = 1u << (bits - 1);
+
+    // Sin ramas: el bit q de cada coordenada es aleatorio y los saltos
+    // mal predichos costaban más que hacer las dos cosas
+    for (uint32_t q = top; q > 1; q >>= 1) {
+        const uint32_t p = q - 1;
+        for (int i = 0; i < 3; i++) {
+            const uint32_t set = 0u - ((x[i] & q) != 0);
+            const uint32_t t = (x[0] ^ x[i]) & p & ~set;
+            x[0] ^= (p & set) | t;              // invertir o intercambiar
+            x[i] ^= t;
+        }
+    }
+
+    // Código de Gray
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+
+    uint32_t t = 0;
+    for (uint32_t q = top; q > 1; q >>= 1) {
+        if (x[2] & q) {
+            t ^= q - 1;
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        x[i] ^= t;
+    }
+}
+
+template <typename Code, typename Encode>
+void computeCodes(const glm::vec3* points, size_t count, const AABB& bounds, int bits, Code* codes, size_t stride, Encode&& encode) {
+    const char* bytes = reinterpret_cast<const char*>(points);
+
+    core::parallelFor(count, 1 << 16, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            const glm::vec3& point = *reinterpret_cast<const glm::vec3*>(bytes + i * stride);
+            const glm::uvec3 cell = quantize(point, bounds, bits);
+            codes[i] = encode(cell.x, cell.y, cell.z);
+        }
+    });
+}
+
+} // namespace
+
+uint32_t mortonCode30(uint32_t x, uint32_t y, uint32_t z) {
+#if defined(__BMI2__)
+    return _pdep_u32(x, 0x09249249u) | _pdep_u32(y, 0x12492492u) | _pdep_u32(z, 0x24924924u);
+#else
+    return expandBits10(x) | (expandBits10(y) << 1) | (expandBits10(z) << 2);
+#endif
+}
+
+uint64_t mortonCode63(uint32_t x, uint32_t y, uint32_t z) {
+#if defined(__BMI2__)
+    return _pdep_u64(x, 0x1249249249249249ull)
+        | _pdep_u64(y, 0x2492492492492492ull)
+        | _pdep_u64(z, 0x4924924924924924ull);
+#else
+    return expandBits21(x) | (expandBits21(y) << 1) | (expandBits21(z) << 2);
+#endif
+}
+
+uint32_t hilbertCode30(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t transposed[3] = { x & 0x3ffu, y & 0x3ffu, z & 0x3ffu };
+    axesToTranspose(transposed, 10);
+    return mortonCode30(transposed[2], transposed[1], transposed[0]);
+}
+
+uint64_t hilbertCode63(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t transposed[3] = { x & 0x1fffffu, y & 0x1fffffu, z & 0x1fffffu };
+    axesToTranspose(transposed, 21);
+    return mortonCode63(transposed[2], transposed[1], transposed[0]);
+}
+
+glm::uvec3 quantize(const glm::vec3& point, const AABB& bounds, int bits) {
+    const float cells = static_cast<float>(1u << bits);
+    const glm::vec3 extent = glm::max(bounds.max - bounds.min, glm::vec3(1e-30f));
+    const glm::vec3 cell = glm::clamp((point - bounds.min) / extent * cells, glm::vec3(0.0f), glm::vec3(cells - 1.0f));
+
+    return glm::uvec3(cell);
+}
+
+void computeCurveCodes(
+    const glm::vec3* points,
+    size_t count,
+    const AABB& bounds,
+    SpaceFillingCurve curve,
+    uint32_t* codes,
+    size_t stride) {
+
+    if (curve == SpaceFillingCurve::Morton) {
+        computeCodes(points, count, bounds, 10, codes, stride, mortonCode30);
+    } else {
+        computeCodes(points, count, bounds, 10, codes, stride, hilbertCode30);
+    }
+}
+
+void computeCurveCodes(
+    const glm::vec3* points,
+    size_t count,
+    const AABB& bounds,
+    SpaceFillingCurve curve,
+    uint64_t* codes,
+    size_t stride) {
+
+    if (curve == SpaceFillingCurve::Morton) {
+        computeCodes(points, count, bounds, 21, codes, stride, mortonCode63);
+    } else {
+        computeCodes(points, count, bounds, 21, codes, stride, hilbertCode63);
+    }
+}
+
+} // namespace math
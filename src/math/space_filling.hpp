@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "aabb.hpp"
+
+// Curvas que recorren el espacio (space-filling curves): asignan a cada
+// punto un entero de forma que puntos cercanos en el espacio suelen tener
+// códigos cercanos. Ordenar por código deja juntos en memoria los objetos
+// que están juntos en la escena.
+//
+// Los códigos de 30 bits usan 10 bits por eje y los de 63 bits, 21.
+// - Morton (orden Z): entrelazar los bits de x, y, z. Muy barato, pero
+//   con saltos grandes entre octantes.
+// - Hilbert: sin saltos, dos códigos consecutivos son siempre celdas
+//   vecinas. Algo más caro (algoritmo de Skilling).
+
+namespace math {
+
+enum class SpaceFillingCurve {
+    Morton,
+    Hilbert
+};
+
+// Coordenadas enteras en [0, 2^10) o [0, 2^21); los bits de más se ignoran
+uint32_t mortonCode30(uint32_t x, uint32_t y, uint32_t z);
+uint64_t mortonCode63(uint32_t x, uint32_t y, uint32_t z);
+
+uint32_t hilbertCode30(uint32_t x, uint32_t y, uint32_t z);
+uint64_t hilbertCode63(uint32_t x, uint32_t y, uint32_t z);
+
+// Celda de la rejilla de 2^bits por eje que ocupa 'point' dentro de
+// 'bounds'. Los puntos fuera de la caja se llevan al borde
+glm::uvec3 quantize(const glm::vec3& point, const AABB& bounds, int bits);
+
+// Códigos de muchos puntos a la vez, en paralelo. 'stride' en bytes, como
+// en calculateBoundingBox
+void computeCurveCodes(
+    const glm::vec3* points,
+    size_t count,
+    const AABB& bounds,
+    SpaceFillingCurve curve,
+    uint32_t* codes,
+    size_t stride = sizeof(glm::vec3)
+);
+
+void computeCurveCodes(
+    const glm::vec3* points,
+    size_t count,
+    const AABB& bounds,
+    SpaceFillingCurve curve,
+    uint64_t* codes,
+    size_t stride = sizeof(glm::vec3)
+);
+
+} // namespace math
@@ -2,24 +2,21 @@
 #include <cmath>
 
 
-glm::mat4 Transform::getModelMatrix() const {
-    glm::mat4 model = glm::mat4(1.0f);
-
-    // Traslación
-    model = glm::translate(model, position);
-
-    // Rotación quaternaria
-    model *= glm::mat4_cast(rotation);
-
-    // Escalado
-    model = glm::scale(model, scale);
-
-    return model;
+glm::mat4 Transform::getModelMatrix(const glm::dvec3& origin) const {
+    // T * R * S sin multiplicar matrices: las columnas de la rotación
+    // escaladas y la traslación como última columna
+    const glm::mat3 basis = glm::mat3_cast(rotation);
+
+    return glm::mat4(
+        glm::vec4(basis[0] * scale.x, 0.0f),
+        glm::vec4(basis[1] * scale.y, 0.0f),
+        glm::vec4(basis[2] * scale.z, 0.0f),
+        glm::vec4(glm::vec3(position - origin), 1.0f));
 }
 
-void Transform::setFromModelMatrix(const glm::mat4& model) {
+void Transform::setFromModelMatrix(const glm::mat4& model, const glm::dvec3& origin) {
     // Traslación
-    position = glm::vec3(model[3]);
+    position = origin + glm::dvec3(glm::vec3(model[3]));
 
     // Escala
     scale.x = glm::length(glm::vec3(model[0]));
@@ -7,12 +7,16 @@
 #include <glm/gtc/quaternion.hpp>
 
 struct Transform {
-    glm::vec3 position {0.0f};
+    // En double: con coordenadas de obra (kilómetros) un float ya no llega
+    // al milímetro. Para dibujar se resta la posición de la cámara en double
+    // y solo la diferencia pasa a float
+    glm::dvec3 position {0.0};
     glm::quat rotation {1.0f, 0.0f, 0.0f, 0.0f};
     glm::vec3 scale {1.0f};
 
-    glm::mat4 getModelMatrix() const;
-    void setFromModelMatrix(const glm::mat4& model);
+    // Matriz de modelo relativa a 'origin' (normalmente la cámara)
+    glm::mat4 getModelMatrix(const glm::dvec3& origin = glm::dvec3(0.0)) const;
+    void setFromModelMatrix(const glm::mat4& model, const glm::dvec3& origin = glm::dvec3(0.0));
 
     glm::vec3 getRotationEuler() const;
     void setRotationEuler(const glm::vec3& euler);
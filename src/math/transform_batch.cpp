@@ -0,0 +1,306 @@
+#include "transform_batch.hpp"
+#include "simd.hpp"
+
+#include "../core/parallel.hpp"
+
+#include <algorithm>
+
+namespace math {
+
+namespace {
+
+using L = simd::Lanes<4>;
+
+// Por debajo de esto no compensa repartir entre hilos
+constexpr size_t kMinChunk = 1 << 16;
+
+inline size_t paddedSize(size_t count) {
+    return (count + 7) / 8 * 8;
+}
+
+// Columnas 0..2 de la matriz de 4 transformaciones, componente a componente
+// ([columna][fila]); la columna 3 es la posición
+struct Basis {
+    L m[3][3];
+};
+
+Basis composeBasis(const TransformSoA& transforms, size_t i) {
+    const L x = L::load(transforms.rotation(0) + i);
+    const L y = L::load(transforms.rotation(1) + i);
+    const L z = L::load(transforms.rotation(2) + i);
+    const L w = L::load(transforms.rotation(3) + i);
+
+    const L one = L::broadcast(1.0f);
+    const L two = L::broadcast(2.0f);
+
+    const L xx = x * x, yy = y * y, zz = z * z;
+    const L xy = x * y, xz = x * z, yz = y * z;
+    const L wx = w * x, wy = w * y, wz = w * z;
+
+    const L sx = L::load(transforms.scale(0) + i);
+    const L sy = L::load(transforms.scale(1) + i);
+    const L sz = L::load(transforms.scale(2) + i);
+
+    // Igual que glm::mat3_cast, con cada columna multiplicada por su escala
+    Basis b;
+    b.m[0][0] = (one - two * (yy + zz)) * sx;
+    b.m[0][1] = two * (xy + wz) * sx;
+    b.m[0][2] = two * (xz - wy) * sx;
+
+    b.m[1][0] = two * (xy - wz) * sy;
+    b.m[1][1] = (one - two * (xx + zz)) * sy;
+    b.m[1][2] = two * (yz + wx) * sy;
+
+    b.m[2][0] = two * (xz + wy) * sz;
+    b.m[2][1] = two * (yz - wx) * sz;
+    b.m[2][2] = (one - two * (xx + yy)) * sz;
+    return b;
+}
+
+// Posición de 4 transformaciones relativa a 'origin': se resta en double y
+// solo la diferencia pasa a float
+L loadRelative(const double* position, double origin) {
+#if defined(__SSE2__)
+    const __m128d o = _mm_set1_pd(origin);
+    const __m128 lo = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(position), o));
+    const __m128 hi = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(position + 2), o));
+    return { _mm_movelh_ps(lo, hi) };
+#else
+    float relative[4];
+    for (int k = 0; k < 4; k++) {
+        relative[k] = static_cast<float>(position[k] - origin);
+    }
+    return L::load(relative);
+#endif
+}
+
+// Escribe las 4 filas traspuestas en 'out' (una cada 'stride' floats), o
+// solo las 'valid' primeras si el bloque es el último
+void storeTransposed(L a, L b, L c, L d, float* out, size_t stride, size_t valid) {
+    transpose(a, b, c, d);
+
+    const L rows[4] = { a, b, c, d };
+    for (size_t k = 0; k < valid; k++) {
+        rows[k].store(out + k * stride);
+    }
+}
+
+void composeRange(const TransformSoA& transforms, const glm::dvec3& origin, size_t begin, size_t end, glm::mat4* matrices) {
+    const L zero = L::broadcast(0.0f);
+    const L one = L::broadcast(1.0f);
+
+    for (size_t i = begin; i < end; i += 4) {
+        const size_t valid = std::min<size_t>(4, end - i);
+        const Basis b = composeBasis(transforms, i);
+        float* out = &matrices[i][0][0];
+
+        for (int column = 0; column < 3; column++) {
+            storeTransposed(b.m[column][0], b.m[column][1], b.m[column][2], zero, out + 4 * column, 16, valid);
+        }
+        storeTransposed(
+            loadRelative(transforms.position(0) + i, origin.x),
+            loadRelative(transforms.position(1) + i, origin.y),
+            loadRelative(transforms.position(2) + i, origin.z), one, out + 12, 16, valid);
+    }
+}
+
+void composeRange(const TransformSoA& transforms, const glm::dvec3& origin, size_t begin, size_t end, Affine3x4* matrices) {
+    for (size_t i = begin; i < end; i += 4) {
+        const size_t valid = std::min<size_t>(4, end - i);
+        const Basis b = composeBasis(transforms, i);
+        float* out = &matrices[i].rows[0][0];
+
+        for (int row = 0; row < 3; row++) {
+            storeTransposed(b.m[0][row], b.m[1][row], b.m[2][row],
+                loadRelative(transforms.position(row) + i, origin[row]), out + 4 * row, 12, valid);
+        }
+    }
+}
+
+// Cuaternión de una base ortonormal, sin saltos: se calculan los cuatro
+// casos de glm::quat_cast y se elige por carril el de la mayor componente
+void quaternionOf(const L (&m)[3][3], L& x, L& y, L& z, L& w) {
+    const L fourX = m[0][0] - m[1][1] - m[2][2];
+    const L fourY = m[1][1] - m[0][0] - m[2][2];
+    const L fourZ = m[2][2] - m[0][0] - m[1][1];
+    const L fourW = m[0][0] + m[1][1] + m[2][2];
+
+    // Mismo orden de comparación que glm para elegir el mismo caso
+    L biggest = fourW;
+    const L greaterX = fourX > biggest;
+    biggest = select(greaterX, fourX, biggest);
+    const L greaterY = fourY > biggest;
+    biggest = select(greaterY, fourY, biggest);
+    const L isZ = fourZ > biggest;
+    biggest = select(isZ, fourZ, biggest);
+
+    const L isY = andNot(isZ, greaterY);
+    const L isX = andNot(isZ | greaterY, greaterX);
+    const L isW = andNot(isZ | isY | isX, L::fromBits(0xf));
+
+    const L value = sqrt(biggest + L::broadcast(1.0f)) * L::broadcast(0.5f);
+    const L mult = L::broadcast(0.25f) / value;
+
+    const L a = (m[1][2] - m[2][1]) * mult;
+    const L b = (m[2][0] - m[0][2]) * mult;
+    const L c = (m[0][1] - m[1][0]) * mult;
+    const L d = (m[0][1] + m[1][0]) * mult;
+    const L e = (m[2][0] + m[0][2]) * mult;
+    const L f = (m[1][2] + m[2][1]) * mult;
+
+    w = select(isW, value, select(isX, a, select(isY, b, c)));
+    x = select(isX, value, select(isW, a, select(isY, d, e)));
+    y = select(isY, value, select(isW, b, select(isX, d, f)));
+    z = select(isZ, value, select(isW, c, select(isX, e, f)));
+}
+
+void decomposeRange(const glm::mat4* matrices, const glm::dvec3& origin, size_t begin, size_t end, TransformSoA& transforms) {
+    for (size_t i = begin; i < end; i += 4) {
+        const size_t valid = std::min<size_t>(4, end - i);
+
+        // El último bloque se completa con identidades
+        glm::mat4 block[4];
+        for (size_t k = 0; k < 4; k++) {
+            block[k] = k < valid ? matrices[i + k] : glm::mat4(1.0f);
+        }
+
+        L columns[4][4];
+        for (int column = 0; column < 4; column++) {
+            L a = L::load(&block[0][column][0]);
+            L b = L::load(&block[1][column][0]);
+            L c = L::load(&block[2][column][0]);
+            L d = L::load(&block[3][column][0]);
+            transpose(a, b, c, d);
+
+            columns[column][0] = a;
+            columns[column][1] = b;
+            columns[column][2] = c;
+            columns[column][3] = d;
+        }
+
+        L m[3][3];
+        for (int column = 0; column < 3; column++) {
+            const L* v = columns[column];
+            const L length = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+            for (int row = 0; row < 3; row++) {
+                m[column][row] = v[row] / length;
+            }
+            length.store(transforms.scale(column) + i);
+
+            float relative[4];
+            columns[3][column].store(relative);
+            for (int k = 0; k < 4; k++) {
+                transforms.position(column)[i + k] = origin[column] + relative[k];
+            }
+        }
+
+        L x, y, z, w;
+        quaternionOf(m, x, y, z, w);
+        x.store(transforms.rotation(0) + i);
+        y.store(transforms.rotation(1) + i);
+        z.store(transforms.rotation(2) + i);
+        w.store(transforms.rotation(3) + i);
+    }
+}
+
+// Reparte [0, count) entre hilos en bloques alineados a 4
+template <typename Fn>
+void forEachBlock(size_t count, Fn&& fn) {
+    const size_t blocks = (count + 3) / 4;
+
+    core::parallelFor(blocks, kMinChunk / 4, [&](size_t begin, size_t end, size_t) {
+        fn(begin * 4, std::min(end * 4, count));
+    });
+}
+
+} // namespace
+
+void TransformSoA::reserve(size_t count) {
+    for (int i = 0; i < 3; i++) {
+        mPosition[i].reserve(paddedSize(count));
+        mScale[i].reserve(paddedSize(count));
+    }
+    for (std::vector<float>& array : mRotation) {
+        array.reserve(paddedSize(count));
+    }
+}
+
+void TransformSoA::clear() {
+    for (int i = 0; i < 3; i++) {
+        mPosition[i].clear();
+        mScale[i].clear();
+    }
+    for (std::vector<float>& array : mRotation) {
+        array.clear();
+    }
+    mCount = 0;
+}
+
+void TransformSoA::resize(size_t count) {
+    const size_t padded = paddedSize(count);
+
+    for (int i = 0; i < 3; i++) {
+        mPosition[i].resize(padded, 0.0);
+        mScale[i].resize(padded, 1.0f);
+        mRotation[i].resize(padded, 0.0f);
+    }
+    mRotation[3].resize(padded, 1.0f);
+
+    // Al crecer, los huecos de relleno que pasan a ser elementos pueden
+    // tener valores de antes: se reinician a la identidad
+    for (size_t i = mCount; i < count; i++) {
+        set(i, Transform{});
+    }
+    mCount = count;
+}
+
+void TransformSoA::add(const Transform& transform) {
+    resize(mCount + 1);
+    set(mCount - 1, transform);
+}
+
+void TransformSoA::set(size_t index, const Transform& transform) {
+    for (int i = 0; i < 3; i++) {
+        mPosition[i][index] = transform.position[i];
+        mScale[i][index] = transform.scale[i];
+    }
+    mRotation[0][index] = transform.rotation.x;
+    mRotation[1][index] = transform.rotation.y;
+    mRotation[2][index] = transform.rotation.z;
+    mRotation[3][index] = transform.rotation.w;
+}
+
+size_t TransformSoA::size() const {
+    return mCount;
+}
+
+Transform TransformSoA::get(size_t index) const {
+    Transform transform;
+    transform.position = glm::dvec3(mPosition[0][index], mPosition[1][index], mPosition[2][index]);
+    transform.rotation = glm::quat(mRotation[3][index], mRotation[0][index], mRotation[1][index], mRotation[2][index]);
+    transform.scale = glm::vec3(mScale[0][index], mScale[1][index], mScale[2][index]);
+    return transform;
+}
+
+void composeModelMatrices(const TransformSoA& transforms, glm::mat4* matrices, const glm::dvec3& origin) {
+    forEachBlock(transforms.size(), [&](size_t begin, size_t end) {
+        composeRange(transforms, origin, begin, end, matrices);
+    });
+}
+
+void composeModelMatrices(const TransformSoA& transforms, Affine3x4* matrices, const glm::dvec3& origin) {
+    forEachBlock(transforms.size(), [&](size_t begin, size_t end) {
+        composeRange(transforms, origin, begin, end, matrices);
+    });
+}
+
+void decomposeModelMatrices(const glm::mat4* matrices, size_t count, TransformSoA& transforms, const glm::dvec3& origin) {
+    transforms.resize(count);
+
+    forEachBlock(count, [&](size_t begin, size_t end) {
+        decomposeRange(matrices, origin, begin, end, transforms);
+    });
+}
+
+} // namespace math
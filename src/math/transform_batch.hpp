@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "affine.hpp"
+#include "transform.hpp"
+
+// Composición y descomposición de muchas transformaciones a la vez.
+//
+// Las transformaciones se guardan en SoA (un array por componente) y se
+// procesan de 4 en 4: cada componente de 4 transformaciones ocupa un
+// registro, las columnas de la matriz salen directamente del cuaternión sin
+// multiplicar matrices, y una trasposición 4x4 las pasa a matrices
+// consecutivas. El resultado coincide con Transform::getModelMatrix y
+// Transform::setFromModelMatrix.
+//
+// Las posiciones se guardan en double como en Transform; las matrices se
+// generan relativas a un origen (la cámara), restándolo en double antes de
+// pasar a float.
+
+namespace math {
+
+class TransformSoA {
+private:
+    std::vector<double> mPosition[3];
+    std::vector<float> mRotation[4];    // x, y, z, w
+    std::vector<float> mScale[3];
+    size_t mCount = 0;
+
+public:
+    static constexpr size_t kLanes = 8;
+
+    void reserve(size_t count);
+    void clear();
+    // Los elementos nuevos son la transformación identidad
+    void resize(size_t count);
+    void add(const Transform& transform);
+    void set(size_t index, const Transform& transform);
+
+    size_t size() const;
+    Transform get(size_t index) const;
+
+    const double* position(int axis) const { return mPosition[axis].data(); }
+    const float* rotation(int component) const { return mRotation[component].data(); }
+    const float* scale(int axis) const { return mScale[axis].data(); }
+
+    double* position(int axis) { return mPosition[axis].data(); }
+    float* rotation(int component) { return mRotation[component].data(); }
+    float* scale(int axis) { return mScale[axis].data(); }
+};
+
+// Una matriz de modelo por transformación, relativa a 'origin'
+void composeModelMatrices(const TransformSoA& transforms, glm::mat4* matrices,
+    const glm::dvec3& origin = glm::dvec3(0.0));
+
+// Solo las tres primeras filas (la cuarta es siempre 0 0 0 1), que es lo que
+// ocupa por instancia en la GPU
+void composeModelMatrices(const TransformSoA& transforms, Affine3x4* matrices,
+    const glm::dvec3& origin = glm::dvec3(0.0));
+
+// Inversa de composeModelMatrices para matrices sin cizalla ni escala nula
+void decomposeModelMatrices(const glm::mat4* matrices, size_t count, TransformSoA& transforms,
+    const glm::dvec3& origin = glm::dvec3(0.0));
+
+} // namespace math
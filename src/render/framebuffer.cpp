@@ -126,6 +126,10 @@ void Framebuffer::unbind() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+GLuint Framebuffer::getId() const {
+    return mFbo;
+}
+
 GLuint Framebuffer::getTexture() const {
     return mColorTexture;
 }
@@ -18,6 +18,7 @@ public:
     void bind();
     void unbind();
 
+    GLuint getId() const;
     GLuint getTexture() const;
 
     int width() const;
@@ -0,0 +1,186 @@
+#include "geometry_arena.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+using app::geometry::Vertex;
+
+namespace render {
+
+namespace {
+
+// Índices alineados a 16 bytes dentro del buffer
+constexpr size_t indexAlignment = 4;
+
+} // namespace
+
+GeometryArena::~GeometryArena() {
+    if (mVAO != 0) {
+        glDeleteVertexArrays(1, &mVAO);
+        glDeleteBuffers(1, &mVertexBuffer);
+        glDeleteBuffers(1, &mIndexBuffer);
+    }
+}
+
+void GeometryArena::init() {
+    mVertices.grow(kInitialVertices);
+    mIndices.grow(kInitialIndices);
+
+    glGenVertexArrays(1, &mVAO);
+
+    glGenBuffers(1, &mVertexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mVertexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, kInitialVertices * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &mIndexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mIndexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, kInitialIndices * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    setVertexLayout();
+}
+
+void GeometryArena::setVertexLayout() {
+    glBindVertexArray(mVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+
+    // Atributo Position - aPos del Shader
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+
+    // Atributo Color - aColor del Shader
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(1);
+
+    // El buffer de índices forma parte del estado del VAO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GeometryArena::relocate(GLuint& buffer, RangeAllocator& allocator, size_t elementSize, size_t capacity) {
+    const std::vector<RangeMove> moves = allocator.defragment();
+    allocator.grow(capacity);
+
+    GLuint target;
+    glGenBuffers(1, &target);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    glBufferData(GL_COPY_WRITE_BUFFER, allocator.getCapacity() * elementSize, nullptr, GL_STATIC_DRAW);
+
+    // Buffers distintos: las copias pueden solaparse en posiciones
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    for (const RangeMove& move : moves) {
+        glCopyBufferSubData(
+            GL_COPY_READ_BUFFER,
+            GL_COPY_WRITE_BUFFER,
+            move.from * elementSize,
+            move.to * elementSize,
+            move.size * elementSize);
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    glDeleteBuffers(1, &buffer);
+    buffer = target;
+
+    setVertexLayout();
+}
+
+GeometryArena::Handle GeometryArena::allocate(RangeAllocator& allocator, GLuint& buffer, size_t elementSize, size_t count, size_t alignment) {
+    if (mVAO == 0) {
+        init();
+    }
+
+    Handle handle = allocator.allocate(count, alignment);
+    if (handle == kInvalidHandle) {
+        // Crecer al doble (o lo que haga falta) compactando en la misma copia
+        const ArenaStats stats = allocator.getStats();
+        const size_t capacity = std::max(2 * stats.capacity, stats.used + count + alignment);
+        relocate(buffer, allocator, elementSize, capacity);
+
+        handle = allocator.allocate(count, alignment);
+    }
+    return handle;
+}
+
+GeometryArena::Handle GeometryArena::allocateVertices(const std::vector<Vertex>& vertices) {
+    const Handle handle = allocate(mVertices, mVertexBuffer, sizeof(Vertex), vertices.size(), 1);
+    if (handle != kInvalidHandle) {
+        updateVertices(handle, vertices);
+    }
+    return handle;
+}
+
+GeometryArena::Handle GeometryArena::allocateIndices(const std::vector<uint32_t>& indices) {
+    const Handle handle = allocate(mIndices, mIndexBuffer, sizeof(uint32_t), indices.size(), indexAlignment);
+    if (handle != kInvalidHandle) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mIndexBuffer);
+        glBufferSubData(
+            GL_COPY_WRITE_BUFFER,
+            mIndices.getOffset(handle) * sizeof(uint32_t),
+            indices.size() * sizeof(uint32_t),
+            indices.data());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    return handle;
+}
+
+void GeometryArena::updateVertices(Handle handle, const std::vector<Vertex>& vertices) {
+    const size_t count = std::min(vertices.size(), mVertices.getSize(handle));
+
+    // GL_COPY_WRITE_BUFFER y no GL_ARRAY_BUFFER: no toca el estado de dibujo
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mVertexBuffer);
+    glBufferSubData(
+        GL_COPY_WRITE_BUFFER,
+        mVertices.getOffset(handle) * sizeof(Vertex),
+        count * sizeof(Vertex),
+        vertices.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void GeometryArena::releaseVertices(Handle handle) {
+    mVertices.release(handle);
+}
+
+void GeometryArena::releaseIndices(Handle handle) {
+    mIndices.release(handle);
+}
+
+GLint GeometryArena::getBaseVertex(Handle vertices) const {
+    return static_cast<GLint>(mVertices.getOffset(vertices));
+}
+
+size_t GeometryArena::getIndexOffset(Handle indices) const {
+    return mIndices.getOffset(indices);
+}
+
+size_t GeometryArena::getVertexCount(Handle vertices) const {
+    return mVertices.getSize(vertices);
+}
+
+void GeometryArena::bind(GLStateCache& state) const {
+    state.bindVertexArray(mVAO);
+}
+
+void GeometryArena::defragment() {
+    if (mVAO == 0) {
+        return;
+    }
+
+    relocate(mVertexBuffer, mVertices, sizeof(Vertex), mVertices.getCapacity());
+    relocate(mIndexBuffer, mIndices, sizeof(uint32_t), mIndices.getCapacity());
+}
+
+ArenaStats GeometryArena::getVertexStats() const {
+    return mVertices.getStats();
+}
+
+ArenaStats GeometryArena::getIndexStats() const {
+    return mIndices.getStats();
+}
+
+} // namespace render
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "geometry/vertex.hpp"
+#include "range_allocator.hpp"
+#include "gl_state_cache.hpp"
+
+namespace render {
+
+// Buffers de vértices e índices compartidos por todas las mallas con el
+// formato de Vertex, con un solo VAO. Cada malla es un trozo de cada buffer
+// y se dibuja con glDrawElementsBaseVertex: sus índices siguen empezando en
+// 0 y el desplazamiento de sus vértices va en la llamada. Cambiar de malla
+// ya no cambia de VAO ni de buffers.
+//
+// Cuando algo no cabe, el buffer crece a un buffer nuevo y de paso se
+// compacta (una copia en la GPU con glCopyBufferSubData). Los buffers se
+// crean con la primera reserva: la arena puede existir antes que el
+// contexto de OpenGL.
+class GeometryArena {
+public:
+    using Handle = RangeAllocator::Handle;
+    static constexpr Handle kInvalidHandle = RangeAllocator::kInvalidHandle;
+
+    static constexpr size_t kInitialVertices = size_t(1) << 16;
+    static constexpr size_t kInitialIndices = size_t(1) << 18;
+
+private:
+    GLuint mVAO = 0;
+    GLuint mVertexBuffer = 0;
+    GLuint mIndexBuffer = 0;
+
+    RangeAllocator mVertices;
+    RangeAllocator mIndices;
+
+    void init();
+    void setVertexLayout();
+
+    // Copia los rangos vivos a un buffer nuevo de 'capacity' elementos
+    void relocate(GLuint& buffer, RangeAllocator& allocator, size_t elementSize, size_t capacity);
+
+    Handle allocate(RangeAllocator& allocator, GLuint& buffer, size_t elementSize, size_t count, size_t alignment);
+
+public:
+    GeometryArena() = default;
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    Handle allocateVertices(const std::vector<app::geometry::Vertex>& vertices);
+    Handle allocateIndices(const std::vector<uint32_t>& indices);
+
+    // Mismo número de vértices que al reservar
+    void updateVertices(Handle handle, const std::vector<app::geometry::Vertex>& vertices);
+
+    void releaseVertices(Handle handle);
+    void releaseIndices(Handle handle);
+
+    GLint getBaseVertex(Handle vertices) const;
+    size_t getIndexOffset(Handle indices) const;
+    size_t getVertexCount(Handle vertices) const;
+
+    void bind(GLStateCache& state) const;
+
+    // Compacta los dos buffers (sin crecer)
+    void defragment();
+
+    ArenaStats getVertexStats() const;
+    ArenaStats getIndexStats() const;
+};
+
+} // namespace render
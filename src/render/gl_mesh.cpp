@@ -5,7 +5,8 @@
 using  app::geometry::Mesh;
 using  app::geometry::Vertex;
 
-GLMesh::GLMesh(const Mesh& mesh) {
+GLMesh::GLMesh(const Mesh& mesh, render::GeometryArena& arena)
+    : mArena(arena) {
     if (mesh.vertices.empty()) {
         std::cerr << "Error: No se han establecido los datos de vértices para el mesh." << std::endl;
         exit(EXIT_FAILURE);
@@ -16,54 +17,57 @@ GLMesh::GLMesh(const Mesh& mesh) {
     }
 
     indexCount = static_cast<GLsizei>(mesh.indices.size());
-    
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
 
-    // Buffer para los vértices
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        mesh.vertices.size() * sizeof(Vertex),
-        mesh.vertices.data(),
-        GL_STATIC_DRAW
-    );
-
-    // Buffer para los índices de triangulos
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER,
-        mesh.indices.size() * sizeof(mesh.indices[0]),
-        mesh.indices.data(),
-        GL_STATIC_DRAW
-    );
-
-    // Atributo Position - aPos del Shader
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),  (void*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0); // aquí el 0 es el location del atributo aPos
-
-    // Atributo Color - aColor del Shader
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),  (void*)offsetof(Vertex, color));
-    glEnableVertexAttribArray(1); // aquí el 1 es el location del atributo aColor
-
-    // Desvincular VAO y VBO
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Los índices se guardan tal cual (desde 0): el desplazamiento de los
+    // vértices en la arena se suma al dibujar
+    mVertices = mArena.allocateVertices(mesh.vertices);
+    mIndices = mArena.allocateIndices(mesh.indices);
 }
 
 GLMesh::~GLMesh() {
+    mArena.releaseVertices(mVertices);
+    mArena.releaseIndices(mIndices);
 }
 
-void GLMesh::draw() const {
+void GLMesh::draw(render::GLStateCache& state) const {
     // Lógica de dibujo del mesh
 
-    glBindVertexArray(VAO);
-    glDrawElements(
+    mArena.bind(state);
+    glDrawElementsBaseVertex(
         GL_TRIANGLES,
         indexCount,
         GL_UNSIGNED_INT,
-        0
+        (void*)(mArena.getIndexOffset(mIndices) * sizeof(uint32_t)),
+        mArena.getBaseVertex(mVertices)
     );
 }
+
+render::DrawElementsIndirectCommand GLMesh::getDrawCommand(uint32_t firstInstance, uint32_t instanceCount) const {
+    render::DrawElementsIndirectCommand command;
+    command.count = static_cast<uint32_t>(indexCount);
+    command.instanceCount = instanceCount;
+    command.firstIndex = static_cast<uint32_t>(mArena.getIndexOffset(mIndices));
+    command.baseVertex = mArena.getBaseVertex(mVertices);
+    command.baseInstance = firstInstance;
+    return command;
+}
+
+void GLMesh::updateVertices(const std::vector<Vertex>& vertices) {
+    if (vertices.size() == mArena.getVertexCount(mVertices)) {
+        mArena.updateVertices(mVertices, vertices);
+        return;
+    }
+
+    // Otro tamaño: otro trozo de la arena
+    mArena.releaseVertices(mVertices);
+    mVertices = mArena.allocateVertices(vertices);
+}
+
+render::GeometryArena& GLMesh::getArena() const {
+    return mArena;
+}
+
+uint32_t GLMesh::getId() const {
+    // Los trozos de índices no cambian de handle al crecer ni al compactar
+    return mIndices;
+}
@@ -4,18 +4,40 @@
 #include <glad/glad.h>
 
 #include "geometry/mesh.hpp"
+#include "geometry_arena.hpp"
+#include "indirect_draw.hpp"
 
+// Una malla en la GPU: sus trozos de los buffers de una GeometryArena. No
+// se copia (libera sus trozos al destruirse); se comparte con shared_ptr
 class GLMesh
 {
 private:
-    GLuint VAO, VBO, EBO;
+    render::GeometryArena& mArena;
+    render::GeometryArena::Handle mVertices;
+    render::GeometryArena::Handle mIndices;
     GLsizei indexCount;
 
 public:
-    GLMesh(const app::geometry::Mesh& mesh);
+    GLMesh(const app::geometry::Mesh& mesh, render::GeometryArena& arena);
     ~GLMesh();
 
-    void draw() const;
+    GLMesh(const GLMesh&) = delete;
+    GLMesh& operator=(const GLMesh&) = delete;
+
+    void draw(render::GLStateCache& state) const;
+
+    // 'count' copias con las instancias [first, first + count), para un
+    // IndirectDrawBuffer (que dibuja con el VAO de la arena)
+    render::DrawElementsIndirectCommand getDrawCommand(uint32_t firstInstance, uint32_t instanceCount) const;
+
+    // Sustituye los datos de los vértices (mismo número de vértices o distinto)
+    void updateVertices(const std::vector<app::geometry::Vertex>& vertices);
+
+    render::GeometryArena& getArena() const;
+
+    // Distinto para cada malla viva de la arena y pequeño (los identificadores
+    // de las mallas destruidas se reutilizan): cabe en la clave de dibujo
+    uint32_t getId() const;
 };
 
 
@@ -0,0 +1,137 @@
+#include "gl_state_cache.hpp"
+
+namespace render {
+
+void GLStateCache::beginFrame() {
+    mLastFrameStats = mStats;
+    mStats = GLStateStats{};
+}
+
+void GLStateCache::invalidateBindings() {
+    mProgram = kUnknown;
+    mVertexArray = kUnknown;
+    mArrayBuffer = kUnknown;
+    mDrawIndirectBuffer = kUnknown;
+    mUniformBuffers.clear();
+    mCurrentUniforms = nullptr;
+}
+
+bool GLStateCache::shouldIssue(bool redundant) {
+    if (redundant) {
+        mStats.filtered++;
+        return false;
+    }
+    mStats.issued++;
+    return true;
+}
+
+void GLStateCache::useProgram(GLuint program) {
+    if (!shouldIssue(program == mProgram)) {
+        return;
+    }
+    glUseProgram(program);
+    mProgram = program;
+    mCurrentUniforms = program != 0 ? &mUniformValues[program] : nullptr;
+}
+
+void GLStateCache::bindVertexArray(GLuint vertexArray) {
+    if (!shouldIssue(vertexArray == mVertexArray)) {
+        return;
+    }
+    glBindVertexArray(vertexArray);
+    mVertexArray = vertexArray;
+}
+
+void GLStateCache::bindArrayBuffer(GLuint buffer) {
+    if (!shouldIssue(buffer == mArrayBuffer)) {
+        return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    mArrayBuffer = buffer;
+}
+
+void GLStateCache::bindDrawIndirectBuffer(GLuint buffer) {
+    if (!shouldIssue(buffer == mDrawIndirectBuffer)) {
+        return;
+    }
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+    mDrawIndirectBuffer = buffer;
+}
+
+void GLStateCache::bindUniformBuffer(GLuint binding, GLuint buffer) {
+    if (binding >= mUniformBuffers.size()) {
+        mUniformBuffers.resize(binding + 1, kUnknown);
+    }
+    if (!shouldIssue(buffer == mUniformBuffers[binding])) {
+        return;
+    }
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+    mUniformBuffers[binding] = buffer;
+}
+
+void GLStateCache::setEnabled(GLenum capability, bool enabled) {
+    int8_t* cached =
+        capability == GL_DEPTH_TEST ? &mCapabilities[DepthTest] :
+        capability == GL_CULL_FACE ? &mCapabilities[CullFace] :
+        capability == GL_BLEND ? &mCapabilities[Blend] : nullptr;
+
+    if (!shouldIssue(cached != nullptr && *cached == int8_t(enabled))) {
+        return;
+    }
+
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    if (cached != nullptr) {
+        *cached = int8_t(enabled);
+    }
+}
+
+void GLStateCache::polygonMode(GLenum mode) {
+    if (!shouldIssue(mode == mPolygonMode)) {
+        return;
+    }
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+    mPolygonMode = mode;
+}
+
+void GLStateCache::depthFunc(GLenum function) {
+    if (!shouldIssue(function == mDepthFunc)) {
+        return;
+    }
+    glDepthFunc(function);
+    mDepthFunc = function;
+}
+
+void GLStateCache::cullFace(GLenum face) {
+    if (!shouldIssue(face == mCullFace)) {
+        return;
+    }
+    glCullFace(face);
+    mCullFace = face;
+}
+
+void GLStateCache::blendFunc(GLenum source, GLenum destination) {
+    if (!shouldIssue(source == mBlendSource && destination == mBlendDestination)) {
+        return;
+    }
+    glBlendFunc(source, destination);
+    mBlendSource = source;
+    mBlendDestination = destination;
+}
+
+void GLStateCache::lineWidth(float width) {
+    if (!shouldIssue(width == mLineWidth)) {
+        return;
+    }
+    glLineWidth(width);
+    mLineWidth = width;
+}
+
+const GLStateStats& GLStateCache::getFrameStats() const {
+    return mLastFrameStats;
+}
+
+} // namespace render
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "shader.hpp"
+#include "uniform_table.hpp"
+
+namespace render {
+
+// Llamadas a OpenGL hechas y evitadas (por redundantes) en un frame
+struct GLStateStats {
+    size_t issued = 0;
+    size_t filtered = 0;
+};
+
+// Copia en CPU del estado de OpenGL que cambia el renderer: programa, VAO,
+// buffers, polygon mode, depth/cull/blend, grosor de línea y valores de
+// uniformes. Cada cambio se compara con la copia y solo llega al driver si
+// es distinto.
+//
+// Solo vale si todo el que toque ese estado pasa por aquí. Los bindings
+// (programa, VAO, buffers) los cambia también código de fuera del render
+// (las subidas de GeometryArena, ImGui), así que Renderer::render los
+// olvida al empezar con invalidateBindings. El resto solo lo toca el
+// renderer, e ImGui lo deja como lo encontró.
+//
+// GL_COPY_READ_BUFFER y GL_COPY_WRITE_BUFFER no se siguen: son los targets
+// para subir datos sin tocar el estado de dibujo.
+class GLStateCache {
+private:
+    static constexpr GLuint kUnknown = ~0u;
+
+    GLuint mProgram = kUnknown;
+    GLuint mVertexArray = kUnknown;
+    GLuint mArrayBuffer = kUnknown;
+    GLuint mDrawIndirectBuffer = kUnknown;
+    std::vector<GLuint> mUniformBuffers;
+
+    // Capacidades de glEnable que se siguen: -1 desconocida
+    enum Capability { DepthTest, CullFace, Blend, CapabilityCount };
+    int8_t mCapabilities[CapabilityCount] = { -1, -1, -1 };
+
+    GLenum mPolygonMode = kUnknown;
+    GLenum mDepthFunc = kUnknown;
+    GLenum mCullFace = kUnknown;
+    GLenum mBlendSource = kUnknown;
+    GLenum mBlendDestination = kUnknown;
+    float mLineWidth = -1.0f;
+
+    // Último valor de cada uniforme, por programa y location. Es estado del
+    // programa: no se pierde al cambiar de programa ni con invalidateBindings
+    struct UniformValue {
+        bool known = false;
+        unsigned char bytes[64];
+    };
+    std::unordered_map<GLuint, std::vector<UniformValue>> mUniformValues;
+    std::vector<UniformValue>* mCurrentUniforms = nullptr;
+
+    GLStateStats mStats;
+    GLStateStats mLastFrameStats;
+
+public:
+    // Cierra las cuentas del frame anterior
+    void beginFrame();
+
+    // Olvida los bindings: la siguiente llamada de cada uno llega al driver
+    void invalidateBindings();
+
+    // Cuenta una llamada; devuelve si hay que hacerla. Para estado que se
+    // sigue fuera de la caché (p. ej. el contenido de un UniformBuffer)
+    bool shouldIssue(bool redundant);
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vertexArray);
+    void bindArrayBuffer(GLuint buffer);
+    void bindDrawIndirectBuffer(GLuint buffer);
+    void bindUniformBuffer(GLuint binding, GLuint buffer);
+
+    void setEnabled(GLenum capability, bool enabled);
+    void polygonMode(GLenum mode);
+    void depthFunc(GLenum function);
+    void cullFace(GLenum face);
+    void blendFunc(GLenum source, GLenum destination);
+    void lineWidth(float width);
+
+    // Sobre el programa en uso (el último de useProgram)
+    template <typename T>
+    void setUniform(UniformHandle<T> handle, const T& value) {
+        static_assert(sizeof(T) <= sizeof(UniformValue::bytes), "Uniforme demasiado grande para la caché");
+
+        if (!handle.valid()) {
+            return;
+        }
+
+        UniformValue* cached = nullptr;
+        if (mCurrentUniforms != nullptr) {
+            const size_t location = static_cast<size_t>(handle.getLocation());
+            if (location >= mCurrentUniforms->size()) {
+                mCurrentUniforms->resize(location + 1);
+            }
+            cached = &(*mCurrentUniforms)[location];
+        }
+
+        const bool redundant = cached != nullptr && cached->known && std::memcmp(cached->bytes, &value, sizeof(T)) == 0;
+        if (!shouldIssue(redundant)) {
+            return;
+        }
+
+        uploadUniform(handle.getLocation(), value);
+        if (cached != nullptr) {
+            std::memcpy(cached->bytes, &value, sizeof(T));
+            cached->known = true;
+        }
+    }
+
+    // Las cuentas del último frame completo
+    const GLStateStats& getFrameStats() const;
+};
+
+} // namespace render
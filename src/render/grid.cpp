@@ -1,4 +1,5 @@
 #include "grid.hpp"
+#include "geometry/builtin_meshes.hpp"
 
 namespace render {
 
@@ -6,32 +7,9 @@ Grid::Grid() {
 }
 
 bool Grid::init() {
-    constexpr int size = 20;
-    glm::vec3 colorX;
-    glm::vec3 colorZ;
-
-    for (int i = 0; i < size; i++) {
-        if (i == 0) {
-            colorX = { 1.0f,0.0f,0.0f };
-            colorZ = { 0.0f,0.0f,1.0f };
-        } else {
-            colorX = { 0.0f,0.0f,0.0f };
-            colorZ = { 0.0f,0.0f,0.0f };
-        }
-        
-        //Paralelas a Eje Z
-        mVertices.emplace_back(glm::vec3{ i,0,size }, colorZ);
-        mVertices.emplace_back(glm::vec3{ i,0,-size }, colorZ);
-        mVertices.emplace_back(glm::vec3{ -i,0,size }, colorZ);
-        mVertices.emplace_back(glm::vec3{ -i,0,-size }, colorZ);
-
-        //Paralelas a Eje X
-        mVertices.emplace_back(glm::vec3{ size,0,i },colorX);
-        mVertices.emplace_back(glm::vec3{ -size,0,i },colorX);
-        mVertices.emplace_back(glm::vec3{ size,0,-i },colorX);
-        mVertices.emplace_back(glm::vec3{ -size,0,-i },colorX);
-    }
-    mVertexCount = mVertices.size();
+    // Las líneas se generan en tiempo de compilación (builtin_meshes.hpp)
+    static constexpr auto vertices = app::geometry::makeGridLines<20>();
+    mVertexCount = static_cast<GLsizei>(vertices.size());
 
     glGenVertexArrays(1, &mVAO);
     glBindVertexArray(mVAO);
@@ -42,7 +20,7 @@ bool Grid::init() {
     glBufferData(
         GL_ARRAY_BUFFER,
         mVertexCount * sizeof(Vertex),
-        mVertices.data(),
+        vertices.data(),
         GL_STATIC_DRAW
     );
 
@@ -59,15 +37,15 @@ bool Grid::init() {
 
     return true;
 }
-void Grid::draw() {
+void Grid::draw(GLStateCache& state) {
 
-    glBindVertexArray(mVAO);
+    // Sin desenlazar al terminar: el siguiente draw enlaza el suyo
+    state.bindVertexArray(mVAO);
     glDrawArrays(
         GL_LINES,
         0,
         mVertexCount
     );
-    glBindVertexArray(0);
 }
 } // namespace render
 
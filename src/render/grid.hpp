@@ -2,6 +2,7 @@
 #include <glad/glad.h>
 #include "camera/camera.hpp"
 #include "geometry/vertex.hpp"
+#include "gl_state_cache.hpp"
 
 using  app::geometry::Vertex;
 namespace render
@@ -10,15 +11,13 @@ namespace render
     {
     private:
         GLuint mVAO, mVBO;
-        Vertex vertice;
-        std::vector<Vertex> mVertices;
         GLsizei mVertexCount;
     public:
 
         Grid(/* args */);
         bool init();
 
-        void draw();
+        void draw(GLStateCache& state);
     };
     
  
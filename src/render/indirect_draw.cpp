@@ -0,0 +1,99 @@
+#include "indirect_draw.hpp"
+#include "gl_state_cache.hpp"
+#include "instance_buffer.hpp"
+#include "stream_buffer.hpp"
+
+#include <cstring>
+
+namespace render {
+
+bool IndirectDrawBuffer::isMultiDrawSupported() {
+    return GLAD_GL_ARB_multi_draw_indirect
+        && GLAD_GL_ARB_base_instance
+        && glMultiDrawElementsIndirect != nullptr;
+}
+
+void IndirectDrawBuffer::setMultiDraw(bool enabled) {
+    mMultiDraw = enabled && isMultiDrawSupported();
+}
+
+bool IndirectDrawBuffer::usesMultiDraw() const {
+    return mMultiDraw;
+}
+
+void IndirectDrawBuffer::clear() {
+    mCommands.clear();
+    mLastFrameStats = mStats;
+    mStats = IndirectDrawStats{};
+}
+
+size_t IndirectDrawBuffer::add(const DrawElementsIndirectCommand& command) {
+    mCommands.push_back(command);
+    return mCommands.size() - 1;
+}
+
+bool IndirectDrawBuffer::upload(StreamBuffer& stream) {
+    if (!mMultiDraw) {
+        return true;
+    }
+
+    const size_t size = mCommands.size() * sizeof(DrawElementsIndirectCommand);
+    const StreamAllocation allocation = stream.allocate(size);
+    if (!allocation.valid()) {
+        return false;
+    }
+
+    if (size > 0) {
+        std::memcpy(allocation.data, mCommands.data(), size);
+    }
+    mBuffer = stream.getBuffer();
+    mOffset = allocation.offset;
+    return true;
+}
+
+void IndirectDrawBuffer::draw(GLStateCache& state, const InstanceBuffer& instances, size_t first, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    mStats.commands += count;
+
+    if (mMultiDraw) {
+        // Los atributos desde la instancia 0: baseInstance hace el resto
+        instances.bindAttributes(state, 0);
+        state.bindDrawIndirectBuffer(mBuffer);
+
+        glMultiDrawElementsIndirect(
+            GL_TRIANGLES,
+            GL_UNSIGNED_INT,
+            (void*)(mOffset + first * sizeof(DrawElementsIndirectCommand)),
+            static_cast<GLsizei>(count),
+            0);
+        mStats.calls++;
+        return;
+    }
+
+    for (size_t i = first; i < first + count; i++) {
+        const DrawElementsIndirectCommand& command = mCommands[i];
+
+        instances.bindAttributes(state, command.baseInstance);
+        glDrawElementsInstancedBaseVertex(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(command.count),
+            GL_UNSIGNED_INT,
+            (void*)(size_t(command.firstIndex) * sizeof(uint32_t)),
+            static_cast<GLsizei>(command.instanceCount),
+            command.baseVertex);
+    }
+    mStats.calls += count;
+}
+
+const std::vector<DrawElementsIndirectCommand>& IndirectDrawBuffer::getCommands() const {
+    return mCommands;
+}
+
+const IndirectDrawStats& IndirectDrawBuffer::getFrameStats() const {
+    return mLastFrameStats;
+}
+
+} // namespace render
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+
+namespace render {
+
+class GLStateCache;
+class InstanceBuffer;
+class StreamBuffer;
+
+// El formato que lee glMultiDrawElementsIndirect de GL_DRAW_INDIRECT_BUFFER
+struct DrawElementsIndirectCommand {
+    uint32_t count;             // índices
+    uint32_t instanceCount;
+    uint32_t firstIndex;        // en índices, no en bytes
+    int32_t baseVertex;
+    uint32_t baseInstance;      // primera instancia en el InstanceBuffer
+};
+
+static_assert(sizeof(DrawElementsIndirectCommand) == 20, "DrawElementsIndirectCommand debe ser como el de OpenGL");
+
+// Comandos enviados y llamadas de dibujo hechas en el último frame
+struct IndirectDrawStats {
+    size_t commands = 0;
+    size_t calls = 0;
+};
+
+// Los comandos de dibujo de un frame, todos sobre el VAO de la misma
+// GeometryArena. Con GL_ARB_multi_draw_indirect (núcleo en 4.3) van a un
+// buffer indirecto y cada pase es una sola glMultiDrawElementsIndirect. El
+// contexto de App::init es 4.1: si el driver no da la extensión, se recorre
+// el mismo array con una glDrawElementsInstancedBaseVertex por comando.
+//
+// baseInstance hace falta para el camino indirecto (los atributos por
+// instancia se desplazan solos), así que también se exige
+// GL_ARB_base_instance. Sin él, el bucle engancha los atributos de nuevo en
+// cada comando, como antes.
+class IndirectDrawBuffer {
+private:
+    GLuint mBuffer = 0;
+    size_t mOffset = 0;
+    bool mMultiDraw = false;
+
+    std::vector<DrawElementsIndirectCommand> mCommands;
+
+    IndirectDrawStats mStats;
+    IndirectDrawStats mLastFrameStats;
+
+public:
+    // Con el contexto ya cargado por glad
+    static bool isMultiDrawSupported();
+
+    // Elige el camino; el indirecto solo si el driver lo soporta
+    void setMultiDraw(bool enabled);
+    bool usesMultiDraw() const;
+
+    // Empieza un frame: vacía los comandos y cierra las cuentas
+    void clear();
+
+    // Devuelve la posición del comando en el array
+    size_t add(const DrawElementsIndirectCommand& command);
+
+    // Copia los comandos a un trozo del StreamBuffer, que hace de buffer
+    // indirecto (solo en ese camino)
+    bool upload(StreamBuffer& stream);
+
+    // Dibuja los comandos [first, first + count) con el VAO de la arena ya
+    // enlazado y las instancias de 'instances'
+    void draw(GLStateCache& state, const InstanceBuffer& instances, size_t first, size_t count);
+
+    const std::vector<DrawElementsIndirectCommand>& getCommands() const;
+    const IndirectDrawStats& getFrameStats() const;
+};
+
+} // namespace render
@@ -0,0 +1,61 @@
+#include "instance_buffer.hpp"
+#include "gl_state_cache.hpp"
+
+#include <cstddef>
+#include <cstring>
+
+namespace render {
+
+namespace {
+
+// Locations de los atributos por instancia en vertex.glsl
+constexpr GLuint modelRowsLocation = 2;
+constexpr GLuint flagsLocation = 5;
+
+} // namespace
+
+InstanceData* InstanceBuffer::allocate(StreamBuffer& stream, size_t count) {
+    const StreamAllocation allocation = stream.allocate(count * sizeof(InstanceData));
+    if (!allocation.valid()) {
+        return nullptr;
+    }
+
+    mBuffer = stream.getBuffer();
+    mOffset = allocation.offset;
+    return reinterpret_cast<InstanceData*>(allocation.data);
+}
+
+bool InstanceBuffer::upload(StreamBuffer& stream, const std::vector<InstanceData>& instances) {
+    InstanceData* target = allocate(stream, instances.size());
+    if (target == nullptr) {
+        return false;
+    }
+
+    if (!instances.empty()) {
+        std::memcpy(target, instances.data(), instances.size() * sizeof(InstanceData));
+    }
+    return true;
+}
+
+void InstanceBuffer::bindAttributes(GLStateCache& state, size_t firstInstance) const {
+    const size_t base = mOffset + firstInstance * sizeof(InstanceData);
+    const GLsizei stride = sizeof(InstanceData);
+
+    state.bindArrayBuffer(mBuffer);
+
+    // Las tres filas de la matriz afín, un vec4 cada una
+    for (GLuint row = 0; row < 3; row++) {
+        const size_t offset = base + offsetof(InstanceData, model) + row * sizeof(glm::vec4);
+        glVertexAttribPointer(modelRowsLocation + row, 4, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+        glVertexAttribDivisor(modelRowsLocation + row, 1);
+        glEnableVertexAttribArray(modelRowsLocation + row);
+    }
+
+    // Flags como entero: glVertexAttribIPointer, no se convierten a float
+    const size_t flagsOffset = base + offsetof(InstanceData, flags);
+    glVertexAttribIPointer(flagsLocation, 1, GL_UNSIGNED_INT, stride, (void*)flagsOffset);
+    glVertexAttribDivisor(flagsLocation, 1);
+    glEnableVertexAttribArray(flagsLocation);
+}
+
+} // namespace render
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "instance_data.hpp"
+#include "stream_buffer.hpp"
+
+namespace render {
+
+class GLStateCache;
+
+// Las InstanceData de un frame, en un trozo de un StreamBuffer. Los
+// atributos por instancia se enganchan al VAO de cada malla justo antes de
+// dibujarla
+class InstanceBuffer {
+private:
+    GLuint mBuffer = 0;
+    size_t mOffset = 0;
+
+public:
+    // Sitio para 'count' instancias en la región del frame: se escriben
+    // directamente en la memoria que lee la GPU. nullptr si no caben
+    InstanceData* allocate(StreamBuffer& stream, size_t count);
+
+    // Copia 'instances' a un trozo nuevo del StreamBuffer
+    bool upload(StreamBuffer& stream, const std::vector<InstanceData>& instances);
+
+    // Atributos 2-5 del VAO enlazado, empezando en 'firstInstance'. OpenGL
+    // 4.1 no tiene baseInstance: el desplazamiento va en el puntero
+    void bindAttributes(GLStateCache& state, size_t firstInstance) const;
+};
+
+} // namespace render
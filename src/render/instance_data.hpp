@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "math/affine.hpp"
+
+// Lo que el renderer escribe por instancia en el buffer de streaming, en el
+// orden de la cola de dibujo. No usa OpenGL; InstanceBuffer lo engancha a
+// los atributos del VAO.
+
+namespace render {
+
+// Bits de InstanceData::flags (llegan al vertex shader como 'uint')
+enum InstanceFlags : uint32_t {
+    kInstanceSelected = 1u << 0
+};
+
+// Lo que recibe el vertex shader por instancia: las filas de la matriz de
+// modelo (locations 2-4) y los flags (location 5)
+struct InstanceData {
+    math::Affine3x4 model;
+    uint32_t flags = 0;
+};
+
+} // namespace render
@@ -0,0 +1,287 @@
+#include "mesh_streamer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+using app::geometry::ChunkInfo;
+using app::geometry::Vertex;
+
+namespace render {
+
+namespace {
+
+float distanceToBox(const glm::vec3& point, const math::AABB& box) {
+    const glm::vec3 closest = glm::clamp(point, box.min, box.max);
+    return glm::length(point - closest);
+}
+
+} // namespace
+
+MeshStreamer::MeshStreamer(const std::string& path, size_t budgetBytes, size_t uploadBytesPerFrame)
+    : mBudgetBytes(budgetBytes),
+    mUploadBytesPerFrame(uploadBytesPerFrame) {
+
+    mOpen = mFile.open(path);
+    if (!mOpen) {
+        return;
+    }
+
+    mSlots.resize(mFile.getChunks().size());
+
+    mChunkBounds.reserve(mSlots.size());
+    for (const ChunkInfo& chunk : mFile.getChunks()) {
+        mChunkBounds.add(chunk.bounds);
+    }
+    mPlaneCache.assign(math::Frustum::planeCacheSize(mSlots.size()), 0);
+
+    mReader = std::thread(&MeshStreamer::readerLoop, this);
+}
+
+MeshStreamer::~MeshStreamer() {
+    if (mReader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWakeUp.notify_one();
+        mReader.join();
+    }
+
+    for (uint32_t i = 0; i < mSlots.size(); i++) {
+        if (mSlots[i].state == ChunkState::Resident) {
+            evict(i);
+        }
+    }
+}
+
+bool MeshStreamer::isOpen() const {
+    return mOpen;
+}
+
+const app::geometry::ChunkedMeshFile& MeshStreamer::getFile() const {
+    return mFile;
+}
+
+void MeshStreamer::readerLoop() {
+    while (true) {
+        uint32_t index;
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this]() { return mStop || !mRequests.empty(); });
+
+            if (mStop) {
+                return;
+            }
+
+            index = mRequests.front();
+            mRequests.pop_front();
+        }
+
+        // Lectura fuera del cerrojo: el hilo principal nunca espera al disco
+        LoadedChunk chunk{ index, {}, {} };
+        if (!mFile.readChunk(index, chunk.vertices, chunk.indices)) {
+            chunk.vertices.clear();
+            chunk.indices.clear();
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoaded.push_back(std::move(chunk));
+    }
+}
+
+void MeshStreamer::upload(LoadedChunk& chunk) {
+    ChunkSlot& slot = mSlots[chunk.index];
+    slot.state = ChunkState::Resident;
+
+    // Un trozo que no se ha podido leer queda residente y vacío para no
+    // volver a pedirlo en cada frame
+    if (chunk.indices.empty()) {
+        return;
+    }
+
+    GpuChunk& gpu = slot.gpu;
+    gpu.indexCount = static_cast<GLsizei>(chunk.indices.size());
+
+    glGenVertexArrays(1, &gpu.vao);
+    glBindVertexArray(gpu.vao);
+
+    glGenBuffers(1, &gpu.vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, gpu.vbo);
+    glBufferData(GL_ARRAY_BUFFER, chunk.vertices.size() * sizeof(Vertex), chunk.vertices.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &gpu.ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, chunk.indices.size() * sizeof(uint32_t), chunk.indices.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void MeshStreamer::evict(uint32_t index) {
+    ChunkSlot& slot = mSlots[index];
+
+    if (slot.gpu.vao != 0) {
+        glDeleteVertexArrays(1, &slot.gpu.vao);
+        glDeleteBuffers(1, &slot.gpu.vbo);
+        glDeleteBuffers(1, &slot.gpu.ebo);
+    }
+
+    slot.gpu = GpuChunk{};
+    slot.state = ChunkState::Unloaded;
+    mResidentBytes -= mFile.getChunks()[index].byteSize();
+}
+
+bool MeshStreamer::makeRoom(size_t bytes, std::vector<uint32_t>& evictable) {
+    while (mResidentBytes + mInFlightBytes + bytes > mBudgetBytes) {
+        if (evictable.empty()) {
+            return false;
+        }
+
+        evict(evictable.back());
+        evictable.pop_back();
+    }
+    return true;
+}
+
+void MeshStreamer::update(const glm::mat4& viewProjection, const glm::vec3& cameraPosition) {
+    if (!mOpen) {
+        return;
+    }
+
+    mFrame++;
+
+    const std::vector<ChunkInfo>& chunks = mFile.getChunks();
+
+    // 1. Trozos visibles, del más cercano al más lejano
+    const math::Frustum frustum(viewProjection);
+    frustum.classify(mChunkBounds, mVisibility, mPlaneCache.data());
+
+    std::vector<std::pair<float, uint32_t>> visible;
+
+    for (uint32_t i = 0; i < chunks.size(); i++) {
+        if (mVisibility.get(i) != math::Containment::Outside) {
+            visible.emplace_back(distanceToBox(cameraPosition, chunks[i].bounds), i);
+            mSlots[i].lastUsedFrame = mFrame;
+        }
+    }
+    std::sort(visible.begin(), visible.end());
+
+    mVisible.clear();
+    for (const auto& entry : visible) {
+        mVisible.push_back(entry.second);
+    }
+
+    // 2. Recoge lo que ha leído el hilo de lectura
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (LoadedChunk& chunk : mLoaded) {
+            mSlots[chunk.index].state = ChunkState::Loaded;
+            mUploads.push_back(std::move(chunk));
+        }
+        mLoaded.clear();
+    }
+
+    // 3. Sube a GPU una cantidad acotada por frame; lo que ya no se ve se descarta
+    size_t uploadedBytes = 0;
+
+    while (!mUploads.empty() && uploadedBytes < mUploadBytesPerFrame) {
+        LoadedChunk& chunk = mUploads.front();
+        const size_t bytes = chunks[chunk.index].byteSize();
+
+        mInFlightBytes -= bytes;
+
+        if (mSlots[chunk.index].lastUsedFrame == mFrame) {
+            upload(chunk);
+            mResidentBytes += bytes;
+            uploadedBytes += bytes;
+        } else {
+            mSlots[chunk.index].state = ChunkState::Unloaded;
+        }
+
+        mUploads.pop_front();
+    }
+
+    // 4. Candidatos a expulsar: residentes que no se ven, el menos usado al final
+    std::vector<uint32_t> evictable;
+    for (uint32_t i = 0; i < mSlots.size(); i++) {
+        if (mSlots[i].state == ChunkState::Resident && mSlots[i].lastUsedFrame != mFrame) {
+            evictable.push_back(i);
+        }
+    }
+    std::sort(evictable.begin(), evictable.end(), [this](uint32_t a, uint32_t b) {
+        return mSlots[a].lastUsedFrame > mSlots[b].lastUsedFrame;
+    });
+
+    // 5. Nueva cola de lecturas en orden de distancia
+    std::vector<uint8_t> stillQueued(mSlots.size(), 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        // Los pedidos pendientes que han dejado de verse se cancelan
+        for (uint32_t index : mRequests) {
+            if (mSlots[index].lastUsedFrame == mFrame) {
+                stillQueued[index] = 1;
+            } else {
+                mSlots[index].state = ChunkState::Unloaded;
+                mInFlightBytes -= chunks[index].byteSize();
+            }
+        }
+        mRequests.clear();
+
+        bool full = false;
+
+        for (uint32_t index : mVisible) {
+            if (stillQueued[index]) {
+                mRequests.push_back(index);
+                continue;
+            }
+
+            if (full || mSlots[index].state != ChunkState::Unloaded) {
+                continue;
+            }
+
+            const size_t bytes = chunks[index].byteSize();
+            if (!makeRoom(bytes, evictable)) {
+                full = true;
+                continue;
+            }
+
+            mSlots[index].state = ChunkState::Queued;
+            mInFlightBytes += bytes;
+            mRequests.push_back(index);
+        }
+    }
+
+    mWakeUp.notify_one();
+}
+
+void MeshStreamer::draw(GLStateCache& state) const {
+    for (uint32_t index : mVisible) {
+        const ChunkSlot& slot = mSlots[index];
+
+        if (slot.state != ChunkState::Resident || slot.gpu.vao == 0) {
+            continue;
+        }
+
+        state.bindVertexArray(slot.gpu.vao);
+        glDrawElements(GL_TRIANGLES, slot.gpu.indexCount, GL_UNSIGNED_INT, 0);
+    }
+}
+
+size_t MeshStreamer::getResidentBytes() const {
+    return mResidentBytes;
+}
+
+size_t MeshStreamer::getVisibleChunkCount() const {
+    return mVisible.size();
+}
+
+} // namespace render
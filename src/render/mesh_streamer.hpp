@@ -0,0 +1,112 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "geometry/chunked_mesh.hpp"
+#include "math/frustum.hpp"
+#include "gl_state_cache.hpp"
+
+namespace render {
+
+// Dibuja una malla troceada (.cmsh) cargando en GPU solo los trozos
+// visibles, del más cercano al más lejano, sin superar un presupuesto de
+// memoria. Las lecturas de disco se hacen en un hilo aparte; el hilo
+// principal solo intercambia colas y sube a GPU una cantidad acotada de
+// datos por frame, así que nunca espera al disco.
+class MeshStreamer {
+private:
+    enum class ChunkState : uint8_t {
+        Unloaded,
+        Queued,      // pedido al hilo de lectura (o leyéndose)
+        Loaded,      // leído, pendiente de subir a GPU
+        Resident     // en GPU
+    };
+
+    struct GpuChunk {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLuint ebo = 0;
+        GLsizei indexCount = 0;
+    };
+
+    struct ChunkSlot {
+        ChunkState state = ChunkState::Unloaded;
+        GpuChunk gpu;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    struct LoadedChunk {
+        uint32_t index;
+        std::vector<app::geometry::Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    app::geometry::ChunkedMeshFile mFile;
+    bool mOpen = false;
+
+    size_t mBudgetBytes;
+    size_t mUploadBytesPerFrame;
+    size_t mResidentBytes = 0;
+    size_t mInFlightBytes = 0;      // pedidos o leídos pero aún no en GPU
+
+    uint64_t mFrame = 0;
+    std::vector<ChunkSlot> mSlots;
+
+    // Cajas de los trozos en SoA para el test de visibilidad por lotes, y
+    // el último plano de rechazo por grupo de trozos (coherencia entre frames)
+    math::AABBSoA mChunkBounds;
+    std::vector<uint8_t> mPlaneCache;
+    math::ContainmentMasks mVisibility;
+
+    std::vector<uint32_t> mVisible;   // trozos visibles este frame, de cerca a lejos
+    std::deque<LoadedChunk> mUploads; // leídos, esperando turno para subir
+
+    // Compartido con el hilo de lectura (protegido por mMutex)
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::deque<uint32_t> mRequests;
+    std::vector<LoadedChunk> mLoaded;
+    bool mStop = false;
+
+    std::thread mReader;
+
+    void readerLoop();
+    void upload(LoadedChunk& chunk);
+    void evict(uint32_t index);
+
+    // Expulsa trozos residentes no visibles (del menos usado al más usado)
+    // hasta que quepan 'bytes' más. 'evictable' está ordenado con el menos
+    // usado al final.
+    bool makeRoom(size_t bytes, std::vector<uint32_t>& evictable);
+
+public:
+    explicit MeshStreamer(
+        const std::string& path,
+        size_t budgetBytes = size_t(2) << 30,
+        size_t uploadBytesPerFrame = size_t(64) << 20
+    );
+    ~MeshStreamer();
+
+    MeshStreamer(const MeshStreamer&) = delete;
+    MeshStreamer& operator=(const MeshStreamer&) = delete;
+
+    bool isOpen() const;
+    const app::geometry::ChunkedMeshFile& getFile() const;
+
+    // Hilo principal, una vez por frame y con el contexto GL activo
+    void update(const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+    void draw(GLStateCache& state) const;
+
+    size_t getResidentBytes() const;
+    size_t getVisibleChunkCount() const;
+};
+
+} // namespace render
@@ -0,0 +1,160 @@
+#include "outline_pass.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace render {
+
+OutlinePass::OutlinePass() {
+}
+
+OutlinePass::~OutlinePass() {
+    destroyTargets();
+
+    if (mVertexArray != 0) {
+        glDeleteVertexArrays(1, &mVertexArray);
+    }
+}
+
+bool OutlinePass::init() {
+    if (!mMaskShader.load("shaders/vertex.glsl", "shaders/outline_mask_fragment.glsl")
+        || !mJumpShader.load("shaders/fullscreen_vertex.glsl", "shaders/outline_jump_fragment.glsl")
+        || !mCompositeShader.load("shaders/fullscreen_vertex.glsl", "shaders/outline_composite_fragment.glsl")) {
+        return false;
+    }
+    mJumpStep = mJumpShader.getUniform<int>("jumpStep");
+
+    // El triángulo a pantalla completa sale de gl_VertexID, pero el perfil
+    // core no dibuja sin un VAO enlazado
+    glGenVertexArrays(1, &mVertexArray);
+    return true;
+}
+
+void OutlinePass::destroyTargets() {
+    if (mFramebuffers[0] != 0) {
+        glDeleteFramebuffers(2, mFramebuffers);
+        mFramebuffers[0] = mFramebuffers[1] = 0;
+    }
+    if (mTextures[0] != 0) {
+        glDeleteTextures(2, mTextures);
+        mTextures[0] = mTextures[1] = 0;
+    }
+
+    mWidth = 0;
+    mHeight = 0;
+    mResult = -1;
+}
+
+bool OutlinePass::resize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    if (width == mWidth && height == mHeight) {
+        return true;
+    }
+
+    destroyTargets();
+
+    glGenTextures(2, mTextures);
+    glGenFramebuffers(2, mFramebuffers);
+
+    for (int i = 0; i < 2; i++) {
+        // Coordenadas de píxel enteras: 16 bits llegan a 65534 de lado
+        glBindTexture(GL_TEXTURE_2D, mTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16UI, width, height, 0, GL_RG_INTEGER, GL_UNSIGNED_SHORT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[i]);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mTextures[i], 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "Error: Framebuffer del contorno incompleto." << std::endl;
+            destroyTargets();
+            return false;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    mWidth = width;
+    mHeight = height;
+    return true;
+}
+
+bool OutlinePass::beginMask(GLStateCache& state) {
+    if (mFramebuffers[0] == 0) {
+        return false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[0]);
+
+    const GLuint empty[4] = { kNoSeed, kNoSeed, 0, 0 };
+    glClearBufferuiv(GL_COLOR, 0, empty);
+
+    state.setEnabled(GL_DEPTH_TEST, false);
+    state.useProgram(mMaskShader.getProgram());
+    return true;
+}
+
+void OutlinePass::endMask(GLStateCache& state, GLuint target, float width) {
+    state.useProgram(mJumpShader.getProgram());
+    state.bindVertexArray(mVertexArray);
+    glActiveTexture(GL_TEXTURE0);
+
+    int current = 0;
+    for (int step = getFirstJumpStep(width); step >= 1; step /= 2) {
+        glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffers[1 - current]);
+        glBindTexture(GL_TEXTURE_2D, mTextures[current]);
+        state.setUniform(mJumpStep, step);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+
+        current = 1 - current;
+    }
+    mResult = current;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target);
+    state.setEnabled(GL_DEPTH_TEST, true);
+}
+
+void OutlinePass::composite(GLStateCache& state) {
+    if (mResult < 0) {
+        return;
+    }
+
+    state.setEnabled(GL_DEPTH_TEST, false);
+    state.setEnabled(GL_BLEND, true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    state.useProgram(mCompositeShader.getProgram());
+    state.bindVertexArray(mVertexArray);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, mTextures[mResult]);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    state.setEnabled(GL_BLEND, false);
+    state.setEnabled(GL_DEPTH_TEST, true);
+
+    // Hasta la siguiente máscara no hay nada que componer
+    mResult = -1;
+}
+
+int OutlinePass::getFirstJumpStep(float width) {
+    const int reach = static_cast<int>(std::ceil(std::clamp(width, 0.0f, kMaxWidth))) + 1;
+
+    int step = 1;
+    while (2 * step - 1 < reach) {
+        step *= 2;
+    }
+    return step;
+}
+
+int OutlinePass::width() const {
+    return mWidth;
+}
+
+int OutlinePass::height() const {
+    return mHeight;
+}
+
+} // namespace render
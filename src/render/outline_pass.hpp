@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+
+#include <glad/glad.h>
+
+#include "gl_state_cache.hpp"
+#include "shader.hpp"
+#include "uniform_table.hpp"
+
+// Contorno de los seleccionados como post-proceso, con jump flooding (Rong
+// y Tan, "Jump flooding in GPU with applications to Voronoi diagram and
+// distance transform", 2006):
+//
+//   1. Los seleccionados se dibujan en una textura RG16UI en la que cada
+//      píxel cubierto guarda sus propias coordenadas (la "semilla"); el
+//      resto queda vacío.
+//   2. Cada pasada de salto mira 9 píxeles a 'paso' de distancia y se queda
+//      con la semilla más cercana de las que ven. Con pasos k, k/2, ..., 1
+//      cada píxel a menos de 2k conoce la semilla más cercana.
+//   3. La composición pinta sobre el framebuffer del viewport, con mezcla,
+//      los píxeles de fuera cuya semilla está a menos de selectionWidth
+//      (de FrameData), con un píxel de transición para el antialiasing.
+//
+// Las pasadas 2 y 3 son a pantalla completa y solo dependen del tamaño del
+// viewport y del grosor: el coste no cambia con cuántos objetos o
+// triángulos estén seleccionados. Lo único que crece es la pasada 1, que el
+// renderer hace con una sola llamada (el pase Overlay de la cola).
+//
+// Los programas leen su textura de la unidad 0, el valor por defecto de los
+// samplers, así que no hace falta asignarlos.
+
+namespace render {
+
+class OutlinePass {
+public:
+    // Valor de un píxel sin semilla
+    static constexpr GLuint kNoSeed = 0xffff;
+
+    // Grosor máximo en píxeles: fija el número de pasadas
+    static constexpr float kMaxWidth = 64.0f;
+
+private:
+    Shader mMaskShader;
+    Shader mJumpShader;
+    Shader mCompositeShader;
+    UniformHandle<int> mJumpStep;
+
+    // Semillas en dos texturas que se alternan entre pasadas
+    GLuint mTextures[2] = { 0, 0 };
+    GLuint mFramebuffers[2] = { 0, 0 };
+    GLuint mVertexArray = 0;
+
+    int mWidth = 0;
+    int mHeight = 0;
+
+    // Textura con el resultado del último salto, o -1 si no hay contorno
+    // que componer este frame
+    int mResult = -1;
+
+    void destroyTargets();
+
+public:
+    OutlinePass();
+    ~OutlinePass();
+
+    OutlinePass(const OutlinePass&) = delete;
+    OutlinePass& operator=(const OutlinePass&) = delete;
+
+    // Programas y VAO vacío de las pasadas a pantalla completa
+    bool init();
+
+    // Al tamaño del framebuffer del viewport; solo recrea si cambia
+    bool resize(int width, int height);
+
+    // Enlaza y vacía la textura de semillas con el programa de la máscara:
+    // lo que se dibuje hasta endMask es lo seleccionado. Sin test de
+    // profundidad, para que el contorno rodee también lo tapado. Falso (y
+    // no toca nada) si no hay texturas
+    bool beginMask(GLStateCache& state);
+
+    // Las pasadas de salto; deja enlazado 'target' con el estado de antes
+    void endMask(GLStateCache& state, GLuint target, float width);
+
+    // Mezcla el contorno en el framebuffer enlazado. No hace nada si este
+    // frame no ha habido máscara
+    void composite(GLStateCache& state);
+
+    // Primer paso del jump flooding para llegar a 'width' píxeles más el de
+    // transición: la menor potencia de dos k con 2k - 1 >= alcance
+    static int getFirstJumpStep(float width);
+
+    int width() const;
+    int height() const;
+};
+
+} // namespace render
@@ -0,0 +1,183 @@
+#include "range_allocator.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace render {
+
+namespace {
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+float ArenaStats::occupancy() const {
+    return capacity == 0 ? 0.0f : float(used) / float(capacity);
+}
+
+float ArenaStats::fragmentation() const {
+    const size_t free = capacity - used;
+    return free == 0 ? 0.0f : 1.0f - float(largestFreeBlock) / float(free);
+}
+
+RangeAllocator::RangeAllocator(size_t capacity) {
+    grow(capacity);
+}
+
+void RangeAllocator::addFree(size_t offset, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    // Fusión con el hueco anterior y con el siguiente si se tocan
+    auto next = mFreeByOffset.lower_bound(offset);
+    if (next != mFreeByOffset.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            removeFree(previous);
+        }
+    }
+    if (next != mFreeByOffset.end() && next->first == offset + size) {
+        size += next->second;
+        removeFree(next);
+    }
+
+    mFreeByOffset.emplace(offset, size);
+    mFreeBySize.emplace(size, offset);
+}
+
+void RangeAllocator::removeFree(std::map<size_t, size_t>::iterator block) {
+    auto range = mFreeBySize.equal_range(block->second);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == block->first) {
+            mFreeBySize.erase(it);
+            break;
+        }
+    }
+    mFreeByOffset.erase(block);
+}
+
+RangeAllocator::Handle RangeAllocator::allocate(size_t size, size_t alignment) {
+    if (size == 0 || alignment == 0) {
+        return kInvalidHandle;
+    }
+
+    // El hueco más pequeño en el que cabe; con alineación puede que el
+    // primero por tamaño no valga por el relleno del principio
+    for (auto it = mFreeBySize.lower_bound(size); it != mFreeBySize.end(); ++it) {
+        const size_t blockOffset = it->second;
+        const size_t blockSize = it->first;
+        const size_t offset = alignUp(blockOffset, alignment);
+
+        if (offset + size > blockOffset + blockSize) {
+            continue;
+        }
+
+        removeFree(mFreeByOffset.find(blockOffset));
+        addFree(blockOffset, offset - blockOffset);
+        addFree(offset + size, blockOffset + blockSize - offset - size);
+
+        Handle handle;
+        if (!mFreeHandles.empty()) {
+            handle = mFreeHandles.back();
+            mFreeHandles.pop_back();
+        } else {
+            handle = static_cast<Handle>(mRanges.size());
+            mRanges.emplace_back();
+        }
+
+        mRanges[handle] = { offset, size, alignment, true };
+        mUsed += size;
+        return handle;
+    }
+
+    return kInvalidHandle;
+}
+
+void RangeAllocator::release(Handle handle) {
+    if (handle >= mRanges.size() || !mRanges[handle].live) {
+        return;
+    }
+
+    Range& range = mRanges[handle];
+    range.live = false;
+    mUsed -= range.size;
+    addFree(range.offset, range.size);
+    mFreeHandles.push_back(handle);
+}
+
+size_t RangeAllocator::getOffset(Handle handle) const {
+    return mRanges[handle].offset;
+}
+
+size_t RangeAllocator::getSize(Handle handle) const {
+    return mRanges[handle].size;
+}
+
+size_t RangeAllocator::getCapacity() const {
+    return mCapacity;
+}
+
+void RangeAllocator::grow(size_t capacity) {
+    if (capacity <= mCapacity) {
+        return;
+    }
+
+    const size_t previous = mCapacity;
+    mCapacity = capacity;
+    addFree(previous, capacity - previous);
+}
+
+std::vector<RangeMove> RangeAllocator::defragment() {
+    std::vector<Handle> live;
+    for (Handle handle = 0; handle < mRanges.size(); handle++) {
+        if (mRanges[handle].live) {
+            live.push_back(handle);
+        }
+    }
+    std::sort(live.begin(), live.end(), [this](Handle a, Handle b) {
+        return mRanges[a].offset < mRanges[b].offset;
+    });
+
+    mFreeByOffset.clear();
+    mFreeBySize.clear();
+
+    std::vector<RangeMove> moves;
+    size_t cursor = 0;
+
+    for (Handle handle : live) {
+        Range& range = mRanges[handle];
+        const size_t offset = alignUp(cursor, range.alignment);
+        addFree(cursor, offset - cursor);
+
+        if (!moves.empty()
+            && moves.back().from + moves.back().size == range.offset
+            && moves.back().to + moves.back().size == offset) {
+            moves.back().size += range.size;
+        } else {
+            moves.push_back({ range.offset, offset, range.size });
+        }
+
+        range.offset = offset;
+        cursor = offset + range.size;
+    }
+
+    addFree(cursor, mCapacity - cursor);
+    return moves;
+}
+
+ArenaStats RangeAllocator::getStats() const {
+    ArenaStats stats;
+    stats.capacity = mCapacity;
+    stats.used = mUsed;
+    stats.allocations = mRanges.size() - mFreeHandles.size();
+    stats.freeBlocks = mFreeByOffset.size();
+    stats.largestFreeBlock = mFreeBySize.empty() ? 0 : mFreeBySize.rbegin()->first;
+    return stats;
+}
+
+} // namespace render
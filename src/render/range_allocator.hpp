@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Subreparto de un rango [0, capacidad) en trozos, para los buffers grandes
+// de GeometryArena. No usa OpenGL: las unidades son elementos (vértices o
+// índices) y la arena se encarga de los bytes.
+//
+// Los huecos libres se guardan dos veces: por posición, para fusionar los
+// vecinos al liberar, y por tamaño, para elegir el más ajustado (best-fit)
+// sin recorrerlos todos.
+
+namespace render {
+
+struct ArenaStats {
+    size_t capacity = 0;
+    size_t used = 0;
+    size_t allocations = 0;
+    size_t freeBlocks = 0;
+    size_t largestFreeBlock = 0;
+
+    // Fracción de la capacidad reservada
+    float occupancy() const;
+
+    // 0 si todo lo libre es un solo hueco; cerca de 1 si está tan troceado
+    // que el hueco mayor es una parte pequeña de lo libre
+    float fragmentation() const;
+};
+
+// Copia de 'size' elementos de 'from' a 'to' al reorganizar
+struct RangeMove {
+    size_t from;
+    size_t to;
+    size_t size;
+};
+
+class RangeAllocator {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle kInvalidHandle = UINT32_MAX;
+
+private:
+    struct Range {
+        size_t offset = 0;
+        size_t size = 0;
+        size_t alignment = 1;
+        bool live = false;
+    };
+
+    size_t mCapacity = 0;
+    size_t mUsed = 0;
+
+    // Por handle: el handle no cambia aunque defragment mueva el rango
+    std::vector<Range> mRanges;
+    std::vector<Handle> mFreeHandles;
+
+    std::map<size_t, size_t> mFreeByOffset;
+    std::multimap<size_t, size_t> mFreeBySize;
+
+    void addFree(size_t offset, size_t size);
+    void removeFree(std::map<size_t, size_t>::iterator block);
+
+public:
+    explicit RangeAllocator(size_t capacity = 0);
+
+    // kInvalidHandle si no hay un hueco donde quepa (o si size es 0).
+    // 'alignment' en elementos, potencia de dos o no
+    Handle allocate(size_t size, size_t alignment = 1);
+    void release(Handle handle);
+
+    size_t getOffset(Handle handle) const;
+    size_t getSize(Handle handle) const;
+    size_t getCapacity() const;
+
+    // Añade [capacidad actual, 'capacity') como hueco libre
+    void grow(size_t capacity);
+
+    // Junta todos los rangos al principio, en el orden en que estaban, y
+    // deja lo libre en un solo hueco al final. Devuelve las copias para
+    // llevar el contenido a un buffer nuevo: todos los rangos vivos, con
+    // los contiguos fusionados en una sola copia
+    std::vector<RangeMove> defragment();
+
+    ArenaStats getStats() const;
+};
+
+} // namespace render
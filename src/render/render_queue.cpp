@@ -0,0 +1,153 @@
+#include "render_queue.hpp"
+#include "core/radix_sort.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace render {
+
+namespace draw_key {
+
+namespace {
+
+constexpr int kStateBits = kProgramBits + kMaterialBits + kMeshBits;
+
+constexpr uint64_t mask(int bits) {
+    return (uint64_t(1) << bits) - 1;
+}
+
+// Programa, material y malla juntos, en los bits bajos
+uint64_t packState(uint32_t program, uint32_t material, uint32_t mesh) {
+    return ((program & mask(kProgramBits)) << (kMaterialBits + kMeshBits))
+        | ((material & mask(kMaterialBits)) << kMeshBits)
+        | (mesh & mask(kMeshBits));
+}
+
+// packState de una clave, esté donde esté
+uint64_t unpackState(uint64_t key) {
+    return isTranslucent(key) ? key & mask(kStateBits) : (key >> kDepthBits) & mask(kStateBits);
+}
+
+} // namespace
+
+static_assert(2 + 1 + kDepthBits + kStateBits == 64, "La clave de dibujo debe ocupar 64 bits");
+
+uint32_t quantizeDepth(float depth) {
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+
+    // El bit de signo es 0: los 24 siguientes
+    return (bits >> (31 - kDepthBits)) & static_cast<uint32_t>(mask(kDepthBits));
+}
+
+uint64_t encode(RenderPass pass, bool translucent, uint32_t program, uint32_t material, uint32_t mesh, float depth) {
+    const uint64_t state = packState(program, material, mesh);
+    const uint64_t quantized = quantizeDepth(depth);
+
+    uint64_t key = (uint64_t(pass) & 3) << 62;
+    if (translucent) {
+        // De lejos a cerca: la profundidad invertida y antes que el estado
+        key |= uint64_t(1) << 61;
+        key |= (mask(kDepthBits) - quantized) << kStateBits;
+        key |= state;
+    } else {
+        key |= state << kDepthBits;
+        key |= quantized;
+    }
+    return key;
+}
+
+RenderPass getPass(uint64_t key) {
+    return static_cast<RenderPass>(key >> 62);
+}
+
+bool isTranslucent(uint64_t key) {
+    return (key >> 61) & 1;
+}
+
+uint32_t getProgram(uint64_t key) {
+    return static_cast<uint32_t>(unpackState(key) >> (kMaterialBits + kMeshBits));
+}
+
+uint32_t getMaterial(uint64_t key) {
+    return static_cast<uint32_t>((unpackState(key) >> kMeshBits) & mask(kMaterialBits));
+}
+
+uint32_t getMesh(uint64_t key) {
+    return static_cast<uint32_t>(unpackState(key) & mask(kMeshBits));
+}
+
+uint64_t getState(uint64_t key) {
+    return (key & (mask(3) << 61)) | unpackState(key);
+}
+
+} // namespace draw_key
+
+void RenderQueue::gather(size_t chunks) {
+    std::vector<size_t> offsets(chunks + 1, mKeys.size());
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        offsets[chunk + 1] = offsets[chunk] + mChunks[chunk].keys.size();
+    }
+
+    mKeys.resize(offsets[chunks]);
+    mDraws.resize(offsets[chunks]);
+
+    // Cada bloque copia su tramo a su sitio
+    core::parallelFor(chunks, 1, [&](size_t begin, size_t end, size_t) {
+        for (size_t chunk = begin; chunk < end; chunk++) {
+            const Chunk& local = mChunks[chunk];
+            std::copy(local.keys.begin(), local.keys.end(), mKeys.begin() + offsets[chunk]);
+            std::copy(local.draws.begin(), local.draws.end(), mDraws.begin() + offsets[chunk]);
+        }
+    });
+}
+
+void RenderQueue::clear() {
+    mKeys.clear();
+    mDraws.clear();
+    mBatches.clear();
+}
+
+void RenderQueue::push(uint64_t key, uint32_t object, uint32_t mesh, uint32_t flags) {
+    mKeys.push_back(key);
+    mDraws.push_back({ object, mesh, flags });
+}
+
+void RenderQueue::sort() {
+    core::radixSort(mKeys, mDraws, mKeysTemp, mDrawsTemp);
+
+    mBatches.clear();
+
+    uint64_t state = 0;
+    for (size_t i = 0; i < mKeys.size(); i++) {
+        const uint64_t keyState = draw_key::getState(mKeys[i]);
+
+        if (mBatches.empty() || keyState != state || mDraws[i].mesh != mDraws[mBatches.back().first].mesh) {
+            mBatches.push_back({ mKeys[i], static_cast<uint32_t>(i), 0, mDraws[i].object });
+            state = keyState;
+        }
+        mBatches.back().count++;
+    }
+}
+
+size_t RenderQueue::size() const {
+    return mKeys.size();
+}
+
+const std::vector<uint64_t>& RenderQueue::getKeys() const {
+    return mKeys;
+}
+
+const std::vector<QueuedDraw>& RenderQueue::getDraws() const {
+    return mDraws;
+}
+
+const std::vector<DrawBatch>& RenderQueue::getBatches() const {
+    return mBatches;
+}
+
+} // namespace render
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/parallel.hpp"
+
+// Cola de dibujo: cada dibujo visible se resume en una clave de 64 bits y
+// se dibuja en el orden de las claves. Ordenar por clave agrupa los dibujos
+// que comparten estado (pase, programa, material, malla) y dentro de cada
+// grupo los ordena por profundidad. No usa OpenGL.
+//
+// Bits de la clave, de más a menos significativo:
+//
+//   opacos:       pase:2 | 0 | programa:8 | material:13 | malla:16 | profundidad:24
+//   translúcidos: pase:2 | 1 | profundidad:24 | programa:8 | material:13 | malla:16
+//
+// Los opacos van de cerca a lejos (menos sobredibujado) y los translúcidos,
+// después de los opacos del mismo pase, de lejos a cerca (para mezclarse
+// bien), así que en ellos la profundidad pesa más que el estado.
+
+namespace render {
+
+enum class RenderPass : uint8_t {
+    Opaque = 0,     // objetos sólidos
+    Overlay = 1     // los seleccionados, otra vez, en la máscara del contorno
+};
+
+namespace draw_key {
+
+constexpr int kDepthBits = 24;
+constexpr int kMeshBits = 16;
+constexpr int kMaterialBits = 13;
+constexpr int kProgramBits = 8;
+
+// Profundidad de vista (distancia a lo largo de la mirada) a 24 bits sin
+// fijar un rango: los bits de un float positivo crecen con su valor, así que
+// basta con quedarse con los altos. Lo que está detrás de la cámara cuenta
+// como 0
+uint32_t quantizeDepth(float depth);
+
+uint64_t encode(RenderPass pass, bool translucent, uint32_t program, uint32_t material, uint32_t mesh, float depth);
+
+RenderPass getPass(uint64_t key);
+bool isTranslucent(uint64_t key);
+uint32_t getProgram(uint64_t key);
+uint32_t getMaterial(uint64_t key);
+uint32_t getMesh(uint64_t key);
+
+// La clave sin la profundidad: dos dibujos con el mismo estado pueden ir en
+// la misma llamada instanciada
+uint64_t getState(uint64_t key);
+
+} // namespace draw_key
+
+// Lo que acompaña a cada clave. 'mesh' es el identificador completo: en la
+// clave solo caben 16 bits
+struct QueuedDraw {
+    uint32_t object;
+    uint32_t mesh;
+    uint32_t flags;
+};
+
+// Dibujos consecutivos [first, first + count) de la cola ordenada con el
+// mismo estado y la misma malla. 'object' es el primero de ellos
+struct DrawBatch {
+    uint64_t key;
+    uint32_t first;
+    uint32_t count;
+    uint32_t object;
+};
+
+class RenderQueue {
+public:
+    // Escribe en el tramo de un hilo: fill() le da uno a cada bloque
+    class Writer {
+    private:
+        std::vector<uint64_t>& mKeys;
+        std::vector<QueuedDraw>& mDraws;
+
+    public:
+        Writer(std::vector<uint64_t>& keys, std::vector<QueuedDraw>& draws)
+            : mKeys(keys), mDraws(draws) {}
+
+        void push(uint64_t key, uint32_t object, uint32_t mesh, uint32_t flags = 0) {
+            mKeys.push_back(key);
+            mDraws.push_back({ object, mesh, flags });
+        }
+    };
+
+    // Bloques de al menos tantos elementos al llenar en paralelo
+    static constexpr size_t kMinChunk = size_t(1) << 14;
+
+private:
+    struct Chunk {
+        std::vector<uint64_t> keys;
+        std::vector<QueuedDraw> draws;
+    };
+
+    std::vector<Chunk> mChunks;
+    std::vector<uint64_t> mKeys;
+    std::vector<QueuedDraw> mDraws;
+    std::vector<DrawBatch> mBatches;
+
+    // Memoria de trabajo de la ordenación, de un frame para otro
+    std::vector<uint64_t> mKeysTemp;
+    std::vector<QueuedDraw> mDrawsTemp;
+
+    // Junta los tramos de los bloques en mKeys/mDraws, en orden de bloque
+    void gather(size_t chunks);
+
+public:
+    void clear();
+
+    // Un solo hilo
+    void push(uint64_t key, uint32_t object, uint32_t mesh, uint32_t flags = 0);
+
+    // Recorre [0, count) en paralelo: fn(i, writer) encola lo que toque
+    // para el elemento i. Se añade a lo que ya hubiera en la cola, en el
+    // mismo orden que si se hiciera en un solo hilo
+    template <typename Fn>
+    void fill(size_t count, Fn&& fn) {
+        const size_t chunks = core::chunkCount(count, kMinChunk);
+
+        // Con un solo bloque se escribe directamente en la cola
+        if (chunks <= 1) {
+            Writer writer(mKeys, mDraws);
+            for (size_t i = 0; i < count; i++) {
+                fn(i, writer);
+            }
+            return;
+        }
+
+        if (mChunks.size() < chunks) {
+            mChunks.resize(chunks);
+        }
+
+        core::parallelFor(count, kMinChunk, [&](size_t begin, size_t end, size_t chunk) {
+            Chunk& local = mChunks[chunk];
+            local.keys.clear();
+            local.draws.clear();
+
+            Writer writer(local.keys, local.draws);
+            for (size_t i = begin; i < end; i++) {
+                fn(i, writer);
+            }
+        });
+
+        gather(chunks);
+    }
+
+    // Ordena por clave (radix, estable) y forma los lotes
+    void sort();
+
+    size_t size() const;
+    const std::vector<uint64_t>& getKeys() const;
+    const std::vector<QueuedDraw>& getDraws() const;
+    const std::vector<DrawBatch>& getBatches() const;
+};
+
+} // namespace render
@@ -1,6 +1,7 @@
 #include "renderer.hpp"
 
 
+#include <algorithm>
 #include <iostream>
 
 #include <fstream>
@@ -15,47 +16,221 @@ Renderer::~Renderer() {
 
 void Renderer::render(Scene& scene, Camera& camera, const ui::Viewport& viewport, const editor::EditorContext& context) {
 
-    mShader.use();
+    // Entre frames otros (ImGui, las subidas a la arena desde la UI) han
+    // enlazado sus VAO y buffers
+    mState.invalidateBindings();
+    mState.useProgram(mShader.getProgram());
+
+    // Todo se dibuja relativo a la cámara: la vista no lleva traslación y
+    // cada matriz de modelo lleva la posición del objeto menos la de la
+    // cámara, restadas en double. Así los floats de la GPU solo ven
+    // distancias pequeñas aunque el mundo esté en coordenadas de kilómetros
+    const glm::dvec3& origin = camera.getPosition();
 
     mProjection = camera.getPerspectiveMatrix(viewport.getAspectRatio());
     mView = camera.getViewMatrix();
 
-    mShader.setMat4("view", mView);
-    mShader.setMat4("perspective", mProjection);
+    // Datos del frame: una subida y un binding para todos los programas
+    FrameUniforms frame;
+    frame.view = mView;
+    frame.projection = mProjection;
+    frame.viewProjection = mProjection * mView;
+
+    const glm::vec2 viewportSize(std::max(viewport.getWidth(), 1), std::max(viewport.getHeight(), 1));
+    frame.viewportSize = glm::vec4(viewportSize, 1.0f / viewportSize);
+    frame.time = std::chrono::duration<float>(std::chrono::steady_clock::now() - mStartTime).count();
+
+    // Wireframe de toda la escena: lo pinta el mismo shader, sin más
+    // llamadas de dibujo
+    frame.wireframe = context.isWireframe() ? 1 : 0;
+    frame.wireframeColor = glm::vec4(0.05f, 0.05f, 0.05f, 0.8f);
+    frame.wireframeWidth = 1.0f;
+
+    // Contorno de los seleccionados (OutlinePass)
+    frame.selectionColor = glm::vec4(1.0f, 0.6f, 0.0f, 1.0f);
+    frame.selectionWidth = 3.0f;
+
+    mFrameUniforms.update(mState, frame);
+    mFrameUniforms.bind(mState);
+    mDrawUniforms.bind(mState);
+
+    // Lo que ya está en coordenadas de mundo float (grid y mallas troceadas)
+    // solo se traslada
+    const math::Affine3x4 worldToCamera = math::Affine3x4::fromTranslation(glm::vec3(-origin));
+
+    // Dibujamos el Grid, con color normal
+    DrawUniforms draw;
+    draw.model = worldToCamera;
+    mDrawUniforms.update(mState, draw);
+    mGrid.draw(mState);
+
+    const std::vector<Object>& objects = scene.getObjects();
+
+    mTransforms.clear();
+    mTransforms.reserve(objects.size());
+    for (const Object& object : objects) {
+        mTransforms.add(object.getTransform());
+    }
+    mModelMatrices.resize(objects.size());
+    math::composeModelMatrices(mTransforms, mModelMatrices.data(), origin);
+
+    // Visibles: la vista no lleva traslación, así que el frustum de
+    // perspectiva * vista vale para las cajas relativas a la cámara
+    mWorldBoxes.clear();
+    mWorldBoxes.reserve(objects.size());
+    for (size_t i = 0; i < objects.size(); i++) {
+        mWorldBoxes.add(math::transformBoundingBox(objects[i].getBoundingBox(), mModelMatrices[i]));
+    }
+
+    if (mPlaneCache.size() != math::Frustum::planeCacheSize(objects.size())) {
+        mPlaneCache.assign(math::Frustum::planeCacheSize(objects.size()), 0);
+    }
+    math::Frustum(frame.viewProjection).classify(mWorldBoxes, mVisibility, mPlaneCache.data());
+
+    // Profundidad de cada objeto: el centro de su caja sobre la dirección
+    // de la mirada (la vista solo rota)
+    const glm::vec3 forward(-mView[0][2], -mView[1][2], -mView[2][2]);
+    const uint32_t selectedId = context.getSelectedObjectId();
+
+    const float* minX = mWorldBoxes.minX();
+    const float* minY = mWorldBoxes.minY();
+    const float* minZ = mWorldBoxes.minZ();
+    const float* maxX = mWorldBoxes.maxX();
+    const float* maxY = mWorldBoxes.maxY();
+    const float* maxZ = mWorldBoxes.maxZ();
+
+    // Todo opaco, con un solo programa y sin materiales: por ahora la clave
+    // ordena por pase, malla y profundidad
+    mQueue.clear();
+    mQueue.fill(objects.size(), [&](size_t i, RenderQueue::Writer& queue) {
+        if ((mVisibility.outside[i >> 6] >> (i & 63)) & 1) {
+            return;
+        }
+
+        const Object& object = objects[i];
+        const glm::vec3 center(minX[i] + maxX[i], minY[i] + maxY[i], minZ[i] + maxZ[i]);
+        const float depth = 0.5f * glm::dot(forward, center);
+        const uint32_t mesh = object.getMeshId();
+        const uint32_t index = static_cast<uint32_t>(i);
+
+        queue.push(draw_key::encode(RenderPass::Opaque, false, 0, 0, mesh, depth), index, mesh);
+
+        // Los seleccionados, además, en la máscara del contorno: todos en un
+        // solo pase, una llamada por muchos que sean
+        if (object.getId() == selectedId) {
+            queue.push(draw_key::encode(RenderPass::Overlay, false, 0, 0, mesh, depth), index, mesh, kInstanceSelected);
+        }
+    });
+    mQueue.sort();
+
+    // La máscara del contorno, al tamaño de donde se dibuja
+    const Framebuffer& framebuffer = viewport.getFramebuffer();
+    mOutline.resize(framebuffer.width(), framebuffer.height());
 
-    // Dibujamos el Grid
-    mShader.setMat4("model", glm::mat4(1.0f));
-    mShader.setBool("useOverrideColor", false); // Lo dibujamos con color normal
-    mGrid.draw();
+    // Lo que va al anillo este frame: instancias y comandos, con el relleno
+    // de alineación de cada trozo
+    const std::vector<QueuedDraw>& queued = mQueue.getDraws();
+    const size_t streamBytes =
+        queued.size() * sizeof(InstanceData)
+        + mQueue.getBatches().size() * sizeof(DrawElementsIndirectCommand)
+        + 2 * StreamBuffer::kDefaultAlignment;
+    mStream.beginFrame(streamBytes);
 
-    // Dibujar objetos
-    for (auto& object : scene.getObjects()) {
-        const bool isSelected =
-            object.getId() == context.getSelectedObjectId();
+    // Las instancias en el orden de la cola, cada lote un tramo contiguo,
+    // escritas directamente en el buffer que lee la GPU
+    if (InstanceData* instances = mInstances.allocate(mStream, queued.size())) {
+        for (size_t i = 0; i < queued.size(); i++) {
+            instances[i] = { mModelMatrices[queued[i].object], queued[i].flags };
+        }
 
-        mShader.setMat4("model", object.getModelMatrix());
+        // Las matrices van en las instancias
+        draw.useInstancing = 1;
+        mDrawUniforms.update(mState, draw);
 
-        // Siempre dibujamos el objeto sólido
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        mShader.setBool("useOverrideColor", false);
-        object.draw();
+        mState.useProgram(mMeshShader.getProgram());
 
-        if (isSelected) {
+        drawQueue(objects, scene.getGeometryArena(), framebuffer.getId(), frame.selectionWidth);
+    } else {
+        std::cerr << "Error: No caben las instancias en el buffer de streaming." << std::endl;
+    }
 
-            // Después dibujamos el wireframe encima
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            mShader.setBool("useOverrideColor", true); // usamos el color de seleccionado
-            mShader.setVec3("overrideColor", glm::vec3(1.0f, 0.6f, 0.0f));
-            glLineWidth(2.0f);
+    // Mallas troceadas: se deciden los trozos a cargar y se dibujan los residentes
+    if (!scene.getStreamedMeshes().empty()) {
+        // Las cajas de los trozos están en mundo: el frustum se construye
+        // con la vista absoluta
+        const glm::mat4 viewProjection = frame.viewProjection * worldToCamera.toMatrix();
 
-            object.draw();
+        draw = DrawUniforms{};
+        draw.model = worldToCamera;
+        mDrawUniforms.update(mState, draw);
 
-            // Restauramos el estado
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            glLineWidth(1.0f);
-            mShader.setBool("useOverrideColor", false);
+        for (const auto& streamer : scene.getStreamedMeshes()) {
+            // Las subidas y expulsiones de trozos enlazan y borran VAOs por
+            // su cuenta
+            streamer->update(viewProjection, glm::vec3(origin));
+            mState.invalidateBindings();
+            mState.useProgram(mMeshShader.getProgram());
+
+            streamer->draw(mState);
         }
     }
+
+    // El contorno encima de todo
+    mOutline.composite(mState);
+
+    // Después de la máscara, que también lee del anillo
+    mStream.endFrame();
+}
+
+void Renderer::drawQueue(const std::vector<Object>& objects, const GeometryArena& arena, GLuint target, float outlineWidth) {
+    const std::vector<DrawBatch>& batches = mQueue.getBatches();
+
+    // Un comando por lote, en el orden de la cola: los de cada pase quedan
+    // seguidos
+    mCommands.clear();
+    for (const DrawBatch& batch : batches) {
+        mCommands.add(objects[batch.object].getDrawCommand(batch.first, batch.count));
+    }
+    if (!mCommands.upload(mStream)) {
+        std::cerr << "Error: No caben los comandos de dibujo en el buffer de streaming." << std::endl;
+        return;
+    }
+
+    // Ya no se escribe más en el anillo este frame
+    mStream.flush();
+
+    // Todas las mallas de la escena están en su arena: un solo VAO
+    arena.bind(mState);
+
+    size_t first = 0;
+    while (first < batches.size()) {
+        const RenderPass pass = draw_key::getPass(batches[first].key);
+
+        size_t end = first + 1;
+        while (end < batches.size() && draw_key::getPass(batches[end].key) == pass) {
+            end++;
+        }
+
+        if (pass == RenderPass::Overlay) {
+            // Los seleccionados a la máscara; después, los saltos. Es el
+            // último pase y el contorno se compone al final del frame
+            if (mOutline.beginMask(mState)) {
+                mCommands.draw(mState, mInstances, first, end - first);
+                mOutline.endMask(mState, target, outlineWidth);
+            }
+        } else {
+            mCommands.draw(mState, mInstances, first, end - first);
+        }
+        first = end;
+    }
+}
+
+const GLStateStats& Renderer::getStateStats() const {
+    return mState.getFrameStats();
+}
+
+const IndirectDrawStats& Renderer::getIndirectStats() const {
+    return mCommands.getFrameStats();
 }
 
 void Renderer::init() {
@@ -65,17 +240,45 @@ void Renderer::init() {
         exit(EXIT_FAILURE);
     }
 
+    if (!mMeshShader.load("shaders/vertex.glsl", "shaders/wireframe_geometry.glsl", "shaders/wireframe_fragment.glsl")) {
+        std::cerr << "No se ha podido iniciar el Shader de las mallas. \n";
+        exit(EXIT_FAILURE);
+    }
+
+    if (!mOutline.init()) {
+        std::cerr << "No se han podido iniciar los Shaders del contorno. \n";
+        exit(EXIT_FAILURE);
+    }
+
     mGrid.init();
+
+    // El camino indirecto si el driver lo da (Mesa lo da aunque se pida 4.1)
+    mCommands.setMultiDraw(IndirectDrawBuffer::isMultiDrawSupported());
+    std::cout << "Dibujo de objetos: "
+        << (mCommands.usesMultiDraw() ? "glMultiDrawElementsIndirect" : "un glDrawElementsInstancedBaseVertex por lote")
+        << std::endl;
+
+    // Mapeado persistente si hay GL_ARB_buffer_storage
+    mStream.setPersistent(StreamBuffer::isPersistentSupported());
+    std::cout << "Buffer de streaming: "
+        << (mStream.isPersistent() ? "mapeado persistente" : "huérfano + glMapBufferRange sin sincronizar")
+        << std::endl;
+
+    mFrameUniforms.init(kFrameBlockBinding);
+    mDrawUniforms.init(kDrawBlockBinding);
+    mStartTime = std::chrono::steady_clock::now();
 }
 
 void Renderer::beginFrame(SDL_Window* window) {
 
-    // Activar test de profundidad
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);  // estándar
+    mState.beginFrame();
+
+    // Activar test de profundidad (solo llega al driver el primer frame)
+    mState.setEnabled(GL_DEPTH_TEST, true);
+    mState.depthFunc(GL_LESS);  // estándar
 
-    glEnable(GL_CULL_FACE); // opcional: cull front/back faces
-    glCullFace(GL_BACK);    // opcional
+    mState.setEnabled(GL_CULL_FACE, true); // opcional: cull front/back faces
+    mState.cullFace(GL_BACK);    // opcional
 
     int w, h;
     SDL_GL_GetDrawableSize(window, &w, &h);
@@ -7,6 +7,19 @@
 #include "shader.hpp"
 #include "editor/editor_context.hpp"
 #include "grid.hpp"
+#include "math/transform_batch.hpp"
+#include "math/frustum.hpp"
+#include "instance_data.hpp"
+#include "render_queue.hpp"
+#include "instance_buffer.hpp"
+#include "indirect_draw.hpp"
+#include "stream_buffer.hpp"
+#include "uniform_blocks.hpp"
+#include "uniform_buffer.hpp"
+#include "gl_state_cache.hpp"
+#include "outline_pass.hpp"
+
+#include <chrono>
 
 namespace render {
 
@@ -17,9 +30,50 @@ private:
     glm::mat4 mProjection;
     glm::mat4 mView;
 
+    // El grid (líneas) con mShader; las mallas con mMeshShader, que añade el
+    // geometry shader del wireframe sobre el sombreado
     Shader mShader;
+    Shader mMeshShader;
     Grid mGrid;
 
+    // Todo el estado de OpenGL del render pasa por aquí
+    GLStateCache mState;
+
+    // Bloques uniformes FrameData y DrawData, en sus binding points fijos
+    UniformBuffer<FrameUniforms> mFrameUniforms;
+    UniformBuffer<DrawUniforms> mDrawUniforms;
+    std::chrono::steady_clock::time_point mStartTime;
+
+    // Transformaciones de la escena y sus matrices, compuestas por lotes
+    // una vez por frame (se reutilizan para no reservar memoria cada vez)
+    math::TransformSoA mTransforms;
+    std::vector<math::Affine3x4> mModelMatrices;
+
+    // Culling de los objetos (cajas relativas a la cámara) y cola de los
+    // visibles ordenada por clave: una llamada instanciada por cada tramo
+    // con el mismo pase y la misma malla. El overlay son los seleccionados,
+    // otra vez, en la máscara del contorno
+    math::AABBSoA mWorldBoxes;
+    math::ContainmentMasks mVisibility;
+    std::vector<uint8_t> mPlaneCache;
+
+    RenderQueue mQueue;
+    InstanceBuffer mInstances;
+
+    // Instancias y comandos de cada frame, escritos en un anillo de tres
+    // regiones en vez de subidos con glBufferSubData
+    StreamBuffer mStream;
+
+    // Un comando por lote de la cola; cada pase se envía de una vez
+    IndirectDrawBuffer mCommands;
+
+    // Contorno de los seleccionados por jump flooding, compuesto al final
+    OutlinePass mOutline;
+
+    // 'target' es el framebuffer del viewport, que se vuelve a enlazar tras
+    // la máscara del contorno
+    void drawQueue(const std::vector<Object>& objects, const GeometryArena& arena, GLuint target, float outlineWidth);
+
 public:
     Renderer(/* args */);
     ~Renderer();
@@ -37,6 +91,12 @@ public:
     //void setShaderProgram(GLuint shaderProgram);
     //GLuint getShaderProgram() const;
     void beginFrame(SDL_Window* window);
+
+    // Llamadas hechas y evitadas por la caché de estado en el último frame
+    const GLStateStats& getStateStats() const;
+
+    // Comandos y llamadas de dibujo de los objetos en el último frame
+    const IndirectDrawStats& getIndirectStats() const;
 };
 
 
@@ -1,7 +1,9 @@
 #include "shader.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <utility>
 
 namespace render {
 
@@ -12,10 +14,25 @@ std::string Shader::loadSource(const std::string& filename) {
         throw std::runtime_error("No se pudo abrir el archivo shader.");
     }
 
-    return std::string(
-        (std::istreambuf_iterator<char>(file)),
-        std::istreambuf_iterator<char>()
-    );
+    // GLSL no tiene #include: las líneas '#include "archivo"' se sustituyen
+    // por el archivo (relativo al que lo incluye), p. ej. los bloques
+    // uniformes comunes de uniform_blocks.glsl
+    const std::string directory = filename.substr(0, filename.find_last_of('/') + 1);
+    const std::string directive = "#include \"";
+
+    std::string source;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, directive.size(), directive) == 0) {
+            const size_t end = line.find('"', directive.size());
+            source += loadSource(directory + line.substr(directive.size(), end - directive.size()));
+        } else {
+            source += line;
+        }
+        source += '\n';
+    }
+
+    return source;
 }
 
 GLuint Shader::compile(GLenum type, const std::string& source) {
@@ -36,7 +53,7 @@ GLuint Shader::compile(GLenum type, const std::string& source) {
         char infoLog[1024];
         glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
         std::cerr << "Error compilando "
-            << (type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT")
+            << (type == GL_VERTEX_SHADER ? "VERTEX" : type == GL_GEOMETRY_SHADER ? "GEOMETRY" : "FRAGMENT")
             << " shader:\n" << infoLog << std::endl;
         glDeleteShader(shader);
         return 0;
@@ -44,10 +61,13 @@ GLuint Shader::compile(GLenum type, const std::string& source) {
     return shader;
 }
 
-bool Shader::link(GLuint vertexShader, GLuint fragmentShader) {
+bool Shader::link(GLuint vertexShader, GLuint geometryShader, GLuint fragmentShader) {
 
     mProgram = glCreateProgram();
     glAttachShader(mProgram, vertexShader);
+    if (geometryShader != 0) {
+        glAttachShader(mProgram, geometryShader);
+    }
     glAttachShader(mProgram, fragmentShader);
     glLinkProgram(mProgram);
 
@@ -61,6 +81,53 @@ bool Shader::link(GLuint vertexShader, GLuint fragmentShader) {
         mProgram = 0;
         return false;
     }
+
+    reflectUniforms();
+
+    for (const UniformBlockLayout& block : kUniformBlocks) {
+        if (!bindUniformBlock(block)) {
+            glDeleteProgram(mProgram);
+            mProgram = 0;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Shader::bindUniformBlock(const UniformBlockLayout& block) {
+    const GLuint index = glGetUniformBlockIndex(mProgram, block.name);
+    if (index == GL_INVALID_INDEX) {
+        return true; // el programa no usa el bloque
+    }
+
+    glUniformBlockBinding(mProgram, index, block.binding);
+
+    // El bloque GLSL no puede ser mayor que el struct que lo llena
+    GLint size = 0;
+    glGetActiveUniformBlockiv(mProgram, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+    if (static_cast<size_t>(size) > block.size) {
+        std::cerr << "Bloque uniforme " << block.name << ": " << size
+            << " bytes en GLSL y " << block.size << " en C++" << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < block.memberCount; i++) {
+        const UniformBlockMember& member = block.members[i];
+
+        GLuint uniform = GL_INVALID_INDEX;
+        glGetUniformIndices(mProgram, 1, &member.name, &uniform);
+        if (uniform == GL_INVALID_INDEX) {
+            continue; // miembro no usado por este programa
+        }
+
+        GLint offset = -1;
+        glGetActiveUniformsiv(mProgram, 1, &uniform, GL_UNIFORM_OFFSET, &offset);
+        if (static_cast<size_t>(offset) != member.offset) {
+            std::cerr << "Bloque uniforme " << block.name << "." << member.name
+                << ": offset " << offset << " en GLSL y " << member.offset << " en C++" << std::endl;
+            return false;
+        }
+    }
     return true;
 }
 
@@ -87,7 +154,7 @@ bool render::Shader::load(const std::string& vertexFile, const std::string& frag
         return false;
     }
 
-    bool success = link(vertexShader, fragmentShader);
+    bool success = link(vertexShader, 0, fragmentShader);
 
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
@@ -95,61 +162,95 @@ bool render::Shader::load(const std::string& vertexFile, const std::string& frag
     return success;
 }
 
+bool Shader::load(const std::string& vertexFile, const std::string& geometryFile, const std::string& fragmentFile) {
+
+    GLuint vertexShader = compile(GL_VERTEX_SHADER, loadSource(vertexFile));
+    GLuint geometryShader = compile(GL_GEOMETRY_SHADER, loadSource(geometryFile));
+    GLuint fragmentShader = compile(GL_FRAGMENT_SHADER, loadSource(fragmentFile));
+
+    bool success = vertexShader && geometryShader && fragmentShader
+        && link(vertexShader, geometryShader, fragmentShader);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(geometryShader);
+    glDeleteShader(fragmentShader);
+
+    return success;
+}
+
 void Shader::use() const {
     //printf("Shader program = %u\n", mProgram);
     glUseProgram(mProgram);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& value) {
-    GLint location = getUniformLocation(name);
-
-    if (location == -1) {
-        return;
-    }
+GLuint Shader::getProgram() const {
+    return mProgram;
+}
 
-    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+const UniformTable& Shader::getUniformTable() const {
+    return mUniformTable;
 }
 
-void Shader::setBool(const std::string& name, bool value) {
+void Shader::setMat4(const std::string& name, const glm::mat4& value) {
+    set(getUniform<glm::mat4>(name), value);
+}
 
-    GLint location = getUniformLocation(name);
+void Shader::setAffine(const std::string& name, const math::Affine3x4& value) {
+    set(getUniform<math::Affine3x4>(name), value);
+}
 
-    if (location == -1) {
-        return;
-    }
-    glUniform1i(location, value);
+void Shader::setBool(const std::string& name, bool value) {
+    set(getUniform<bool>(name), value);
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) {
-    GLint location = getUniformLocation(name);
-
-    if (location == -1) {
-        return;
-    }
-
-    glUniform3fv(location, 1, glm::value_ptr(value));
+    set(getUniform<glm::vec3>(name), value);
 }
 
 GLint Shader::getUniformLocation(const std::string& name) {
-    auto it = mUniforms.find(name);
-    if (it != mUniforms.end()) {
-        // La clave existe y podemos acceder a su valor con it->second
-        return it->second;
+    const UniformInfo* uniform = mUniformTable.find(name);
+    if (uniform == nullptr) {
+        reportUniform(name, "no encontrado");
+        return -1;
     }
+    return uniform->location;
+}
 
-    GLint location = glGetUniformLocation(mProgram, name.c_str());
-
-    if (location == -1) {
-        std::cerr
-            << "Uniform no encontrado: "
-            << name
-            << std::endl;
+void Shader::reflectUniforms() {
+    mUniformTable.clear();
+    mReportedUniforms.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(mProgram, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(mProgram, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<GLchar> name(std::max(maxLength, 1));
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(mProgram, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+
+        UniformInfo uniform;
+        uniform.name.assign(name.data(), length);
+        uniform.type = type;
+        uniform.count = size;
+        uniform.location = glGetUniformLocation(mProgram, uniform.name.c_str());
+        mUniformTable.add(std::move(uniform));
     }
+}
 
-    mUniforms[name] = location;
+void Shader::reportUniform(const std::string& name, const char* problem) {
+    if (std::find(mReportedUniforms.begin(), mReportedUniforms.end(), name) != mReportedUniforms.end()) {
+        return;
+    }
+    mReportedUniforms.push_back(name);
 
-    return location;
+    std::cerr
+        << "Uniform " << problem << ": "
+        << name
+        << std::endl;
 }
 
 } // namespace render
-
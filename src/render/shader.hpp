@@ -1,35 +1,89 @@
 #pragma once
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include <glad/glad.h>
 #include <glm/mat4x4.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "math/affine.hpp"
+#include "uniform_blocks.hpp"
+#include "uniform_table.hpp"
+
 namespace render {
 
+// Subida de un valor a una location del programa en uso, por tipo
+inline void uploadUniform(GLint location, float value) { glUniform1f(location, value); }
+inline void uploadUniform(GLint location, int value) { glUniform1i(location, value); }
+inline void uploadUniform(GLint location, bool value) { glUniform1i(location, value); }
+inline void uploadUniform(GLint location, const glm::vec3& value) { glUniform3fv(location, 1, glm::value_ptr(value)); }
+inline void uploadUniform(GLint location, const glm::vec4& value) { glUniform4fv(location, 1, glm::value_ptr(value)); }
+inline void uploadUniform(GLint location, const glm::mat4& value) { glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value)); }
+
+// Affine3x4 va por filas y un mat4x3 de GLSL por columnas: se traspone
+inline void uploadUniform(GLint location, const math::Affine3x4& value) { glUniformMatrix4x3fv(location, 1, GL_TRUE, value.data()); }
+
 class Shader {
 private:
     GLuint mProgram = 0;
 
-    std::unordered_map<std::string, GLint> mUniforms;
+    // Uniformes activos, leídos con glGetActiveUniform al enlazar
+    UniformTable mUniformTable;
+
+    // Nombres ya avisados por std::cerr, para no repetir el aviso cada frame
+    std::vector<std::string> mReportedUniforms;
+
+    void reflectUniforms();
+    void reportUniform(const std::string& name, const char* problem);
 
     std::string loadSource(const std::string& filename);
 
     GLuint compile(GLenum type, const std::string& source);
 
-    bool link(GLuint vertexShader, GLuint fragmentShader);
+    // 'geometryShader' puede ser 0
+    bool link(GLuint vertexShader, GLuint geometryShader, GLuint fragmentShader);
+
+    // Asigna el binding point fijo del bloque y comprueba que los offsets
+    // del GLSL coinciden con los del struct de C++
+    bool bindUniformBlock(const UniformBlockLayout& block);
 
 public:
     Shader(/* args */);
     ~Shader();
 
     bool load(const std::string& vertexFile, const std::string& fragmentFile);
+    bool load(const std::string& vertexFile, const std::string& geometryFile, const std::string& fragmentFile);
 
     void use() const;
+    GLuint getProgram() const;
+
+    // Handle tipado para usar con set() sin buscar por nombre. Inválido (y
+    // avisa) si el programa no tiene el uniforme o es de otro tipo
+    template <typename T>
+    UniformHandle<T> getUniform(const std::string& name) {
+        const UniformHandle<T> handle = mUniformTable.getHandle<T>(name);
+        if (!handle.valid()) {
+            reportUniform(name, mUniformTable.find(name) ? "de otro tipo" : "no encontrado");
+        }
+        return handle;
+    }
+
+    // Sobre el programa en uso; con un handle inválido no hace nada
+    template <typename T>
+    void set(UniformHandle<T> handle, const T& value) const {
+        if (handle.valid()) {
+            uploadUniform(handle.getLocation(), value);
+        }
+    }
 
+    const UniformTable& getUniformTable() const;
+
+    // Por nombre: cómodos, pero buscan el nombre en cada llamada
     void setMat4(const std::string& name, const glm::mat4& value);
 
+    // Para uniformes 'mat4x3': 12 floats en vez de 16
+    void setAffine(const std::string& name, const math::Affine3x4& value);
+
     void setBool(const std::string& name, bool value);
 
     void setVec3(const std::string& name, const glm::vec3& value);
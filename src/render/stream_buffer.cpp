@@ -0,0 +1,184 @@
+#include "stream_buffer.hpp"
+
+#include <algorithm>
+
+namespace render {
+
+namespace {
+
+// Lo que se espera cada vez a la GPU antes de volver a preguntar
+constexpr GLuint64 fenceTimeout = 1'000'000;   // 1 ms
+
+size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+StreamBuffer::~StreamBuffer() {
+    destroy();
+}
+
+bool StreamBuffer::isPersistentSupported() {
+    return GLAD_GL_ARB_buffer_storage && glBufferStorage != nullptr;
+}
+
+void StreamBuffer::setPersistent(bool enabled) {
+    destroy();
+    mPersistent = enabled && isPersistentSupported();
+}
+
+bool StreamBuffer::isPersistent() const {
+    return mPersistent;
+}
+
+void StreamBuffer::create(size_t regionSize) {
+    destroy();
+
+    mRegionSize = alignUp(std::max(regionSize, kMinRegionSize), kDefaultAlignment);
+    const GLsizeiptr size = static_cast<GLsizeiptr>(kRegions * mRegionSize);
+
+    glGenBuffers(1, &mBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+
+    if (mPersistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+        mMapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    // El siguiente beginFrame empieza por la región 0
+    mRegion = kRegions - 1;
+    mUsed = 0;
+}
+
+void StreamBuffer::destroy() {
+    if (mBuffer == 0) {
+        return;
+    }
+
+    // Nada que la GPU aún lea puede desaparecer
+    for (size_t region = 0; region < kRegions; region++) {
+        waitFence(region);
+    }
+
+    if (mMapped != nullptr) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        mMapped = nullptr;
+    }
+
+    glDeleteBuffers(1, &mBuffer);
+    mBuffer = 0;
+    mRegionSize = 0;
+}
+
+void StreamBuffer::waitFence(size_t region) {
+    GLsync& fence = mFences[region];
+    if (fence == nullptr) {
+        return;
+    }
+
+    GLenum result = glClientWaitSync(fence, 0, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        mStalls++;
+        do {
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout);
+        } while (result == GL_TIMEOUT_EXPIRED);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamBuffer::beginFrame(size_t bytes) {
+    if (mBuffer == 0 || bytes > mRegionSize) {
+        // Con margen para no crecer por poco cada frame
+        create(bytes + bytes / 2);
+    }
+
+    mRegion = (mRegion + 1) % kRegions;
+    mUsed = 0;
+
+    if (mPersistent) {
+        waitFence(mRegion);
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+
+    // Al dar la vuelta, almacenamiento nuevo: lo que la GPU aún lea sigue
+    // en el viejo. Dentro de una vuelta cada región se escribe una vez, así
+    // que este camino no necesita fences
+    if (mRegion == 0) {
+        glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(kRegions * mRegionSize), nullptr, GL_STREAM_DRAW);
+    }
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+    mMapped = static_cast<unsigned char*>(glMapBufferRange(
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(mRegion * mRegionSize),
+        static_cast<GLsizeiptr>(mRegionSize),
+        flags));
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+StreamAllocation StreamBuffer::allocate(size_t size, size_t alignment) {
+    StreamAllocation allocation;
+
+    const size_t offset = alignUp(mUsed, std::max<size_t>(alignment, 1));
+    if (mMapped == nullptr || offset + size > mRegionSize) {
+        return allocation;
+    }
+    mUsed = offset + size;
+
+    // El puntero mapeado cubre todo el buffer o solo la región
+    allocation.data = mMapped + (mPersistent ? mRegion * mRegionSize : 0) + offset;
+    allocation.offset = mRegion * mRegionSize + offset;
+    allocation.size = size;
+    return allocation;
+}
+
+void StreamBuffer::flush() {
+    // Coherente: las escrituras ya son visibles para los comandos siguientes
+    if (mPersistent || mMapped == nullptr) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    mMapped = nullptr;
+}
+
+void StreamBuffer::endFrame() {
+    if (mBuffer == 0) {
+        return;
+    }
+
+    flush();
+
+    if (mPersistent) {
+        mFences[mRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+GLuint StreamBuffer::getBuffer() const {
+    return mBuffer;
+}
+
+size_t StreamBuffer::getRegionSize() const {
+    return mRegionSize;
+}
+
+size_t StreamBuffer::getStalls() const {
+    return mStalls;
+}
+
+} // namespace render
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include <glad/glad.h>
+
+namespace render {
+
+// Trozo de la región del frame: se escribe en 'data' y se usa 'offset' en
+// las llamadas de OpenGL sobre StreamBuffer::getBuffer()
+struct StreamAllocation {
+    unsigned char* data = nullptr;
+    size_t offset = 0;
+    size_t size = 0;
+
+    bool valid() const { return data != nullptr; }
+};
+
+// Buffer en anillo para los datos que cambian cada frame (instancias,
+// comandos de dibujo). Tres regiones: la CPU escribe en una mientras la GPU
+// puede estar leyendo las de los dos frames anteriores.
+//
+// Con GL_ARB_buffer_storage el buffer se mapea una sola vez, persistente y
+// coherente: se escribe directamente en la memoria que lee la GPU, sin
+// glBufferSubData. Cada región queda protegida por una fence al cerrar su
+// frame y se espera a ella antes de volver a escribir encima.
+//
+// Sin la extensión (OpenGL 4.1) cada región se mapea al empezar su frame con
+// GL_MAP_UNSYNCHRONIZED_BIT y se desmapea antes de dibujar. Al dar la vuelta
+// el buffer se deja huérfano, y eso hace de fence: el driver da
+// almacenamiento nuevo mientras la GPU acaba con el viejo.
+//
+// Un frame: beginFrame(bytes), allocate..., flush(), dibujar, endFrame().
+class StreamBuffer {
+public:
+    static constexpr size_t kRegions = 3;
+    static constexpr size_t kDefaultAlignment = 16;
+    static constexpr size_t kMinRegionSize = size_t(1) << 16;
+
+private:
+    GLuint mBuffer = 0;
+    size_t mRegionSize = 0;
+    size_t mRegion = 0;
+    size_t mUsed = 0;
+    bool mPersistent = false;
+
+    // Persistente: todo el buffer. Si no: la región del frame, o nullptr
+    // fuera de beginFrame/flush
+    unsigned char* mMapped = nullptr;
+    GLsync mFences[kRegions] = {};
+
+    // Veces que la CPU ha tenido que esperar a la GPU
+    size_t mStalls = 0;
+
+    void create(size_t regionSize);
+    void destroy();
+    void waitFence(size_t region);
+
+public:
+    StreamBuffer() = default;
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Con el contexto ya cargado por glad
+    static bool isPersistentSupported();
+
+    // Elige el camino (el persistente solo si el driver lo soporta). Fuera
+    // de un frame: descarta el buffer actual
+    void setPersistent(bool enabled);
+    bool isPersistent() const;
+
+    // Pasa a la región siguiente, esperando a la GPU si aún la lee, con
+    // sitio para al menos 'bytes'. Si no cabe, el buffer crece aquí: todo lo
+    // de un frame se reserva después
+    void beginFrame(size_t bytes);
+
+    // Inválida (data nulo) si no queda sitio en la región
+    StreamAllocation allocate(size_t size, size_t alignment = kDefaultAlignment);
+
+    // Deja lo escrito a la vista de la GPU. Antes de dibujar con ello
+    void flush();
+
+    // Cierra el frame: la fence de su región (con mapeo persistente)
+    void endFrame();
+
+    GLuint getBuffer() const;
+    size_t getRegionSize() const;
+    size_t getStalls() const;
+};
+
+} // namespace render
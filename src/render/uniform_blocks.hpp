@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <glm/glm.hpp>
+
+#include "math/affine.hpp"
+
+// Bloques uniformes std140 compartidos por todos los programas, con su
+// declaración GLSL en shaders/uniform_blocks.glsl. Los static_assert fijan
+// los offsets de std140 en C++; al enlazar, Shader compara los offsets que
+// da OpenGL para el bloque GLSL con las tablas de miembros de aquí.
+//
+// Reglas de std140 que importan aquí: vec3 y vec4 se alinean a 16 bytes;
+// un mat4 son 4 columnas vec4 (64 bytes); un mat4x3 row_major son 3 filas
+// vec4 (48 bytes, igual que Affine3x4); bool ocupa 4 bytes; el tamaño del
+// bloque se redondea a 16.
+
+namespace render {
+
+// Binding points fijos (GLSL 4.10 no tiene layout(binding) en bloques: los
+// asigna Shader al enlazar)
+constexpr uint32_t kFrameBlockBinding = 0;
+constexpr uint32_t kDrawBlockBinding = 1;
+
+// Una vez por frame
+struct FrameUniforms {
+    glm::mat4 view{ 1.0f };
+    glm::mat4 projection{ 1.0f };
+    glm::mat4 viewProjection{ 1.0f };
+    glm::vec4 viewportSize{ 0.0f };     // ancho, alto, 1/ancho, 1/alto
+    glm::vec4 wireframeColor{ 0.0f, 0.0f, 0.0f, 1.0f };
+    glm::vec4 selectionColor{ 1.0f, 0.6f, 0.0f, 1.0f };
+    float time = 0.0f;                  // segundos desde Renderer::init
+    float wireframeWidth = 1.0f;        // en píxeles
+    float selectionWidth = 2.0f;        // el contorno de los seleccionados (OutlinePass)
+    uint32_t wireframe = 0;             // wireframe sobre toda la escena
+};
+
+static_assert(offsetof(FrameUniforms, view) == 0, "FrameData.view");
+static_assert(offsetof(FrameUniforms, projection) == 64, "FrameData.projection");
+static_assert(offsetof(FrameUniforms, viewProjection) == 128, "FrameData.viewProjection");
+static_assert(offsetof(FrameUniforms, viewportSize) == 192, "FrameData.viewportSize");
+static_assert(offsetof(FrameUniforms, wireframeColor) == 208, "FrameData.wireframeColor");
+static_assert(offsetof(FrameUniforms, selectionColor) == 224, "FrameData.selectionColor");
+static_assert(offsetof(FrameUniforms, time) == 240, "FrameData.time");
+static_assert(offsetof(FrameUniforms, wireframeWidth) == 244, "FrameData.wireframeWidth");
+static_assert(offsetof(FrameUniforms, selectionWidth) == 248, "FrameData.selectionWidth");
+static_assert(offsetof(FrameUniforms, wireframe) == 252, "FrameData.wireframe");
+static_assert(sizeof(FrameUniforms) == 256, "FrameData: tamaño std140");
+
+// Por llamada de dibujo (o por lote instanciado)
+struct DrawUniforms {
+    math::Affine3x4 model;
+    uint32_t useInstancing = 0;
+    uint32_t padding[3] = {};
+};
+
+static_assert(offsetof(DrawUniforms, model) == 0, "DrawData.model");
+static_assert(offsetof(DrawUniforms, useInstancing) == 48, "DrawData.useInstancing");
+static_assert(sizeof(DrawUniforms) == 64, "DrawData: tamaño std140");
+
+// Descripción de cada bloque para la comprobación al enlazar
+struct UniformBlockMember {
+    const char* name;
+    size_t offset;
+};
+
+struct UniformBlockLayout {
+    const char* name;
+    uint32_t binding;
+    size_t size;
+    const UniformBlockMember* members;
+    size_t memberCount;
+};
+
+constexpr UniformBlockMember kFrameBlockMembers[] = {
+    { "view", offsetof(FrameUniforms, view) },
+    { "projection", offsetof(FrameUniforms, projection) },
+    { "viewProjection", offsetof(FrameUniforms, viewProjection) },
+    { "viewportSize", offsetof(FrameUniforms, viewportSize) },
+    { "wireframeColor", offsetof(FrameUniforms, wireframeColor) },
+    { "selectionColor", offsetof(FrameUniforms, selectionColor) },
+    { "time", offsetof(FrameUniforms, time) },
+    { "wireframeWidth", offsetof(FrameUniforms, wireframeWidth) },
+    { "selectionWidth", offsetof(FrameUniforms, selectionWidth) },
+    { "wireframe", offsetof(FrameUniforms, wireframe) },
+};
+
+constexpr UniformBlockMember kDrawBlockMembers[] = {
+    { "model", offsetof(DrawUniforms, model) },
+    { "useInstancing", offsetof(DrawUniforms, useInstancing) },
+};
+
+constexpr UniformBlockLayout kUniformBlocks[] = {
+    { "FrameData", kFrameBlockBinding, sizeof(FrameUniforms), kFrameBlockMembers, std::size(kFrameBlockMembers) },
+    { "DrawData", kDrawBlockBinding, sizeof(DrawUniforms), kDrawBlockMembers, std::size(kDrawBlockMembers) },
+};
+
+} // namespace render
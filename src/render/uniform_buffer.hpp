@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#include "gl_state_cache.hpp"
+
+namespace render {
+
+// Buffer de un bloque uniforme std140 con el contenido de un struct de
+// uniform_blocks.hpp, enganchado a su binding point fijo
+template <typename T>
+class UniformBuffer {
+private:
+    GLuint mBuffer = 0;
+    uint32_t mBinding = 0;
+
+    // Lo último que se subió, para no repetir subidas iguales
+    T mContents{};
+    bool mUploaded = false;
+
+public:
+    UniformBuffer() = default;
+
+    ~UniformBuffer() {
+        if (mBuffer != 0) {
+            glDeleteBuffers(1, &mBuffer);
+        }
+    }
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void init(uint32_t binding) {
+        mBinding = binding;
+
+        // GL_COPY_WRITE_BUFFER: no toca los bindings de GL_UNIFORM_BUFFER
+        glGenBuffers(1, &mBuffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, sizeof(T), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    // Lo ven todos los programas con el bloque en este binding point
+    void bind(GLStateCache& state) const {
+        state.bindUniformBuffer(mBinding, mBuffer);
+    }
+
+    void update(GLStateCache& state, const T& value) {
+        const bool redundant = mUploaded && std::memcmp(&mContents, &value, sizeof(T)) == 0;
+        if (!state.shouldIssue(redundant)) {
+            return;
+        }
+
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mBuffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(T), &value);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        mContents = value;
+        mUploaded = true;
+    }
+};
+
+} // namespace render
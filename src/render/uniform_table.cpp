@@ -0,0 +1,36 @@
+#include "uniform_table.hpp"
+
+#include <utility>
+
+namespace render {
+
+void UniformTable::clear() {
+    mUniforms.clear();
+    mIndices.clear();
+}
+
+void UniformTable::add(UniformInfo uniform) {
+    if (uniform.location < 0) {
+        return;
+    }
+
+    // glGetActiveUniform nombra los arrays como "nombre[0]"
+    const size_t bracket = uniform.name.find('[');
+    if (bracket != std::string::npos) {
+        uniform.name.resize(bracket);
+    }
+
+    mIndices[uniform.name] = mUniforms.size();
+    mUniforms.push_back(std::move(uniform));
+}
+
+const UniformInfo* UniformTable::find(const std::string& name) const {
+    auto it = mIndices.find(name);
+    return it != mIndices.end() ? &mUniforms[it->second] : nullptr;
+}
+
+const std::vector<UniformInfo>& UniformTable::getUniforms() const {
+    return mUniforms;
+}
+
+} // namespace render
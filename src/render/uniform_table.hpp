@@ -0,0 +1,79 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "math/affine.hpp"
+
+// Uniformes de un programa tal como los describe glGetActiveUniform al
+// enlazar, y los handles tipados que se sacan de ellos. Resolver un handle
+// busca por nombre una sola vez; usarlo después es pasar un entero.
+//
+// No llama a OpenGL (solo usa sus enums), así que se puede probar y medir
+// sin contexto.
+
+namespace render {
+
+// Tipo GLSL que corresponde a cada tipo de C++
+template <typename T>
+struct UniformType;
+
+template <> struct UniformType<float> { static constexpr GLenum value = GL_FLOAT; };
+template <> struct UniformType<int> { static constexpr GLenum value = GL_INT; };
+template <> struct UniformType<bool> { static constexpr GLenum value = GL_BOOL; };
+template <> struct UniformType<glm::vec3> { static constexpr GLenum value = GL_FLOAT_VEC3; };
+template <> struct UniformType<glm::vec4> { static constexpr GLenum value = GL_FLOAT_VEC4; };
+template <> struct UniformType<glm::mat4> { static constexpr GLenum value = GL_FLOAT_MAT4; };
+template <> struct UniformType<math::Affine3x4> { static constexpr GLenum value = GL_FLOAT_MAT4x3; };
+
+// Location de un uniforme del tipo T, o inválido (-1) si el programa no lo
+// tiene o es de otro tipo
+template <typename T>
+class UniformHandle {
+private:
+    GLint mLocation = -1;
+
+public:
+    UniformHandle() = default;
+    explicit UniformHandle(GLint location) : mLocation(location) {}
+
+    bool valid() const { return mLocation >= 0; }
+    GLint getLocation() const { return mLocation; }
+};
+
+struct UniformInfo {
+    std::string name;       // sin el "[0]" de los arrays
+    GLenum type = 0;
+    GLint location = -1;
+    GLint count = 1;        // elementos si es un array
+};
+
+class UniformTable {
+private:
+    std::vector<UniformInfo> mUniforms;
+    std::unordered_map<std::string, size_t> mIndices;
+
+public:
+    void clear();
+
+    // Los uniformes de los bloques (location -1) no se guardan
+    void add(UniformInfo uniform);
+
+    const UniformInfo* find(const std::string& name) const;
+
+    template <typename T>
+    UniformHandle<T> getHandle(const std::string& name) const {
+        const UniformInfo* uniform = find(name);
+        if (uniform == nullptr || uniform->type != UniformType<T>::value) {
+            return UniformHandle<T>();
+        }
+        return UniformHandle<T>(uniform->location);
+    }
+
+    const std::vector<UniformInfo>& getUniforms() const;
+};
+
+} // namespace render
@@ -1,19 +1,41 @@
 #include "object.hpp"
 #include <algorithm>
+#include <iostream>
+#include <utility>
 
 using  app::geometry::Mesh;
+using  app::geometry::Vertex;
 
 Object::Object(uint32_t id,
     const std::string& name,
     const Mesh& mesh,
-    const Transform& transform)
-    : mId(id),
+    const Transform& transform,
+    render::GeometryArena& arena)
+    : mMesh(mesh),
+    mGLmesh(std::make_shared<GLMesh>(mesh, arena)),
+    mId(id),
     mName(name),
-    mMesh(mesh),
-    mGLmesh(this->mMesh),
     mTransform(transform)
     {
         mBoundingBox = math::calculateBoundingBox(mMesh);
+        mBoundingSphere = math::calculateBoundingSphere(mMesh);
+        mOrientedBoundingBox = math::calculateOrientedBoundingBox(mMesh);
+}
+
+Object::Object(uint32_t id,
+    const std::string& name,
+    const Mesh& mesh,
+    const Transform& transform,
+    std::shared_ptr<GLMesh> glMesh)
+    : mMesh(mesh),
+    mGLmesh(std::move(glMesh)),
+    mId(id),
+    mName(name),
+    mTransform(transform)
+    {
+        mBoundingBox = math::calculateBoundingBox(mMesh);
+        mBoundingSphere = math::calculateBoundingSphere(mMesh);
+        mOrientedBoundingBox = math::calculateOrientedBoundingBox(mMesh);
 }
 
 Object::~Object() {
@@ -23,8 +45,26 @@ void Object::update(float dt) {
     //mTransform.rotation.y += dt * 10.0f;
 }
 
-void Object::draw() const {
-    mGLmesh.draw();
+void Object::draw(render::GLStateCache& state) const {
+    if (mSubdividedGLmesh) {
+        mSubdividedGLmesh->draw(state);
+        return;
+    }
+
+    mGLmesh->draw(state);
+}
+
+render::DrawElementsIndirectCommand Object::getDrawCommand(uint32_t first, uint32_t count) const {
+    if (mSubdividedGLmesh) {
+        return mSubdividedGLmesh->getDrawCommand(first, count);
+    }
+
+    return mGLmesh->getDrawCommand(first, count);
+}
+
+uint32_t Object::getMeshId() const {
+    const GLMesh* mesh = mSubdividedGLmesh ? mSubdividedGLmesh.get() : mGLmesh.get();
+    return mesh->getId();
 }
 
 glm::mat4 Object::getModelMatrix() const {
@@ -39,6 +79,36 @@ std::string Object::getName() const {
     return mName;
 }
 
+const Mesh& Object::getMesh() const {
+    return mMesh;
+}
+
+bool Object::setVertices(const std::vector<Vertex>& vertices) {
+    if (vertices.size() != mMesh.vertices.size()) {
+        std::cerr << "Error: La jaula editada no tiene los mismos vértices que la malla." << std::endl;
+        return false;
+    }
+
+    mMesh.vertices = vertices;
+
+    // La malla de la GPU puede ser la de otros objetos: se mueve una propia
+    if (mGLmesh.use_count() > 1) {
+        mGLmesh = std::make_shared<GLMesh>(mMesh, mGLmesh->getArena());
+    } else {
+        mGLmesh->updateVertices(mMesh.vertices);
+    }
+
+    mBoundingBox = math::calculateBoundingBox(mMesh);
+    mBoundingSphere = math::calculateBoundingSphere(mMesh);
+    mOrientedBoundingBox = math::calculateOrientedBoundingBox(mMesh);
+
+    mVertexTree.reset();
+    mTriangleBvh.reset();
+
+    updateSubdivision();
+    return true;
+}
+
 Transform& Object::getTransform() {
     return mTransform;
 }
@@ -51,6 +121,82 @@ const math::AABB& Object::getBoundingBox() const {
     return mBoundingBox;
 }
 
+const math::BoundingSphere& Object::getBoundingSphere() const {
+    return mBoundingSphere;
+}
+
+const math::OBB& Object::getOrientedBoundingBox() const {
+    return mOrientedBoundingBox;
+}
+
+const app::geometry::KdTree& Object::getVertexTree() const {
+    if (!mVertexTree) {
+        mVertexTree = std::make_shared<const app::geometry::KdTree>(mMesh);
+    }
+    return *mVertexTree;
+}
+
+const app::geometry::Bvh& Object::getTriangleBvh() const {
+    if (!mTriangleBvh) {
+        std::vector<glm::vec3> positions(mMesh.vertices.size());
+        for (size_t i = 0; i < positions.size(); i++) {
+            positions[i] = mMesh.vertices[i].position;
+        }
+        mTriangleBvh = std::make_shared<const app::geometry::Bvh>(
+            app::geometry::Bvh::fromTriangles(positions, mMesh.indices));
+    }
+    return *mTriangleBvh;
+}
+
+int Object::getSubdivisionLevels() const {
+    return mSubdivision ? mSubdivision->getLevels() : 0;
+}
+
+void Object::setSubdivisionLevels(int levels) {
+    if (levels == getSubdivisionLevels()) {
+        return;
+    }
+
+    if (levels <= 0) {
+        mSubdivision.reset();
+        mSubdividedGLmesh.reset();
+        mSubdividedVertices.clear();
+        return;
+    }
+
+    // La topología y las tablas se calculan una sola vez por nivel
+    mSubdivision = std::make_shared<app::geometry::SubdivisionSurface>(mMesh, levels);
+    mSubdivision->evaluate(mMesh.vertices, mSubdividedVertices, mSubdivisionScratch);
+
+    mSubdividedGLmesh = std::make_shared<GLMesh>(
+        Mesh(mSubdividedVertices, mSubdivision->getIndices()),
+        mGLmesh->getArena());
+}
+
+void Object::updateSubdivision() {
+    if (!mSubdivision) {
+        return;
+    }
+
+    // Tras mover vértices de la jaula solo hay que aplicar las tablas
+    if (!mSubdivision->evaluate(mMesh.vertices, mSubdividedVertices, mSubdivisionScratch)) {
+        return;
+    }
+
+    // Las copias del objeto comparten la malla subdividida de la GPU
+    if (mSubdividedGLmesh.use_count() > 1) {
+        mSubdividedGLmesh = std::make_shared<GLMesh>(
+            Mesh(mSubdividedVertices, mSubdivision->getIndices()),
+            mSubdividedGLmesh->getArena());
+    } else {
+        mSubdividedGLmesh->updateVertices(mSubdividedVertices);
+    }
+}
+
+const std::vector<Vertex>& Object::getSubdividedVertices() const {
+    return mSubdividedVertices;
+}
+
 /* const math::AABB Object::calculateBoundingBox(const Mesh& mesh) const {
 
     if (mesh.vertices.empty()) {
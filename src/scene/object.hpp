@@ -1,11 +1,16 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
+#include "geometry/bvh.hpp"
+#include "geometry/kd_tree.hpp"
 #include "geometry/mesh.hpp"
+#include "geometry/subdivision.hpp"
 #include "render/gl_mesh.hpp"
 #include "math/transform.hpp"
 #include "math/aabb.hpp"
+#include "math/bounds.hpp"
 
 
 
@@ -13,31 +18,84 @@ class Object {
 
 private:
     app::geometry::Mesh mMesh;
-    GLMesh mGLmesh;
+    // Compartida entre los objetos creados con la misma malla: el renderer
+    // los agrupa por ella y los dibuja en una sola llamada instanciada
+    std::shared_ptr<GLMesh> mGLmesh;
     uint32_t mId;
     std::string mName;
     Transform mTransform;
     math::AABB mBoundingBox;
+    math::BoundingSphere mBoundingSphere;
+    math::OBB mOrientedBoundingBox;
+
+    // Previsualización de la superficie de subdivisión (nullptr si no hay)
+    std::shared_ptr<app::geometry::SubdivisionSurface> mSubdivision;
+    std::shared_ptr<GLMesh> mSubdividedGLmesh;
+    std::vector<app::geometry::Vertex> mSubdividedVertices;
+    // Propios de cada copia: la superficie sí se comparte
+    app::geometry::SubdivisionScratch mSubdivisionScratch;
+
+    // Estructuras de búsqueda para el snapping, en espacio local. Se
+    // construyen la primera vez que se piden: la mayoría de objetos nunca
+    // reciben una consulta
+    mutable std::shared_ptr<const app::geometry::KdTree> mVertexTree;
+    mutable std::shared_ptr<const app::geometry::Bvh> mTriangleBvh;
 
 public:
 
     Object(uint32_t id,
         const std::string& name,
         const app::geometry::Mesh& mesh,
-        const Transform& transform
+        const Transform& transform,
+        render::GeometryArena& arena
+    );
+    // 'glMesh' ya contiene 'mesh' en la GPU (p. ej. el cubo de Scene)
+    Object(uint32_t id,
+        const std::string& name,
+        const app::geometry::Mesh& mesh,
+        const Transform& transform,
+        std::shared_ptr<GLMesh> glMesh
     );
     ~Object();
 
+    // Movibles sin copiar la malla (Scene los reordena)
+    Object(const Object&) = default;
+    Object(Object&&) = default;
+    Object& operator=(const Object&) = default;
+    Object& operator=(Object&&) = default;
+
     void update(float dt);
-    void draw() const;
+    void draw(render::GLStateCache& state) const;
+    // Comando de dibujo de la malla que se dibuja, con 'count' instancias
+    render::DrawElementsIndirectCommand getDrawCommand(uint32_t first, uint32_t count) const;
+
+    // Identifica la malla que se dibuja (la subdividida si la hay): mismos
+    // valores, misma llamada instanciada
+    uint32_t getMeshId() const;
     glm::mat4 getModelMatrix() const;
     uint32_t getId() const;
     std::string getName() const;
+    const app::geometry::Mesh& getMesh() const;
+
+    // Edición de la jaula: sustituye los vértices sin cambiar la topología
+    // y pone al día la GPU, los volúmenes envolventes y la subdivisión.
+    // Falso (y no toca nada) si no coincide el número de vértices
+    bool setVertices(const std::vector<app::geometry::Vertex>& vertices);
 
     Transform& getTransform();
     const Transform& getTransform() const;
 
     const math::AABB& getBoundingBox() const;
+    const math::BoundingSphere& getBoundingSphere() const;
+    const math::OBB& getOrientedBoundingBox() const;
+
+    const app::geometry::KdTree& getVertexTree() const;
+    const app::geometry::Bvh& getTriangleBvh() const;
+
+    int getSubdivisionLevels() const;
+    void setSubdivisionLevels(int levels);
+    void updateSubdivision();
+    const std::vector<app::geometry::Vertex>& getSubdividedVertices() const;
 
     /* const math::AABB calculateBoundingBox(const app::geometry::Mesh& mesh) const; */
 
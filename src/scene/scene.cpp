@@ -1,4 +1,8 @@
 #include "scene.hpp"
+#include "core/radix_sort.hpp"
+
+#include <limits>
+#include <numeric>
 
 Scene::Scene(/* args */) {
 }
@@ -6,19 +10,34 @@ Scene::Scene(/* args */) {
 Scene::~Scene() {
 }
 
+void Scene::registerSlot(uint32_t id, size_t slot) {
+    if (id >= mSlots.size()) {
+        mSlots.resize(static_cast<size_t>(id) + 1, kNoSlot);
+    }
+    mSlots[id] = static_cast<uint32_t>(slot);
+    mSpatialOrderDirty = true;
+}
+
 void Scene::addObject(const Object& obj) {
     mObjects.emplace_back(obj);
+    registerSlot(obj.getId(), mObjects.size() - 1);
+    mNextId = std::max(mNextId, obj.getId() + 1);
 }
 
 void Scene::update(float dt) {
+    // Al principio del frame, antes de que nadie guarde punteros a objetos
+    if (mSpatialOrderDirty && mObjects.size() >= kAutoSortMinObjects) {
+        sortObjects();
+    }
+
     for (auto& obj : mObjects) {
         obj.update(dt);
     }
 }
 
-void Scene::draw() {
+void Scene::draw(render::GLStateCache& state) {
     for (auto& obj : mObjects) {
-        obj.draw();
+        obj.draw(state);
     }
 }
 
@@ -26,38 +45,149 @@ const std::vector<Object>& Scene::getObjects() const {
     return mObjects;
 }
 
+uint32_t Scene::getNextId() const {
+    return mNextId;
+}
+
+void Scene::sortObjects(math::SpaceFillingCurve curve) {
+    mSpatialOrderDirty = false;
+
+    const size_t count = mObjects.size();
+    if (count < 2) {
+        return;
+    }
+
+    // Posiciones relativas al mínimo, restadas en double: lejos del origen
+    // el float solo ve la diferencia
+    const double inf = std::numeric_limits<double>::infinity();
+    glm::dvec3 min(inf);
+    glm::dvec3 max(-inf);
+    for (const Object& object : mObjects) {
+        min = glm::min(min, object.getTransform().position);
+        max = glm::max(max, object.getTransform().position);
+    }
+
+    std::vector<glm::vec3> positions(count);
+    for (size_t i = 0; i < count; i++) {
+        positions[i] = glm::vec3(mObjects[i].getTransform().position - min);
+    }
+
+    // 10 bits por eje sobran para el número de objetos de una escena
+    std::vector<uint32_t> codes(count);
+    math::computeCurveCodes(
+        positions.data(), count,
+        math::AABB{ glm::vec3(0.0f), glm::vec3(max - min) },
+        curve, codes.data());
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    core::radixSort(codes, order);
+
+    std::vector<Object> sorted;
+    sorted.reserve(count);
+    for (uint32_t index : order) {
+        sorted.push_back(std::move(mObjects[index]));
+    }
+    mObjects.swap(sorted);
+
+    for (size_t slot = 0; slot < count; slot++) {
+        mSlots[mObjects[slot].getId()] = static_cast<uint32_t>(slot);
+    }
+}
+
 Object& Scene::createCubeMesh(const Transform& transform) {
 
     std::string name = "cube_" + std::to_string(mNextId);
 
+    const app::geometry::Mesh mesh = app::geometry::MeshFactory::createCubeMesh();
+    if (!mCubeGLMesh) {
+        mCubeGLMesh = std::make_shared<GLMesh>(mesh, mGeometryArena);
+    }
+
     mObjects.emplace_back(
         mNextId++,
         name,
-        app::geometry::MeshFactory::createCubeMesh(),
-        transform
+        mesh,
+        transform,
+        mCubeGLMesh
     );
+    registerSlot(mObjects.back().getId(), mObjects.size() - 1);
 
     return mObjects.back();
 }
 
-const Object* Scene::findObject(uint32_t id) const {
-    
-    for (const auto& object : mObjects) {
-        if (object.getId() == id) {
-            return &object;
-        }
+Object& Scene::createObject(const std::string& name, const app::geometry::Mesh& mesh, const Transform& transform) {
+
+    mObjects.emplace_back(
+        mNextId++,
+        name,
+        mesh,
+        transform,
+        mGeometryArena
+    );
+    registerSlot(mObjects.back().getId(), mObjects.size() - 1);
+
+    return mObjects.back();
+}
+
+Object* Scene::createBooleanObject(uint32_t idA, uint32_t idB, app::geometry::BooleanOperation operation) {
+
+    const Object* a = findObject(idA);
+    const Object* b = findObject(idB);
+
+    if (a == nullptr || b == nullptr || a == b) {
+        return nullptr;
     }
 
-    return nullptr;
+    // El resultado se calcula antes de añadirlo: emplace_back puede invalidar a y b
+    const app::geometry::Mesh mesh = app::geometry::meshBoolean(
+        a->getMesh(), a->getModelMatrix(),
+        b->getMesh(), b->getModelMatrix(),
+        operation
+    );
+
+    // Intersección de objetos separados o diferencia con A dentro de B: no
+    // queda nada, y GLMesh no admite mallas vacías
+    if (mesh.indices.empty()) {
+        return nullptr;
+    }
+
+    const char* prefix =
+        operation == app::geometry::BooleanOperation::Union ? "union_" :
+        operation == app::geometry::BooleanOperation::Difference ? "difference_" : "intersection_";
+
+    return &createObject(prefix + std::to_string(mNextId), mesh, Transform{});
 }
 
-Object* Scene::findObject(uint32_t id) {
+bool Scene::addStreamedMesh(const std::string& path, size_t budgetBytes) {
 
-    for (auto& object : mObjects) {
-        if (object.getId() == id) {
-            return &object;
-        }
+    auto streamer = std::make_unique<render::MeshStreamer>(path, budgetBytes);
+    if (!streamer->isOpen()) {
+        return false;
     }
 
-    return nullptr;
+    mStreamedMeshes.push_back(std::move(streamer));
+    return true;
+}
+
+const std::vector<std::unique_ptr<render::MeshStreamer>>& Scene::getStreamedMeshes() const {
+    return mStreamedMeshes;
+}
+
+render::GeometryArena& Scene::getGeometryArena() {
+    return mGeometryArena;
+}
+
+const Object* Scene::findObject(uint32_t id) const {
+    if (id >= mSlots.size() || mSlots[id] == kNoSlot) {
+        return nullptr;
+    }
+    return &mObjects[mSlots[id]];
+}
+
+Object* Scene::findObject(uint32_t id) {
+    if (id >= mSlots.size() || mSlots[id] == kNoSlot) {
+        return nullptr;
+    }
+    return &mObjects[mSlots[id]];
 }
@@ -1,25 +1,77 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include "object.hpp"
+#include "render/mesh_streamer.hpp"
 #include "geometry/mesh_factory.hpp"
+#include "geometry/mesh_boolean.hpp"
+#include "math/space_filling.hpp"
 
 class Scene
 {
 private:
+    // Vértices e índices de todas las mallas de los objetos. Antes que
+    // mObjects: se destruye después de ellos
+    render::GeometryArena mGeometryArena;
+
+    // Los objetos pueden reordenarse en memoria (ver sortObjects); los ids
+    // no cambian y mSlots da la posición actual de cada uno
     std::vector<Object> mObjects;
+    std::vector<uint32_t> mSlots;
     uint32_t mNextId = 1;
+    bool mSpatialOrderDirty = false;
+
+    void registerSlot(uint32_t id, size_t slot);
+
+    // Todos los cubos comparten la misma malla de GPU (se crea con el
+    // primero) para que el renderer los dibuje instanciados
+    std::shared_ptr<GLMesh> mCubeGLMesh;
+
+    // Mallas troceadas en disco que se cargan bajo demanda (no son Object:
+    // nunca están enteras en memoria)
+    std::vector<std::unique_ptr<render::MeshStreamer>> mStreamedMeshes;
 
 public:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    // A partir de este número de objetos update() los reordena solo cuando
+    // se añaden nuevos
+    static constexpr size_t kAutoSortMinObjects = 256;
+
     Scene(/* args */);
     ~Scene();
 
     void addObject(const Object& obj);
     void update(float dt);
-    void draw();
+    void draw(render::GLStateCache& state);
+    // En orden espacial tras sortObjects, no de creación
     const std::vector<Object>& getObjects() const;
 
+    // Ids válidos: [1, getNextId()), con huecos si se borran objetos
+    uint32_t getNextId() const;
+
+    // Reordena los objetos por el código de Morton (o Hilbert) de su
+    // posición, para que los que están cerca en la escena lo estén también
+    // en memoria. Invalida los punteros y referencias a objetos, no los ids.
+    // Morton por defecto: en bench_space_filling da la misma localidad que
+    // Hilbert y es bastante más barato de calcular
+    void sortObjects(math::SpaceFillingCurve curve = math::SpaceFillingCurve::Morton);
+
     Object& createCubeMesh(const Transform& transform);
+    Object& createObject(const std::string& name, const app::geometry::Mesh& mesh, const Transform& transform);
+
+    // Crea un objeto nuevo con el resultado de la operación entre dos objetos
+    // (en espacio de mundo). Devuelve nullptr si alguno de los ids no existe
+    // o si el resultado queda vacío.
+    Object* createBooleanObject(uint32_t idA, uint32_t idB, app::geometry::BooleanOperation operation);
+
+    bool addStreamedMesh(const std::string& path, size_t budgetBytes = size_t(2) << 30);
+    const std::vector<std::unique_ptr<render::MeshStreamer>>& getStreamedMeshes() const;
+
+    render::GeometryArena& getGeometryArena();
 
+    // O(1) a través de mSlots
     const Object* findObject(uint32_t id) const;
     Object* findObject(uint32_t id);
 
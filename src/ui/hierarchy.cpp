@@ -14,11 +14,18 @@ void Hierarchy::draw() {
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10));
     ImGui::Begin("Hierarchy");
 
-    for (const auto& obj : mScene.getObjects()) {
-        bool selected = obj.getId() == mContext.getSelectedObjectId();
+    // Por id, para listar en orden de creación aunque la escena los
+    // haya reordenado en memoria
+    for (uint32_t id = 1; id < mScene.getNextId(); id++) {
+        const Object* obj = mScene.findObject(id);
+        if (obj == nullptr) {
+            continue;
+        }
+
+        bool selected = obj->getId() == mContext.getSelectedObjectId();
 
-        if (ImGui::Selectable(obj.getName().c_str(), selected)) {
-            mContext.setSelectedObjectId(obj.getId());
+        if (ImGui::Selectable(obj->getName().c_str(), selected)) {
+            mContext.setSelectedObjectId(obj->getId());
         }
 
     }
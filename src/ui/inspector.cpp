@@ -27,9 +27,11 @@ void Inspector::draw() {
 
         Transform& transform = object->getTransform();
 
-        ImGui::DragFloat3(
+        ImGui::DragScalarN(
             "Position",
+            ImGuiDataType_Double,
             glm::value_ptr(transform.position),
+            3,
             0.1f
         );
 
@@ -49,11 +51,99 @@ void Inspector::draw() {
             0.05f
         );
 
+        ImGui::Separator();
+
+        int subdivisionLevels = object->getSubdivisionLevels();
+        if (ImGui::SliderInt("Subdivision", &subdivisionLevels, 0, 3)) {
+            object->setSubdivisionLevels(subdivisionLevels);
+        }
+
+        ImGui::Separator();
+
+        // Último: puede añadir objetos a la escena e invalidar 'object'
+        drawBooleanOperations(*object);
     }
 
+    drawGeometryArenaStats();
+
     ImGui::End();
     
     ImGui::PopStyleVar();
 
 }
+void Inspector::drawBooleanOperations(const Object& object) {
+    const Object* operand = mScene.findObject(mBooleanOperandId);
+    if (operand == &object) {
+        operand = nullptr;
+    }
+
+    const std::string preview = operand ? operand->getName() : "None";
+
+    if (ImGui::BeginCombo("Operand", preview.c_str())) {
+        for (const auto& other : mScene.getObjects()) {
+            if (other.getId() == object.getId()) {
+                continue;
+            }
+
+            if (ImGui::Selectable(other.getName().c_str(), other.getId() == mBooleanOperandId)) {
+                mBooleanOperandId = other.getId();
+            }
+        }
+        ImGui::EndCombo();
+    }
+
+    if (operand == nullptr) {
+        return;
+    }
+
+    const uint32_t objectId = object.getId();
+    Object* result = nullptr;
+
+    if (ImGui::Button("Union")) {
+        result = mScene.createBooleanObject(objectId, mBooleanOperandId, app::geometry::BooleanOperation::Union);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Difference")) {
+        result = mScene.createBooleanObject(objectId, mBooleanOperandId, app::geometry::BooleanOperation::Difference);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Intersection")) {
+        result = mScene.createBooleanObject(objectId, mBooleanOperandId, app::geometry::BooleanOperation::Intersection);
+    }
+
+    if (result != nullptr) {
+        mContext.setSelectedObjectId(result->getId());
+        mBooleanOperandId = editor::EditorContext::mNoObjectIdSelected;
+    }
+}
+
+void Inspector::drawGeometryArenaStats() {
+    if (!ImGui::CollapsingHeader("Geometry arena")) {
+        return;
+    }
+
+    render::GeometryArena& arena = mScene.getGeometryArena();
+
+    auto drawStats = [](const char* label, const render::ArenaStats& stats) {
+        ImGui::Text(
+            "%s: %zu / %zu (%.1f%%), %zu blocks",
+            label,
+            stats.used,
+            stats.capacity,
+            100.0f * stats.occupancy(),
+            stats.allocations);
+        ImGui::Text(
+            "  free: %zu holes, fragmentation %.1f%%",
+            stats.freeBlocks,
+            100.0f * stats.fragmentation());
+    };
+
+    drawStats("Vertices", arena.getVertexStats());
+    drawStats("Indices", arena.getIndexStats());
+
+    if (ImGui::Button("Defragment")) {
+        arena.defragment();
+    }
+}
+
 } // namespace ui
@@ -10,6 +10,12 @@ class Inspector {
 private:
     editor::EditorContext& mContext;
     Scene& mScene;
+
+    // Segundo operando de las operaciones booleanas
+    uint32_t mBooleanOperandId = editor::EditorContext::mNoObjectIdSelected;
+
+    void drawBooleanOperations(const Object& object);
+    void drawGeometryArenaStats();
 public:
     Inspector(editor::EditorContext& context, Scene& scene);
     ~Inspector();
@@ -29,6 +29,20 @@ void Toolbar::addTransformModeButton(const char* label, editor::TransformMode mo
     ImGui::PopStyleColor();
 }
 
+void Toolbar::addSnapModeButton(const char* label, editor::SnapMode mode) {
+
+    bool selected = (mContext.getSnapMode() == mode);
+
+    ImGui::PushStyleColor(ImGuiCol_Button, getButtonColor(selected));
+
+    // Pulsar el modo activo lo desactiva
+    if (ImGui::Button(label)) {
+        mContext.setSnapMode(selected ? editor::SnapMode::None : mode);
+    }
+
+    ImGui::PopStyleColor();
+}
+
 ImVec4 Toolbar::getButtonColor(bool selected) const {
 
     if (selected) {
@@ -73,13 +87,35 @@ void Toolbar::draw() {
     ImGui::Text(" | ");
     ImGui::SameLine();
 
+    // Snapping al mover: vértices, aristas o caras de los demás objetos
+    addSnapModeButton("Vtx", editor::SnapMode::Vertex);
+    ImGui::SameLine();
+    addSnapModeButton("Edg", editor::SnapMode::Edge);
+    ImGui::SameLine();
+    addSnapModeButton("Fac", editor::SnapMode::Face);
+    ImGui::SameLine();
+
+    ImGui::Text(" | ");
+    ImGui::SameLine();
+
+    // Wireframe sobre el sombreado
+    ImGui::PushStyleColor(ImGuiCol_Button, getButtonColor(mContext.isWireframe()));
+    if (ImGui::Button("Wire")) {
+        mContext.setWireframe(!mContext.isWireframe());
+    }
+    ImGui::PopStyleColor();
+    ImGui::SameLine();
+
+    ImGui::Text(" | ");
+    ImGui::SameLine();
+
     ImGui::Button("E"); ImGui::SameLine();
 
     ImGui::Button("+"); ImGui::SameLine();
 
     if (ImGui::Button("Cube")) {
         Transform t;
-        t.position = glm::vec3(0.0f, 0.0f, -2.0f);
+        t.position = glm::dvec3(0.0, 0.0, -2.0);
         mScene.createCubeMesh(t);
     }
 
@@ -14,6 +14,7 @@ private:
     Scene& mScene;
     void addButton(const char* label, editor::Tool tool);
     void addTransformModeButton(const char* label, editor::TransformMode mode);
+    void addSnapModeButton(const char* label, editor::SnapMode mode);
     ImVec4 getButtonColor(bool selected) const;
 
 public:
@@ -1,14 +1,123 @@
 #include "viewport.hpp"
+#include "math/distance.hpp"
 #include "math/intersection.hpp"
+#include "math/transform_batch.hpp"
 
 
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
 #include <optional>
+#include <vector>
 #include <iostream>
 
 
 namespace ui {
 
+namespace {
+
+// Radio de snapping como fracción de la distancia a la cámara, para que en
+// pantalla mida siempre lo mismo
+constexpr float snapRadiusFactor = 0.03f;
+
+// Busca el vértice, el punto de arista o el punto de cara de los objetos
+// (salvo 'ignoredId') más cercano a 'point' y a menos de 'radius'. Todo en
+// coordenadas relativas a la cámara ('origin').
+//
+// Las consultas se hacen en el espacio local de cada objeto con el radio
+// dividido por la escala mínima, que cubre todo lo que está a 'radius' en
+// mundo; los candidatos se comparan ya en mundo. Con escala no uniforme el
+// punto más cercano de una arista o cara se calcula en la métrica local, lo
+// que basta para ajustar el gizmo.
+bool findSnapPoint(
+    const std::vector<Object>& objects,
+    uint32_t ignoredId,
+    editor::SnapMode mode,
+    const glm::vec3& point,
+    float radius,
+    const glm::dvec3& origin,
+    glm::vec3& snapped) {
+
+    float best = radius * radius;
+    bool found = false;
+
+    for (const Object& object : objects) {
+        if (object.getId() == ignoredId) {
+            continue;
+        }
+
+        const Transform& transform = object.getTransform();
+        const math::Affine3x4 modelMatrix = math::Affine3x4::fromTransform(transform, origin);
+
+        if (math::distanceSquared(point, math::transformBoundingBox(object.getBoundingBox(), modelMatrix)) > best) {
+            continue;
+        }
+
+        const glm::vec3 scale = glm::abs(transform.scale);
+        const float minScale = std::min(scale.x, std::min(scale.y, scale.z));
+        const float maxScale = std::max(scale.x, std::max(scale.y, scale.z));
+        if (minScale <= 0.0f) {
+            continue;
+        }
+
+        const glm::vec3 localPoint = math::inverseTransform(transform, origin).transformPoint(point);
+        const float localRadius = std::sqrt(best) / minScale;
+
+        auto consider = [&](const glm::vec3& localCandidate) {
+            const glm::vec3 candidate = modelMatrix.transformPoint(localCandidate);
+            const glm::vec3 d = candidate - point;
+            const float distance = glm::dot(d, d);
+
+            if (distance < best) {
+                best = distance;
+                snapped = candidate;
+                found = true;
+            }
+        };
+
+        const std::vector<app::geometry::Vertex>& vertices = object.getMesh().vertices;
+        const std::vector<uint32_t>& indices = object.getMesh().indices;
+
+        if (mode == editor::SnapMode::Vertex) {
+            const app::geometry::KdTree& tree = object.getVertexTree();
+
+            // Con escala uniforme el más cercano en local lo es en mundo
+            if (maxScale - minScale <= 1e-6f * maxScale) {
+                const uint32_t nearest = tree.nearest(localPoint, localRadius);
+                if (nearest != app::geometry::KdTree::npos) {
+                    consider(vertices[nearest].position);
+                }
+            } else {
+                tree.queryRadius(localPoint, localRadius, [&](uint32_t index, float) {
+                    consider(vertices[index].position);
+                });
+            }
+            continue;
+        }
+
+        const math::AABB queryBox{ localPoint - glm::vec3(localRadius), localPoint + glm::vec3(localRadius) };
+
+        object.getTriangleBvh().queryOverlap(queryBox, [&](uint32_t triangle) {
+            const glm::vec3& a = vertices[indices[3 * triangle]].position;
+            const glm::vec3& b = vertices[indices[3 * triangle + 1]].position;
+            const glm::vec3& c = vertices[indices[3 * triangle + 2]].position;
+
+            if (mode == editor::SnapMode::Face) {
+                consider(math::closestPointOnTriangle(localPoint, a, b, c));
+                return;
+            }
+
+            consider(math::closestPointOnSegment(localPoint, a, b));
+            consider(math::closestPointOnSegment(localPoint, b, c));
+            consider(math::closestPointOnSegment(localPoint, c, a));
+        });
+    }
+
+    return found;
+}
+
+} // namespace
+
 glm::vec2 Viewport::screenToNDC(const glm::vec2& mouseAbsolutePosition) const {
 
     glm::vec2 mousePositionViewport{
@@ -70,21 +179,26 @@ void Viewport::update(const input::Input& input) {
     }
     // hemos hecho click dentro del viewport
 
-    math::Ray worldRay =
+    // El rayo y las matrices de los objetos, relativos a la cámara
+    const glm::dvec3& origin = mCamera.getPosition();
+
+    math::Ray cameraRay =
         screenToRay(input.mouseAbsolutePosition);
 
+    const glm::dvec3 worldOrigin = origin + glm::dvec3(cameraRay.origin);
+
     std::cout
         << "worldRay origin: "
-        << worldRay.origin.x << ", "
-        << worldRay.origin.y << ", "
-        << worldRay.origin.z
+        << worldOrigin.x << ", "
+        << worldOrigin.y << ", "
+        << worldOrigin.z
         << '\n';
 
     std::cout
         << "worldRay direction: "
-        << worldRay.direction.x << ", "
-        << worldRay.direction.y << ", "
-        << worldRay.direction.z
+        << cameraRay.direction.x << ", "
+        << cameraRay.direction.y << ", "
+        << cameraRay.direction.z
         << '\n';
 
     float closestDistance =
@@ -92,13 +206,46 @@ void Viewport::update(const input::Input& input) {
 
     uint32_t selectedObjectId = 0;
 
-    for (const Object& object : mScene.getObjects()) {
+    const std::vector<Object>& objects = mScene.getObjects();
+
+    // Descarte previo: el rayo contra las cajas de mundo (relativas a la
+    // cámara) de todos los objetos de una vez; solo los alcanzados pasan al
+    // test en espacio local
+    math::TransformSoA transforms;
+    transforms.reserve(objects.size());
+    for (const Object& object : objects) {
+        transforms.add(object.getTransform());
+    }
+
+    std::vector<math::Affine3x4> modelMatrices(objects.size());
+    math::composeModelMatrices(transforms, modelMatrices.data(), origin);
+
+    math::AABBSoA worldBoxes;
+    worldBoxes.reserve(objects.size());
+
+    for (size_t i = 0; i < objects.size(); i++) {
+        worldBoxes.add(math::transformBoundingBox(
+            objects[i].getBoundingBox(),
+            modelMatrices[i]));
+    }
+
+    std::vector<uint64_t> hitMask(worldBoxes.maskWords());
+    float broadDistance;
+    math::intersect(math::makeRayInverse(cameraRay), worldBoxes, broadDistance, hitMask.data());
+
+    for (size_t i = 0; i < objects.size(); i++) {
+
+        if ((hitMask[i >> 6] >> (i & 63) & 1) == 0) {
+            continue;
+        }
+
+        const Object& object = objects[i];
 
-        glm::mat4 modelMatrix =
-            object.getTransform().getModelMatrix();
+        const math::Affine3x4& modelMatrix = modelMatrices[i];
 
+        // Inversa cerrada desde la TRS: sin glm::inverse de una 4x4
         math::Ray localRay =
-            worldToLocalRay(worldRay, modelMatrix);
+            worldToLocalRay(cameraRay, math::inverseTransform(object.getTransform(), origin));
 
         float localDistance;
 
@@ -113,10 +260,10 @@ void Viewport::update(const input::Input& input) {
                 localDistance * localRay.direction;
 
             glm::vec3 worldHitPoint =
-                glm::vec3(modelMatrix * glm::vec4(localHitPoint, 1.0f));
+                modelMatrix.transformPoint(localHitPoint);
 
             float worldDistance =
-                glm::length(worldHitPoint - worldRay.origin);
+                glm::length(worldHitPoint - cameraRay.origin);
 
 
             if (worldDistance < closestDistance) {
@@ -208,8 +355,10 @@ void Viewport::end() {
     if (objectSelected != nullptr) {
         Transform& transform = objectSelected->getTransform();
 
-        // Obtención de matrices necesarias para Manipulate()
-        glm::mat4 modelMatrix = transform.getModelMatrix();
+        // Obtención de matrices necesarias para Manipulate(), relativas a
+        // la cámara como todo lo que se dibuja
+        const glm::dvec3& origin = mCamera.getPosition();
+        glm::mat4 modelMatrix = transform.getModelMatrix(origin);
 
         glm::mat4 viewMatrix = mCamera.getViewMatrix();
 
@@ -257,7 +406,23 @@ void Viewport::end() {
 
         // Recomponer de model a position,rotation y scale
         if (ImGuizmo::IsUsing()) {
-            transform.setFromModelMatrix(modelMatrix);
+
+            // Al mover, el pivote se ajusta a la geometría cercana de los
+            // demás objetos. ImGuizmo recalcula la posición desde el ratón
+            // en cada frame, así que el ajuste no se acumula
+            const editor::SnapMode snapMode = mContext.getSnapMode();
+
+            if (operation == ImGuizmo::TRANSLATE && snapMode != editor::SnapMode::None) {
+                const glm::vec3 pivot(modelMatrix[3]);
+                glm::vec3 snapped;
+
+                if (findSnapPoint(mScene.getObjects(), objectId, snapMode, pivot,
+                    snapRadiusFactor * glm::length(pivot), origin, snapped)) {
+                    modelMatrix[3] = glm::vec4(snapped, 1.0f);
+                }
+            }
+
+            transform.setFromModelMatrix(modelMatrix, origin);
         }
     }
     ImGui::End();
@@ -279,6 +444,10 @@ int Viewport::getHeight() const {
     return static_cast<int>(mSize.y);
 }
 
+const render::Framebuffer& Viewport::getFramebuffer() const {
+    return mFramebuffer;
+}
+
 bool Viewport::isMouseOver(const glm::ivec2& mouseAbsolutePosition) const {
 
     float left = mImagePos.x;
@@ -302,41 +471,37 @@ math::Ray Viewport::screenToRay(const glm::vec2& mouseAbsolutePosition) const {
     glm::vec4 nearPointNDC{ ndc.x, ndc.y, -1.0f, 1.0f };
     glm::vec4 farPointNDC{ ndc.x, ndc.y, 1.0f, 1.0f };
 
-    //Matriz de inversión, de NDC a World
-    glm::mat4 inverseViewProjection = glm::inverse(
-        mCamera.getPerspectiveMatrix(getAspectRatio()) * mCamera.getViewMatrix());
+    //Matriz de inversión, de NDC al espacio de la cámara. En double: con
+    // un plano lejano grande la inversa de la proyección en float pierde
+    // precisión en el punto lejano
+    glm::dmat4 inverseViewProjection = glm::inverse(
+        glm::dmat4(mCamera.getPerspectiveMatrix(getAspectRatio())) * glm::dmat4(mCamera.getViewMatrix()));
 
-    // Transformar near y far a world
-    glm::vec4 nearPointWorld = inverseViewProjection * nearPointNDC;
-    glm::vec4 farPointWorld = inverseViewProjection * farPointNDC;
+    // Transformar near y far
+    glm::dvec4 nearPointCamera = inverseViewProjection * glm::dvec4(nearPointNDC);
+    glm::dvec4 farPointCamera = inverseViewProjection * glm::dvec4(farPointNDC);
 
     // Realizar la división perspectiva
-    glm::vec3 nearPoint = glm::vec3(nearPointWorld / nearPointWorld.w);
-    glm::vec3 farPoint = glm::vec3(farPointWorld / farPointWorld.w);
+    glm::dvec3 nearPoint = glm::dvec3(nearPointCamera / nearPointCamera.w);
+    glm::dvec3 farPoint = glm::dvec3(farPointCamera / farPointCamera.w);
 
     // Construir el rayo
 
     math::Ray ray;
 
-    ray.origin = nearPoint;
-    ray.direction = glm::normalize(farPoint - nearPoint);
+    ray.origin = glm::vec3(nearPoint);
+    ray.direction = glm::vec3(glm::normalize(farPoint - nearPoint));
 
     return ray;
 
 }
 
-math::Ray Viewport::worldToLocalRay(const math::Ray& worldRay, const glm::mat4& modelMatrix) const {
-
-    glm::mat4 inverseModel = glm::inverse(modelMatrix);
-
-    glm::vec4 origin = inverseModel * glm::vec4(worldRay.origin, 1.0f);
-
-    glm::vec4 direction = inverseModel * glm::vec4(worldRay.direction, 0.0f);
+math::Ray Viewport::worldToLocalRay(const math::Ray& worldRay, const math::Affine3x4& inverseModel) const {
 
     math::Ray localRay;
 
-    localRay.origin = glm::vec3(origin);
-    localRay.direction = glm::normalize(glm::vec3(direction));
+    localRay.origin = inverseModel.transformPoint(worldRay.origin);
+    localRay.direction = glm::normalize(inverseModel.transformVector(worldRay.direction));
 
     return localRay;
 }
@@ -8,6 +8,7 @@
 #include "render/framebuffer.hpp"
 #include "camera/camera.hpp"
 #include "input/input.hpp"
+#include "math/affine.hpp"
 #include "math/ray.hpp"
 
 
@@ -44,10 +45,16 @@ public:
     int getWidth() const;
     int getHeight() const;
 
+    // Donde dibuja el renderer entre beginRender y endRender
+    const render::Framebuffer& getFramebuffer() const;
+
     bool isMouseOver(const glm::ivec2& mouseAbsolutePosition) const;
 
+    // Rayo relativo a la cámara (origen en Camera::getPosition()), calculado
+    // en double y pasado a float solo al final
     math::Ray screenToRay(const glm::vec2& mouseAbsolutePosition) const;
-    math::Ray worldToLocalRay(const math::Ray& worldRay, const glm::mat4& modelMatrix) const;
+    // Recibe la inversa de la matriz de modelo (de mundo a local)
+    math::Ray worldToLocalRay(const math::Ray& worldRay, const math::Affine3x4& inverseModel) const;
 
 };
 
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "core/radix_sort.hpp"
+
+namespace {
+
+template <typename Key>
+bool matchesStableSort(size_t count, Key keyMask) {
+    std::mt19937_64 rng(count);
+
+    std::vector<Key> keys(count);
+    std::vector<uint32_t> values(count);
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = static_cast<Key>(rng()) & keyMask;
+        values[i] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<std::pair<Key, uint32_t>> expected(count);
+    for (size_t i = 0; i < count; i++) {
+        expected[i] = { keys[i], values[i] };
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    core::radixSort(keys, values);
+
+    for (size_t i = 0; i < count; i++) {
+        if (keys[i] != expected[i].first || values[i] != expected[i].second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * La ordenación radix debe dar el mismo resultado que std::stable_sort,
+ * con claves de 32 y 64 bits, con pasadas triviales (claves cortas o muy
+ * repetidas) y con tamaño suficiente para repartirse en varios hilos.
+ */
+bool testRadixSortMatchesStableSort() {
+    for (size_t count : { size_t(0), size_t(1), size_t(1000), size_t(300001) }) {
+        if (!matchesStableSort<uint32_t>(count, 0x3fffffffu)
+            || !matchesStableSort<uint32_t>(count, 0x0f0f0f00u)
+            || !matchesStableSort<uint64_t>(count, ~uint64_t(0))
+            || !matchesStableSort<uint64_t>(count, 0x7fffffffffffffffull >> 40)) {
+            std::cerr << "[FAIL] radixSort distinta de std::stable_sort (" << count << " claves)\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] radixSort igual que std::stable_sort\n";
+    return true;
+}
@@ -0,0 +1,55 @@
+#include <cmath>
+#include <iostream>
+
+#include "geometry/builtin_meshes.hpp"
+#include "geometry/mesh_factory.hpp"
+
+using namespace app::geometry;
+
+static_assert(kSphereMesh.vertices.size() == 32 * 15 + 2, "Esfera fija con vértices de más");
+static_assert(kSphereMesh.indices.size() == 6 * 32 * 15, "Esfera fija con índices de más");
+static_assert(kCubeMesh.indices[35] == 4, "Cubo fijo mal generado");
+
+/**
+ * La esfera generada en tiempo de compilación debe coincidir con la misma
+ * esfera calculada con std::sin/cos, y la de MeshFactory con otra
+ * resolución debe quedar bien indexada.
+ */
+bool testBuiltinSphereMatchesRuntime() {
+    constexpr uint32_t segments = 32;
+    constexpr uint32_t rings = 16;
+    const double pi = std::acos(-1.0);
+
+    for (uint32_t r = 1; r < rings; r++) {
+        const double phi = pi * r / rings;
+
+        for (uint32_t s = 0; s < segments; s++) {
+            const double theta = 2.0 * pi * s / segments;
+            const glm::vec3 expected = 0.5f * glm::vec3(
+                std::sin(phi) * std::cos(theta),
+                std::cos(phi),
+                std::sin(phi) * std::sin(theta));
+
+            const glm::vec3& position = kSphereMesh.vertices[1 + (r - 1) * segments + s].position;
+            if (glm::any(glm::greaterThan(glm::abs(position - expected), glm::vec3(1e-6f)))) {
+                std::cerr << "[FAIL] Esfera fija: vértice distinto del calculado en ejecución\n";
+                return false;
+            }
+        }
+    }
+
+    const Mesh sphere = MeshFactory::createSphereMesh(7, 5);
+    if (sphere.vertices.size() != sphereVertexCount(7, 5) || sphere.indices.size() != sphereIndexCount(7, 5)) {
+        std::cerr << "[FAIL] Esfera de MeshFactory con tamaños incorrectos\n";
+        return false;
+    }
+    for (uint32_t index : sphere.indices) {
+        if (index >= sphere.vertices.size()) {
+            std::cerr << "[FAIL] Esfera de MeshFactory con índices fuera de rango\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Esfera fija igual a la calculada en ejecución\n";
+    return true;
+}
@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+#include "geometry/chunked_mesh.hpp"
+#include "geometry/mesh_factory.hpp"
+
+namespace {
+
+double signedVolume(const std::vector<app::geometry::Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    double volume = 0.0;
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const glm::dvec3 a(vertices[indices[t]].position);
+        const glm::dvec3 b(vertices[indices[t + 1]].position);
+        const glm::dvec3 c(vertices[indices[t + 2]].position);
+        volume += glm::dot(a, glm::cross(b, c)) / 6.0;
+    }
+    return volume;
+}
+
+} // namespace
+
+/**
+ * Escribir una esfera troceada (forzando volcados al fichero temporal con un
+ * límite de memoria mínimo) y leer todos los trozos debe devolver los mismos
+ * triángulos, cada uno dentro de la caja de su trozo.
+ */
+bool testChunkedMeshRoundTrip() {
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh(64, 32);
+    const std::string path = (std::filesystem::temp_directory_path() / "test_chunked_mesh.cmsh").string();
+
+    app::geometry::ChunkedMeshBuilder builder(path, math::calculateBoundingBox(sphere), 4, 4096);
+
+    // Se añade en dos partes para simular una entrada por bloques
+    const size_t half = sphere.indices.size() / 6 * 3;
+    builder.addTriangles(app::geometry::Mesh(sphere.vertices,
+        std::vector<uint32_t>(sphere.indices.begin(), sphere.indices.begin() + half)));
+    builder.addTriangles(app::geometry::Mesh(sphere.vertices,
+        std::vector<uint32_t>(sphere.indices.begin() + half, sphere.indices.end())));
+
+    app::geometry::ChunkedMeshFile file;
+    if (!builder.finish() || !file.open(path)) {
+        std::cerr << "[FAIL] Malla troceada: no se pudo escribir o abrir\n";
+        return false;
+    }
+
+    size_t indexCount = 0;
+    double volume = 0.0;
+    bool inside = true;
+
+    std::vector<app::geometry::Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    for (size_t i = 0; i < file.getChunks().size(); i++) {
+        const app::geometry::ChunkInfo& chunk = file.getChunks()[i];
+
+        if (!file.readChunk(i, vertices, indices)) {
+            std::cerr << "[FAIL] Malla troceada: no se pudo leer el trozo " << i << '\n';
+            return false;
+        }
+
+        for (const app::geometry::Vertex& vertex : vertices) {
+            inside &= glm::all(glm::greaterThanEqual(vertex.position, chunk.bounds.min)) &&
+                glm::all(glm::lessThanEqual(vertex.position, chunk.bounds.max));
+        }
+
+        indexCount += indices.size();
+        volume += signedVolume(vertices, indices);
+    }
+
+    std::remove(path.c_str());
+
+    const double expected = signedVolume(sphere.vertices, sphere.indices);
+
+    if (file.getChunks().size() < 2 || indexCount != sphere.indices.size() || !inside ||
+        std::abs(volume - expected) > 1e-6) {
+        std::cerr
+            << "[FAIL] Malla troceada: los datos leídos no coinciden\n"
+            << "  Trozos: " << file.getChunks().size() << '\n'
+            << "  Índices: " << indexCount << " (esperado " << sphere.indices.size() << ")\n"
+            << "  Volumen: " << volume << " (esperado " << expected << ")\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Malla troceada en disco\n";
+    return true;
+}
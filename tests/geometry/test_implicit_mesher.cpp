@@ -0,0 +1,95 @@
+#include <iostream>
+#include <map>
+#include <utility>
+
+#include "geometry/mesh_factory.hpp"
+
+namespace {
+
+app::geometry::ScalarField sphereField(float radius) {
+    // Rejilla de 33^3 sobre [-1.5, 1.5]; el tamaño de bloque 8 fuerza costuras
+    return app::geometry::sampleField(
+        [radius](const glm::vec3& p) { return glm::length(p) - radius; },
+        glm::ivec3(33), glm::vec3(-1.5f), 3.0f / 32.0f);
+}
+
+// Cada arista dirigida debe aparecer una vez y su opuesta también:
+// la malla es cerrada y con orientación coherente
+bool isClosedAndOriented(const app::geometry::Mesh& mesh) {
+    std::map<std::pair<uint32_t, uint32_t>, int> edges;
+
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        for (int k = 0; k < 3; k++) {
+            const uint32_t a = mesh.indices[t + k];
+            const uint32_t b = mesh.indices[t + (k + 1) % 3];
+            edges[{ a, b }]++;
+        }
+    }
+
+    for (const auto& [edge, count] : edges) {
+        const auto opposite = edges.find({ edge.second, edge.first });
+        if (count != 1 || opposite == edges.end() || opposite->second != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float signedVolume(const app::geometry::Mesh& mesh) {
+    float volume = 0.0f;
+
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const glm::vec3& a = mesh.vertices[mesh.indices[t]].position;
+        const glm::vec3& b = mesh.vertices[mesh.indices[t + 1]].position;
+        const glm::vec3& c = mesh.vertices[mesh.indices[t + 2]].position;
+        volume += glm::dot(a, glm::cross(b, c)) / 6.0f;
+    }
+    return volume;
+}
+
+bool checkSphere(const char* name, app::geometry::MesherMode mode) {
+    const float radius = 1.0f;
+    const float expected = 4.0f / 3.0f * 3.14159265f * radius * radius * radius;
+
+    app::geometry::MesherSettings settings;
+    settings.mode = mode;
+    settings.blockSize = 8;
+
+    const app::geometry::Mesh mesh =
+        app::geometry::MeshFactory::createImplicitMesh(sphereField(radius), settings);
+
+    const float volume = signedVolume(mesh);
+
+    if (mesh.indices.empty() || !isClosedAndOriented(mesh) ||
+        std::abs(volume - expected) > 0.05f * expected) {
+        std::cerr
+            << "[FAIL] " << name << ": malla abierta o volumen incorrecto\n"
+            << "  Triángulos: " << mesh.indices.size() / 3 << '\n'
+            << "  Volumen: " << volume << " (esperado " << expected << ")\n";
+        return false;
+    }
+
+    for (const app::geometry::Vertex& vertex : mesh.vertices) {
+        if (std::abs(glm::length(vertex.position) - radius) > 0.05f) {
+            std::cerr << "[FAIL] " << name << ": vértice fuera de la superficie\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] " << name << '\n';
+    return true;
+}
+
+} // namespace
+
+/**
+ * Marching cubes sobre una esfera con varios bloques: la malla debe ser
+ * cerrada (las costuras entre bloques comparten vértices) y con volumen positivo.
+ */
+bool testImplicitMesherSphereClosed() {
+    return checkSphere("Mallado implícito (marching cubes)", app::geometry::MesherMode::MarchingCubes);
+}
+
+bool testImplicitMesherDualContouring() {
+    return checkSphere("Mallado implícito (dual contouring)", app::geometry::MesherMode::DualContouring);
+}
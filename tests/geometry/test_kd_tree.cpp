@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "geometry/kd_tree.hpp"
+
+using app::geometry::KdNeighbor;
+using app::geometry::KdTree;
+
+/**
+ * Vecino más cercano, k más cercanos y búsqueda por radio deben dar lo
+ * mismo que la fuerza bruta, también con puntos repetidos y con tamaño
+ * suficiente para construir en paralelo.
+ */
+bool testKdTreeMatchesBruteForce() {
+    std::mt19937 rng(39);
+    std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+    std::uniform_int_distribution<int> grid(-5, 5);
+
+    for (size_t count : { size_t(1), size_t(7), size_t(1000), size_t(200000) }) {
+        std::vector<glm::vec3> points(count);
+        for (size_t i = 0; i < count; i++) {
+            // La mitad sobre una rejilla, para tener coordenadas repetidas
+            points[i] = i % 2 == 0
+                ? glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng))
+                : glm::vec3(grid(rng), grid(rng), 0.0f);
+        }
+
+        const KdTree tree(points.data(), points.size());
+        if (tree.size() != count) {
+            std::cerr << "[FAIL] KdTree: tamaño incorrecto\n";
+            return false;
+        }
+
+        std::vector<KdNeighbor> neighbors;
+        std::vector<uint32_t> inside;
+        std::vector<float> distances(count);
+
+        for (int q = 0; q < 100; q++) {
+            const glm::vec3 query(coordinate(rng), coordinate(rng), coordinate(rng));
+
+            for (size_t i = 0; i < count; i++) {
+                const glm::vec3 d = points[i] - query;
+                distances[i] = glm::dot(d, d);
+            }
+            const size_t k = 10;
+            std::vector<float> sorted = distances;
+            std::partial_sort(sorted.begin(), sorted.begin() + std::min(k, count), sorted.end());
+
+            float nearestDistance;
+            const uint32_t nearest = tree.nearest(query, std::numeric_limits<float>::infinity(), &nearestDistance);
+            if (nearest == KdTree::npos || distances[nearest] != sorted[0] || nearestDistance != sorted[0]) {
+                std::cerr << "[FAIL] KdTree: vecino más cercano incorrecto\n";
+                return false;
+            }
+
+            tree.kNearest(query, k, neighbors);
+            if (neighbors.size() != std::min(k, count)) {
+                std::cerr << "[FAIL] KdTree: número de vecinos incorrecto\n";
+                return false;
+            }
+            for (size_t i = 0; i < neighbors.size(); i++) {
+                if (neighbors[i].distanceSquared != sorted[i] || distances[neighbors[i].index] != sorted[i]) {
+                    std::cerr << "[FAIL] KdTree: k vecinos incorrectos\n";
+                    return false;
+                }
+            }
+
+            const float radius = 3.0f;
+            tree.queryRadius(query, radius, inside);
+            const size_t expected = std::count_if(distances.begin(), distances.end(), [&](float distance) {
+                return distance <= radius * radius;
+            });
+            if (inside.size() != expected) {
+                std::cerr << "[FAIL] KdTree: búsqueda por radio incorrecta\n";
+                return false;
+            }
+            for (uint32_t index : inside) {
+                if (distances[index] > radius * radius) {
+                    std::cerr << "[FAIL] KdTree: punto fuera del radio\n";
+                    return false;
+                }
+            }
+
+            // Con distancia máxima por debajo del más cercano no hay resultado
+            if (sorted[0] > 0.0f && tree.nearest(query, 0.5f * std::sqrt(sorted[0])) != KdTree::npos) {
+                std::cerr << "[FAIL] KdTree: no respeta la distancia máxima\n";
+                return false;
+            }
+        }
+    }
+
+    if (KdTree().nearest(glm::vec3(0.0f)) != KdTree::npos) {
+        std::cerr << "[FAIL] KdTree vacío\n";
+        return false;
+    }
+
+    std::cout << "[PASS] KdTree igual a la fuerza bruta\n";
+    return true;
+}
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "geometry/mesh_factory.hpp"
+#include "geometry/mesh_boolean.hpp"
+#include "math/predicates.hpp"
+
+namespace {
+
+float signedVolume(const app::geometry::Mesh& mesh, const glm::mat4& model = glm::mat4(1.0f)) {
+    double volume = 0.0;
+
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const glm::vec3 a(model * glm::vec4(mesh.vertices[mesh.indices[t]].position, 1.0f));
+        const glm::vec3 b(model * glm::vec4(mesh.vertices[mesh.indices[t + 1]].position, 1.0f));
+        const glm::vec3 c(model * glm::vec4(mesh.vertices[mesh.indices[t + 2]].position, 1.0f));
+        volume += glm::dot(a, glm::cross(b, c)) / 6.0;
+    }
+    return static_cast<float>(volume);
+}
+
+// Cerrada y variedad: cada arista orientada aparece una sola vez y su
+// opuesta también, así que cada arista separa exactamente dos triángulos
+bool isClosedManifold(const app::geometry::Mesh& mesh) {
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        for (int k = 0; k < 3; k++) {
+            edges.emplace_back(mesh.indices[t + k], mesh.indices[t + (k + 1) % 3]);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    if (std::adjacent_find(edges.begin(), edges.end()) != edges.end()) {
+        return false;
+    }
+    for (const auto& edge : edges) {
+        if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(edge.second, edge.first))) {
+            return false;
+        }
+    }
+    return !edges.empty();
+}
+
+} // namespace
+
+/**
+ * orient3d debe ser exacto aunque el punto esté a una distancia del plano
+ * inferior al error de redondeo del cálculo directo en double.
+ */
+bool testOrient3dExact() {
+    const glm::vec3 a(0.0f, 0.0f, 0.0f);
+    const glm::vec3 b(1.0f, 0.0f, 0.0f);
+    const glm::vec3 c(0.0f, 1.0f, 0.0f);
+
+    // Cuatro puntos exactamente coplanares (x + y + z = 0) para los que el
+    // determinante en double da 1.19e-7 en lugar de 0
+    const glm::vec3 p(928.2431640625f, 226.35791015625f, -1154.60107421875f);
+    const glm::vec3 q(-315.1136779785156f, 675.7372436523438f, -360.6235656738281f);
+    const glm::vec3 r(-763.8657836914062f, 385.27386474609375f, 378.5919189453125f);
+    const glm::vec3 s(-809.538330078125f, -200.5885009765625f, 1010.1268310546875f);
+
+    const bool ok =
+        math::orient3d(a, b, c, glm::vec3(0.3f, 0.3f, -1e-30f)) > 0 &&
+        math::orient3d(a, b, c, glm::vec3(0.3f, 0.3f, 1e-30f)) < 0 &&
+        math::orient3d(a, b, c, glm::vec3(0.3f, 0.3f, 0.0f)) == 0 &&
+        math::orient3d(p, q, r, s) == 0 &&
+        math::orient2d(glm::vec2(0.0f), glm::vec2(1e6f, 1.0f), glm::vec2(2e6f, 2.0f)) == 0;
+
+    if (!ok) {
+        std::cerr << "[FAIL] orient3d exacto\n";
+        return false;
+    }
+
+    std::cout << "[PASS] orient3d exacto\n";
+    return true;
+}
+
+/**
+ * Dos esferas que se solapan: vol(a ∪ b) + vol(a ∩ b) = vol(a) + vol(b)
+ * y vol(a - b) = vol(a) - vol(a ∩ b).
+ */
+bool testMeshBooleanVolumes() {
+    using app::geometry::BooleanOperation;
+
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh(48, 24);
+    const glm::mat4 modelA(1.0f);
+    const glm::mat4 modelB = glm::translate(glm::mat4(1.0f), glm::vec3(0.4f, 0.1f, 0.05f));
+
+    const float volumeA = signedVolume(sphere, modelA);
+    const float volumeB = signedVolume(sphere, modelB);
+
+    const float unionVolume = signedVolume(app::geometry::meshBoolean(sphere, modelA, sphere, modelB, BooleanOperation::Union));
+    const float intersectionVolume = signedVolume(app::geometry::meshBoolean(sphere, modelA, sphere, modelB, BooleanOperation::Intersection));
+    const float differenceVolume = signedVolume(app::geometry::meshBoolean(sphere, modelA, sphere, modelB, BooleanOperation::Difference));
+
+    const float tolerance = 1e-3f * volumeA;
+
+    if (intersectionVolume <= 0.0f ||
+        std::abs(unionVolume + intersectionVolume - volumeA - volumeB) > tolerance ||
+        std::abs(differenceVolume - (volumeA - intersectionVolume)) > tolerance) {
+        std::cerr
+            << "[FAIL] Booleanas entre mallas: volúmenes incoherentes\n"
+            << "  A: " << volumeA << ", B: " << volumeB << '\n'
+            << "  Unión: " << unionVolume
+            << ", intersección: " << intersectionVolume
+            << ", diferencia: " << differenceVolume << '\n';
+        return false;
+    }
+
+    std::cout << "[PASS] Booleanas entre mallas\n";
+    return true;
+}
+
+/**
+ * Las operaciones que no dejan nada devuelven una malla vacía (y no
+ * triángulos degenerados): la intersección de dos objetos separados y la
+ * diferencia de A menos un B que lo contiene.
+ */
+bool testMeshBooleanEmptyResults() {
+    using app::geometry::BooleanOperation;
+
+    const app::geometry::Mesh cube = app::geometry::MeshFactory::createCubeMesh();
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh();
+
+    const glm::mat4 identity(1.0f);
+    const glm::mat4 apart = glm::translate(glm::mat4(1.0f), glm::vec3(3.0f, 0.2f, -0.1f));
+    const glm::mat4 enclosing = glm::scale(glm::mat4(1.0f), glm::vec3(3.0f));
+
+    const app::geometry::Mesh disjoint = app::geometry::meshBoolean(cube, identity, sphere, apart, BooleanOperation::Intersection);
+    const app::geometry::Mesh enclosed = app::geometry::meshBoolean(cube, identity, sphere, enclosing, BooleanOperation::Difference);
+
+    // Con los mismos operandos, la unión separada conserva las dos mallas
+    const app::geometry::Mesh both = app::geometry::meshBoolean(cube, identity, sphere, apart, BooleanOperation::Union);
+
+    if (!disjoint.indices.empty() || !enclosed.indices.empty() ||
+        both.indices.size() != cube.indices.size() + sphere.indices.size()) {
+        std::cerr
+            << "[FAIL] Booleanas vacías: intersección separada con " << disjoint.indices.size() / 3
+            << " triángulos, diferencia contenida con " << enclosed.indices.size() / 3 << '\n';
+        return false;
+    }
+
+    std::cout << "[PASS] Booleanas vacías\n";
+    return true;
+}
+
+/**
+ * El resultado de una booleana es una malla cerrada (los vértices de la
+ * costura están soldados y sin uniones en T), así que puede ser a su vez
+ * operando de otra: (a ∪ b) con c debe cumplir las mismas identidades de
+ * volumen y seguir cerrado.
+ */
+bool testMeshBooleanChained() {
+    using app::geometry::BooleanOperation;
+    using app::geometry::meshBoolean;
+
+    const app::geometry::Mesh sphere = app::geometry::MeshFactory::createSphereMesh(32, 16);
+    const app::geometry::Mesh cube = app::geometry::MeshFactory::createCubeMesh();
+
+    const glm::mat4 identity(1.0f);
+    const glm::mat4 modelB = glm::translate(glm::mat4(1.0f), glm::vec3(0.4f, 0.1f, 0.05f));
+    const glm::mat4 modelC = glm::translate(glm::mat4(1.0f), glm::vec3(0.35f, 0.45f, -0.3f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(0.8f));
+    const glm::mat4 modelD = glm::translate(glm::mat4(1.0f), glm::vec3(-0.2f, -0.1f, 0.15f))
+        * glm::scale(glm::mat4(1.0f), glm::vec3(0.6f));
+
+    const app::geometry::Mesh joined = meshBoolean(sphere, identity, sphere, modelB, BooleanOperation::Union);
+
+    const app::geometry::Mesh unionC = meshBoolean(joined, identity, cube, modelC, BooleanOperation::Union);
+    const app::geometry::Mesh intersectionC = meshBoolean(joined, identity, cube, modelC, BooleanOperation::Intersection);
+    const app::geometry::Mesh differenceC = meshBoolean(joined, identity, cube, modelC, BooleanOperation::Difference);
+
+    // Y otra vez sobre el resultado encadenado
+    const app::geometry::Mesh again = meshBoolean(differenceC, identity, sphere, modelD, BooleanOperation::Difference);
+
+    const float volumeJoined = signedVolume(joined);
+    const float volumeC = signedVolume(cube, modelC);
+    const float volumeUnion = signedVolume(unionC);
+    const float volumeIntersection = signedVolume(intersectionC);
+    const float volumeDifference = signedVolume(differenceC);
+    const float volumeAgain = signedVolume(again);
+
+    const float tolerance = 1e-3f * volumeJoined;
+
+    const bool closed = isClosedManifold(joined) && isClosedManifold(unionC) &&
+        isClosedManifold(intersectionC) && isClosedManifold(differenceC) && isClosedManifold(again);
+
+    if (!closed || volumeIntersection <= 0.0f ||
+        std::abs(volumeUnion + volumeIntersection - volumeJoined - volumeC) > tolerance ||
+        std::abs(volumeDifference - (volumeJoined - volumeIntersection)) > tolerance ||
+        volumeAgain <= 0.0f || volumeAgain >= volumeDifference) {
+        std::cerr
+            << "[FAIL] Booleanas encadenadas: " << (closed ? "volúmenes incoherentes" : "resultado abierto") << '\n'
+            << "  A ∪ B: " << volumeJoined << ", C: " << volumeC << '\n'
+            << "  Unión: " << volumeUnion
+            << ", intersección: " << volumeIntersection
+            << ", diferencia: " << volumeDifference
+            << ", otra diferencia: " << volumeAgain << '\n';
+        return false;
+    }
+
+    std::cout << "[PASS] Booleanas encadenadas\n";
+    return true;
+}
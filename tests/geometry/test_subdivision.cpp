@@ -0,0 +1,92 @@
+#include <iostream>
+#include <cmath>
+
+#include "geometry/mesh_factory.hpp"
+#include "geometry/subdivision.hpp"
+
+/**
+ * Un nivel sobre el cubo triangulado (8 vértices, 18 aristas, 12 caras)
+ * debe dar 38 vértices y 36 quads, y los pesos de cada fila deben sumar 1.
+ */
+bool testSubdivisionCubeCounts() {
+    const app::geometry::Mesh cube = app::geometry::MeshFactory::createCubeMesh();
+    const app::geometry::SubdivisionSurface surface(cube, 1);
+
+    if (surface.getRefinedVertexCount() != 38 ||
+        surface.getIndices().size() != 36 * 6) {
+        std::cerr
+            << "[FAIL] Subdivisión del cubo: conteos incorrectos\n"
+            << "  Vértices: " << surface.getRefinedVertexCount() << " (esperado 38)\n"
+            << "  Índices: " << surface.getIndices().size() << " (esperado 216)\n";
+        return false;
+    }
+
+    const app::geometry::StencilTable& table = surface.getTables()[0];
+
+    for (size_t row = 0; row < table.size(); row++) {
+        float sum = 0.0f;
+        for (uint32_t e = table.offsets[row]; e < table.offsets[row + 1]; e++) {
+            sum += table.weights[e];
+        }
+
+        if (std::abs(sum - 1.0f) > 1e-5f) {
+            std::cerr
+                << "[FAIL] Subdivisión del cubo: la fila " << row
+                << " suma " << sum << '\n';
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Subdivisión del cubo\n";
+    return true;
+}
+
+// Reevaluar tras mover un vértice debe coincidir con construir de cero
+bool testSubdivisionReevaluation() {
+    app::geometry::Mesh cage = app::geometry::MeshFactory::createCubeMesh();
+    const app::geometry::SubdivisionSurface surface(cage, 3);
+
+    cage.vertices[2].position += glm::vec3(0.3f, 0.5f, -0.2f);
+
+    std::vector<app::geometry::Vertex> reevaluated;
+    surface.evaluate(cage.vertices, reevaluated);
+
+    const app::geometry::SubdivisionSurface rebuilt(cage, 3);
+    const app::geometry::Mesh expected = rebuilt.refine(cage);
+
+    if (reevaluated.size() != expected.vertices.size()) {
+        std::cerr << "[FAIL] Reevaluación de la subdivisión: tamaños distintos\n";
+        return false;
+    }
+
+    for (size_t i = 0; i < reevaluated.size(); i++) {
+        if (glm::length(reevaluated[i].position - expected.vertices[i].position) > 1e-5f) {
+            std::cerr << "[FAIL] Reevaluación de la subdivisión: vértice " << i << " distinto\n";
+            return false;
+        }
+    }
+
+    // Una jaula con otro número de vértices se rechaza sin tocar la salida,
+    // también sin tablas (nivel 0), donde solo se copiaría
+    const app::geometry::SubdivisionSurface flat(cage, 0);
+    std::vector<app::geometry::Vertex> shorter(cage.vertices.begin(), cage.vertices.end() - 1);
+    std::vector<app::geometry::Vertex> longer = cage.vertices;
+    longer.push_back(cage.vertices[0]);
+
+    std::vector<app::geometry::Vertex> untouched = reevaluated;
+    if (surface.evaluate(shorter, untouched) || surface.evaluate(longer, untouched) ||
+        flat.evaluate(longer, untouched) || untouched.size() != reevaluated.size() ||
+        !surface.refine(app::geometry::Mesh(shorter, cage.indices)).vertices.empty()) {
+        std::cerr << "[FAIL] Reevaluación de la subdivisión: acepta una jaula de otro tamaño\n";
+        return false;
+    }
+    for (size_t i = 0; i < untouched.size(); i++) {
+        if (untouched[i].position != reevaluated[i].position) {
+            std::cerr << "[FAIL] Reevaluación de la subdivisión: una jaula rechazada cambia la salida\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Reevaluación de la subdivisión\n";
+    return true;
+}
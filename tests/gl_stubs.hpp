@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include <glad/glad.h>
+
+// Sustituye punteros de glad (o banderas de extensiones) por los de un test
+// sin contexto de OpenGL y los devuelve a su valor al salir de ámbito: los
+// tests que vienen detrás en el mismo test_runner no heredan los stubs
+class GLStubs {
+private:
+    std::vector<std::function<void()>> mRestore;
+
+public:
+    GLStubs() = default;
+
+    ~GLStubs() {
+        for (auto restore = mRestore.rbegin(); restore != mRestore.rend(); ++restore) {
+            (*restore)();
+        }
+    }
+
+    GLStubs(const GLStubs&) = delete;
+    GLStubs& operator=(const GLStubs&) = delete;
+
+    // 'value' no participa en la deducción: el tipo lo fija 'target'
+    template <typename T>
+    void set(T& target, std::common_type_t<T> value) {
+        mRestore.push_back([&target, saved = target]() { target = saved; });
+        target = value;
+    }
+};
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "math/affine.hpp"
+
+namespace {
+
+bool nearlyEqual(const math::Affine3x4& a, const glm::mat4& b, float tolerance) {
+    const glm::mat4 m = a.toMatrix();
+
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            const float scale = std::max(1.0f, std::abs(b[column][row]));
+            if (std::abs(m[column][row] - b[column][row]) > tolerance * scale) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Las inversas afines (cerrada desde la TRS y general) y el producto deben
+ * coincidir con las operaciones de glm sobre la matriz 4x4 completa.
+ */
+bool testAffineMatchesMatrix() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> scale(0.2f, 5.0f);
+    std::uniform_real_distribution<float> shear(-0.5f, 0.5f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    for (int i = 0; i < 200; i++) {
+        Transform transform;
+        transform.position = glm::vec3(position(rng), position(rng), position(rng));
+        transform.rotation = glm::normalize(glm::quat(gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng)));
+        transform.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+
+        const glm::mat4 model = transform.getModelMatrix();
+        const math::Affine3x4 affine = math::Affine3x4::fromTransform(transform);
+
+        if (!nearlyEqual(affine, model, 1e-5f)) {
+            std::cerr << "[FAIL] Matriz afín: fromTransform distinta de getModelMatrix\n";
+            return false;
+        }
+
+        if (!nearlyEqual(math::inverseTransform(transform), glm::inverse(model), 1e-4f)) {
+            std::cerr << "[FAIL] Matriz afín: inversa de la TRS distinta\n";
+            return false;
+        }
+
+        // Una afín con cizalla, que ya no sale de ninguna TRS
+        glm::mat4 sheared = model;
+        sheared[1][0] += shear(rng);
+        sheared[2][1] += shear(rng);
+
+        if (!nearlyEqual(math::inverse(math::Affine3x4(sheared)), glm::inverse(sheared), 1e-4f)) {
+            std::cerr << "[FAIL] Matriz afín: inversa general distinta\n";
+            return false;
+        }
+
+        if (!nearlyEqual(math::Affine3x4(sheared) * affine, sheared * model, 1e-5f)) {
+            std::cerr << "[FAIL] Matriz afín: producto distinto\n";
+            return false;
+        }
+
+        const glm::vec3 p(position(rng), position(rng), position(rng));
+        const glm::vec3 expected(model * glm::vec4(p, 1.0f));
+        if (glm::length(affine.transformPoint(p) - expected) > 1e-4f * std::max(1.0f, glm::length(expected))) {
+            std::cerr << "[FAIL] Matriz afín: transformPoint distinto\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Matriz afín igual a la 4x4\n";
+
+    return true;
+}
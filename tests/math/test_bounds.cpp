@@ -0,0 +1,124 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "geometry/mesh.hpp"
+#include "math/bounds.hpp"
+
+namespace {
+
+// Nube de puntos pseudoaleatoria alargada y girada, para que las
+// distintas envolventes no coincidan entre sí.
+std::vector<app::geometry::Vertex> makePointCloud(size_t count) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+    std::vector<app::geometry::Vertex> vertices;
+    vertices.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 p{ dist(rng) * 10.0f, dist(rng) * 2.0f, dist(rng) * 0.5f };
+        p = glm::vec3(p.x + p.y, p.x - p.y, p.z) + glm::vec3(3.0f, -7.0f, 100.0f);
+        vertices.emplace_back(p);
+    }
+    return vertices;
+}
+
+} // namespace
+
+/**
+ * El kernel paralelo/SIMD debe dar exactamente la misma caja
+ * que el recorrido escalar, también con stride de vec3 empaquetado.
+ */
+bool testBoundingBoxMatchesScalar() {
+
+    // Tamaño suficiente para que se repartan varios bloques
+    const std::vector<app::geometry::Vertex> vertices = makePointCloud(300001);
+
+    glm::vec3 expectedMin = vertices[0].position;
+    glm::vec3 expectedMax = vertices[0].position;
+    std::vector<glm::vec3> packed;
+
+    for (const app::geometry::Vertex& vertex : vertices) {
+        expectedMin = glm::min(expectedMin, vertex.position);
+        expectedMax = glm::max(expectedMax, vertex.position);
+        packed.push_back(vertex.position);
+    }
+
+    const math::AABB strided = math::calculateBoundingBox(
+        &vertices[0].position, vertices.size(), sizeof(app::geometry::Vertex));
+
+    const math::AABB tight = math::calculateBoundingBox(packed.data(), packed.size());
+
+    if (strided.min != expectedMin || strided.max != expectedMax ||
+        tight.min != expectedMin || tight.max != expectedMax) {
+        std::cerr << "[FAIL] AABB SIMD distinta de la escalar\n";
+        return false;
+    }
+
+    std::cout << "[PASS] AABB SIMD igual a la escalar\n";
+    return true;
+}
+
+// Las esferas de Ritter y EPOS deben contener todos los puntos
+bool testBoundingSphereContainsPoints() {
+    const std::vector<app::geometry::Vertex> vertices = makePointCloud(200003);
+
+    const math::BoundingSphere ritter = math::calculateBoundingSphereRitter(
+        &vertices[0].position, vertices.size(), sizeof(app::geometry::Vertex));
+
+    const math::BoundingSphere epos = math::calculateBoundingSphereEPOS(
+        &vertices[0].position, vertices.size(), sizeof(app::geometry::Vertex));
+
+    for (const app::geometry::Vertex& vertex : vertices) {
+        if (!math::contains(ritter, vertex.position) ||
+            !math::contains(epos, vertex.position)) {
+            std::cerr << "[FAIL] Esfera envolvente: punto fuera de la esfera\n";
+            return false;
+        }
+    }
+
+    // La nube es una caja de semiejes ~ (14, 14, 0.5): el radio no puede
+    // ser mucho mayor que la mitad de su diagonal.
+    if (epos.radius > 1.2f * ritter.radius || epos.radius > 15.0f) {
+        std::cerr
+            << "[FAIL] Esfera envolvente: radio demasiado grande\n"
+            << "  Ritter: " << ritter.radius << '\n'
+            << "  EPOS: " << epos.radius << '\n';
+        return false;
+    }
+
+    std::cout << "[PASS] Esferas envolventes contienen la nube\n";
+    return true;
+}
+
+// La OBB por PCA contiene los puntos y es más ajustada que la AABB
+bool testOrientedBoundingBoxContainsPoints() {
+    const std::vector<app::geometry::Vertex> vertices = makePointCloud(100000);
+    const app::geometry::Mesh mesh(vertices, {});
+
+    const math::OBB box = math::calculateOrientedBoundingBox(mesh);
+    const math::AABB aabb = math::calculateBoundingBox(mesh);
+
+    for (const app::geometry::Vertex& vertex : vertices) {
+        if (!math::contains(box, vertex.position)) {
+            std::cerr << "[FAIL] OBB: punto fuera de la caja\n";
+            return false;
+        }
+    }
+
+    const glm::vec3 aabbSize = aabb.max - aabb.min;
+    const float aabbVolume = aabbSize.x * aabbSize.y * aabbSize.z;
+    const float obbVolume = 8.0f * box.halfExtents.x * box.halfExtents.y * box.halfExtents.z;
+
+    if (obbVolume >= aabbVolume) {
+        std::cerr
+            << "[FAIL] OBB: no es más ajustada que la AABB\n"
+            << "  Volumen OBB: " << obbVolume << '\n'
+            << "  Volumen AABB: " << aabbVolume << '\n';
+        return false;
+    }
+
+    std::cout << "[PASS] OBB por PCA contiene la nube\n";
+    return true;
+}
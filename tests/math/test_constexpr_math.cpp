@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "math/constexpr_math.hpp"
+
+// Las funciones tienen que poder evaluarse en tiempo de compilación
+static_assert(math::cx::sqrt(4.0) == 2.0, "cx::sqrt no es constexpr o no es exacta");
+static_assert(math::cx::sin(0.0) == 0.0, "cx::sin no es constexpr");
+static_assert(math::cx::cos(0.0) == 1.0, "cx::cos no es constexpr");
+static_assert(math::cx::length(glm::vec3(3.0f, 4.0f, 0.0f)) == 5.0f, "cx::length no es constexpr");
+
+/**
+ * sqrt, sin y cos deben respetar las cotas documentadas en
+ * constexpr_math.hpp frente a las de la biblioteca estándar, y las utilidades
+ * de cuaterniones coincidir con glm.
+ */
+bool testConstexprMathErrorBounds() {
+    std::mt19937 rng(38);
+
+    std::uniform_real_distribution<double> exponent(-300.0, 300.0);
+    for (int i = 0; i < 100000; i++) {
+        const double x = std::pow(10.0, exponent(rng));
+        const double expected = std::sqrt(x);
+        const double ulp = std::nextafter(expected, HUGE_VAL) - expected;
+
+        if (std::abs(math::cx::sqrt(x) - expected) > ulp) {
+            std::cerr << "[FAIL] cx::sqrt(" << x << ") a más de 1 ulp\n";
+            return false;
+        }
+    }
+
+    if (!std::isnan(math::cx::sqrt(-1.0)) || math::cx::sqrt(0.0) != 0.0) {
+        std::cerr << "[FAIL] cx::sqrt: casos especiales\n";
+        return false;
+    }
+
+    for (double range : { 4.0, 100.0, 1e4 }) {
+        std::uniform_real_distribution<double> angle(-range, range);
+
+        for (int i = 0; i < 100000; i++) {
+            const double x = angle(rng);
+            const double tolerance = 1e-15 * std::max(1.0, std::abs(x));
+
+            if (std::abs(math::cx::sin(x) - std::sin(x)) > tolerance
+                || std::abs(math::cx::cos(x) - std::cos(x)) > tolerance) {
+                std::cerr << "[FAIL] cx::sin/cos(" << x << ") fuera de la cota\n";
+                return false;
+            }
+        }
+    }
+
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    std::uniform_real_distribution<float> angle(-10.0f, 10.0f);
+    for (int i = 0; i < 1000; i++) {
+        const glm::vec3 axis = glm::normalize(glm::vec3(gaussian(rng), gaussian(rng), gaussian(rng)));
+        const float radians = angle(rng);
+
+        const glm::quat expected = glm::angleAxis(radians, axis);
+        const glm::quat rotation = math::cx::angleAxis(radians, axis);
+        const glm::mat3 basis = math::cx::mat3Cast(rotation);
+        const glm::mat3 expectedBasis = glm::mat3_cast(expected);
+
+        bool equal = std::abs(glm::dot(rotation, expected) - 1.0f) < 1e-5f;
+        for (int c = 0; c < 3; c++) {
+            equal &= glm::all(glm::lessThan(glm::abs(basis[c] - expectedBasis[c]), glm::vec3(1e-5f)));
+        }
+
+        if (!equal) {
+            std::cerr << "[FAIL] cx::angleAxis/mat3Cast distinto de glm\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Matemáticas constexpr dentro de las cotas\n";
+    return true;
+}
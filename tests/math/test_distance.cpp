@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include "math/distance.hpp"
+
+namespace {
+
+float distanceSquared(const glm::vec3& a, const glm::vec3& b) {
+    const glm::vec3 d = a - b;
+    return glm::dot(d, d);
+}
+
+} // namespace
+
+/**
+ * Los puntos más cercanos no pueden estar más lejos que ningún punto
+ * muestreado de la primitiva, y tienen que estar sobre ella.
+ */
+bool testClosestPointsMatchSampling() {
+    std::mt19937 rng(39);
+    std::uniform_real_distribution<float> coordinate(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    auto randomPoint = [&]() {
+        return glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+    };
+
+    constexpr int samples = 2000;
+    constexpr float tolerance = 1e-4f;
+
+    for (int i = 0; i < 200; i++) {
+        const glm::vec3 p = randomPoint();
+
+        // Punto - triángulo
+        const glm::vec3 a = randomPoint();
+        const glm::vec3 b = randomPoint();
+        const glm::vec3 c = randomPoint();
+        const glm::vec3 onTriangle = math::closestPointOnTriangle(p, a, b, c);
+        const float triangleDistance = distanceSquared(p, onTriangle);
+
+        // Sobre el plano y dentro: baricéntricas en [0, 1]
+        const glm::vec3 normal = glm::cross(b - a, c - a);
+        const glm::vec3 offset = onTriangle - a;
+        const float area = glm::dot(normal, normal);
+        const float v = glm::dot(glm::cross(offset, c - a), normal) / area;
+        const float w = glm::dot(glm::cross(b - a, offset), normal) / area;
+        if (std::abs(glm::dot(offset, normal)) > tolerance * std::sqrt(area) * glm::length(offset) + tolerance
+            || v < -tolerance || w < -tolerance || v + w > 1.0f + tolerance) {
+            std::cerr << "[FAIL] closestPointOnTriangle fuera del triángulo\n";
+            return false;
+        }
+
+        for (int s = 0; s < samples; s++) {
+            float u = unit(rng);
+            float t = unit(rng);
+            if (u + t > 1.0f) {
+                u = 1.0f - u;
+                t = 1.0f - t;
+            }
+            const glm::vec3 sample = a + u * (b - a) + t * (c - a);
+            if (distanceSquared(p, sample) < triangleDistance - tolerance) {
+                std::cerr << "[FAIL] closestPointOnTriangle no es el más cercano\n";
+                return false;
+            }
+        }
+
+        // Punto - OBB
+        math::OBB obb;
+        obb.center = randomPoint();
+        obb.axes = glm::mat3_cast(glm::normalize(glm::quat(gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng))));
+        obb.halfExtents = glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f;
+
+        const float obbDistance = math::distanceSquared(p, obb);
+        if (!math::contains(obb, math::closestPointOnOBB(p, obb) + (obb.center - p) * 1e-4f)
+            && obbDistance > 0.0f) {
+            std::cerr << "[FAIL] closestPointOnOBB fuera de la caja\n";
+            return false;
+        }
+
+        for (int s = 0; s < samples; s++) {
+            const glm::vec3 local = (glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f - 1.0f) * obb.halfExtents;
+            const glm::vec3 sample = obb.center + obb.axes * local;
+            if (distanceSquared(p, sample) < obbDistance - tolerance) {
+                std::cerr << "[FAIL] closestPointOnOBB no es el más cercano\n";
+                return false;
+            }
+        }
+
+        // Segmento - AABB
+        const glm::vec3 corner = randomPoint();
+        const math::AABB box{ corner, corner + glm::vec3(unit(rng), unit(rng), unit(rng)) * 2.0f };
+        const glm::vec3 from = randomPoint() * 2.0f;
+        const glm::vec3 to = randomPoint() * 2.0f;
+
+        glm::vec3 onSegment;
+        glm::vec3 onBox;
+        const float segmentDistance = math::closestPointsSegmentAABB(from, to, box, &onSegment, &onBox);
+
+        if (std::abs(distanceSquared(onSegment, onBox) - segmentDistance) > tolerance
+            || std::abs(math::distanceSquared(onSegment, box) - segmentDistance) > tolerance) {
+            std::cerr << "[FAIL] closestPointsSegmentAABB: puntos incoherentes\n";
+            return false;
+        }
+
+        for (int s = 0; s <= samples; s++) {
+            const glm::vec3 sample = from + (to - from) * (float(s) / samples);
+            if (math::distanceSquared(sample, box) < segmentDistance - tolerance) {
+                std::cerr << "[FAIL] closestPointsSegmentAABB no es el más cercano\n";
+                return false;
+            }
+        }
+
+        // Punto - segmento
+        float t;
+        const glm::vec3 onEdge = math::closestPointOnSegment(p, from, to, &t);
+        if (t < 0.0f || t > 1.0f || distanceSquared(p, from) < distanceSquared(p, onEdge) - tolerance
+            || distanceSquared(p, to) < distanceSquared(p, onEdge) - tolerance) {
+            std::cerr << "[FAIL] closestPointOnSegment\n";
+            return false;
+        }
+    }
+
+    // Segmento que atraviesa la caja
+    const math::AABB unitBox{ glm::vec3(0.0f), glm::vec3(1.0f) };
+    if (math::closestPointsSegmentAABB(glm::vec3(-1.0f, 0.5f, 0.5f), glm::vec3(2.0f, 0.5f, 0.5f), unitBox) != 0.0f) {
+        std::cerr << "[FAIL] closestPointsSegmentAABB: el segmento corta la caja\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Puntos más cercanos frente a muestreo\n";
+    return true;
+}
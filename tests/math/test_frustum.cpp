@@ -0,0 +1,137 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "math/frustum.hpp"
+
+namespace {
+
+glm::mat4 viewProjection(const glm::vec3& eye) {
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    return projection * glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+const char* nameOf(math::Containment containment) {
+    switch (containment) {
+    case math::Containment::Outside: return "fuera";
+    case math::Containment::Intersect: return "corta";
+    case math::Containment::Inside: return "dentro";
+    }
+    return "?";
+}
+
+// Comprueba que el resultado es coherente con las 8 esquinas de la caja
+bool cornersAgree(const math::Frustum& frustum, const math::AABB& box, math::Containment containment) {
+    int inside = 0;
+    for (int corner = 0; corner < 8; corner++) {
+        const glm::vec3 p(
+            corner & 1 ? box.max.x : box.min.x,
+            corner & 2 ? box.max.y : box.min.y,
+            corner & 4 ? box.max.z : box.min.z);
+        inside += frustum.contains(p);
+    }
+
+    if (containment == math::Containment::Inside) {
+        return inside == 8;
+    }
+    if (containment == math::Containment::Outside) {
+        return inside == 0;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Los tests por lotes (AABB, esferas y OBB; con y sin caché de planos a lo
+ * largo de varios frames) deben dar la misma clasificación que los escalares.
+ */
+bool testFrustumBatchMatchesScalar() {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 8.0f);
+    std::uniform_real_distribution<float> angle(-3.0f, 3.0f);
+
+    constexpr size_t count = 1003;
+
+    std::vector<math::AABB> boxes;
+    math::AABBSoA boxSoA;
+    math::BoundingSphereSoA sphereSoA;
+    math::OBBSoA obbSoA;
+
+    for (size_t i = 0; i < count; i++) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        const glm::vec3 half(extent(rng), extent(rng), extent(rng));
+
+        boxes.push_back({ center - half, center + half });
+        boxSoA.add(boxes.back());
+        sphereSoA.add(math::BoundingSphere{ center, half.x });
+
+        math::OBB obb;
+        obb.center = center;
+        obb.axes = glm::mat3_cast(glm::quat(glm::vec3(angle(rng), angle(rng), angle(rng))));
+        obb.halfExtents = half;
+        obbSoA.add(obb);
+    }
+
+    std::vector<uint8_t> boxCache(math::Frustum::planeCacheSize(count), 0);
+    std::vector<uint8_t> sphereCache(math::Frustum::planeCacheSize(count), 0);
+    std::vector<uint8_t> obbCache(math::Frustum::planeCacheSize(count), 0);
+    std::vector<uint8_t> scalarCache(count, 0);
+
+    int counts[3] = { 0, 0, 0 };
+
+    // La cámara gira alrededor del origen para que la caché vaya cambiando
+    for (int frame = 0; frame < 6; frame++) {
+        const float a = frame * 0.7f;
+        const math::Frustum frustum(viewProjection(glm::vec3(40.0f * std::sin(a), 10.0f, 40.0f * std::cos(a))));
+
+        math::ContainmentMasks plain, cachedBoxes, cachedSpheres, cachedObbs, sphereMasks, obbMasks;
+        frustum.classify(boxSoA, plain);
+        frustum.classify(boxSoA, cachedBoxes, boxCache.data());
+        frustum.classify(sphereSoA, sphereMasks);
+        frustum.classify(sphereSoA, cachedSpheres, sphereCache.data());
+        frustum.classify(obbSoA, obbMasks);
+        frustum.classify(obbSoA, cachedObbs, obbCache.data());
+
+        for (size_t i = 0; i < count; i++) {
+            const math::Containment box = frustum.classify(boxes[i]);
+            const math::Containment boxCached = frustum.classify(boxes[i], &scalarCache[i]);
+            const math::Containment sphere = frustum.classify(sphereSoA.get(i));
+            const math::Containment obb = frustum.classify(obbSoA.get(i));
+
+            if (plain.get(i) != box || cachedBoxes.get(i) != box || boxCached != box ||
+                sphereMasks.get(i) != sphere || cachedSpheres.get(i) != sphere ||
+                obbMasks.get(i) != obb || cachedObbs.get(i) != obb) {
+                std::cerr
+                    << "[FAIL] Frustum por lotes: "
+                    << "clasificación distinta en el elemento " << i << " (frame " << frame << ")\n"
+                    << "  AABB: " << nameOf(box) << " / " << nameOf(plain.get(i))
+                    << " / " << nameOf(cachedBoxes.get(i)) << '\n';
+                return false;
+            }
+
+            if (!cornersAgree(frustum, boxes[i], box)) {
+                std::cerr
+                    << "[FAIL] Frustum por lotes: "
+                    << "la AABB " << i << " sale " << nameOf(box) << " pero sus esquinas no\n";
+                return false;
+            }
+
+            counts[static_cast<int>(box)]++;
+        }
+    }
+
+    // Que la escena de prueba cubra los tres casos
+    if (counts[0] == 0 || counts[1] == 0 || counts[2] == 0) {
+        std::cerr << "[FAIL] Frustum por lotes: la prueba no cubre los tres casos\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Frustum por lotes igual al escalar\n";
+
+    return true;
+}
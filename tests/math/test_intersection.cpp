@@ -1,6 +1,8 @@
 #include <iostream>
 #include <cmath>
 #include <cassert>
+#include <random>
+#include <vector>
 
 #include "math/intersection.hpp"
 
@@ -160,4 +162,346 @@ bool testRayParallelOutsideAABB() {
 
     return true;
 }
+
+/**
+ * Comprueba que la versión SoA (un rayo contra muchas cajas) da los mismos
+ * impactos y la misma caja más cercana que el test escalar, incluidos los
+ * casos de los tests anteriores y un número de cajas que no es múltiplo
+ * del ancho SIMD.
+ */
+bool testRayBatchMatchesScalar() {
+    const math::AABB unitBox{
+        glm::vec3(-1.0f, -1.0f, -1.0f),
+        glm::vec3(1.0f,  1.0f,  1.0f)
+    };
+
+    std::vector<math::Ray> rays = {
+        { glm::vec3(-5.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f) },
+        { glm::vec3(-5.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+        { glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) },
+        { glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f) },
+        { glm::vec3(-1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) }
+    };
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 3.0f);
+
+    for (int r = 0; r < 64; r++) {
+        rays.push_back({
+            glm::vec3(position(rng), position(rng), position(rng)),
+            glm::normalize(glm::vec3(position(rng), position(rng), position(rng)))
+        });
+    }
+
+    std::vector<math::AABB> boxes = { unitBox };
+    for (int b = 0; b < 1002; b++) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        const glm::vec3 half(extent(rng), extent(rng), extent(rng));
+        boxes.push_back({ center - half, center + half });
+    }
+
+    for (size_t count : { size_t(1), size_t(5), size_t(8), boxes.size() }) {
+        const std::vector<math::AABB> subset(boxes.begin(), boxes.begin() + count);
+        const math::AABBSoA soa(subset);
+
+        std::vector<uint64_t> mask(soa.maskWords());
+
+        for (const math::Ray& ray : rays) {
+            float batchDistance = -1.0f;
+            const size_t nearest = math::intersect(
+                math::makeRayInverse(ray), soa, batchDistance, mask.data());
+
+            size_t expectedNearest = math::AABBSoA::npos;
+            float expectedDistance = 0.0f;
+
+            for (size_t i = 0; i < count; i++) {
+                float distance = 0.0f;
+                const bool hit = math::intersect(ray, subset[i], distance);
+                const bool batchHit = (mask[i >> 6] >> (i & 63) & 1) != 0;
+
+                if (hit != batchHit) {
+                    std::cerr
+                        << "[FAIL] Rayo contra cajas SoA: "
+                        << "impacto distinto en la caja " << i << '\n';
+                    return false;
+                }
+
+                if (hit && (expectedNearest == math::AABBSoA::npos || distance < expectedDistance)) {
+                    expectedNearest = i;
+                    expectedDistance = distance;
+                }
+            }
+
+            for (size_t i = count; i < mask.size() * 64; i++) {
+                if ((mask[i >> 6] >> (i & 63) & 1) != 0) {
+                    std::cerr
+                        << "[FAIL] Rayo contra cajas SoA: "
+                        << "bit de relleno activo " << i << '\n';
+                    return false;
+                }
+            }
+
+            if (nearest != expectedNearest ||
+                (nearest != math::AABBSoA::npos &&
+                    std::abs(batchDistance - expectedDistance) >= 0.0001f)) {
+                std::cerr
+                    << "[FAIL] Rayo contra cajas SoA: "
+                    << "caja más cercana incorrecta\n"
+                    << "  Esperado: " << expectedNearest << " a " << expectedDistance << '\n'
+                    << "  Obtenido: " << nearest << " a " << batchDistance << '\n';
+                return false;
+            }
+        }
+    }
+
+    std::cout << "[PASS] Rayo contra cajas SoA\n";
+
+    return true;
+}
+
+namespace {
+
+// Möller–Trumbore en double. 'margin' es la distancia (en baricéntricas)
+// al borde más cercano, para saber si el caso es ambiguo en float.
+bool referenceTriangleHit(const math::Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    double& t, double& margin) {
+
+    const glm::dvec3 o(ray.origin);
+    const glm::dvec3 d(ray.direction);
+    const glm::dvec3 e1 = glm::dvec3(b) - glm::dvec3(a);
+    const glm::dvec3 e2 = glm::dvec3(c) - glm::dvec3(a);
+
+    const glm::dvec3 p = glm::cross(d, e2);
+    const double det = glm::dot(e1, p);
+    if (det == 0.0) {
+        margin = 0.0;
+        return false;
+    }
+
+    const glm::dvec3 s = o - glm::dvec3(a);
+    const double u = glm::dot(s, p) / det;
+    const glm::dvec3 q = glm::cross(s, e1);
+    const double v = glm::dot(d, q) / det;
+    t = glm::dot(e2, q) / det;
+
+    margin = std::min(std::min(std::abs(u), std::abs(v)), std::min(std::abs(1.0 - u - v), std::abs(t)));
+    return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0;
+}
+
+template <math::TriangleTest Test, math::HitMode Mode, int Width>
+bool checkBatch(const math::Ray& ray, const math::TriangleSoA& soa, size_t expected, double expectedT,
+    const std::vector<bool>& hits, const char* name) {
+
+    math::TriangleHit hit;
+    const size_t found = math::intersect<Test, Mode, Width>(ray, soa, hit);
+
+    bool ok;
+    if (Mode == math::HitMode::Closest) {
+        ok = found == expected &&
+            (found == math::TriangleSoA::npos || std::abs(hit.t - expectedT) <= 1e-4 * std::max(1.0, expectedT));
+    } else {
+        ok = (found == math::TriangleSoA::npos) == (expected == math::TriangleSoA::npos) &&
+            (found == math::TriangleSoA::npos || hits[found]);
+    }
+
+    if (!ok) {
+        std::cerr
+            << "[FAIL] Rayo contra triángulos: "
+            << name << " (" << Width << " carriles)\n"
+            << "  Esperado: " << expected << '\n'
+            << "  Obtenido: " << found << '\n';
+    }
+    return ok;
+}
+
+} // namespace
+
+/**
+ * Möller–Trumbore y el test estanco, en escalar y por lotes de 4 y 8
+ * triángulos, deben coincidir con una referencia en double en todos los
+ * casos que no están a menos de 1e-3 de un borde.
+ */
+bool testRayTriangleMatchesReference() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t t = 0; t < 301; t++) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        for (int k = 0; k < 3; k++) {
+            indices.push_back(static_cast<uint32_t>(positions.size()));
+            positions.push_back(center + glm::vec3(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+
+    const math::TriangleSoA soa(positions, indices);
+    const size_t triangleCount = soa.size();
+
+    int checkedRays = 0;
+
+    for (int r = 0; r < 2000; r++) {
+        const math::Ray ray{
+            glm::vec3(position(rng), position(rng), position(rng)),
+            glm::normalize(glm::vec3(position(rng), position(rng), position(rng)))
+        };
+
+        size_t expected = math::TriangleSoA::npos;
+        double expectedT = 0.0;
+        bool ambiguous = false;
+        std::vector<bool> hits(triangleCount, false);
+
+        for (size_t i = 0; i < triangleCount && !ambiguous; i++) {
+            const glm::vec3 a = soa.getVertex(i, 0);
+            const glm::vec3 b = soa.getVertex(i, 1);
+            const glm::vec3 c = soa.getVertex(i, 2);
+
+            double t = 0.0;
+            double margin = 0.0;
+            hits[i] = referenceTriangleHit(ray, a, b, c, t, margin);
+            if (margin < 1e-3) {
+                ambiguous = true;
+                break;
+            }
+
+            // Escalares
+            math::TriangleHit mt, woop;
+            const bool mtHit = math::intersectTriangle<math::TriangleTest::MollerTrumbore>(ray, a, b, c, mt);
+            const bool woopHit = math::intersectTriangle<math::TriangleTest::Watertight>(ray, a, b, c, woop);
+
+            if (mtHit != hits[i] || woopHit != hits[i] ||
+                (hits[i] && (std::abs(mt.t - t) > 1e-4 * std::max(1.0, t) ||
+                    std::abs(woop.t - t) > 1e-4 * std::max(1.0, t) ||
+                    std::abs(woop.u - mt.u) > 1e-4f || std::abs(woop.v - mt.v) > 1e-4f))) {
+                std::cerr
+                    << "[FAIL] Rayo contra triángulos: "
+                    << "test escalar distinto de la referencia\n";
+                return false;
+            }
+
+            if (hits[i] && (expected == math::TriangleSoA::npos || t < expectedT)) {
+                expected = i;
+                expectedT = t;
+            }
+        }
+
+        if (ambiguous) {
+            continue;
+        }
+        checkedRays++;
+
+        using math::HitMode;
+        using math::TriangleTest;
+
+        const bool ok =
+            checkBatch<TriangleTest::MollerTrumbore, HitMode::Closest, 4>(ray, soa, expected, expectedT, hits, "MT más cercano") &&
+            checkBatch<TriangleTest::MollerTrumbore, HitMode::Closest, 8>(ray, soa, expected, expectedT, hits, "MT más cercano") &&
+            checkBatch<TriangleTest::MollerTrumbore, HitMode::Any, 4>(ray, soa, expected, expectedT, hits, "MT cualquiera") &&
+            checkBatch<TriangleTest::MollerTrumbore, HitMode::Any, 8>(ray, soa, expected, expectedT, hits, "MT cualquiera") &&
+            checkBatch<TriangleTest::Watertight, HitMode::Closest, 4>(ray, soa, expected, expectedT, hits, "estanco más cercano") &&
+            checkBatch<TriangleTest::Watertight, HitMode::Closest, 8>(ray, soa, expected, expectedT, hits, "estanco más cercano") &&
+            checkBatch<TriangleTest::Watertight, HitMode::Any, 4>(ray, soa, expected, expectedT, hits, "estanco cualquiera") &&
+            checkBatch<TriangleTest::Watertight, HitMode::Any, 8>(ray, soa, expected, expectedT, hits, "estanco cualquiera");
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (checkedRays < 1000) {
+        std::cerr
+            << "[FAIL] Rayo contra triángulos: "
+            << "demasiados casos ambiguos (" << checkedRays << ")\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Rayo contra triángulos (referencia en double)\n";
+
+    return true;
+}
+
+/**
+ * Rayos dirigidos exactamente a vértices y aristas compartidas de una malla
+ * sin huecos: el test estanco debe encontrar siempre algún triángulo.
+ */
+bool testRayTriangleWatertight() {
+    constexpr int side = 12;
+
+    // Rejilla en un plano inclinado, con coordenadas que no son exactas en
+    // binario para que las funciones de arista se redondeen
+    auto vertexAt = [](float x, float y) {
+        return glm::vec3(x * 0.3f, y * 0.3f, 0.37f * x * 0.3f + 0.11f * y * 0.3f);
+    };
+
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (int y = 0; y <= side; y++) {
+        for (int x = 0; x <= side; x++) {
+            positions.push_back(vertexAt(float(x), float(y)));
+        }
+    }
+    for (int y = 0; y < side; y++) {
+        for (int x = 0; x < side; x++) {
+            const uint32_t a = y * (side + 1) + x;
+            indices.insert(indices.end(), { a, a + 1, a + side + 1, a + 1, a + side + 2, a + side + 1 });
+        }
+    }
+
+    const math::TriangleSoA soa(positions, indices);
+
+    const glm::vec3 directions[] = {
+        glm::normalize(glm::vec3(0.0f, 0.0f, -1.0f)),
+        glm::normalize(glm::vec3(0.13f, -0.07f, -1.0f)),
+        glm::normalize(glm::vec3(-0.41f, 0.29f, -1.0f))
+    };
+
+    int rays = 0;
+    int mollerMisses = 0;
+
+    // Vértices interiores y puntos medios de las aristas
+    for (int y = 2; y <= 2 * side - 2; y++) {
+        for (int x = 2; x <= 2 * side - 2; x++) {
+            const glm::vec3 target = vertexAt(x * 0.5f, y * 0.5f);
+
+            for (const glm::vec3& direction : directions) {
+                const math::Ray ray{ target - 7.0f * direction, direction };
+                rays++;
+
+                math::TriangleHit hit;
+                if (math::intersect<math::TriangleTest::Watertight, math::HitMode::Any, 8>(ray, soa, hit) ==
+                        math::TriangleSoA::npos ||
+                    math::intersect<math::TriangleTest::Watertight, math::HitMode::Closest, 4>(ray, soa, hit) ==
+                        math::TriangleSoA::npos) {
+                    std::cerr
+                        << "[FAIL] Test estanco: "
+                        << "el rayo hacia (" << x * 0.5f << ", " << y * 0.5f << ") "
+                        << "pasa entre triángulos\n";
+                    return false;
+                }
+
+                bool scalarHit = false;
+                for (size_t i = 0; i < soa.size() && !scalarHit; i++) {
+                    scalarHit = math::intersectTriangle<math::TriangleTest::Watertight>(
+                        ray, soa.getVertex(i, 0), soa.getVertex(i, 1), soa.getVertex(i, 2), hit);
+                }
+                if (!scalarHit) {
+                    std::cerr << "[FAIL] Test estanco: el test escalar deja un hueco\n";
+                    return false;
+                }
+
+                mollerMisses += math::intersect<math::TriangleTest::MollerTrumbore, math::HitMode::Any, 8>(
+                    ray, soa, hit) == math::TriangleSoA::npos;
+            }
+        }
+    }
+
+    std::cout
+        << "[PASS] Test estanco sin huecos (" << rays << " rayos; "
+        << "Möller–Trumbore falla en " << mollerMisses << ")\n";
+
+    return true;
+}
+
 // bool testRayParallelInsideAABB();
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "geometry/bvh.hpp"
+#include "math/ray_packet.hpp"
+
+namespace {
+
+// Möller–Trumbore en double, un rayo y un triángulo
+bool referenceHit(const math::Ray& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, double& t) {
+    const glm::dvec3 o(ray.origin);
+    const glm::dvec3 d(ray.direction);
+    const glm::dvec3 e1 = glm::dvec3(b) - glm::dvec3(a);
+    const glm::dvec3 e2 = glm::dvec3(c) - glm::dvec3(a);
+
+    const glm::dvec3 p = glm::cross(d, e2);
+    const double det = glm::dot(e1, p);
+    if (det == 0.0) {
+        return false;
+    }
+
+    const glm::dvec3 s = o - glm::dvec3(a);
+    const double u = glm::dot(s, p) / det;
+    const glm::dvec3 q = glm::cross(s, e1);
+    const double v = glm::dot(d, q) / det;
+    t = glm::dot(e2, q) / det;
+
+    return u >= 0.0 && v >= 0.0 && u + v <= 1.0 && t >= 0.0;
+}
+
+template <int N>
+bool checkPackets(
+    const std::vector<glm::vec3>& positions,
+    const std::vector<uint32_t>& indices,
+    const app::geometry::Bvh& bvh,
+    const std::vector<math::Ray>& rays) {
+
+    const size_t triangleCount = indices.size() / 3;
+
+    for (size_t first = 0; first < rays.size(); first += N) {
+        math::RayPacket<N> packet;
+        math::RayPacketHit<N> hit;
+
+        const int count = static_cast<int>(std::min<size_t>(N, rays.size() - first));
+        for (int lane = 0; lane < count; lane++) {
+            packet.setRay(lane, rays[first + lane]);
+        }
+
+        bvh.queryPacket(packet, [&](uint32_t triangle, int lanes) {
+            math::intersect(packet,
+                positions[indices[3 * triangle]],
+                positions[indices[3 * triangle + 1]],
+                positions[indices[3 * triangle + 2]],
+                triangle, hit, lanes);
+        });
+
+        for (int lane = 0; lane < count; lane++) {
+            const math::Ray& ray = rays[first + lane];
+
+            double bestT = std::numeric_limits<double>::infinity();
+            for (size_t triangle = 0; triangle < triangleCount; triangle++) {
+                double t;
+                if (referenceHit(ray,
+                    positions[indices[3 * triangle]],
+                    positions[indices[3 * triangle + 1]],
+                    positions[indices[3 * triangle + 2]], t) && t < bestT) {
+                    bestT = t;
+                }
+            }
+
+            const bool expectedHit = bestT != std::numeric_limits<double>::infinity();
+            const bool packetHit = hit.primitive[lane] != math::RayPacketHit<N>::kNoHit;
+
+            // Un rayo que roza una arista puede caer a un lado u otro según
+            // el redondeo; solo se exige coincidencia lejos de los bordes
+            if (expectedHit != packetHit) {
+                double t;
+                const glm::vec3 nudge(1e-4f);
+                const math::Ray shifted{ ray.origin + nudge, ray.direction };
+                bool ambiguous = false;
+                for (size_t triangle = 0; triangle < triangleCount && !ambiguous; triangle++) {
+                    ambiguous = referenceHit(shifted,
+                        positions[indices[3 * triangle]],
+                        positions[indices[3 * triangle + 1]],
+                        positions[indices[3 * triangle + 2]], t) != expectedHit;
+                }
+                if (ambiguous) {
+                    continue;
+                }
+
+                std::cerr
+                    << "[FAIL] Paquetes de rayos: "
+                    << "impacto distinto en el rayo " << first + lane
+                    << " (paquete de " << N << ")\n";
+                return false;
+            }
+
+            if (expectedHit && std::abs(packet.tMax[lane] - bestT) > 1e-3 * std::max(1.0, bestT)) {
+                std::cerr
+                    << "[FAIL] Paquetes de rayos: "
+                    << "distancia incorrecta en el rayo " << first + lane << '\n'
+                    << "  Esperado: " << bestT << '\n'
+                    << "  Obtenido: " << packet.tMax[lane] << '\n';
+                return false;
+            }
+        }
+
+        // Los carriles vacíos no deben tocarse
+        for (int lane = count; lane < N; lane++) {
+            if (hit.primitive[lane] != math::RayPacketHit<N>::kNoHit) {
+                std::cerr << "[FAIL] Paquetes de rayos: carril inactivo con impacto\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Los paquetes de 4 y 8 rayos recorriendo el BVH deben encontrar el mismo
+ * triángulo más cercano que una búsqueda exhaustiva rayo a rayo, y el
+ * frustum del paquete nunca debe descartar una caja que algún rayo corta.
+ */
+bool testRayPacketMatchesSingleRays() {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.8f, 0.8f);
+
+    // Sopa de triángulos aleatorios
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t t = 0; t < 2000; t++) {
+        const glm::vec3 center(position(rng), position(rng), position(rng));
+        for (int k = 0; k < 3; k++) {
+            indices.push_back(static_cast<uint32_t>(positions.size()));
+            positions.push_back(center + glm::vec3(offset(rng), offset(rng), offset(rng)));
+        }
+    }
+
+    const app::geometry::Bvh bvh = app::geometry::Bvh::fromTriangles(positions, indices);
+
+    // Rayos coherentes desde una cámara (rejilla) y 6 sueltos para
+    // probar paquetes incompletos
+    std::vector<math::Ray> rays;
+    const glm::vec3 eye(0.0f, 0.0f, -25.0f);
+    for (int y = 0; y < 24; y++) {
+        for (int x = 0; x < 24; x++) {
+            const glm::vec3 target((x - 11.5f) * 0.9f, (y - 11.5f) * 0.9f, 0.0f);
+            rays.push_back({ eye, glm::normalize(target - eye) });
+        }
+    }
+    for (int r = 0; r < 6; r++) {
+        rays.push_back({
+            glm::vec3(position(rng), position(rng), -20.0f),
+            glm::normalize(glm::vec3(offset(rng), offset(rng), 1.0f))
+        });
+    }
+
+    if (!checkPackets<4>(positions, indices, bvh, rays) ||
+        !checkPackets<8>(positions, indices, bvh, rays)) {
+        return false;
+    }
+
+    // Frustum conservador
+    for (size_t first = 0; first + 8 <= rays.size(); first += 8) {
+        math::RayPacket8 packet;
+        for (int lane = 0; lane < 8; lane++) {
+            packet.setRay(lane, rays[first + lane]);
+        }
+        const math::RayPacketFrustum frustum = math::makePacketFrustum(packet);
+
+        for (const app::geometry::BvhNode& node : bvh.getNodes()) {
+            if (math::intersect(packet, node.bounds) != 0 && !math::overlaps(frustum, node.bounds)) {
+                std::cerr
+                    << "[FAIL] Paquetes de rayos: "
+                    << "el frustum descarta una caja alcanzada\n";
+                return false;
+            }
+        }
+    }
+
+    std::cout << "[PASS] Paquetes de rayos contra BVH\n";
+
+    return true;
+}
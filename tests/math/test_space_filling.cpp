@@ -0,0 +1,88 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "math/space_filling.hpp"
+
+namespace {
+
+// Entrelazado bit a bit, la definición directa del código de Morton
+uint64_t referenceMorton(uint32_t x, uint32_t y, uint32_t z, int bits) {
+    uint64_t code = 0;
+    for (int bit = 0; bit < bits; bit++) {
+        code |= uint64_t((x >> bit) & 1) << (3 * bit);
+        code |= uint64_t((y >> bit) & 1) << (3 * bit + 1);
+        code |= uint64_t((z >> bit) & 1) << (3 * bit + 2);
+    }
+    return code;
+}
+
+} // namespace
+
+/**
+ * Morton debe coincidir con el entrelazado bit a bit. Hilbert debe ser una
+ * biyección de la rejilla en la que dos códigos consecutivos son siempre
+ * celdas vecinas, y a resolución completa conservar el orden de la curva
+ * de 10 bits en los bits altos.
+ */
+bool testSpaceFillingCurves() {
+    std::mt19937 rng(40);
+    std::uniform_int_distribution<uint32_t> coordinate(0, (1u << 21) - 1);
+
+    for (int i = 0; i < 100000; i++) {
+        const uint32_t x = coordinate(rng);
+        const uint32_t y = coordinate(rng);
+        const uint32_t z = coordinate(rng);
+
+        if (math::mortonCode63(x, y, z) != referenceMorton(x, y, z, 21)
+            || math::mortonCode30(x & 0x3ff, y & 0x3ff, z & 0x3ff) != referenceMorton(x & 0x3ff, y & 0x3ff, z & 0x3ff, 10)) {
+            std::cerr << "[FAIL] Código de Morton distinto del entrelazado de bits\n";
+            return false;
+        }
+
+        // Las celdas de 10 bits son prefijos de las de 21 en las dos curvas
+        if (math::hilbertCode63(x, y, z) >> 33 != math::hilbertCode30(x >> 11, y >> 11, z >> 11)
+            || math::mortonCode63(x, y, z) >> 33 != math::mortonCode30(x >> 11, y >> 11, z >> 11)) {
+            std::cerr << "[FAIL] Curvas de 30 y 63 bits incoherentes\n";
+            return false;
+        }
+    }
+
+    // Rejilla completa de 2^10 celdas por eje a 30 bits: se recorre entera
+    // con 2^30 códigos, así que se comprueba sobre la subrejilla de 2^4
+    // (los 12 bits altos de la curva de Hilbert recorren un cubo de 16^3)
+    constexpr uint32_t side = 16;
+    std::vector<glm::uvec3> cells(side * side * side, glm::uvec3(UINT32_MAX));
+
+    for (uint32_t x = 0; x < side; x++) {
+        for (uint32_t y = 0; y < side; y++) {
+            for (uint32_t z = 0; z < side; z++) {
+                const uint32_t code = math::hilbertCode30(x << 6, y << 6, z << 6) >> 18;
+                if (code >= cells.size() || cells[code].x != UINT32_MAX) {
+                    std::cerr << "[FAIL] Hilbert no es una biyección\n";
+                    return false;
+                }
+                cells[code] = glm::uvec3(x, y, z);
+            }
+        }
+    }
+
+    for (size_t i = 1; i < cells.size(); i++) {
+        const glm::ivec3 step = glm::ivec3(cells[i]) - glm::ivec3(cells[i - 1]);
+        if (std::abs(step.x) + std::abs(step.y) + std::abs(step.z) != 1) {
+            std::cerr << "[FAIL] Hilbert: códigos consecutivos en celdas no vecinas\n";
+            return false;
+        }
+    }
+
+    // Los puntos se cuantizan en la caja y los de fuera van al borde
+    const math::AABB box{ glm::vec3(-1.0f), glm::vec3(1.0f) };
+    if (math::quantize(glm::vec3(-5.0f, 0.0f, 5.0f), box, 10) != glm::uvec3(0, 512, 1023)) {
+        std::cerr << "[FAIL] quantize fuera de la caja\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Curvas de Morton y Hilbert\n";
+    return true;
+}
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "math/transform_batch.hpp"
+
+namespace {
+
+bool nearlyEqual(float a, float b, float tolerance) {
+    return std::abs(a - b) <= tolerance * std::max(1.0f, std::max(std::abs(a), std::abs(b)));
+}
+
+bool nearlyEqual(const glm::mat4& a, const glm::mat4& b, float tolerance) {
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            if (!nearlyEqual(a[column][row], b[column][row], tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Componer y descomponer por lotes debe dar lo mismo que getModelMatrix y
+ * setFromModelMatrix transformación a transformación, incluido el último
+ * bloque incompleto y rotaciones que pasan por los cuatro casos del
+ * cuaternión.
+ */
+bool testTransformBatchMatchesScalar() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.1f, 10.0f);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+
+    constexpr size_t count = 1003;
+
+    std::vector<Transform> transforms;
+    math::TransformSoA soa;
+
+    for (size_t i = 0; i < count; i++) {
+        Transform transform;
+        transform.position = glm::vec3(position(rng), position(rng), position(rng));
+        transform.rotation = glm::normalize(glm::quat(gaussian(rng), gaussian(rng), gaussian(rng), gaussian(rng)));
+        transform.scale = glm::vec3(scale(rng), scale(rng), scale(rng));
+
+        // Giros de 180° alrededor de cada eje: w = 0 y una sola componente
+        if (i < 3) {
+            transform.rotation = glm::quat(0.0f, float(i == 0), float(i == 1), float(i == 2));
+        }
+
+        transforms.push_back(transform);
+        soa.add(transform);
+    }
+
+    std::vector<glm::mat4> matrices(count);
+    std::vector<math::Affine3x4> affines(count);
+    math::composeModelMatrices(soa, matrices.data());
+    math::composeModelMatrices(soa, affines.data());
+
+    for (size_t i = 0; i < count; i++) {
+        const glm::mat4 expected = transforms[i].getModelMatrix();
+
+        if (!nearlyEqual(matrices[i], expected, 1e-5f)) {
+            std::cerr << "[FAIL] Transformaciones por lotes: matriz " << i << " distinta\n";
+            return false;
+        }
+
+        for (int row = 0; row < 3; row++) {
+            for (int column = 0; column < 4; column++) {
+                if (affines[i].rows[row][column] != matrices[i][column][row]) {
+                    std::cerr << "[FAIL] Transformaciones por lotes: filas 3x4 " << i << " distintas\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    math::TransformSoA decomposed;
+    math::decomposeModelMatrices(matrices.data(), count, decomposed);
+
+    if (decomposed.size() != count) {
+        std::cerr << "[FAIL] Transformaciones por lotes: descompuestas " << decomposed.size() << '\n';
+        return false;
+    }
+
+    int quaternionCases[4] = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; i++) {
+        Transform expected;
+        expected.setFromModelMatrix(matrices[i]);
+        const Transform actual = decomposed.get(i);
+
+        bool same = true;
+        for (int k = 0; k < 3; k++) {
+            same &= nearlyEqual(actual.position[k], expected.position[k], 1e-6f);
+            same &= nearlyEqual(actual.scale[k], expected.scale[k], 1e-5f);
+        }
+        for (int k = 0; k < 4; k++) {
+            same &= nearlyEqual(actual.rotation[k], expected.rotation[k], 1e-4f);
+        }
+
+        if (!same || !nearlyEqual(actual.getModelMatrix(), matrices[i], 1e-4f)) {
+            std::cerr << "[FAIL] Transformaciones por lotes: descomposición " << i << " distinta\n";
+            return false;
+        }
+
+        // Caso de quat_cast: la componente mayor en valor absoluto
+        int biggest = 0;
+        for (int k = 1; k < 4; k++) {
+            if (std::abs(actual.rotation[k]) > std::abs(actual.rotation[biggest])) {
+                biggest = k;
+            }
+        }
+        quaternionCases[biggest]++;
+    }
+
+    for (int cases : quaternionCases) {
+        if (cases == 0) {
+            std::cerr << "[FAIL] Transformaciones por lotes: la prueba no cubre los cuatro casos\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Transformaciones por lotes iguales a las escalares\n";
+
+    return true;
+}
+
+/**
+ * Con posiciones de obra (cientos de km) las matrices relativas a una
+ * cámara cercana deben conservar el milímetro, y descomponerlas con el
+ * mismo origen debe devolver las posiciones en double.
+ */
+bool testTransformCameraRelative() {
+    const glm::dvec3 site(512345.678, 812.25, 4712345.125);
+    const glm::dvec3 camera = site + glm::dvec3(3.0, 1.5, -7.0);
+
+    math::TransformSoA soa;
+    std::vector<Transform> transforms;
+
+    for (int i = 0; i < 7; i++) {
+        Transform transform;
+        transform.position = site + glm::dvec3(0.001 * i, -0.002 * i, 0.25 * i);
+        transform.scale = glm::vec3(1.0f + 0.1f * i);
+        transforms.push_back(transform);
+        soa.add(transform);
+    }
+
+    std::vector<glm::mat4> matrices(transforms.size());
+    std::vector<math::Affine3x4> affines(transforms.size());
+    math::composeModelMatrices(soa, matrices.data(), camera);
+    math::composeModelMatrices(soa, affines.data(), camera);
+
+    for (size_t i = 0; i < transforms.size(); i++) {
+        const glm::dvec3 expected = transforms[i].position - camera;
+        const glm::dvec3 batch(glm::vec3(matrices[i][3]));
+        const glm::dvec3 scalar(glm::vec3(transforms[i].getModelMatrix(camera)[3]));
+        const glm::dvec3 affine(affines[i].getTranslation());
+
+        if (glm::length(batch - expected) > 1e-6 ||
+            glm::length(scalar - expected) > 1e-6 ||
+            glm::length(affine - expected) > 1e-6) {
+            std::cerr << "[FAIL] Transformaciones relativas: traslación " << i << " imprecisa\n";
+            return false;
+        }
+    }
+
+    math::TransformSoA decomposed;
+    math::decomposeModelMatrices(matrices.data(), matrices.size(), decomposed, camera);
+
+    for (size_t i = 0; i < transforms.size(); i++) {
+        if (glm::length(decomposed.get(i).position - transforms[i].position) > 1e-6) {
+            std::cerr << "[FAIL] Transformaciones relativas: posición " << i << " imprecisa\n";
+            return false;
+        }
+    }
+
+    // Referencia: la matriz absoluta en float no distingue milímetros aquí
+    const glm::dvec3 absolute(glm::vec3(transforms[1].getModelMatrix()[3]));
+    if (glm::length(absolute - transforms[1].position) < 1e-3) {
+        std::cerr << "[FAIL] Transformaciones relativas: la prueba no ejercita la precisión\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Transformaciones relativas a la cámara\n";
+
+    return true;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+
+#include "render/gl_state_cache.hpp"
+
+#include "../gl_stubs.hpp"
+
+namespace {
+
+// Sin contexto de OpenGL: los punteros de glad apuntan a funciones que solo
+// cuentan las llamadas que llegarían al driver
+int driverCalls = 0;
+
+void APIENTRY countUseProgram(GLuint) { driverCalls++; }
+void APIENTRY countBindVertexArray(GLuint) { driverCalls++; }
+void APIENTRY countBindBuffer(GLenum, GLuint) { driverCalls++; }
+void APIENTRY countBindBufferBase(GLenum, GLuint, GLuint) { driverCalls++; }
+void APIENTRY countEnable(GLenum) { driverCalls++; }
+void APIENTRY countPolygonMode(GLenum, GLenum) { driverCalls++; }
+void APIENTRY countLineWidth(GLfloat) { driverCalls++; }
+void APIENTRY countDepthFunc(GLenum) { driverCalls++; }
+void APIENTRY countUniform1i(GLint, GLint) { driverCalls++; }
+
+} // namespace
+
+/**
+ * La caché de estado solo debe dejar pasar al driver los cambios reales,
+ * olvidar los bindings (y no el resto) con invalidateBindings, recordar los
+ * uniformes de cada programa al cambiar de uno a otro, y contar por frame
+ * las llamadas hechas y las evitadas.
+ */
+bool testGLStateCacheFiltersRedundantCalls() {
+    GLStubs gl;
+    gl.set(glad_glUseProgram, countUseProgram);
+    gl.set(glad_glBindVertexArray, countBindVertexArray);
+    gl.set(glad_glBindBuffer, countBindBuffer);
+    gl.set(glad_glBindBufferBase, countBindBufferBase);
+    gl.set(glad_glEnable, countEnable);
+    gl.set(glad_glDisable, countEnable);
+    gl.set(glad_glPolygonMode, countPolygonMode);
+    gl.set(glad_glLineWidth, countLineWidth);
+    gl.set(glad_glDepthFunc, countDepthFunc);
+    gl.set(glad_glUniform1i, countUniform1i);
+
+    render::GLStateCache state;
+    const render::UniformHandle<bool> flag(2);
+
+    // Dos frames iguales: el segundo solo repite lo que se olvida
+    for (int frame = 0; frame < 2; frame++) {
+        state.beginFrame();
+        state.invalidateBindings();
+
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.depthFunc(GL_LESS);
+
+        state.useProgram(3);
+        state.setUniform(flag, true);
+        state.setUniform(flag, true);
+
+        state.bindUniformBuffer(0, 10);
+        state.bindUniformBuffer(1, 11);
+        state.bindUniformBuffer(0, 10);
+
+        for (GLuint vertexArray : { 5u, 5u, 6u, 6u }) {
+            state.bindVertexArray(vertexArray);
+            state.bindArrayBuffer(20);
+            state.polygonMode(GL_FILL);
+        }
+
+        state.polygonMode(GL_LINE);
+        state.lineWidth(2.0f);
+        state.polygonMode(GL_FILL);
+        state.lineWidth(1.0f);
+
+        // Otro programa y vuelta: el uniforme del primero sigue igual
+        state.useProgram(4);
+        state.useProgram(3);
+        state.setUniform(flag, true);
+        state.setUniform(flag, false);
+    }
+    state.beginFrame();
+
+    // Hechas en el segundo frame: el programa 3 (1), el uniforme a true y
+    // luego a false (2), los dos buffers uniformes (2), los VAOs 5 y 6 (2),
+    // el array buffer (1), LINE y FILL (2), los dos grosores (2) y los
+    // programas 4 y 3 (2). De 29 llamadas en total
+    const int expectedIssued = 1 + 2 + 2 + 2 + 1 + 2 + 2 + 2;
+    const render::GLStateStats& stats = state.getFrameStats();
+
+    driverCalls = 0;
+    state.lineWidth(1.0f);
+    state.setEnabled(GL_DEPTH_TEST, true);
+    const bool nothingIssued = driverCalls == 0;
+
+    const bool ok = stats.issued == size_t(expectedIssued)
+        && stats.issued + stats.filtered == 29
+        && nothingIssued;
+
+    if (!ok) {
+        std::cerr << "[FAIL] Caché de estado GL: " << stats.issued << " hechas, "
+            << stats.filtered << " evitadas\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Caché de estado GL sin llamadas redundantes\n";
+    return true;
+}
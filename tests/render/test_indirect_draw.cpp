@@ -0,0 +1,193 @@
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "render/gl_state_cache.hpp"
+#include "render/indirect_draw.hpp"
+#include "render/instance_buffer.hpp"
+#include "render/stream_buffer.hpp"
+
+#include "../gl_stubs.hpp"
+
+namespace {
+
+// Sin contexto de OpenGL: los punteros de glad apuntan a funciones que
+// apuntan lo que dibujaría el driver, ya resuelto a (índices, primer índice,
+// vértice base, primera instancia, instancias)
+using Draw = std::tuple<uint32_t, uint32_t, int32_t, uint32_t, uint32_t>;
+
+std::vector<Draw> drawn;
+std::vector<unsigned char> streamStorage;
+size_t attributeBase = 0;
+int drawCalls = 0;
+
+void APIENTRY stubGenBuffers(GLsizei count, GLuint* buffers) {
+    for (GLsizei i = 0; i < count; i++) {
+        buffers[i] = 7;
+    }
+}
+void APIENTRY stubDeleteBuffers(GLsizei, const GLuint*) {}
+void APIENTRY stubBindBuffer(GLenum, GLuint) {}
+
+// El StreamBuffer (sin mapeo persistente) en memoria
+void APIENTRY stubBufferData(GLenum, GLsizeiptr size, const void*, GLenum) {
+    streamStorage.assign(static_cast<size_t>(size), 0);
+}
+void* APIENTRY stubMapBufferRange(GLenum, GLintptr offset, GLsizeiptr, GLbitfield) {
+    return streamStorage.data() + offset;
+}
+GLboolean APIENTRY stubUnmapBuffer(GLenum) { return GL_TRUE; }
+GLsync APIENTRY stubFenceSync(GLenum, GLbitfield) { return reinterpret_cast<GLsync>(size_t(1)); }
+void APIENTRY stubDeleteSync(GLsync) {}
+GLenum APIENTRY stubClientWaitSync(GLsync, GLbitfield, GLuint64) { return GL_ALREADY_SIGNALED; }
+
+void APIENTRY stubVertexAttribPointer(GLuint location, GLint, GLenum, GLboolean, GLsizei stride, const void* pointer) {
+    // La primera fila de la matriz marca dónde empiezan las instancias
+    if (location == 2) {
+        attributeBase = reinterpret_cast<size_t>(pointer) / static_cast<size_t>(stride);
+    }
+}
+void APIENTRY stubVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) {}
+void APIENTRY stubVertexAttribDivisor(GLuint, GLuint) {}
+void APIENTRY stubEnableVertexAttribArray(GLuint) {}
+
+void APIENTRY stubDrawElementsInstancedBaseVertex(GLenum, GLsizei count, GLenum, const void* indices, GLsizei instances, GLint baseVertex) {
+    const uint32_t firstIndex = static_cast<uint32_t>(reinterpret_cast<size_t>(indices) / sizeof(uint32_t));
+    drawn.emplace_back(uint32_t(count), firstIndex, baseVertex, uint32_t(attributeBase), uint32_t(instances));
+    drawCalls++;
+}
+
+void APIENTRY stubMultiDrawElementsIndirect(GLenum, GLenum, const void* indirect, GLsizei count, GLsizei) {
+    const size_t offset = reinterpret_cast<size_t>(indirect);
+    for (size_t i = 0; i < static_cast<size_t>(count); i++) {
+        render::DrawElementsIndirectCommand command;
+        std::memcpy(&command, streamStorage.data() + offset + i * sizeof(command), sizeof(command));
+        drawn.emplace_back(
+            command.count,
+            command.firstIndex,
+            command.baseVertex,
+            uint32_t(attributeBase + command.baseInstance),
+            command.instanceCount);
+    }
+    drawCalls++;
+}
+
+// Dibuja los comandos en pases como Renderer::drawQueue y devuelve lo dibujado
+std::vector<Draw> drawPasses(bool multiDraw, const std::vector<render::DrawElementsIndirectCommand>& commands, const std::vector<size_t>& passes) {
+    render::GLStateCache state;
+    render::StreamBuffer stream;
+    render::InstanceBuffer instances;
+    render::IndirectDrawBuffer buffer;
+
+    buffer.setMultiDraw(multiDraw);
+    if (buffer.usesMultiDraw() != multiDraw) {
+        return {};
+    }
+
+    // Las instancias primero, como en Renderer::render: los comandos no
+    // empiezan al principio de la región
+    stream.beginFrame(1000);
+    instances.allocate(stream, 3);
+
+    buffer.clear();
+    for (const render::DrawElementsIndirectCommand& command : commands) {
+        buffer.add(command);
+    }
+    if (!buffer.upload(stream)) {
+        return {};
+    }
+    stream.flush();
+
+    drawn.clear();
+    drawCalls = 0;
+    size_t first = 0;
+    for (size_t end : passes) {
+        buffer.draw(state, instances, first, end - first);
+        first = end;
+    }
+    stream.endFrame();
+
+    // Las cuentas salen al empezar el frame siguiente
+    buffer.clear();
+    const render::IndirectDrawStats& stats = buffer.getFrameStats();
+    if (stats.commands != commands.size() || stats.calls != size_t(drawCalls)) {
+        return {};
+    }
+    return drawn;
+}
+
+} // namespace
+
+/**
+ * El camino de glMultiDrawElementsIndirect y el bucle de OpenGL 4.1 deben
+ * dibujar lo mismo a partir del mismo array de comandos: el primero con una
+ * llamada por pase y el segundo con una por comando.
+ */
+bool testIndirectDrawMatchesFallback() {
+    GLStubs gl;
+    gl.set(glad_glGenBuffers, stubGenBuffers);
+    gl.set(glad_glDeleteBuffers, stubDeleteBuffers);
+    gl.set(glad_glBindBuffer, stubBindBuffer);
+    gl.set(glad_glBufferData, stubBufferData);
+    gl.set(glad_glMapBufferRange, stubMapBufferRange);
+    gl.set(glad_glUnmapBuffer, stubUnmapBuffer);
+    gl.set(glad_glFenceSync, stubFenceSync);
+    gl.set(glad_glDeleteSync, stubDeleteSync);
+    gl.set(glad_glClientWaitSync, stubClientWaitSync);
+    gl.set(glad_glVertexAttribPointer, stubVertexAttribPointer);
+    gl.set(glad_glVertexAttribIPointer, stubVertexAttribIPointer);
+    gl.set(glad_glVertexAttribDivisor, stubVertexAttribDivisor);
+    gl.set(glad_glEnableVertexAttribArray, stubEnableVertexAttribArray);
+    gl.set(glad_glDrawElementsInstancedBaseVertex, stubDrawElementsInstancedBaseVertex);
+    gl.set(glad_glMultiDrawElementsIndirect, stubMultiDrawElementsIndirect);
+
+    // Lotes seguidos en el buffer de instancias, como los deja la cola
+    std::mt19937 rng(47);
+    std::vector<render::DrawElementsIndirectCommand> commands(40);
+    uint32_t nextInstance = 0;
+    for (render::DrawElementsIndirectCommand& command : commands) {
+        command.count = 36 * (1 + rng() % 4);
+        command.instanceCount = 1 + rng() % 100;
+        command.firstIndex = 4 * (rng() % 1000);
+        command.baseVertex = static_cast<int32_t>(rng() % 5000);
+        command.baseInstance = nextInstance;
+        nextInstance += command.instanceCount;
+    }
+    const std::vector<size_t> passes = { 31, 31, 40 };
+
+    // Sin las extensiones no se puede elegir el camino indirecto
+    gl.set(GLAD_GL_ARB_multi_draw_indirect, 0);
+    gl.set(GLAD_GL_ARB_base_instance, 0);
+    const std::vector<Draw> fallback = drawPasses(false, commands, passes);
+    const int fallbackCalls = drawCalls;
+    const bool refused = drawPasses(true, commands, passes).empty();
+
+    GLAD_GL_ARB_multi_draw_indirect = 1;
+    GLAD_GL_ARB_base_instance = 1;
+    const std::vector<Draw> multiDraw = drawPasses(true, commands, passes);
+    const int multiDrawCalls = drawCalls;
+
+    if (!refused || fallback.size() != commands.size() || multiDraw != fallback) {
+        std::cerr << "[FAIL] Dibujo indirecto distinto del bucle de OpenGL 4.1\n";
+        return false;
+    }
+
+    for (size_t i = 0; i < commands.size(); i++) {
+        if (std::get<3>(fallback[i]) != commands[i].baseInstance) {
+            std::cerr << "[FAIL] Dibujo indirecto: instancias desplazadas en el bucle\n";
+            return false;
+        }
+    }
+
+    // Una llamada por comando, o por pase con comandos (el del medio está
+    // vacío)
+    if (fallbackCalls != int(commands.size()) || multiDrawCalls != 2) {
+        std::cerr << "[FAIL] Dibujo indirecto: llamadas de más\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Dibujo indirecto igual que el bucle de OpenGL 4.1\n";
+    return true;
+}
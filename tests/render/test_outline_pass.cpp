@@ -0,0 +1,173 @@
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "render/gl_state_cache.hpp"
+#include "render/outline_pass.hpp"
+
+#include "../gl_stubs.hpp"
+
+namespace {
+
+// Sin contexto de OpenGL: se apunta qué textura lleva cada framebuffer y,
+// en cada glDrawArrays, en qué framebuffer se escribe, qué textura se lee y
+// si hay mezcla
+struct FullscreenDraw {
+    GLuint framebuffer;
+    GLuint texture;
+    bool blend;
+};
+
+std::vector<FullscreenDraw> draws;
+std::map<GLuint, GLuint> attachments;
+GLuint nextName = 1;
+GLuint boundFramebuffer = 0;
+GLuint boundTexture = 0;
+bool blend = false;
+bool depthTest = true;
+std::vector<GLuint> cleared;
+
+void APIENTRY stubGenNames(GLsizei count, GLuint* names) {
+    for (GLsizei i = 0; i < count; i++) {
+        names[i] = nextName++;
+    }
+}
+void APIENTRY stubDeleteNames(GLsizei, const GLuint*) {}
+void APIENTRY stubBindTexture(GLenum, GLuint texture) { boundTexture = texture; }
+void APIENTRY stubTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+void APIENTRY stubTexParameteri(GLenum, GLenum, GLint) {}
+void APIENTRY stubBindFramebuffer(GLenum, GLuint framebuffer) { boundFramebuffer = framebuffer; }
+void APIENTRY stubFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint texture, GLint) {
+    attachments[boundFramebuffer] = texture;
+}
+GLenum APIENTRY stubCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+void APIENTRY stubClearBufferuiv(GLenum, GLint, const GLuint* value) {
+    if (value[0] == render::OutlinePass::kNoSeed && value[1] == render::OutlinePass::kNoSeed) {
+        cleared.push_back(boundFramebuffer);
+    }
+}
+void APIENTRY stubActiveTexture(GLenum) {}
+void APIENTRY stubUseProgram(GLuint) {}
+void APIENTRY stubBindVertexArray(GLuint) {}
+void APIENTRY stubBlendFunc(GLenum, GLenum) {}
+void APIENTRY stubEnable(GLenum capability) {
+    blend |= capability == GL_BLEND;
+    depthTest |= capability == GL_DEPTH_TEST;
+}
+void APIENTRY stubDisable(GLenum capability) {
+    blend &= capability != GL_BLEND;
+    depthTest &= capability != GL_DEPTH_TEST;
+}
+void APIENTRY stubDrawArrays(GLenum, GLint, GLsizei) {
+    draws.push_back({ boundFramebuffer, boundTexture, blend });
+}
+
+// Máscara, saltos y composición sobre 'target' con el grosor dado; comprueba
+// que cada pasada lee lo que escribió la anterior
+bool floods(render::OutlinePass& outline, render::GLStateCache& state, GLuint target, float width) {
+    draws.clear();
+    cleared.clear();
+    boundFramebuffer = target;
+
+    bool ok = outline.beginMask(state);
+    const GLuint mask = boundFramebuffer;
+    ok &= cleared.size() == 1 && cleared[0] == mask && mask != target;
+    ok &= !depthTest;
+
+    outline.endMask(state, target, width);
+    ok &= boundFramebuffer == target && depthTest;
+
+    // Una pasada por paso: k, k/2, ..., 1
+    size_t steps = 0;
+    for (int step = render::OutlinePass::getFirstJumpStep(width); step >= 1; step /= 2) {
+        steps++;
+    }
+    ok &= draws.size() == steps;
+
+    GLuint written = attachments[mask];
+    for (const FullscreenDraw& draw : draws) {
+        ok &= draw.texture == written && attachments[draw.framebuffer] != written && !draw.blend;
+        written = attachments[draw.framebuffer];
+    }
+
+    // La composición lee el último salto y escribe, mezclando, en el destino
+    outline.composite(state);
+    ok &= draws.size() == steps + 1;
+    ok &= draws.back().framebuffer == target && draws.back().texture == written && draws.back().blend;
+    ok &= !blend && depthTest;
+
+    // Hasta la siguiente máscara no hay nada que componer
+    outline.composite(state);
+    ok &= draws.size() == steps + 1;
+    return ok;
+}
+
+} // namespace
+
+/**
+ * El contorno por jump flooding debe hacer las pasadas justas para su
+ * grosor, alternando las dos texturas de semillas sin leer y escribir la
+ * misma, y componer el último resultado sobre el framebuffer del viewport
+ * una sola vez por máscara.
+ */
+bool testOutlinePassPingPongs() {
+    GLStubs gl;
+    gl.set(glad_glGenTextures, stubGenNames);
+    gl.set(glad_glDeleteTextures, stubDeleteNames);
+    gl.set(glad_glGenFramebuffers, stubGenNames);
+    gl.set(glad_glDeleteFramebuffers, stubDeleteNames);
+    gl.set(glad_glDeleteVertexArrays, stubDeleteNames);
+    gl.set(glad_glBindTexture, stubBindTexture);
+    gl.set(glad_glTexImage2D, stubTexImage2D);
+    gl.set(glad_glTexParameteri, stubTexParameteri);
+    gl.set(glad_glBindFramebuffer, stubBindFramebuffer);
+    gl.set(glad_glFramebufferTexture2D, stubFramebufferTexture2D);
+    gl.set(glad_glCheckFramebufferStatus, stubCheckFramebufferStatus);
+    gl.set(glad_glClearBufferuiv, stubClearBufferuiv);
+    gl.set(glad_glActiveTexture, stubActiveTexture);
+    gl.set(glad_glUseProgram, stubUseProgram);
+    gl.set(glad_glBindVertexArray, stubBindVertexArray);
+    gl.set(glad_glBlendFunc, stubBlendFunc);
+    gl.set(glad_glEnable, stubEnable);
+    gl.set(glad_glDisable, stubDisable);
+    gl.set(glad_glDrawArrays, stubDrawArrays);
+
+    bool ok = true;
+
+    // 2k - 1 debe llegar al grosor más el píxel de transición
+    ok &= render::OutlinePass::getFirstJumpStep(0.0f) == 1;
+    ok &= render::OutlinePass::getFirstJumpStep(1.0f) == 2;
+    ok &= render::OutlinePass::getFirstJumpStep(2.5f) == 4;
+    ok &= render::OutlinePass::getFirstJumpStep(3.0f) == 4;
+    ok &= render::OutlinePass::getFirstJumpStep(4.0f) == 4;
+    ok &= render::OutlinePass::getFirstJumpStep(6.0f) == 4;
+    ok &= render::OutlinePass::getFirstJumpStep(7.0f) == 8;
+    ok &= render::OutlinePass::getFirstJumpStep(1000.0f) == render::OutlinePass::getFirstJumpStep(render::OutlinePass::kMaxWidth);
+
+    {
+        render::GLStateCache state;
+        render::OutlinePass outline;
+
+        // Sin texturas no hay máscara
+        ok &= !outline.beginMask(state);
+        ok &= !outline.resize(0, 480);
+
+        ok &= outline.resize(640, 480);
+        ok &= outline.width() == 640 && outline.height() == 480;
+
+        ok &= floods(outline, state, 100, 3.0f);
+        ok &= floods(outline, state, 100, 1.0f);
+
+        // Al cambiar de tamaño se recrean las texturas
+        ok &= outline.resize(800, 600);
+        ok &= floods(outline, state, 200, 10.0f);
+    }
+
+    if (!ok) {
+        std::cerr << "[FAIL] Contorno por jump flooding\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Contorno por jump flooding\n";
+    return true;
+}
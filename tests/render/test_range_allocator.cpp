@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "render/range_allocator.hpp"
+
+namespace {
+
+using render::RangeAllocator;
+
+struct LiveRange {
+    RangeAllocator::Handle handle;
+    size_t alignment;
+};
+
+// Sin solapes, dentro de la capacidad, alineados y con las estadísticas
+// iguales a los huecos que quedan entre los rangos vivos
+bool consistent(const RangeAllocator& allocator, const std::vector<LiveRange>& live) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t used = 0;
+    for (const LiveRange& range : live) {
+        const size_t offset = allocator.getOffset(range.handle);
+        if (offset % range.alignment != 0) {
+            return false;
+        }
+        ranges.emplace_back(offset, allocator.getSize(range.handle));
+        used += allocator.getSize(range.handle);
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    size_t cursor = 0;
+    size_t holes = 0;
+    size_t largest = 0;
+    auto hole = [&](size_t size) {
+        if (size > 0) {
+            holes++;
+            largest = std::max(largest, size);
+        }
+    };
+    for (const auto& range : ranges) {
+        if (range.first < cursor) {
+            return false;
+        }
+        hole(range.first - cursor);
+        cursor = range.first + range.second;
+    }
+    if (cursor > allocator.getCapacity()) {
+        return false;
+    }
+    hole(allocator.getCapacity() - cursor);
+
+    const render::ArenaStats stats = allocator.getStats();
+    return stats.used == used
+        && stats.allocations == live.size()
+        && stats.freeBlocks == holes
+        && stats.largestFreeBlock == largest;
+}
+
+} // namespace
+
+/**
+ * Reservas y liberaciones aleatorias (con alineación y crecimiento) deben
+ * dejar siempre rangos disjuntos y unas estadísticas que cuadren con los
+ * huecos reales. Después de defragment, las copias que devuelve deben
+ * llevar el contenido de cada rango a su nueva posición, sin huecos.
+ */
+bool testRangeAllocatorConsistency() {
+    std::mt19937 rng(42);
+    RangeAllocator allocator(4096);
+    std::vector<LiveRange> live;
+
+    // Contenido simulado del buffer: el handle dueño de cada elemento
+    std::vector<uint32_t> buffer(allocator.getCapacity(), RangeAllocator::kInvalidHandle);
+
+    for (int step = 0; step < 20000; step++) {
+        if (live.empty() || rng() % 100 < 55) {
+            const size_t size = 1 + rng() % 200;
+            const size_t alignment = (rng() % 3 == 0) ? 4 : 1;
+
+            RangeAllocator::Handle handle = allocator.allocate(size, alignment);
+            if (handle == RangeAllocator::kInvalidHandle) {
+                allocator.grow(allocator.getCapacity() * 2);
+                buffer.resize(allocator.getCapacity(), RangeAllocator::kInvalidHandle);
+                handle = allocator.allocate(size, alignment);
+            }
+            if (handle == RangeAllocator::kInvalidHandle) {
+                std::cerr << "[FAIL] RangeAllocator sin hueco tras crecer\n";
+                return false;
+            }
+
+            std::fill_n(buffer.begin() + allocator.getOffset(handle), size, handle);
+            live.push_back({ handle, alignment });
+        } else {
+            const size_t index = rng() % live.size();
+            allocator.release(live[index].handle);
+            live[index] = live.back();
+            live.pop_back();
+        }
+
+        if (step % 97 == 0 && !consistent(allocator, live)) {
+            std::cerr << "[FAIL] RangeAllocator inconsistente en el paso " << step << '\n';
+            return false;
+        }
+
+        if (step % 5000 == 4999) {
+            const render::ArenaStats before = allocator.getStats();
+
+            std::vector<uint32_t> compacted(buffer.size(), RangeAllocator::kInvalidHandle);
+            for (const render::RangeMove& move : allocator.defragment()) {
+                std::copy_n(buffer.begin() + move.from, move.size, compacted.begin() + move.to);
+            }
+            buffer.swap(compacted);
+
+            for (const LiveRange& range : live) {
+                const size_t offset = allocator.getOffset(range.handle);
+                for (size_t i = 0; i < allocator.getSize(range.handle); i++) {
+                    if (buffer[offset + i] != range.handle) {
+                        std::cerr << "[FAIL] defragment no conserva el contenido\n";
+                        return false;
+                    }
+                }
+            }
+
+            const render::ArenaStats after = allocator.getStats();
+            if (!consistent(allocator, live) || after.used != before.used
+                || after.largestFreeBlock < before.largestFreeBlock) {
+                std::cerr << "[FAIL] defragment inconsistente\n";
+                return false;
+            }
+        }
+    }
+
+    std::cout << "[PASS] RangeAllocator sin solapes y estadísticas exactas\n";
+    return true;
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "render/render_queue.hpp"
+
+namespace {
+
+using render::RenderPass;
+namespace draw_key = render::draw_key;
+
+bool keysRoundTrip() {
+    for (bool translucent : { false, true }) {
+        const uint64_t key = draw_key::encode(RenderPass::Overlay, translucent, 200, 5000, 60000, 12.5f);
+
+        if (draw_key::getPass(key) != RenderPass::Overlay
+            || draw_key::isTranslucent(key) != translucent
+            || draw_key::getProgram(key) != 200
+            || draw_key::getMaterial(key) != 5000
+            || draw_key::getMesh(key) != 60000) {
+            return false;
+        }
+    }
+
+    // Profundidad monótona, y lo de detrás de la cámara al principio
+    return draw_key::quantizeDepth(-3.0f) == 0
+        && draw_key::quantizeDepth(0.01f) < draw_key::quantizeDepth(0.02f)
+        && draw_key::quantizeDepth(1.0f) < draw_key::quantizeDepth(1000.0f);
+}
+
+bool orderIsRespected() {
+    render::RenderQueue queue;
+    queue.push(draw_key::encode(RenderPass::Overlay, false, 0, 0, 1, 1.0f), 0, 1);
+    queue.push(draw_key::encode(RenderPass::Opaque, true, 0, 0, 1, 1.0f), 1, 1);
+    queue.push(draw_key::encode(RenderPass::Opaque, true, 0, 0, 2, 9.0f), 2, 2);
+    queue.push(draw_key::encode(RenderPass::Opaque, false, 0, 0, 2, 1.0f), 3, 2);
+    queue.push(draw_key::encode(RenderPass::Opaque, false, 0, 0, 1, 5.0f), 4, 1);
+    queue.push(draw_key::encode(RenderPass::Opaque, false, 0, 0, 1, 2.0f), 5, 1);
+    queue.sort();
+
+    // Opacos por malla y de cerca a lejos, translúcidos de lejos a cerca y
+    // el overlay al final
+    const uint32_t expected[] = { 5, 4, 3, 2, 1, 0 };
+    for (size_t i = 0; i < queue.size(); i++) {
+        if (queue.getDraws()[i].object != expected[i]) {
+            return false;
+        }
+    }
+
+    // La malla 1 opaca es un solo lote con dos dibujos
+    return queue.getBatches().size() == 5 && queue.getBatches()[0].count == 2;
+}
+
+bool parallelFillMatchesSerial(size_t count) {
+    std::mt19937 rng(static_cast<uint32_t>(count));
+    std::uniform_real_distribution<float> depth(-10.0f, 1000.0f);
+
+    std::vector<uint64_t> keys(count);
+    std::vector<uint32_t> meshes(count);
+    for (size_t i = 0; i < count; i++) {
+        meshes[i] = rng() % 9;
+        const RenderPass pass = rng() % 8 == 0 ? RenderPass::Overlay : RenderPass::Opaque;
+        keys[i] = draw_key::encode(pass, rng() % 4 == 0, rng() % 3, 0, meshes[i], depth(rng));
+    }
+
+    render::RenderQueue serial;
+    render::RenderQueue parallel;
+
+    for (size_t i = 0; i < count; i++) {
+        if (i % 5 != 0) {
+            serial.push(keys[i], uint32_t(i), meshes[i], uint32_t(i));
+        }
+    }
+    parallel.fill(count, [&](size_t i, render::RenderQueue::Writer& writer) {
+        if (i % 5 != 0) {
+            writer.push(keys[i], uint32_t(i), meshes[i], uint32_t(i));
+        }
+    });
+
+    serial.sort();
+    parallel.sort();
+
+    if (serial.getKeys() != parallel.getKeys() || serial.getBatches().size() != parallel.getBatches().size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < serial.size(); i++) {
+        const render::QueuedDraw& a = serial.getDraws()[i];
+        const render::QueuedDraw& b = parallel.getDraws()[i];
+        if (a.object != b.object || a.flags != b.flags || keys[a.object] != serial.getKeys()[i]) {
+            return false;
+        }
+        if (i > 0 && serial.getKeys()[i - 1] > serial.getKeys()[i]) {
+            return false;
+        }
+    }
+
+    // Lotes contiguos, cada uno con un solo estado y una sola malla
+    uint32_t next = 0;
+    for (const render::DrawBatch& batch : parallel.getBatches()) {
+        if (batch.first != next || batch.count == 0) {
+            return false;
+        }
+        for (uint32_t i = batch.first; i < batch.first + batch.count; i++) {
+            if (draw_key::getState(parallel.getKeys()[i]) != draw_key::getState(batch.key)
+                || parallel.getDraws()[i].mesh != parallel.getDraws()[batch.first].mesh) {
+                return false;
+            }
+        }
+        next += batch.count;
+    }
+    return next == parallel.size();
+}
+
+} // namespace
+
+/**
+ * La clave de dibujo conserva sus campos y ordena por pase, translucidez,
+ * estado y profundidad; la cola llenada en paralelo queda igual que la
+ * llenada en un solo hilo.
+ */
+bool testRenderQueueSortsByKey() {
+    if (!keysRoundTrip()) {
+        std::cerr << "[FAIL] Campos de la clave de dibujo\n";
+        return false;
+    }
+
+    if (!orderIsRespected()) {
+        std::cerr << "[FAIL] Orden de la cola de dibujo\n";
+        return false;
+    }
+
+    for (size_t count : { size_t(0), size_t(1), size_t(1000), size_t(200000) }) {
+        if (!parallelFillMatchesSerial(count)) {
+            std::cerr << "[FAIL] Cola de dibujo en paralelo distinta de la secuencial (" << count << " dibujos)\n";
+            return false;
+        }
+    }
+
+    std::cout << "[PASS] Cola de dibujo ordenada por clave\n";
+    return true;
+}
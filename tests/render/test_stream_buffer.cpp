@@ -0,0 +1,154 @@
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "render/stream_buffer.hpp"
+
+#include "../gl_stubs.hpp"
+
+namespace {
+
+// Sin contexto de OpenGL: un buffer falso en memoria y fences numeradas.
+// Se apunta lo que importa para el anillo: qué fences se esperan, cuándo
+// se deja huérfano el buffer y si está mapeado al dibujar
+std::vector<unsigned char> storage;
+bool mapped = false;
+int orphans = 0;
+int storages = 0;
+size_t nextFence = 1;
+std::vector<size_t> waited;
+
+void APIENTRY stubGenBuffers(GLsizei count, GLuint* buffers) {
+    for (GLsizei i = 0; i < count; i++) {
+        buffers[i] = 9;
+    }
+}
+void APIENTRY stubDeleteBuffers(GLsizei, const GLuint*) { storage.clear(); }
+void APIENTRY stubBindBuffer(GLenum, GLuint) {}
+
+void APIENTRY stubBufferData(GLenum, GLsizeiptr size, const void*, GLenum) {
+    storage.assign(static_cast<size_t>(size), 0);
+    orphans++;
+}
+
+void APIENTRY stubBufferStorage(GLenum, GLsizeiptr size, const void*, GLbitfield) {
+    storage.assign(static_cast<size_t>(size), 0);
+    storages++;
+}
+
+void* APIENTRY stubMapBufferRange(GLenum, GLintptr offset, GLsizeiptr, GLbitfield) {
+    mapped = true;
+    return storage.data() + offset;
+}
+
+GLboolean APIENTRY stubUnmapBuffer(GLenum) {
+    mapped = false;
+    return GL_TRUE;
+}
+
+GLsync APIENTRY stubFenceSync(GLenum, GLbitfield) {
+    return reinterpret_cast<GLsync>(nextFence++);
+}
+void APIENTRY stubDeleteSync(GLsync) {}
+
+GLenum APIENTRY stubClientWaitSync(GLsync fence, GLbitfield, GLuint64) {
+    waited.push_back(reinterpret_cast<size_t>(fence));
+    return GL_ALREADY_SIGNALED;
+}
+
+bool rotates(bool persistent) {
+    GLAD_GL_ARB_buffer_storage = persistent ? 1 : 0;
+    orphans = 0;
+    storages = 0;
+    nextFence = 1;
+    waited.clear();
+
+    bool ok = true;
+    {
+        render::StreamBuffer stream;
+        stream.setPersistent(persistent);
+        ok &= stream.isPersistent() == persistent;
+
+        const size_t region = render::StreamBuffer::kMinRegionSize;
+
+        for (size_t frame = 0; frame < 7; frame++) {
+            stream.beginFrame(1000);
+            const size_t expected = frame % render::StreamBuffer::kRegions;
+
+            // Antes de escribir encima, la fence del frame que usó la región.
+            // Sin persistencia cada vuelta estrena almacenamiento y no hay
+            // que esperar nunca
+            if (persistent && frame >= render::StreamBuffer::kRegions) {
+                ok &= !waited.empty() && waited.back() == frame + 1 - render::StreamBuffer::kRegions;
+            }
+
+            const render::StreamAllocation a = stream.allocate(100);
+            const render::StreamAllocation b = stream.allocate(52, 16);
+            ok &= a.valid() && b.valid();
+            ok &= a.offset == expected * region;
+            ok &= b.offset == a.offset + 112;
+            ok &= !stream.allocate(region).valid();
+
+            std::memset(b.data, int(frame + 1), b.size);
+            stream.flush();
+
+            // Lo escrito está en su sitio del buffer y nada mapeado al
+            // dibujar (salvo el mapeo persistente)
+            ok &= storage[b.offset] == frame + 1 && storage[b.offset + b.size - 1] == frame + 1;
+            ok &= mapped == persistent;
+
+            stream.endFrame();
+        }
+
+        // Sin persistencia, huérfano en la creación y en cada vuelta
+        // (frames 0, 3 y 6)
+        ok &= persistent ? storages == 1 && orphans == 0 : orphans == 4 && storages == 0;
+        ok &= persistent ? waited.size() == 4 : waited.empty();
+
+        // Crecer espera a todo lo que la GPU pueda leer todavía
+        waited.clear();
+        stream.beginFrame(3 * region);
+        ok &= stream.getRegionSize() >= 3 * region;
+        ok &= stream.allocate(3 * region).valid();
+        ok &= waited.size() == (persistent ? 3u : 0u);
+        stream.endFrame();
+    }
+
+    // Destruido: desmapeado
+    ok &= !mapped;
+    return ok;
+}
+
+} // namespace
+
+/**
+ * El anillo debe rotar sus tres regiones y crecer sin dejar nada en uso. Con
+ * mapeo persistente espera la fence de cada región antes de reutilizarla;
+ * sin GL_ARB_buffer_storage desmapea antes de dibujar y deja el buffer
+ * huérfano al dar la vuelta.
+ */
+bool testStreamBufferRotatesRegions() {
+    GLStubs gl;
+    gl.set(glad_glGenBuffers, stubGenBuffers);
+    gl.set(glad_glDeleteBuffers, stubDeleteBuffers);
+    gl.set(glad_glBindBuffer, stubBindBuffer);
+    gl.set(glad_glBufferData, stubBufferData);
+    gl.set(glad_glBufferStorage, stubBufferStorage);
+    gl.set(glad_glMapBufferRange, stubMapBufferRange);
+    gl.set(glad_glUnmapBuffer, stubUnmapBuffer);
+    gl.set(glad_glFenceSync, stubFenceSync);
+    gl.set(glad_glDeleteSync, stubDeleteSync);
+    gl.set(glad_glClientWaitSync, stubClientWaitSync);
+    gl.set(GLAD_GL_ARB_buffer_storage, 0);
+
+    const bool persistent = rotates(true);
+    const bool fallback = rotates(false);
+
+    if (!persistent || !fallback) {
+        std::cerr << "[FAIL] Buffer de streaming en anillo (" << (persistent ? "huérfano" : "persistente") << ")\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Buffer de streaming en anillo\n";
+    return true;
+}
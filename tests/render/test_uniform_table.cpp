@@ -0,0 +1,37 @@
+#include <iostream>
+
+#include "render/uniform_table.hpp"
+
+/**
+ * Los handles tipados solo deben resolverse si el uniforme existe y su tipo
+ * GLSL coincide con el de C++; los arrays se buscan sin "[0]" y los
+ * miembros de bloques (location -1) no aparecen.
+ */
+bool testUniformHandlesResolveByType() {
+    render::UniformTable table;
+    table.add({ "view", GL_FLOAT_MAT4, 3, 1 });
+    table.add({ "model", GL_FLOAT_MAT4x3, 0, 1 });
+    table.add({ "useOverrideColor", GL_BOOL, 7, 1 });
+    table.add({ "lights[0]", GL_FLOAT_VEC3, 9, 4 });
+    table.add({ "time", GL_FLOAT, -1, 1 });
+
+    const bool ok =
+        table.getHandle<glm::mat4>("view").getLocation() == 3
+        && table.getHandle<math::Affine3x4>("model").getLocation() == 0
+        && table.getHandle<bool>("useOverrideColor").getLocation() == 7
+        && table.getHandle<glm::vec3>("lights").getLocation() == 9
+        && table.find("lights")->count == 4
+        && !table.getHandle<glm::mat4>("model").valid()
+        && !table.getHandle<int>("useOverrideColor").valid()
+        && !table.getHandle<float>("time").valid()
+        && !table.getHandle<glm::vec3>("missing").valid()
+        && table.getUniforms().size() == 4;
+
+    if (!ok) {
+        std::cerr << "[FAIL] Handles de uniformes mal resueltos\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Handles de uniformes resueltos por nombre y tipo\n";
+    return true;
+}
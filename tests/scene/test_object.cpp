@@ -0,0 +1,136 @@
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "geometry/mesh_factory.hpp"
+#include "geometry/subdivision.hpp"
+#include "scene/object.hpp"
+
+#include "../gl_stubs.hpp"
+
+namespace {
+
+// Sin contexto de OpenGL: los buffers son vectores de bytes, así se puede
+// leer lo que la arena ha subido
+std::map<GLuint, std::vector<char>> buffers;
+std::map<GLenum, GLuint> bound;
+GLuint nextName = 1;
+
+// El buffer de vértices es el que la arena deja como GL_ARRAY_BUFFER al
+// fijar el formato del VAO
+GLuint vertexBuffer = 0;
+
+void APIENTRY stubGenNames(GLsizei count, GLuint* names) {
+    for (GLsizei i = 0; i < count; i++) {
+        names[i] = nextName++;
+    }
+}
+void APIENTRY stubDeleteNames(GLsizei, const GLuint*) {}
+void APIENTRY stubBindVertexArray(GLuint) {}
+void APIENTRY stubBindBuffer(GLenum target, GLuint buffer) {
+    bound[target] = buffer;
+    if (target == GL_ARRAY_BUFFER && buffer != 0) {
+        vertexBuffer = buffer;
+    }
+}
+void APIENTRY stubBufferData(GLenum target, GLsizeiptr size, const void*, GLenum) {
+    buffers[bound[target]].assign(size, 0);
+}
+void APIENTRY stubBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    std::memcpy(buffers[bound[target]].data() + offset, data, size);
+}
+void APIENTRY stubCopyBufferSubData(GLenum read, GLenum write, GLintptr from, GLintptr to, GLsizeiptr size) {
+    std::memcpy(buffers[bound[write]].data() + to, buffers[bound[read]].data() + from, size);
+}
+void APIENTRY stubVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+void APIENTRY stubEnableVertexAttribArray(GLuint) {}
+
+bool sameVertices(const std::vector<app::geometry::Vertex>& a, const std::vector<app::geometry::Vertex>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (glm::length(a[i].position - b[i].position) > 1e-5f ||
+            glm::length(a[i].color - b[i].color) > 1e-5f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Lo que hay en la GPU para la malla que dibuja 'object'
+std::vector<app::geometry::Vertex> uploadedVertices(const Object& object, size_t count) {
+    const render::DrawElementsIndirectCommand command = object.getDrawCommand(0, 1);
+    const std::vector<char>& data = buffers[vertexBuffer];
+
+    std::vector<app::geometry::Vertex> vertices(count);
+    std::memcpy(vertices.data(), data.data() + command.baseVertex * sizeof(app::geometry::Vertex),
+        count * sizeof(app::geometry::Vertex));
+    return vertices;
+}
+
+} // namespace
+
+/**
+ * Editar la jaula de un objeto subdividido debe dejar la superficie (en
+ * memoria y en la GPU) igual que evaluarla de cero con la jaula nueva, sin
+ * tocar las copias del objeto que compartían la superficie.
+ */
+bool testObjectCageEditUpdatesSubdivision() {
+    GLStubs gl;
+    gl.set(glad_glGenVertexArrays, stubGenNames);
+    gl.set(glad_glDeleteVertexArrays, stubDeleteNames);
+    gl.set(glad_glGenBuffers, stubGenNames);
+    gl.set(glad_glDeleteBuffers, stubDeleteNames);
+    gl.set(glad_glBindVertexArray, stubBindVertexArray);
+    gl.set(glad_glBindBuffer, stubBindBuffer);
+    gl.set(glad_glBufferData, stubBufferData);
+    gl.set(glad_glBufferSubData, stubBufferSubData);
+    gl.set(glad_glCopyBufferSubData, stubCopyBufferSubData);
+    gl.set(glad_glVertexAttribPointer, stubVertexAttribPointer);
+    gl.set(glad_glEnableVertexAttribArray, stubEnableVertexAttribArray);
+
+    const int levels = 2;
+    const app::geometry::Mesh cage = app::geometry::MeshFactory::createCubeMesh();
+    const app::geometry::Mesh original = app::geometry::SubdivisionSurface(cage, levels).refine(cage);
+
+    app::geometry::Mesh moved = cage;
+    moved.vertices[2].position += glm::vec3(0.3f, 0.5f, -0.2f);
+    moved.vertices[5].color = glm::vec3(1.0f, 0.0f, 0.0f);
+    const app::geometry::Mesh expected = app::geometry::SubdivisionSurface(moved, levels).refine(moved);
+
+    bool ok = true;
+    {
+        render::GeometryArena arena;
+        Object object(1, "Cubo", cage, Transform{}, arena);
+        object.setSubdivisionLevels(levels);
+
+        // La copia comparte superficie y mallas de la GPU
+        Object copy = object;
+
+        ok &= !copy.setVertices(std::vector<app::geometry::Vertex>(3));
+        ok &= copy.setVertices(moved.vertices);
+
+        ok &= sameVertices(copy.getSubdividedVertices(), expected.vertices);
+        ok &= sameVertices(uploadedVertices(copy, expected.vertices.size()), expected.vertices);
+
+        ok &= sameVertices(object.getSubdividedVertices(), original.vertices);
+        ok &= sameVertices(uploadedVertices(object, original.vertices.size()), original.vertices);
+        ok &= object.getMeshId() != copy.getMeshId();
+
+        // Volver a la jaula original reevalúa sobre la misma malla de la GPU
+        const uint32_t meshId = copy.getMeshId();
+        ok &= copy.setVertices(cage.vertices);
+        ok &= copy.getMeshId() == meshId;
+        ok &= sameVertices(uploadedVertices(copy, original.vertices.size()), original.vertices);
+    }
+
+    if (!ok) {
+        std::cerr << "[FAIL] Edición de la jaula de un objeto subdividido\n";
+        return false;
+    }
+
+    std::cout << "[PASS] Edición de la jaula de un objeto subdividido\n";
+    return true;
+}
@@ -10,4 +10,72 @@ bool testRayMissesAABB();
 
 bool testRayStartsInsideAABB();
 
-bool testRayParallelOutsideAABB();
\ No newline at end of file
+bool testRayParallelOutsideAABB();
+
+bool testRayBatchMatchesScalar();
+
+bool testRayPacketMatchesSingleRays();
+
+bool testRayTriangleMatchesReference();
+
+bool testRayTriangleWatertight();
+
+bool testBoundingBoxMatchesScalar();
+
+bool testBoundingSphereContainsPoints();
+
+bool testOrientedBoundingBoxContainsPoints();
+
+bool testFrustumBatchMatchesScalar();
+
+bool testTransformBatchMatchesScalar();
+
+bool testTransformCameraRelative();
+
+bool testAffineMatchesMatrix();
+
+bool testClosestPointsMatchSampling();
+
+bool testSpaceFillingCurves();
+
+bool testRadixSortMatchesStableSort();
+
+bool testConstexprMathErrorBounds();
+
+bool testBuiltinSphereMatchesRuntime();
+
+bool testSubdivisionCubeCounts();
+
+bool testSubdivisionReevaluation();
+
+bool testObjectCageEditUpdatesSubdivision();
+
+bool testImplicitMesherSphereClosed();
+
+bool testImplicitMesherDualContouring();
+
+bool testOrient3dExact();
+
+bool testMeshBooleanVolumes();
+
+bool testMeshBooleanEmptyResults();
+
+bool testMeshBooleanChained();
+
+bool testChunkedMeshRoundTrip();
+
+bool testKdTreeMatchesBruteForce();
+
+bool testRangeAllocatorConsistency();
+
+bool testUniformHandlesResolveByType();
+
+bool testGLStateCacheFiltersRedundantCalls();
+
+bool testRenderQueueSortsByKey();
+
+bool testIndirectDrawMatchesFallback();
+
+bool testStreamBufferRotatesRegions();
+
+bool testOutlinePassPingPongs();
@@ -10,6 +10,40 @@ int main() {
     success &= testRayMissesAABB();
     success &= testRayStartsInsideAABB();
     success &= testRayParallelOutsideAABB();
+    success &= testRayBatchMatchesScalar();
+    success &= testRayPacketMatchesSingleRays();
+    success &= testRayTriangleMatchesReference();
+    success &= testRayTriangleWatertight();
+    success &= testBoundingBoxMatchesScalar();
+    success &= testBoundingSphereContainsPoints();
+    success &= testOrientedBoundingBoxContainsPoints();
+    success &= testFrustumBatchMatchesScalar();
+    success &= testTransformBatchMatchesScalar();
+    success &= testTransformCameraRelative();
+    success &= testAffineMatchesMatrix();
+    success &= testClosestPointsMatchSampling();
+    success &= testSpaceFillingCurves();
+    success &= testRadixSortMatchesStableSort();
+    success &= testConstexprMathErrorBounds();
+    success &= testBuiltinSphereMatchesRuntime();
+    success &= testSubdivisionCubeCounts();
+    success &= testSubdivisionReevaluation();
+    success &= testObjectCageEditUpdatesSubdivision();
+    success &= testImplicitMesherSphereClosed();
+    success &= testImplicitMesherDualContouring();
+    success &= testOrient3dExact();
+    success &= testMeshBooleanVolumes();
+    success &= testMeshBooleanEmptyResults();
+    success &= testMeshBooleanChained();
+    success &= testChunkedMeshRoundTrip();
+    success &= testKdTreeMatchesBruteForce();
+    success &= testRangeAllocatorConsistency();
+    success &= testUniformHandlesResolveByType();
+    success &= testGLStateCacheFiltersRedundantCalls();
+    success &= testRenderQueueSortsByKey();
+    success &= testIndirectDrawMatchesFallback();
+    success &= testStreamBufferRotatesRegions();
+    success &= testOutlinePassPingPongs();
 
    return success ? EXIT_SUCCESS : EXIT_FAILURE;
 }
\ No newline at end of file